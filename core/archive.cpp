@@ -0,0 +1,262 @@
+#include "core/archive.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
+
+#include "core/file_io.h"
+#include "core/utf.h"
+
+namespace fs = std::filesystem;
+
+bool ReadArchiveMemo(IArchiveMemoIo& io, const fs::path& folder, ArchiveRecord& rec) {
+    std::error_code ec;
+    auto t = fs::last_write_time(folder / L"folder_memo.txt", ec);
+    if (ec) return false;
+    rec.mtime = (int64_t)t.time_since_epoch().count();
+    rec.content = io.Load(folder.wstring());
+    rec.hash = Sha256::Of(rec.content.data(), rec.content.size());
+    return true;
+}
+
+std::string ArchiveRelativePath(const fs::path& folder, const std::wstring& root) {
+    return WideToUtf8(folder.lexically_relative(fs::path(root)).wstring());
+}
+
+void AppendArchiveRecord(std::string& out, const ArchiveRecord& rec) {
+    uint32_t hdr[4] = { 0x45414D46 /* "FMAE" */, rec.root, (uint32_t)rec.relPath.size(), (uint32_t)rec.content.size() };
+    out.append((const char*)hdr, sizeof(hdr));
+    out.append((const char*)&rec.mtime, 8);
+    out.append((const char*)rec.hash.data(), 32);
+    out += rec.relPath;
+    out += rec.content;
+}
+
+bool ExportMemoArchive(IArchiveMemoIo& io, const std::vector<std::wstring>& roots, const fs::path& archive, unsigned threads, ArchiveStats& stats) {
+    auto t0 = std::chrono::steady_clock::now();
+    if (threads == 0) threads = 1;
+    fs::path tmp = archive; tmp += L".tmp";
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    std::string header;
+    uint32_t head[3] = { 0x52414D46 /* "FMAR" */, 1, (uint32_t)roots.size() };
+    header.append((const char*)head, sizeof(head));
+    for (const auto& root : roots) {
+        std::string utf8 = WideToUtf8(root);
+        uint32_t len = (uint32_t)utf8.size();
+        header.append((const char*)&len, 4);
+        header += utf8;
+    }
+    out.write(header.data(), header.size());
+
+    std::mutex outMutex;
+    std::atomic<unsigned long long> records{ 0 }, bytes{ 0 };
+    std::vector<std::string> buffers(threads);
+    auto flush = [&](std::string& buf) {
+        std::lock_guard<std::mutex> lock(outMutex);
+        out.write(buf.data(), buf.size());
+        buf.clear();
+    };
+    ParallelTreeWalker walker;
+    walker.Run(roots, threads, [&](unsigned worker, uint32_t root, const fs::path& folder) {
+        thread_local ArchiveRecord rec;
+        if (!ReadArchiveMemo(io, folder, rec)) return;
+        rec.root = root;
+        rec.relPath = ArchiveRelativePath(folder, roots[root]);
+        AppendArchiveRecord(buffers[worker], rec);
+        records++;
+        bytes += rec.content.size();
+        if (buffers[worker].size() >= ARCHIVE_FLUSH_BYTES) flush(buffers[worker]);
+    });
+    for (auto& buf : buffers) if (!buf.empty()) flush(buf);
+    uint32_t endMagic = 0x5A414D46; // "FMAZ"
+    unsigned long long count = records;
+    out.write((const char*)&endMagic, 4);
+    out.write((const char*)&count, 8);
+    out.close();
+    std::error_code ec;
+    if (out) fs::rename(tmp, archive, ec);
+    if (!out || ec) { fs::remove(tmp, ec); return false; }
+
+    stats.records = count;
+    stats.contentBytes = bytes;
+    stats.directories = walker.Directories();
+    stats.steals = walker.Steals();
+    stats.sleeps = walker.Sleeps();
+    stats.ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    return true;
+}
+
+bool ReadMemoArchive(const fs::path& archive, std::vector<std::wstring>& roots, const std::function<void(const ArchiveRecord&)>& fn) {
+    std::ifstream in(archive, std::ios::binary);
+    uint32_t head[3];
+    if (!in.read((char*)head, sizeof(head)) || head[0] != 0x52414D46 || head[1] != 1) return false;
+    roots.clear();
+    for (uint32_t i = 0; i < head[2]; i++) {
+        uint32_t len;
+        std::string utf8;
+        if (!in.read((char*)&len, 4)) return false;
+        utf8.resize(len);
+        if (len && !in.read(&utf8[0], len)) return false;
+        roots.push_back(Utf8ToWide(utf8));
+    }
+    ArchiveRecord rec;
+    unsigned long long count = 0;
+    for (;;) {
+        uint32_t magic;
+        if (!in.read((char*)&magic, 4)) return false;
+        if (magic == 0x5A414D46) {
+            unsigned long long expected;
+            return in.read((char*)&expected, 8) && expected == count;
+        }
+        uint32_t hdr[3];
+        if (magic != 0x45414D46 || !in.read((char*)hdr, sizeof(hdr)) || hdr[0] >= roots.size()) return false;
+        rec.root = hdr[0];
+        rec.relPath.resize(hdr[1]);
+        rec.content.resize(hdr[2]);
+        if (!in.read((char*)&rec.mtime, 8) || !in.read((char*)rec.hash.data(), 32)) return false;
+        if (hdr[1] && !in.read(&rec.relPath[0], hdr[1])) return false;
+        if (hdr[2] && !in.read(&rec.content[0], hdr[2])) return false;
+        if (Sha256::Of(rec.content.data(), rec.content.size()) != rec.hash) return false;
+        fn(rec);
+        count++;
+    }
+}
+
+fs::path ArchiveFolder(const std::vector<std::wstring>& roots, const ArchiveRecord& rec, const std::wstring& target) {
+    fs::path base = target.empty() ? fs::path(roots[rec.root]) : fs::path(target);
+    fs::path folder = (base / fs::path(Utf8ToWide(rec.relPath))).lexically_normal();
+    // 루트 자체의 메모("." -> "루트/")는 순회가 보는 경로와 같도록 끝 구분자 제거
+    if (!folder.has_filename() && folder.has_relative_path()) folder = folder.parent_path();
+    return folder;
+}
+
+// [PRD 5.9] 덮어쓰기 전 현재 내용은 io.Restore에 함께 넘김 (Win32 앱은 버전 기록으로 남김, --restore와 같은 안전망)
+bool RestoreMemoArchive(IArchiveMemoIo& io, const fs::path& archive, const std::wstring& target,
+                        size_t& restored, size_t& unchanged, size_t& skipped) {
+    restored = unchanged = skipped = 0;
+    std::vector<std::wstring> roots;
+    return ReadMemoArchive(archive, roots, [&](const ArchiveRecord& rec) {
+        fs::path folder = ArchiveFolder(roots, rec, target);
+        std::wstring path = folder.wstring();
+        std::error_code ec;
+        if (!fs::is_directory(folder, ec)) { skipped++; return; }
+        std::string live;
+        bool hadMemo = fs::exists(folder / L"folder_memo.txt", ec);
+        if (hadMemo) {
+            live = io.Load(path);
+            if (live == rec.content) { unchanged++; return; }
+        }
+        if (io.Restore(path, hadMemo ? &live : nullptr, rec.content)) restored++;
+        else skipped++;
+    });
+}
+
+bool DiffMemoArchive(IArchiveMemoIo& io, const fs::path& archive, const std::wstring& target, unsigned threads,
+                     std::vector<std::wstring>& lines, ArchiveStats& stats) {
+    auto t0 = std::chrono::steady_clock::now();
+    if (threads == 0) threads = 1;
+    std::vector<std::wstring> roots;
+    std::unordered_map<std::wstring, std::pair<Sha256::Digest, size_t>> archived; // 정규화 경로 -> (해시, 번호)
+    std::vector<std::wstring> archivedPaths;
+    bool ok = ReadMemoArchive(archive, roots, [&](const ArchiveRecord& rec) {
+        std::wstring path = ArchiveFolder(roots, rec, target).wstring();
+        archived[io.NormalizeKey(path)] = { rec.hash, archivedPaths.size() };
+        archivedPaths.push_back(path);
+    });
+    if (!ok) return false;
+
+    std::vector<std::wstring> liveRoots = roots;
+    if (!target.empty()) liveRoots.assign(1, target);
+    std::vector<std::vector<std::wstring>> found(threads);
+    std::vector<std::vector<size_t>> seen(threads);
+    std::atomic<unsigned long long> records{ 0 }, bytes{ 0 };
+    ParallelTreeWalker walker;
+    walker.Run(liveRoots, threads, [&](unsigned worker, uint32_t, const fs::path& folder) {
+        thread_local ArchiveRecord rec;
+        if (!ReadArchiveMemo(io, folder, rec)) return;
+        records++;
+        bytes += rec.content.size();
+        std::wstring path = folder.lexically_normal().wstring();
+        auto it = archived.find(io.NormalizeKey(path));
+        if (it == archived.end()) { found[worker].push_back(L"+ " + path); return; }
+        seen[worker].push_back(it->second.second);
+        if (it->second.first != rec.hash) found[worker].push_back(L"M " + path);
+    });
+
+    std::vector<bool> matched(archivedPaths.size(), false);
+    for (const auto& list : seen) for (size_t i : list) matched[i] = true;
+    lines.clear();
+    for (auto& list : found) lines.insert(lines.end(), list.begin(), list.end());
+    for (size_t i = 0; i < archivedPaths.size(); i++) if (!matched[i]) lines.push_back(L"- " + archivedPaths[i]);
+    std::sort(lines.begin(), lines.end(), [](const std::wstring& a, const std::wstring& b) { return a.compare(2, std::wstring::npos, b, 2, std::wstring::npos) < 0; });
+
+    stats.records = records;
+    stats.contentBytes = bytes;
+    stats.directories = walker.Directories();
+    stats.steals = walker.Steals();
+    stats.sleeps = walker.Sleeps();
+    stats.ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    return true;
+}
+
+std::wstring ArchiveStatsLine(const wchar_t* what, const ArchiveStats& s, unsigned threads) {
+    double sec = s.ms > 0 ? s.ms / 1000.0 : 0.001;
+    wchar_t buf[300];
+    swprintf(buf, 300, L"%ls: %llu memos (%.1f MB) in %llu directories, %lld ms, %u threads -> %.0f dirs/s, %.1f MB/s, %llu steals, %llu sleeps",
+        what, s.records, s.contentBytes / 1048576.0, s.directories, s.ms, threads, s.directories / sec,
+        s.contentBytes / 1048576.0 / sec, s.steals, s.sleeps);
+    return buf;
+}
+
+bool RunArchiveBench(IArchiveMemoIo& io, const fs::path& dir, size_t directories, unsigned threads,
+                     const std::function<void(const std::wstring&)>& print) {
+    std::error_code ec;
+    fs::path tree = dir / L"tree";
+    if (!fs::exists(dir / L"bench.ready", ec)) {
+        auto t0 = std::chrono::steady_clock::now();
+        fs::remove_all(tree, ec);
+        std::deque<fs::path> frontier{ tree };
+        fs::create_directories(tree, ec);
+        size_t made = 1;
+        std::string memo = "synthetic memo\r\n";
+        for (int i = 0; i < 12; i++) memo += "line of text for throughput measurement " + std::to_string(i) + "\r\n";
+        while (made < directories && !frontier.empty()) {
+            fs::path parent = frontier.front();
+            frontier.pop_front();
+            for (int c = 0; c < 16 && made < directories; c++, made++) {
+                fs::path child = parent / std::to_wstring(c);
+                if (!fs::create_directory(child, ec)) return false;
+                if (made % 8 == 0) WriteFileAtomic(child / L"folder_memo.txt", memo);
+                frontier.push_back(child);
+            }
+        }
+        std::ofstream(dir / L"bench.ready") << directories;
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+        print(L"generated " + std::to_wstring(made) + L" directories in " + std::to_wstring(ms) + L" ms");
+    }
+    std::vector<std::wstring> roots{ tree.wstring() };
+    fs::path archive = dir / L"bench.fma";
+    ArchiveStats single, parallel, diff;
+    if (!ExportMemoArchive(io, roots, archive, 1, single) || !ExportMemoArchive(io, roots, archive, threads, parallel)) return false;
+    print(ArchiveStatsLine(L"export", single, 1));
+    print(ArchiveStatsLine(L"export", parallel, threads));
+    std::vector<std::wstring> lines;
+    if (!DiffMemoArchive(io, archive, std::wstring(), threads, lines, diff)) return false;
+    print(ArchiveStatsLine(L"diff", diff, threads));
+    print(L"archive " + std::to_wstring(fs::file_size(archive, ec)) + L" bytes, " + std::to_wstring(lines.size()) + L" difference(s)");
+    return lines.empty();
+}
+
+bool FileArchiveIo::Restore(const std::wstring& folderPath, const std::string*, const std::string& content) {
+    if (!WriteFileAtomic(MemoJournalStore::BasePath(folderPath), content)) return false;
+    std::error_code ec;
+    fs::remove(MemoJournalStore::JournalPath(folderPath), ec); // 헤더가 새 기준 파일과 맞지 않아 어차피 무시되지만 남기지 않음
+    return true;
+}
+
+std::wstring FileArchiveIo::NormalizeKey(const std::wstring& folderPath) {
+    return fs::path(folderPath).lexically_normal().generic_wstring();
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/history.h"
+#include "core/journal.h"
+
+// --- [메모 아카이브] ---
+// [PRD 6.2] 트리 전체 메모 백업/이전/감사 (--archive-export / --archive-restore / --archive-diff)
+// -> 오버레이 없이 루트 아래 folder_memo.txt를 모두 찾아 하나의 아카이브로 (경로, 수정 시각, SHA-256, 내용).
+// -> 시간 대부분이 디렉터리 열거 -> 작업 훔치기 병렬 순회: 스레드마다 디렉터리 덱, 자기 덱은 뒤에서(깊이 우선, 지역성),
+//    비면 다른 스레드 덱의 앞(트리 위쪽, 큰 덩어리)에서 훔침. 한쪽 가지만 깊은 트리도 스레드가 놀지 않음.
+// -> 훔칠 것도 없으면 조건 변수에서 잠듦 (새 디렉터리가 들어오거나 전체가 끝나면 깨움) -> 가지가 좁은 구간에서 CPU를 태우지 않음.
+// -> 읽기는 IArchiveMemoIo 경계 (Win32 앱: g_journal.Load로 남은 저널 재생, CLI: MemoJournalStore) -> 오버레이가 보여 줄 내용 그대로 보관.
+// -> 레코드는 스레드별 버퍼에 모았다가 ARCHIVE_FLUSH_BYTES마다 한 번에 덧붙임 (순서 보장 없음, 복원/비교는 경로로 맞춤).
+// -> 순회/형식은 std::filesystem + std::thread만 사용 (Win32 의존 없음).
+// -> 형식: [헤더: 'FMAR' | version | 루트 수 | (길이, 루트 UTF-8)...]
+//          + [레코드: 'FMAE' | 루트 번호 | 경로 길이 | 내용 길이 | mtime(i64) | SHA-256 | 루트 기준 상대 경로(UTF-8) | 내용]...
+//          + [끝: 'FMAZ' | 레코드 수(u64)]  -> 끝 표식이 없으면 중간에 끊긴 아카이브로 보고 거부
+const size_t ARCHIVE_FLUSH_BYTES = 1024 * 1024;
+
+struct ArchiveRecord {
+    uint32_t root = 0;
+    std::string relPath; // 루트 기준 상대 경로 (루트 자체는 ".")
+    int64_t mtime = 0;   // folder_memo.txt 수정 시각 (file_clock 틱)
+    Sha256::Digest hash{};
+    std::string content;
+};
+
+class ParallelTreeWalker {
+public:
+    // 메모가 있는 폴더마다 호출 (여러 스레드에서 동시에, worker = 0..threads-1)
+    typedef std::function<void(unsigned worker, uint32_t root, const std::filesystem::path& folder)> Visit;
+
+    void Run(const std::vector<std::wstring>& roots, unsigned threads, const Visit& visit) {
+        if (threads == 0) threads = 1;
+        m_queues.clear();
+        for (unsigned i = 0; i < threads; i++) m_queues.emplace_back(new Queue);
+        m_pending = roots.size();
+        m_pushes = 0;
+        m_sleepers = 0;
+        for (uint32_t r = 0; r < roots.size(); r++) m_queues[r % threads]->dirs.push_back({ r, std::filesystem::path(roots[r]) });
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads; i++) workers.emplace_back([this, i, &visit] { Worker(i, visit); });
+        Worker(0, visit);
+        for (auto& t : workers) t.join();
+    }
+
+    unsigned long long Directories() const { return m_dirs; }
+    unsigned long long Steals() const { return m_steals; }
+    unsigned long long Sleeps() const { return m_sleeps; }
+
+private:
+    struct Dir {
+        uint32_t root;
+        std::filesystem::path path;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Dir> dirs;
+    };
+
+    bool Pop(unsigned self, Dir& out) {
+        {
+            Queue& own = *m_queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.dirs.empty()) { out = std::move(own.dirs.back()); own.dirs.pop_back(); return true; }
+        }
+        for (size_t k = 1; k < m_queues.size(); k++) {
+            Queue& victim = *m_queues[(self + k) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.dirs.empty()) { out = std::move(victim.dirs.front()); victim.dirs.pop_front(); m_steals++; return true; }
+        }
+        return false;
+    }
+
+    void Worker(unsigned self, const Visit& visit) {
+        Dir dir;
+        std::vector<Dir> subdirs;
+        for (;;) {
+            // 덱을 훑기 전의 넣기 횟수 -> 훑은 뒤 잠들기 전에 그 사이 넣은 것이 있으면 다시 훑음 (깨움 유실 방지)
+            unsigned long long pushes;
+            {
+                std::lock_guard<std::mutex> lock(m_idleMutex);
+                pushes = m_pushes;
+            }
+            if (!Pop(self, dir)) {
+                std::unique_lock<std::mutex> lock(m_idleMutex);
+                if (m_pending.load() == 0) return;
+                if (m_pushes == pushes) {
+                    m_sleepers++;
+                    m_sleeps++;
+                    m_idleCv.wait(lock, [&] { return m_pending.load() == 0 || m_pushes != pushes; });
+                    m_sleepers--;
+                }
+                if (m_pending.load() == 0) return;
+                continue;
+            }
+            subdirs.clear();
+            bool hasMemo = false;
+            std::error_code ec;
+            std::filesystem::directory_iterator it(dir.path, std::filesystem::directory_options::skip_permission_denied, ec), end;
+            for (; !ec && it != end; it.increment(ec)) {
+                std::error_code tec;
+                // 열거 시 받은 종류 정보만 사용 (항목마다 stat 안 함). 링크/정션은 따라가지 않음 (순환 방지)
+                if (it->is_symlink(tec)) continue;
+                if (it->is_directory(tec)) subdirs.push_back({ dir.root, it->path() });
+                else if (it->path().filename() == L"folder_memo.txt") hasMemo = true;
+            }
+            if (!subdirs.empty()) {
+                m_pending += subdirs.size(); // 자식을 먼저 세야 아래 감소로 0이 되어 다른 스레드가 일찍 끝나지 않음
+                {
+                    Queue& own = *m_queues[self];
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    for (auto& d : subdirs) own.dirs.push_back(std::move(d));
+                }
+                std::lock_guard<std::mutex> lock(m_idleMutex);
+                m_pushes++;
+                if (m_sleepers) m_idleCv.notify_all(); // 잠든 스레드가 있을 때만 (보통은 모두 바쁨)
+            }
+            if (hasMemo) visit(self, dir.root, dir.path);
+            m_dirs++;
+            if (--m_pending == 0) {
+                std::lock_guard<std::mutex> lock(m_idleMutex); // 잠들기 직전의 스레드가 0을 놓치지 않도록 락 아래서 알림
+                m_idleCv.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::atomic<size_t> m_pending{ 0 };
+    std::mutex m_idleMutex; // m_pushes/m_sleepers 보호 + 잠든 스레드 깨우기
+    std::condition_variable m_idleCv;
+    unsigned long long m_pushes = 0;
+    unsigned m_sleepers = 0;
+    std::atomic<unsigned long long> m_dirs{ 0 };
+    std::atomic<unsigned long long> m_steals{ 0 };
+    std::atomic<unsigned long long> m_sleeps{ 0 };
+};
+
+// 아카이브가 메모를 읽고 되돌리는 경계 (Win32 앱은 g_journal/폴더 저장소/버전 기록, CLI는 MemoJournalStore + 파일)
+class IArchiveMemoIo {
+public:
+    virtual ~IArchiveMemoIo() {}
+    virtual std::string Load(const std::wstring& folderPath) = 0; // 남은 저널까지 재생한 내용
+    // 복원 기록. live = 덮어쓸 현재 내용 (메모가 없던 폴더면 nullptr) -> 버전 기록 등 안전망용
+    virtual bool Restore(const std::wstring& folderPath, const std::string* live, const std::string& content) = 0;
+    virtual std::wstring NormalizeKey(const std::wstring& folderPath) = 0; // 비교용 경로 키 (대소문자/구분자)
+};
+
+// 앱 밖(CLI/테스트)용: MemoJournalStore::Load로 읽고(남은 저널 재생), 복원은 원자적 기록 후 낡은 저널 삭제 (버전 기록 없음)
+class FileArchiveIo : public IArchiveMemoIo {
+public:
+    std::string Load(const std::wstring& folderPath) override { return m_journal.Load(folderPath); }
+    bool Restore(const std::wstring& folderPath, const std::string* live, const std::string& content) override;
+    std::wstring NormalizeKey(const std::wstring& folderPath) override; // 대소문자 구분 (POSIX)
+
+private:
+    MemoJournalStore m_journal;
+};
+
+struct ArchiveStats {
+    unsigned long long records = 0;
+    unsigned long long contentBytes = 0;
+    unsigned long long directories = 0;
+    unsigned long long steals = 0;
+    unsigned long long sleeps = 0; // 훔칠 것이 없어 잠든 횟수 (바쁜 대기 대신)
+    long long ms = 0;
+};
+
+// 폴더의 메모 한 개 읽기 (아카이브/비교 공통)
+bool ReadArchiveMemo(IArchiveMemoIo& io, const std::filesystem::path& folder, ArchiveRecord& rec);
+std::string ArchiveRelativePath(const std::filesystem::path& folder, const std::wstring& root);
+void AppendArchiveRecord(std::string& out, const ArchiveRecord& rec);
+
+// 임시 파일에 기록 후 교체 -> 실패해도 기존 아카이브 유지
+bool ExportMemoArchive(IArchiveMemoIo& io, const std::vector<std::wstring>& roots, const std::filesystem::path& archive, unsigned threads, ArchiveStats& stats);
+
+// 아카이브 전체 검증 후 레코드마다 fn 호출. 끊겼거나 해시가 맞지 않으면 false (fn은 그 전까지 호출됨)
+bool ReadMemoArchive(const std::filesystem::path& archive, std::vector<std::wstring>& roots, const std::function<void(const ArchiveRecord&)>& fn);
+
+// 복원/비교 대상 폴더 (target이 있으면 원래 루트 대신 그 아래로)
+std::filesystem::path ArchiveFolder(const std::vector<std::wstring>& roots, const ArchiveRecord& rec, const std::wstring& target);
+
+// [PRD 6.2] 복원: 내용이 다른 메모만 기록. 폴더가 없으면 만들지 않고 건너뜀 (공유/이전 대상에 빈 폴더 방지)
+bool RestoreMemoArchive(IArchiveMemoIo& io, const std::filesystem::path& archive, const std::wstring& target,
+                        size_t& restored, size_t& unchanged, size_t& skipped);
+
+// [PRD 6.2] 비교: 아카이브 루트(또는 대상)를 같은 병렬 순회로 훑어 해시 비교
+// 출력: "+ 경로" 트리에만 있음, "- 경로" 아카이브에만 있음, "M 경로" 내용 다름
+bool DiffMemoArchive(IArchiveMemoIo& io, const std::filesystem::path& archive, const std::wstring& target, unsigned threads,
+                     std::vector<std::wstring>& lines, ArchiveStats& stats);
+
+std::wstring ArchiveStatsLine(const wchar_t* what, const ArchiveStats& s, unsigned threads);
+
+// [PRD 6.2] 합성 트리(분기 16, 8개 중 1개 폴더에 메모)를 만들고 내보내기/비교 처리량 측정
+// -> 트리는 한 번만 만듦 (bench.ready 표식). 1스레드와 threads로 각각 내보내 병렬 순회 효과를 함께 보고.
+bool RunArchiveBench(IArchiveMemoIo& io, const std::filesystem::path& dir, size_t directories, unsigned threads,
+                     const std::function<void(const std::wstring&)>& print);
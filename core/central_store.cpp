@@ -0,0 +1,261 @@
+#include "core/central_store.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <cwctype>
+
+#include "core/crc32.h"
+
+namespace fs = std::filesystem;
+
+std::wstring CentralLogStore::NormalizeKey(const std::wstring& folderPath) {
+    std::wstring key;
+    key.reserve(folderPath.size());
+    for (wchar_t c : folderPath) key.push_back(c == L'/' ? L'\\' : (wchar_t)towlower(c));
+    while (key.size() > 3 && key.back() == L'\\') key.pop_back();
+    return key;
+}
+
+bool CentralLogStore::Open(const fs::path& dir) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_file.IsOpen()) return true;
+    auto t0 = std::chrono::steady_clock::now();
+    m_logPath = dir / L"store.log";
+    m_indexPath = dir / L"store.idx";
+    m_entries.clear();
+    m_liveBytes = m_deadBytes = 0;
+
+    if (!OpenLogLocked()) return false;
+    uint64_t scanFrom = LoadIndexLocked();
+    uint64_t fileSize = m_logSize;
+    m_logSize = ScanLocked(scanFrom, fileSize);
+    if (m_logSize < fileSize) m_file.Truncate(m_logSize); // 잘린 꼬리 제거 -> 다음 레코드는 유효한 끝에 이어 씀
+    m_indexDirty = m_logSize != scanFrom;
+
+    m_openInfo.memos = m_entries.size();
+    m_openInfo.ms = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    m_openInfo.fromSnapshot = scanFrom > LOG_HEADER_SIZE;
+    m_openInfo.scannedBytes = fileSize - scanFrom;
+    return true;
+}
+
+void CentralLogStore::Close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file.IsOpen()) return;
+    if (!(NeedsCompactLocked() && CompactLocked()) && m_indexDirty) WriteIndexLocked();
+    m_file.Close();
+}
+
+bool CentralLogStore::Exists(const std::wstring& folderPath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.count(NormalizeKey(folderPath)) != 0;
+}
+
+bool CentralLogStore::Read(const std::wstring& folderPath, std::string& bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(NormalizeKey(folderPath));
+    if (it == m_entries.end()) return false;
+    return ReadValueLocked(it->second, bytes);
+}
+
+bool CentralLogStore::Write(const std::wstring& folderPath, const std::string& bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file.IsOpen()) return false;
+    Entry e;
+    int64_t mtime = (int64_t)std::chrono::system_clock::now().time_since_epoch().count();
+    if (!AppendRecord(m_file, m_logSize, folderPath, bytes.data(), (uint32_t)bytes.size(), Crc32(bytes.data(), bytes.size()), mtime, e)) return false;
+    if (!m_file.Flush()) return false;
+    UpsertLocked(NormalizeKey(folderPath), e);
+    m_indexDirty = true;
+    if (NeedsCompactLocked()) CompactLocked();
+    return true;
+}
+
+bool CentralLogStore::Stamp(const std::wstring& folderPath, long long& mtime, unsigned long long& size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(NormalizeKey(folderPath));
+    if (it == m_entries.end()) return false;
+    mtime = it->second.mtime;
+    size = it->second.valueLen;
+    return true;
+}
+
+void CentralLogStore::ListFolders(std::vector<std::wstring>& folders) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    folders.clear();
+    folders.reserve(m_entries.size());
+    for (const auto& kv : m_entries) folders.push_back(kv.second.path);
+}
+
+std::string CentralLogStore::LogHeaderBytes(uint64_t generation) {
+    uint32_t hdr[2] = { LOG_MAGIC, 1 };
+    std::string out((const char*)hdr, sizeof(hdr));
+    out.append((const char*)&generation, 8);
+    return out;
+}
+
+bool CentralLogStore::ReadValueLocked(const Entry& e, std::string& bytes) {
+    bytes.resize(e.valueLen);
+    if (!m_file.ReadAt(e.offset, &bytes[0], e.valueLen)) { bytes.clear(); return false; }
+    return Crc32(bytes.data(), bytes.size()) == e.valueCrc;
+}
+
+bool CentralLogStore::AppendRecord(RandomAccessFile& file, uint64_t& end, const std::wstring& path, const char* value, uint32_t valueLen,
+                                   uint32_t valueCrc, int64_t mtime, Entry& out) {
+    RecordHeader hdr = { RECORD_MAGIC, (uint32_t)path.size(), valueLen, valueCrc, mtime, 0, 0 };
+    std::vector<uint16_t> path16(path.begin(), path.end());
+    hdr.headerCrc = Crc32(path16.data(), path16.size() * 2, Crc32(&hdr, offsetof(RecordHeader, headerCrc)));
+    std::string record((const char*)&hdr, sizeof(hdr));
+    record.append((const char*)path16.data(), path16.size() * 2);
+    record.append(value, valueLen);
+    if (!file.WriteAt(end, record)) return false;
+    out.path = path;
+    out.offset = end + sizeof(hdr) + path16.size() * 2;
+    out.valueLen = valueLen;
+    out.valueCrc = valueCrc;
+    out.mtime = mtime;
+    out.recordBytes = (uint32_t)record.size();
+    end += record.size();
+    return true;
+}
+
+void CentralLogStore::UpsertLocked(const std::wstring& key, const Entry& e) {
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_liveBytes -= it->second.recordBytes;
+        m_deadBytes += it->second.recordBytes;
+        it->second = e;
+    } else {
+        m_entries.emplace(key, e);
+    }
+    m_liveBytes += e.recordBytes;
+}
+
+bool CentralLogStore::OpenLogLocked() {
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!m_file.Open(m_logPath, false)) return false;
+        uint64_t size = 0;
+        if (!m_file.Size(size)) break;
+        if (size == 0) {
+            m_generation = 1;
+            m_logSize = LOG_HEADER_SIZE;
+            if (m_file.WriteAt(0, LogHeaderBytes(m_generation)) && m_file.Flush()) return true;
+            break;
+        }
+        uint32_t hdr[2] = { 0, 0 };
+        m_logSize = size;
+        if (m_logSize >= LOG_HEADER_SIZE && m_file.ReadAt(0, hdr, 8) && m_file.ReadAt(8, &m_generation, 8) &&
+            hdr[0] == LOG_MAGIC && hdr[1] == 1) return true;
+        m_file.Close();
+        fs::path bad = m_logPath; bad += L".bad";
+        if (!MoveFileReplace(m_logPath, bad)) return false;
+    }
+    m_file.Close();
+    return false;
+}
+
+uint64_t CentralLogStore::LoadIndexLocked() {
+    std::string bytes;
+    if (!ReadWholeFile(m_indexPath, bytes) || bytes.size() < sizeof(IndexHeader)) return LOG_HEADER_SIZE;
+    IndexHeader h;
+    memcpy(&h, bytes.data(), sizeof(h));
+    if (h.magic != INDEX_MAGIC || h.version != 1 || h.generation != m_generation ||
+        h.logSize < LOG_HEADER_SIZE || h.logSize > m_logSize ||
+        Crc32(bytes.data() + sizeof(h), bytes.size() - sizeof(h)) != h.bodyCrc) return LOG_HEADER_SIZE;
+
+    m_entries.reserve(h.count);
+    size_t pos = sizeof(h);
+    for (uint32_t i = 0; i < h.count; i++) {
+        IndexEntry ie;
+        if (pos + sizeof(ie) > bytes.size()) { m_entries.clear(); m_liveBytes = 0; return LOG_HEADER_SIZE; }
+        memcpy(&ie, bytes.data() + pos, sizeof(ie));
+        pos += sizeof(ie);
+        if (ie.pathLen > MAX_PATH_CHARS || pos + ie.pathLen * 2 > bytes.size()) { m_entries.clear(); m_liveBytes = 0; return LOG_HEADER_SIZE; }
+        Entry e;
+        const uint16_t* p = (const uint16_t*)(bytes.data() + pos);
+        e.path.assign(p, p + ie.pathLen);
+        pos += ie.pathLen * 2;
+        e.offset = ie.offset; e.valueLen = ie.valueLen; e.valueCrc = ie.valueCrc;
+        e.mtime = ie.mtime; e.recordBytes = ie.recordBytes;
+        m_liveBytes += e.recordBytes;
+        m_entries.emplace(NormalizeKey(e.path), std::move(e));
+    }
+    if (m_liveBytes > h.logSize - LOG_HEADER_SIZE) { m_entries.clear(); m_liveBytes = 0; return LOG_HEADER_SIZE; }
+    m_deadBytes = h.logSize - LOG_HEADER_SIZE - m_liveBytes;
+    return h.logSize;
+}
+
+uint64_t CentralLogStore::ScanLocked(uint64_t from, uint64_t fileSize) {
+    uint64_t pos = from;
+    std::string body;
+    while (pos + sizeof(RecordHeader) <= fileSize) {
+        RecordHeader hdr;
+        if (!m_file.ReadAt(pos, &hdr, sizeof(hdr))) break;
+        if (hdr.magic != RECORD_MAGIC || hdr.pathLen > MAX_PATH_CHARS) break;
+        uint64_t bodyLen = (uint64_t)hdr.pathLen * 2 + hdr.valueLen;
+        if (pos + sizeof(hdr) + bodyLen > fileSize) break; // 잘린 레코드
+        body.resize((size_t)bodyLen);
+        if (!m_file.ReadAt(pos + sizeof(hdr), &body[0], (uint32_t)bodyLen)) break;
+        if (Crc32(body.data(), hdr.pathLen * 2, Crc32(&hdr, offsetof(RecordHeader, headerCrc))) != hdr.headerCrc) break;
+        if (Crc32(body.data() + hdr.pathLen * 2, hdr.valueLen) != hdr.valueCrc) break;
+
+        Entry e;
+        const uint16_t* p = (const uint16_t*)body.data();
+        e.path.assign(p, p + hdr.pathLen);
+        e.offset = pos + sizeof(hdr) + hdr.pathLen * 2;
+        e.valueLen = hdr.valueLen; e.valueCrc = hdr.valueCrc; e.mtime = hdr.mtime;
+        e.recordBytes = (uint32_t)(sizeof(hdr) + bodyLen);
+        UpsertLocked(NormalizeKey(e.path), e);
+        pos += sizeof(hdr) + bodyLen;
+    }
+    return pos;
+}
+
+void CentralLogStore::WriteIndexLocked() {
+    std::string body;
+    for (const auto& kv : m_entries) {
+        const Entry& e = kv.second;
+        IndexEntry ie = { e.offset, e.mtime, e.valueLen, e.valueCrc, e.recordBytes, (uint32_t)e.path.size() };
+        body.append((const char*)&ie, sizeof(ie));
+        for (wchar_t c : e.path) { uint16_t u = (uint16_t)c; body.append((const char*)&u, 2); }
+    }
+    IndexHeader h = { INDEX_MAGIC, 1, m_generation, m_logSize, (uint32_t)m_entries.size(), Crc32(body.data(), body.size()) };
+    std::string out((const char*)&h, sizeof(h));
+    out += body;
+    if (WriteFileAtomic(m_indexPath, out)) m_indexDirty = false;
+}
+
+bool CentralLogStore::CompactLocked() {
+    fs::path tmp = m_logPath; tmp += L".tmp";
+    RandomAccessFile out;
+    if (!out.Open(tmp, true)) return false;
+    uint64_t generation = m_generation + 1;
+    uint64_t end = LOG_HEADER_SIZE;
+    bool ok = out.WriteAt(0, LogHeaderBytes(generation));
+    std::unordered_map<std::wstring, Entry> next;
+    next.reserve(m_entries.size());
+    std::string value;
+    for (auto it = m_entries.begin(); ok && it != m_entries.end(); ++it) {
+        Entry e;
+        ok = ReadValueLocked(it->second, value) &&
+             AppendRecord(out, end, it->second.path, value.data(), it->second.valueLen, it->second.valueCrc, it->second.mtime, e);
+        if (ok) next.emplace(it->first, std::move(e));
+    }
+    if (ok) ok = out.Flush();
+    out.Close();
+    std::error_code ec;
+    if (!ok) { fs::remove(tmp, ec); return false; }
+
+    m_file.Close(); // 열린 핸들이 있으면 교체 불가 (Win32)
+    bool replaced = MoveFileReplace(tmp, m_logPath);
+    bool reopened = m_file.Open(m_logPath, false);
+    if (!replaced) { fs::remove(tmp, ec); return false; }
+    m_entries.swap(next);
+    m_generation = generation;
+    m_logSize = end;
+    m_liveBytes = end - LOG_HEADER_SIZE;
+    m_deadBytes = 0;
+    WriteIndexLocked();
+    return reopened;
+}
\ No newline at end of file
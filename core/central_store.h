@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/file_io.h"
+
+// --- [중앙 로그 저장소] ---
+// [PRD 5.7] 중앙 로그 저장소 (Log-Structured Store, --central-store)
+// -> 읽기 전용 공유/동기화 폴더를 건드리지 않도록 모든 메모를 %LOCALAPPDATA%\FolderMemo\store.log 하나에 덧붙여 기록.
+// -> 메모리 해시 색인(정규화 경로 -> 최신 레코드 위치)이라 존재 확인은 디스크 접근 없음, 읽기는 ReadAt 한 번.
+// -> 시작: store.idx(색인 스냅샷)를 읽고 스냅샷 이후 덧붙은 레코드만 훑음. 스냅샷이 없거나 로그 세대가 다르면 로그 전체를 훑음.
+// -> 복구: 잘리거나 CRC가 깨진 첫 레코드에서 훑기를 멈추고 그 뒤를 잘라냄 (마지막 저장 하나만 잃음).
+// -> 죽은 레코드(덮어쓴 이전 버전)가 살아 있는 양보다 많아지면 압축: 최신 레코드만 새 로그로 복사 -> 원자적 교체 + 세대 증가.
+// -> 로그 포맷: [헤더: 'FMSL' | version | 세대(u64)] + [레코드: RecordHeader | 원래 경로(u16) | 내용(UTF-8)]...
+// -> 파일 접근은 RandomAccessFile(core/file_io.h)만 사용 -> Win32 앱(main.cpp의 CentralLogStorage가 IMemoStorage로 감쌈)과 Linux 테스트/벤치가 같은 코드.
+class CentralLogStore {
+public:
+    static constexpr uint64_t COMPACT_MIN_DEAD_BYTES = 4 * 1024 * 1024; // 죽은 레코드가 이보다 적으면 압축 안 함
+
+    struct OpenInfo {
+        size_t memos = 0;
+        long long ms = 0;
+        bool fromSnapshot = false;
+        uint64_t scannedBytes = 0; // 스냅샷 이후(또는 전체) 훑은 로그 길이
+    };
+
+    // 대소문자/구분자 차이로 같은 폴더가 두 번 저장되지 않도록 정규화 (NTFS 기본 대소문자 무시)
+    // [PRD 5.9] 기록 보관도 같은 키를 씀
+    static std::wstring NormalizeKey(const std::wstring& folderPath);
+
+    ~CentralLogStore() { Close(); }
+
+    bool Open(const std::filesystem::path& dir);
+    // 종료 -> 필요하면 압축 후 색인 스냅샷 기록 (다음 시작은 로그를 다시 훑지 않음)
+    void Close();
+
+    bool Exists(const std::wstring& folderPath);
+    bool Read(const std::wstring& folderPath, std::string& bytes);
+    bool Write(const std::wstring& folderPath, const std::string& bytes);
+    bool Stamp(const std::wstring& folderPath, long long& mtime, unsigned long long& size);
+    void ListFolders(std::vector<std::wstring>& folders);
+
+    size_t Count() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.size();
+    }
+    OpenInfo LastOpen() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_openInfo;
+    }
+    uint64_t Generation() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_generation;
+    }
+
+private:
+    struct Entry {
+        std::wstring path;    // 마지막 기록 때의 원래 경로 (내보내기용)
+        uint64_t offset = 0;  // 내용 시작 위치
+        uint32_t valueLen = 0;
+        uint32_t valueCrc = 0;
+        int64_t mtime = 0;
+        uint32_t recordBytes = 0;
+    };
+    struct RecordHeader {
+        uint32_t magic;     // 'FMSR'
+        uint32_t pathLen;   // u16 단위
+        uint32_t valueLen;
+        uint32_t valueCrc;
+        int64_t mtime;
+        uint32_t reserved;
+        uint32_t headerCrc; // 앞 28바이트 + 경로
+    };
+    struct IndexHeader {
+        uint32_t magic;     // 'FMSX'
+        uint32_t version;
+        uint64_t generation;
+        uint64_t logSize;   // 스냅샷이 반영한 로그 길이
+        uint32_t count;
+        uint32_t bodyCrc;
+    };
+    struct IndexEntry {
+        uint64_t offset;
+        int64_t mtime;
+        uint32_t valueLen;
+        uint32_t valueCrc;
+        uint32_t recordBytes;
+        uint32_t pathLen;
+    };
+    static constexpr uint32_t LOG_MAGIC = 0x4C534D46;    // "FMSL"
+    static constexpr uint32_t RECORD_MAGIC = 0x52534D46; // "FMSR"
+    static constexpr uint32_t INDEX_MAGIC = 0x58534D46;  // "FMSX"
+    static constexpr uint64_t LOG_HEADER_SIZE = 16;
+    static constexpr uint32_t MAX_PATH_CHARS = 32768;
+
+    static std::string LogHeaderBytes(uint64_t generation);
+    bool ReadValueLocked(const Entry& e, std::string& bytes);
+    // 레코드 하나를 end 위치에 기록하고 end를 전진 (호출자가 Flush)
+    static bool AppendRecord(RandomAccessFile& file, uint64_t& end, const std::wstring& path, const char* value, uint32_t valueLen,
+                             uint32_t valueCrc, int64_t mtime, Entry& out);
+    void UpsertLocked(const std::wstring& key, const Entry& e);
+    // 로그 열기 (없으면 새로 만들고, 헤더가 깨졌으면 옆으로 치우고 새로 시작)
+    bool OpenLogLocked();
+    // 색인 스냅샷 적재 -> 로그를 이어서 훑을 위치 반환 (실패 시 로그 처음부터)
+    uint64_t LoadIndexLocked();
+    // from부터 레코드를 읽어 색인 갱신 -> 마지막 유효 레코드의 끝 반환
+    uint64_t ScanLocked(uint64_t from, uint64_t fileSize);
+    void WriteIndexLocked();
+    bool NeedsCompactLocked() const {
+        return m_deadBytes >= COMPACT_MIN_DEAD_BYTES && m_deadBytes > m_liveBytes;
+    }
+    // 최신 레코드만 새 로그로 복사 -> 교체 -> 세대 증가 + 스냅샷 (실패 시 기존 로그 그대로 사용)
+    bool CompactLocked();
+
+    std::mutex m_mutex; // 색인 + 파일 포인터 (읽기/쓰기가 한 핸들을 공유)
+    std::filesystem::path m_logPath;
+    std::filesystem::path m_indexPath;
+    RandomAccessFile m_file;
+    uint64_t m_generation = 0;
+    uint64_t m_logSize = 0;   // 다음 레코드 기록 위치
+    uint64_t m_liveBytes = 0; // 최신 레코드 합
+    uint64_t m_deadBytes = 0; // 덮어쓴 레코드 합 (압축으로 회수)
+    bool m_indexDirty = false;
+    OpenInfo m_openInfo;
+    std::unordered_map<std::wstring, Entry> m_entries; // 정규화 경로 -> 최신 레코드
+};
\ No newline at end of file
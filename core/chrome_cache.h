@@ -0,0 +1,171 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// --- [외곽 비트맵 캐시] ---
+// [PRD 4.6] 미리 그린 오버레이 외곽(chrome) -> WM_PAINT는 비트맵 복사만
+// -> 예전에는 그릴 때마다 배경/버튼 글리프(X, ㅁ, _)/테두리/구분선을 GDI 호출로 다시 그리고,
+//    상태가 바뀔 때마다 배경 지우기까지 해서 레이어드 창이 눈에 띄게 깜빡였음.
+// -> 상태(최소화 + / 최소화 ▤ / 펼침) x 충돌 테두리 x 크기별로 한 번만 그려 두고 재사용.
+//    크기는 픽셀 기준이므로 DPI 때문에 크기가 달라지면 자연히 새 항목.
+// -> 펼친 상태는 제목줄(버튼 + 위 테두리 + 구분선)만 캐시: 나머지는 편집창이 덮고 1px 테두리만 보임 -> 큰 비트맵을 들지 않음.
+// -> WM_ERASEBKGND 생략 + WS_CLIPCHILDREN -> 지웠다 다시 그리기/편집창 위 덧칠 없음. 무효화도 바뀐 영역만 (ChromeDirtyRects).
+// -> 그리기/비트맵은 장치 인터페이스 뒤 (Win32는 main.cpp의 Win32ChromeDevice, 테스트는 메모리 픽셀 버퍼)
+const size_t CHROME_CACHE_MAX = 8;
+
+const int CHROME_MIN_EMPTY = 0; // 최소화, 메모 없음 (+)
+const int CHROME_MIN_MEMO = 1;  // 최소화, 메모 있음 (▤)
+const int CHROME_OPEN = 2;      // 펼침 (보통/확대)
+
+struct ChromeKey {
+    int state;     // CHROME_*
+    bool conflict; // [PRD 5.8] 병합 충돌 테두리
+    int width;
+    int height;    // 펼침은 제목줄 높이 고정이라 0
+    bool operator==(const ChromeKey& o) const { return state == o.state && conflict == o.conflict && width == o.width && height == o.height; }
+};
+
+struct ChromeRect {
+    int left, top, right, bottom;
+};
+
+// 외곽에 쓰는 색 (Win32는 OverlayPaintKit의 공유 브러시)
+enum ChromeInk { CHROME_INK_BG, CHROME_INK_BORDER, CHROME_INK_LINE, CHROME_INK_CONFLICT };
+
+template <typename Dc, typename Bitmap>
+class BasicChromeDevice {
+public:
+    virtual ~BasicChromeDevice() {}
+    virtual void Fill(Dc dc, const ChromeRect& rc, ChromeInk ink) = 0;
+    virtual void Frame(Dc dc, const ChromeRect& rc, ChromeInk ink) = 0; // 1px 테두리 (FrameRect)
+    virtual void Line(Dc dc, int x0, int y0, int x1, int y1) = 0;       // 글리프 펜, 끝점 제외 (LineTo)
+    virtual void Box(Dc dc, const ChromeRect& rc) = 0;                   // 글리프 펜 윤곽 + 기본 브러시 (Rectangle)
+    virtual void Icon(Dc dc, const ChromeRect& rc, bool memo) = 0;       // 가운데 '+' / '▤'
+    virtual Bitmap CreateBitmap(Dc like, int w, int h) = 0;             // 실패하면 Bitmap()
+    virtual Dc BeginDraw(Bitmap bmp) = 0;                                // 비트맵에 그리기 시작 (메모리 DC)
+    virtual void EndDraw(Bitmap bmp) = 0;
+    virtual void Blit(Dc dst, Bitmap src, int w, int h) = 0;            // (0,0)에 w x h 복사
+    virtual void DestroyBitmap(Bitmap bmp) = 0;
+    virtual void ReleaseScratch() {} // 메모리 DC 등 캐시를 비울 때 함께 반납
+};
+
+// [PRD 4.6] 바뀐 외곽만 무효화할 영역 (배경 지우기 없음)
+// whole: 최소화 <-> 펼침처럼 외곽 전체가 바뀜. 아니면 제목줄 + 테두리만 (편집창이 덮는 영역 제외)
+inline void ChromeDirtyRects(int w, int h, int buttonSize, bool whole, std::vector<ChromeRect>& out) {
+    out.clear();
+    if (whole) { out.push_back({ 0, 0, w, h }); return; }
+    out.push_back({ 0, 0, w, std::min(h, buttonSize + 1) });
+    out.push_back({ 0, 0, 1, h });
+    out.push_back({ w - 1, 0, w, h });
+    out.push_back({ 0, h - 1, w, h });
+}
+
+// UI 스레드 전용
+template <typename Dc, typename Bitmap>
+class BasicChromeCache {
+public:
+    typedef BasicChromeDevice<Dc, Bitmap> Device;
+
+    BasicChromeCache(Device* device, int buttonSize) : m_device(device), m_buttonSize(buttonSize) {}
+    ~BasicChromeCache() { Clear(); }
+
+    void Paint(Dc hdc, const ChromeKey& key, int clientW, int clientH) {
+        auto t0 = std::chrono::steady_clock::now();
+        int stripH = key.state == CHROME_OPEN ? std::min(clientH, m_buttonSize + 1) : clientH;
+        Bitmap bmp = Get(hdc, key, clientW, stripH);
+        if (bmp) m_device->Blit(hdc, bmp, clientW, stripH);
+        else Render(hdc, key, clientW, stripH); // 비트맵을 못 만들면 직접 그림 (결과는 같음)
+        if (key.state == CHROME_OPEN) {
+            ChromeInk frame = key.conflict ? CHROME_INK_CONFLICT : CHROME_INK_BORDER;
+            if (clientH > stripH) {
+                // 제목줄 아래: 배경 + 좌/우 테두리 (편집창 영역은 WS_CLIPCHILDREN으로 잘려 실제로는 가장자리만 그려짐)
+                m_device->Fill(hdc, { 0, stripH, clientW, clientH }, CHROME_INK_BG);
+                m_device->Fill(hdc, { 0, stripH, 1, clientH }, frame);
+                m_device->Fill(hdc, { clientW - 1, stripH, clientW, clientH }, frame);
+            }
+            // 아래 테두리 (제목줄만큼 낮은 창에서 구분선과 겹치면 예전 순서대로 구분선이 위)
+            if (clientH > stripH || clientH <= m_buttonSize) m_device->Fill(hdc, { 0, clientH - 1, clientW, clientH }, frame);
+        }
+        m_paints++;
+        m_paintNs += (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    // 예전 WM_PAINT 그리기 그대로 (펼침은 제목줄 높이 h까지만)
+    void Render(Dc hdc, const ChromeKey& key, int w, int h) {
+        ChromeRect rc = { 0, 0, w, h };
+        ChromeInk frame = key.conflict ? CHROME_INK_CONFLICT : CHROME_INK_BORDER;
+        m_device->Fill(hdc, rc, CHROME_INK_BG);
+
+        if (key.state != CHROME_OPEN) {
+            m_device->Icon(hdc, rc, key.state == CHROME_MIN_MEMO);
+            m_device->Frame(hdc, rc, frame);
+            return;
+        }
+
+        int btnW = m_buttonSize;
+        int right = w;
+        // X
+        m_device->Line(hdc, right - btnW + 8, 8, right - 8, btnW - 8);
+        m_device->Line(hdc, right - 8, 8, right - btnW + 8, btnW - 8);
+        // ㅁ
+        int expRight = right - btnW;
+        m_device->Box(hdc, { expRight - btnW + 8, 8, expRight - 8, btnW - 8 });
+        // _
+        int minRight = expRight - btnW;
+        m_device->Line(hdc, minRight - btnW + 8, btnW - 8, minRight - 8, btnW - 8);
+
+        // 위/좌/우 테두리 + 구분선 (아래 테두리는 본문 쪽에서)
+        m_device->Fill(hdc, { 0, 0, w, 1 }, frame);
+        m_device->Fill(hdc, { 0, 0, 1, h }, frame);
+        m_device->Fill(hdc, { w - 1, 0, w, h }, frame);
+        if (h > m_buttonSize) m_device->Fill(hdc, { 0, m_buttonSize, w, m_buttonSize + 1 }, CHROME_INK_LINE);
+    }
+
+    void Clear() {
+        for (auto& e : m_entries) m_device->DestroyBitmap(e.bitmap);
+        m_entries.clear();
+        m_device->ReleaseScratch();
+    }
+
+    unsigned long long Paints() const { return m_paints; }
+    unsigned long long Renders() const { return m_renders; }
+    unsigned long long PaintNs() const { return m_paintNs; }
+    size_t Bitmaps() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        ChromeKey key;
+        int height; // 펼침은 키에 높이가 없음 -> 제목줄보다 낮은 창의 잘린 비트맵을 다른 창이 쓰지 않게
+        Bitmap bitmap;
+        unsigned long long lastUse;
+    };
+
+    Bitmap Get(Dc hdc, const ChromeKey& key, int w, int h) {
+        if (w <= 0 || h <= 0) return Bitmap();
+        for (auto& e : m_entries) {
+            if (e.key == key && e.height == h) { e.lastUse = ++m_clock; return e.bitmap; }
+        }
+        Bitmap bmp = m_device->CreateBitmap(hdc, w, h);
+        if (!bmp) return Bitmap();
+        Render(m_device->BeginDraw(bmp), key, w, h);
+        m_device->EndDraw(bmp);
+        m_renders++;
+        if (m_entries.size() >= CHROME_CACHE_MAX) {
+            auto lru = std::min_element(m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+            m_device->DestroyBitmap(lru->bitmap);
+            m_entries.erase(lru);
+        }
+        m_entries.push_back({ key, h, bmp, ++m_clock });
+        return bmp;
+    }
+
+    Device* m_device;
+    int m_buttonSize;
+    std::vector<Entry> m_entries;
+    unsigned long long m_clock = 0;
+    unsigned long long m_paints = 0;
+    unsigned long long m_renders = 0;
+    unsigned long long m_paintNs = 0;
+};
\ No newline at end of file
@@ -0,0 +1,7 @@
+#pragma once
+// --- [CRC32] ---
+#include <cstddef>
+#include <cstdint>
+
+// [PRD 5.4] CRC32 (IEEE) -> 저널 레코드 손상/잘림 검출용
+uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0);
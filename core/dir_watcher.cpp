@@ -0,0 +1,146 @@
+#include "core/dir_watcher.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+static const uint32_t WATCH_MASK = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE |
+    IN_ATTRIB | IN_ONLYDIR;
+
+static bool IsMemoFileName(const char* name) {
+    static const char prefix[] = "folder_memo.";
+    return strncasecmp(name, prefix, sizeof(prefix) - 1) == 0;
+}
+
+void InotifyDirectoryWatcher::Start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_thread.joinable()) return;
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) return;
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd < 0) { close(m_fd); m_fd = -1; return; }
+    m_thread = std::thread(&InotifyDirectoryWatcher::Loop, this);
+}
+
+void InotifyDirectoryWatcher::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable()) return;
+    }
+    uint64_t one = 1;
+    (void)!write(m_wakeFd, &one, sizeof(one));
+    m_thread.join();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    close(m_fd); // 남은 감시는 fd와 함께 해제됨
+    close(m_wakeFd);
+    m_fd = m_wakeFd = -1;
+    m_byPath.clear();
+    m_byWd.clear();
+}
+
+bool InotifyDirectoryWatcher::Watch(const std::wstring& folderPath) {
+    std::wstring evicted;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_fd < 0) return false;
+        auto it = m_byPath.find(folderPath);
+        if (it != m_byPath.end()) { it->second.lastUsed = ++m_tick; return true; }
+        // inotify_add_watch는 경로 조회뿐이라 빠름 -> 락 안에서 (Win32처럼 느린 공유 열기가 없음)
+        int wd = inotify_add_watch(m_fd, std::filesystem::path(folderPath).c_str(), WATCH_MASK);
+        if (wd < 0) { m_unwatchable++; return false; }
+        auto dup = m_byWd.find(wd);
+        if (dup != m_byWd.end()) m_byPath.erase(dup->second); // 같은 디렉터리를 다른 이름으로 -> 감시 공유, 최신 이름으로
+        WatchEntry& w = m_byPath[folderPath];
+        w.wd = wd;
+        w.lastUsed = ++m_tick;
+        m_byWd[wd] = folderPath;
+        if (m_byPath.size() > MAX_WATCHES) evicted = EvictOldestLocked();
+    }
+    if (!evicted.empty()) m_onChange(evicted);
+    return true;
+}
+
+void InotifyDirectoryWatcher::Pin(const std::wstring& folderPath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pins[folderPath]++;
+}
+
+void InotifyDirectoryWatcher::Unpin(const std::wstring& folderPath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_pins.find(folderPath);
+    if (it != m_pins.end() && --it->second <= 0) m_pins.erase(it);
+}
+
+bool InotifyDirectoryWatcher::IsWatching(const std::wstring& folderPath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_byPath.count(folderPath) != 0;
+}
+
+std::wstring InotifyDirectoryWatcher::EvictOldestLocked() {
+    const std::wstring* oldest = nullptr;
+    unsigned long long oldestUse = 0;
+    for (const auto& kv : m_byPath) {
+        if (m_pins.count(kv.first)) continue;
+        if (!oldest || kv.second.lastUsed < oldestUse) { oldest = &kv.first; oldestUse = kv.second.lastUsed; }
+    }
+    if (!oldest) return std::wstring(); // 전부 고정 -> 잠시 한도 초과 허용
+    std::wstring path = *oldest;
+    int wd = m_byPath[path].wd;
+    inotify_rm_watch(m_fd, wd); // 뒤따르는 IN_IGNORED는 m_byWd에 없으므로 무시됨
+    m_byWd.erase(wd);
+    m_byPath.erase(path);
+    return path;
+}
+
+void InotifyDirectoryWatcher::Loop() {
+    alignas(struct inotify_event) char buf[16 * 1024];
+    for (;;) {
+        pollfd fds[2] = { { m_fd, POLLIN, 0 }, { m_wakeFd, POLLIN, 0 } };
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (fds[1].revents) return; // Stop 신호
+        ssize_t n = read(m_fd, buf, sizeof(buf));
+        if (n <= 0) continue;
+
+        std::vector<std::wstring> changed;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (char* p = buf; p < buf + n;) {
+                const inotify_event* ev = (const inotify_event*)p;
+                p += sizeof(inotify_event) + ev->len;
+                m_notifications++;
+                if (ev->mask & IN_Q_OVERFLOW) {
+                    for (const auto& kv : m_byPath) changed.push_back(kv.first); // 무엇이 바뀌었는지 모름
+                    continue;
+                }
+                auto it = m_byWd.find(ev->wd);
+                if (it == m_byWd.end()) continue; // 이미 해제한 감시
+                if (ev->mask & IN_IGNORED) {
+                    // 폴더 삭제/이동/언마운트 -> 감시가 풀림
+                    changed.push_back(it->second);
+                    m_byPath.erase(it->second);
+                    m_byWd.erase(it);
+                    continue;
+                }
+                if (ev->len > 0 && IsMemoFileName(ev->name)) changed.push_back(it->second);
+            }
+        }
+        // 한 번 읽은 묶음 안의 같은 폴더 알림은 하나로
+        for (size_t i = 0; i < changed.size(); i++) {
+            bool dup = false;
+            for (size_t j = 0; j < i && !dup; j++) dup = changed[j] == changed[i];
+            if (!dup) m_onChange(changed[i]);
+        }
+    }
+}
+#endif
@@ -0,0 +1,58 @@
+#pragma once
+// --- [디렉터리 변경 알림 (inotify)] ---
+// [PRD 3.3] Linux 백엔드 (테스트/벤치용). Win32 백엔드는 main.cpp의 DirectoryWatcher (ReadDirectoryChangesW + IOCP), 계약은 같음:
+// -> 폴더마다 비재귀 감시 하나 (여러 오버레이가 같은 폴더를 봐도 하나). folder_memo.* 생성/기록/이름 변경/삭제가 보이면 onChange(폴더).
+// -> 감시 수는 MAX_WATCHES로 제한 (가장 오래 안 쓴 것부터 해제, [PRD 5.8] Pin된 폴더는 제외) -> 해제된 폴더도 onChange로 알림.
+// -> 알림 큐 넘침(IN_Q_OVERFLOW)이면 무엇이 바뀌었는지 모르므로 감시 중인 모든 폴더를 알림.
+// -> 폴더 자체가 지워지거나 옮겨져 감시가 풀리면(IN_IGNORED) 감시 목록에서 빼고 알림 -> 호출자는 TTL/주기 확인으로.
+#ifdef __linux__
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+class InotifyDirectoryWatcher {
+public:
+    using ChangeFn = std::function<void(const std::wstring& folderPath)>;
+    static constexpr size_t MAX_WATCHES = 128;
+
+    explicit InotifyDirectoryWatcher(ChangeFn onChange) : m_onChange(std::move(onChange)) {}
+    ~InotifyDirectoryWatcher() { Stop(); }
+
+    void Start();
+    void Stop();
+
+    // 감시 중이거나 새로 걸었으면 true, 걸 수 없는 폴더(없음, 권한, 한도 초과)면 false -> 호출자는 TTL 사용
+    bool Watch(const std::wstring& folderPath);
+
+    void Pin(const std::wstring& folderPath);
+    void Unpin(const std::wstring& folderPath);
+    bool IsWatching(const std::wstring& folderPath);
+
+    size_t Watching() { std::lock_guard<std::mutex> lock(m_mutex); return m_byPath.size(); }
+    unsigned long long Notifications() { std::lock_guard<std::mutex> lock(m_mutex); return m_notifications; }
+    unsigned long long Unwatchable() { std::lock_guard<std::mutex> lock(m_mutex); return m_unwatchable; }
+
+private:
+    struct WatchEntry {
+        int wd = -1;
+        unsigned long long lastUsed = 0;
+    };
+
+    std::wstring EvictOldestLocked();
+    void Loop();
+
+    ChangeFn m_onChange;
+    std::mutex m_mutex;
+    int m_fd = -1;
+    int m_wakeFd = -1; // Stop 신호 (eventfd)
+    std::thread m_thread;
+    std::unordered_map<std::wstring, WatchEntry> m_byPath;
+    std::unordered_map<int, std::wstring> m_byWd;
+    std::unordered_map<std::wstring, int> m_pins;
+    unsigned long long m_tick = 0;
+    unsigned long long m_notifications = 0;
+    unsigned long long m_unwatchable = 0;
+};
+#endif
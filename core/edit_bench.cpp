@@ -0,0 +1,137 @@
+#include "core/edit_bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/file_io.h"
+#include "core/grams.h"
+#include "core/journal.h"
+#include "core/memo_buffer.h"
+#include "core/utf.h"
+
+namespace fs = std::filesystem;
+
+const size_t EDIT_BENCH_SAVE_EVERY = 20;
+const size_t EDIT_BENCH_SAMPLE_BYTES = 256 * 1024;
+
+bool RunEditBench(size_t keys, const fs::path& dir, const std::function<void(const std::wstring&)>& print) {
+    const size_t sizes[] = { 10 * 1024, 100 * 1024, 1024 * 1024, 10 * 1024 * 1024 };
+    const wchar_t hangul[] = L"가나다라마바사아자차카타파하";
+    const size_t hangulCount = sizeof(hangul) / sizeof(hangul[0]) - 1;
+    std::error_code ec;
+    fs::path oldDir = dir / L"old", newDir = dir / L"new";
+    fs::remove_all(dir, ec);
+    fs::create_directories(oldDir, ec);
+    fs::create_directories(newDir, ec);
+    bool ok = true;
+    for (size_t target : sizes) {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::wstring doc, line, insert;
+        for (size_t bytes = 0, n = 0; bytes < target; n++) {
+            line = L"메모 줄 " + std::to_wstring(n) + L" - synthetic memo line for edit benchmark\r\n";
+            doc += line;
+            bytes += line.size() + 8; // 한글 4자 x 2바이트 더
+        }
+        MemoBuffer buffer;
+        buffer.LoadText(doc.data(), doc.size());
+        std::string encoded;
+        WideToUtf8(doc.data(), doc.size(), encoded);
+        WriteFileAtomic(MemoJournalStore::BasePath(newDir.wstring()), encoded);
+        fs::remove(MemoJournalStore::JournalPath(newDir.wstring()), ec);
+        MemoJournalStore journal;
+        journal.Start();
+
+        size_t stride = std::max<size_t>(1, target / EDIT_BENCH_SAMPLE_BYTES);
+        size_t caret = doc.size() / 2, resyncs = 0, oldKeys = 0, newKeys = 0, oldSaves = 0, newSaves = 0;
+        long long oldKeyNs = 0, newKeyNs = 0, oldSaveNs = 0, newSaveNs = 0;
+        std::wstring decoded;
+        std::vector<uint32_t> grams;
+        std::shared_ptr<const std::string> cached; // 내용 캐시/버전 기록/미룬 색인이 들고 있는 마지막 사본
+        volatile wchar_t sink = 0;
+        auto since = [](std::chrono::steady_clock::time_point t0) {
+            return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+        };
+        for (size_t k = 0; k < keys; k++) {
+            double r = uniform(rng);
+            size_t pos = caret, del = 0;
+            insert.clear();
+            if (r < 0.55) insert.push_back(r < 0.35 ? (wchar_t)(L'a' + rng() % 26) : hangul[rng() % hangulCount]);
+            else if (r < 0.70) { if (pos) { pos--; del = 1; } }
+            else if (r < 0.75) del = pos < doc.size() ? 1 : 0;
+            else if (r < 0.85) { if (pos) { pos--; del = 1; } insert.push_back(hangul[rng() % hangulCount]); } // 조합 중 글자 교체
+            else if (r < 0.98) { caret = rng() % (doc.size() + 1); continue; } // 변경 없음 -> EN_CHANGE 없음
+            else if (r < 0.99) { size_t n = 50 + rng() % 950; while (insert.size() < n) insert += line; insert.resize(n); }
+            else { del = std::min(doc.size() - pos, (size_t)(rng() % 1000)); insert.push_back(L'x'); }
+            if (!del && insert.empty()) continue;
+            doc.replace(pos, del, insert); // 편집창이 한 일 (재지 않음)
+            caret = pos + insert.size();
+
+            if (k % stride == 0) {
+                auto t0 = std::chrono::steady_clock::now();
+                std::wstring text(doc); // 예전 EN_CHANGE: 전체 복사
+                sink = text[text.size() / 2];
+                oldKeyNs += since(t0);
+                oldKeys++;
+            }
+            auto t0 = std::chrono::steady_clock::now();
+            if (!buffer.ApplyChange(doc.data(), doc.size(), caret)) {
+                resyncs++;
+                buffer.LoadText(doc.data(), doc.size());
+            }
+            newKeyNs += since(t0);
+            newKeys++;
+
+            if (newKeys % EDIT_BENCH_SAVE_EVERY == 0) {
+                t0 = std::chrono::steady_clock::now();
+                std::shared_ptr<const std::string> snapshot = buffer.Snapshot();
+                bool written;
+                if (snapshot->size() >= JOURNAL_AUTO_BYTES) {
+                    written = journal.Save(newDir.wstring(), *snapshot);
+                } else {
+                    written = WriteFileAtomic(MemoJournalStore::BasePath(newDir.wstring()), *snapshot);
+                    fs::remove(MemoJournalStore::JournalPath(newDir.wstring()), ec);
+                }
+                cached = snapshot;
+                newSaveNs += since(t0);
+                newSaves++;
+                ok = ok && written;
+                if ((newKeys / EDIT_BENCH_SAVE_EVERY) % stride == 0) {
+                    t0 = std::chrono::steady_clock::now();
+                    WideToUtf8(doc.data(), doc.size(), encoded);                 // 예전 SaveMemo: 전체 인코딩
+                    Utf8ToWide(encoded.data(), encoded.size(), decoded);         // 예전 WriteMemoAndIndex: 색인/캐시용 전체 디코드
+                    ExtractGrams(decoded, grams);                                // 예전 색인 갱신: 저장마다 전체 gram 추출
+                    ok = ok && WriteFileAtomic(MemoJournalStore::BasePath(oldDir.wstring()), encoded); // 전체 기록
+                    oldSaveNs += since(t0);
+                    oldSaves++;
+                }
+            }
+        }
+        (void)sink;
+        auto t0 = std::chrono::steady_clock::now();
+        std::shared_ptr<const std::string> last = buffer.Snapshot();
+        ExtractGramsUtf8(last->data(), last->size(), grams); // 미룬 색인 갱신 (질의/병합 때 1번)
+        long long lazyIndexNs = since(t0);
+        journal.Save(newDir.wstring(), *last);
+        journal.Stop(); // 남은 저널 접기
+        WideToUtf8(doc.data(), doc.size(), encoded);
+        std::string onDisk;
+        ReadWholeFile(MemoJournalStore::BasePath(newDir.wstring()), onDisk);
+        bool same = *last == encoded && onDisk == encoded;
+        auto avg = [](long long ns, size_t n) { return n ? ns / 1000.0 / n : 0.0; };
+        double oldKey = avg(oldKeyNs, oldKeys), newKey = avg(newKeyNs, newKeys);
+        double oldSave = avg(oldSaveNs, oldSaves), newSave = avg(newSaveNs, newSaves);
+        wchar_t buf[400];
+        swprintf(buf, 400, L"%5zu KB (-> %zu KB): key: full copy %.1f us, buffer %.2f us (%.0fx) | save: full path %.0f us, buffer path %.0f us (%.1fx) + index on query %.0f us | %zu edits, %zu saves, %zu pieces, %llu compactions, %zu resyncs%ls",
+            target / 1024, encoded.size() / 1024, oldKey, newKey, newKey > 0 ? oldKey / newKey : 0.0,
+            oldSave, newSave, newSave > 0 ? oldSave / newSave : 0.0, lazyIndexNs / 1000.0,
+            newKeys, newSaves, buffer.Pieces(), buffer.Compactions(), resyncs, same ? L"" : L" MISMATCH");
+        print(buf);
+        ok = ok && same;
+    }
+    return ok;
+}
\ No newline at end of file
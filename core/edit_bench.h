@@ -0,0 +1,18 @@
+#pragma once
+// --- [편집 벤치] ---
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+// [PRD 5.11] --edit-bench <키 입력 수> (tests/memo_buffer_test --bench와 같음): 합성 입력 세션 재생으로 편집 버퍼 + 저장 경로 측정
+// -> 10KB/100KB/1MB/10MB 메모마다 같은 입력 열을 재생: 이어 입력 55% / Backspace 15% / Delete 5% / 한글 조합 갱신 10% /
+//    캐럿 이동 13% / 붙여넣기(50~1000자) 1% / 선택 영역 덮어쓰기 1%. EDIT_BENCH_SAVE_EVERY 입력마다 저장 1번.
+// -> 입력: 예전 방식은 입력마다 편집창 전체 복사(std::wstring 새로), 버퍼는 ApplyChange. 편집창 자체의 갱신 비용(공통)은 재지 않음.
+// -> 저장: Writer 스레드가 하는 일 전부를 dir 아래 실제 파일로 잼.
+//    예전 = 전체 UTF-8 인코딩 + 색인/캐시용 전체 디코드 + gram 추출 + 전체 원자적 기록.
+//    지금 = 버퍼 사본(바뀐 구간만, 이전 사본을 캐시가 들고 있으면 전체 복사 1번) + 기록 (JOURNAL_AUTO_BYTES 이상이면 저널 덧붙이기,
+//           압축 스레드도 돌림) + 캐시/색인은 사본 포인터만. 미룬 gram 추출은 질의 때 1번 -> 따로 보고.
+// -> 예전 방식은 EDIT_BENCH_SAMPLE_BYTES당 한 번꼴로만 표본 측정 (10MB x 수천 번 복사/기록은 분 단위).
+// -> 끝에 버퍼 사본과 기록된 파일(저널 재생 포함)이 편집창 내용(재생한 문서)의 인코딩과 같은지 확인.
+bool RunEditBench(size_t keys, const std::filesystem::path& dir, const std::function<void(const std::wstring&)>& print);
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// --- [편집창 풀] ---
+// [PRD 4.5] 편집창은 펼친 오버레이에만 (최소화 오버레이 = 편집창 없는 가벼운 껍데기)
+// -> 폴더마다 메모가 없으면 '+' 아이콘 상태라 대부분의 오버레이는 편집창을 쓰지 않음.
+//    예전에는 WM_CREATE마다 EDIT를 만들어 창 수만큼 USER 객체/편집 버퍼를 들고 있었음.
+// -> 펼칠 때 풀에서 꺼내 붙이고, 최소화/메모 없는 폴더로 이동하면 비워서 되돌려 놓음.
+// -> 예비 편집창은 만든 오버레이 곁에만 (오버레이당 최대 1개, 다른 오버레이로 옮기지 않음):
+//    EDIT는 부모를 바꿔도 만들 때의 부모에게 알림(EN_CHANGE)을 보내므로, 옮기면 다른 오버레이의 경로로 저장됨.
+//    예비는 숨김 + 다른 컨트롤 ID -> 오버레이의 편집창 조회/EN_CHANGE 처리에서 제외.
+// -> 내용은 따로 보관하지 않음: 입력마다 저장 큐로 넘어가므로 다시 펼칠 때 대기 중 저장 -> 디스크 순으로 다시 채움.
+// -> 큰 내용을 담았던 편집창은 버퍼가 줄지 않으므로 재사용하지 않고 파괴.
+// -> 창 조작은 호스트 인터페이스 뒤 (Win32는 main.cpp의 Win32EditorHost, 테스트는 핸들/버퍼를 세는 가짜)
+const size_t EDITOR_POOL_MAX = 4;
+const size_t EDITOR_POOL_MAX_CHARS = 64 * 1024;
+
+template <typename Handle>
+class BasicEditorHost {
+public:
+    virtual ~BasicEditorHost() {}
+    // 숨김 상태의 새 편집창 (오버레이 자식, 글자 수 제한 없음). 실패하면 Handle()
+    virtual Handle CreateEditor(Handle hOverlay) = 0;
+    // 같은 오버레이의 예비 편집창을 다시 편집창으로 (숨김 그대로)
+    virtual void AdoptEditor(Handle hEdit) = 0;
+    // 오버레이에서 뗄 때: 글꼴 참조 반납 + 숨김
+    virtual void DetachEditor(Handle hEdit) = 0;
+    // 오버레이와 함께 OS가 파괴하는 편집창: 글꼴 참조만 반납
+    virtual void ForgetEditor(Handle hEdit) = 0;
+    virtual size_t EditorTextLength(Handle hEdit) = 0;
+    // 예비로 보관: 편집창 조회에서 뺀 뒤 비우기 (되돌리기 기록/읽기 전용도 초기화). 부모는 그대로
+    virtual void ParkEditor(Handle hEdit) = 0;
+    virtual void DestroyEditor(Handle hEdit) = 0;
+};
+
+// UI 스레드 전용
+template <typename Handle>
+class BasicEditorPool {
+public:
+    typedef BasicEditorHost<Handle> Host;
+
+    explicit BasicEditorPool(Host* host) : m_host(host) {}
+
+    Handle Acquire(Handle hOverlay) {
+        Handle hEdit = Handle();
+        auto it = FindSpare(hOverlay);
+        if (it != m_spare.end()) {
+            hEdit = it->second;
+            m_spare.erase(it);
+            m_host->AdoptEditor(hEdit);
+            m_reused++;
+        } else {
+            hEdit = m_host->CreateEditor(hOverlay);
+            if (!hEdit) return Handle();
+            m_created++;
+        }
+        m_attached++;
+        return hEdit;
+    }
+
+    // 호출 전 내용은 이미 저장 큐로 넘어가 있어야 함 (EN_CHANGE마다 제출되므로 보통 그대로 반납 가능)
+    // 비우기도 EN_CHANGE를 보냄 -> 호출자는 그동안 저장을 막아야 함 (main.cpp는 settingText)
+    void Release(Handle hOverlay, Handle hEdit) {
+        if (!hEdit) return;
+        m_attached--;
+        m_host->DetachEditor(hEdit);
+        if (m_spare.size() >= EDITOR_POOL_MAX || m_host->EditorTextLength(hEdit) > EDITOR_POOL_MAX_CHARS) {
+            m_host->DestroyEditor(hEdit);
+            m_destroyed++;
+            return;
+        }
+        m_host->ParkEditor(hEdit);
+        m_spare.emplace_back(hOverlay, hEdit);
+    }
+
+    // 오버레이 파괴 -> 붙어 있던 편집창(없으면 Handle())과 예비는 OS가 함께 파괴. 글꼴만 반납하고 기록에서 뺌
+    void Forget(Handle hOverlay, Handle hEdit) {
+        if (hEdit) {
+            m_attached--;
+            m_host->ForgetEditor(hEdit);
+        }
+        auto it = FindSpare(hOverlay);
+        if (it != m_spare.end()) m_spare.erase(it);
+    }
+
+    void Clear() {
+        for (const auto& spare : m_spare) m_host->DestroyEditor(spare.second);
+        m_spare.clear();
+    }
+
+    size_t Attached() const { return m_attached; }
+    size_t Spare() const { return m_spare.size(); }
+    unsigned long long Created() const { return m_created; }
+    unsigned long long Reused() const { return m_reused; }
+    unsigned long long Destroyed() const { return m_destroyed; }
+
+private:
+    typedef std::vector<std::pair<Handle, Handle>> SpareList; // (만든 오버레이, 편집창)
+
+    typename SpareList::iterator FindSpare(Handle hOverlay) {
+        return std::find_if(m_spare.begin(), m_spare.end(), [hOverlay](const std::pair<Handle, Handle>& s) { return s.first == hOverlay; });
+    }
+
+    Host* m_host;
+    SpareList m_spare;
+    size_t m_attached = 0;
+    unsigned long long m_created = 0;
+    unsigned long long m_reused = 0;
+    unsigned long long m_destroyed = 0;
+};
\ No newline at end of file
@@ -0,0 +1,184 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// --- [경로 해석] ---
+// [PRD 3.1.5] 창 핸들 형식은 템플릿 인자 (Win32는 HWND, 테스트는 가짜 창) -> COM 백엔드만 main.cpp에 남음
+// [PRD 3.1.5] 셸 백엔드 인터페이스
+// -> 경로 해석 로직(캐시/무효화)과 실제 COM 호출을 분리 -> 가짜 백엔드로 정확성/지연 측정 가능
+template <typename Handle>
+struct BasicShellTab {
+    Handle hwnd;
+    void* token; // 백엔드 고유 탭 핸들 (ReleaseTab 전까지 유효)
+};
+
+template <typename Handle>
+class BasicShellBackend {
+public:
+    typedef BasicShellTab<Handle> ShellTab;
+
+    virtual ~BasicShellBackend() {}
+    virtual bool ListTabs(std::vector<ShellTab>& out) = 0;                           // 전체 탭 나열 (토큰 소유권은 호출자)
+    virtual bool ReadTab(void* token, std::wstring& name, std::wstring& path) = 0;   // 탭 하나의 표시 이름/경로
+    virtual void RetainTab(void* token) = 0;
+    virtual void ReleaseTab(void* token) = 0;
+    virtual void Disconnect() = 0;
+};
+
+// [PRD 3.1.5] 캐시 기반 탐색기 경로 해석기 (Invalidation-Driven)
+// -> 창 핸들별로 탭 토큰 + (제목 -> 경로) 결과를 캐시. 제목이 같고 무효화되지 않았으면 COM 호출 0회.
+// -> NAMECHANGE 시 해당 창만 Dirty 표시 -> 그 창의 탭만 다시 조회. 새 탭 등으로 못 찾을 때만 전체 재나열.
+// -> COM 호출은 락 밖에서 수행 (응답 없는 탐색기 하나가 다른 창의 해석을 막지 않도록).
+template <typename Handle>
+class BasicExplorerPathResolver {
+public:
+    typedef BasicShellTab<Handle> ShellTab;
+    typedef BasicShellBackend<Handle> IShellBackend;
+
+    explicit BasicExplorerPathResolver(IShellBackend* backend) : m_backend(backend) {}
+
+    // [PRD 7.2] 재생 모드 전용 -> 첫 Resolve 전에만 교체
+    void SetBackend(IShellBackend* backend) { m_backend = backend; }
+
+    std::wstring Resolve(Handle hExplorer, const std::wstring& windowTitle) {
+        std::vector<void*> tabs;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_cache.find(hExplorer);
+            if (it != m_cache.end()) {
+                Entry& e = it->second;
+                if (!e.dirty && !e.path.empty() && e.title == windowTitle) { m_hits++; return e.path; }
+                tabs = e.tabs;
+                for (void* t : tabs) m_backend->RetainTab(t);
+            }
+            m_misses++;
+        }
+
+        std::wstring path = MatchTabs(tabs, windowTitle);
+        ReleaseAll(tabs);
+
+        if (path.empty()) {
+            // 처음 보는 창이거나 탭 구성이 바뀜 -> 전체 재나열 1회
+            std::vector<ShellTab> all;
+            if (m_backend->ListTabs(all)) {
+                std::vector<void*> mine;
+                for (const auto& t : all) if (t.hwnd == hExplorer) { m_backend->RetainTab(t.token); mine.push_back(t.token); }
+                path = MatchTabs(mine, windowTitle);
+                ReleaseAll(mine);
+                ReplaceTabs(all);
+            }
+        }
+
+        if (!path.empty()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Entry& e = m_cache[hExplorer];
+            e.title = windowTitle;
+            e.path = path;
+            e.dirty = false;
+        }
+        return path;
+    }
+
+    // [PRD 3.2.3] 여러 창을 한 번의 전체 나열로 해석 (시작 시 이미 열린 창 일괄 부착용)
+    // -> 창마다 Resolve하면 창 수만큼 ListTabs가 반복됨. 여기서는 1회 나열 후 창별로 탭을 나눠 매칭.
+    void ResolveAll(const std::vector<std::pair<Handle, std::wstring>>& windows, std::vector<std::wstring>& paths) {
+        paths.assign(windows.size(), L"");
+        std::vector<ShellTab> all;
+        if (windows.empty() || !m_backend->ListTabs(all)) return;
+
+        std::unordered_map<Handle, std::vector<void*>> byWindow;
+        for (const auto& t : all) byWindow[t.hwnd].push_back(t.token);
+        for (size_t i = 0; i < windows.size(); i++) {
+            auto it = byWindow.find(windows[i].first);
+            if (it != byWindow.end()) paths[i] = MatchTabs(it->second, windows[i].second);
+        }
+        ReplaceTabs(all); // 토큰 소유권은 캐시로 이전 (MatchTabs는 빌려 쓰기만 함)
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_misses += windows.size();
+        for (size_t i = 0; i < windows.size(); i++) {
+            if (paths[i].empty()) continue;
+            Entry& e = m_cache[windows[i].first];
+            e.title = windows[i].second;
+            e.path = paths[i];
+            e.dirty = false;
+        }
+    }
+
+    // 탐색기 창이 이동(NAMECHANGE)함 -> 다음 Resolve에서 이 창만 재조회
+    void MarkDirty(Handle hExplorer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_cache.find(hExplorer);
+        if (it != m_cache.end()) it->second.dirty = true;
+    }
+
+    // 탐색기 창이 사라짐 -> 탭 토큰 해제
+    void Forget(Handle hExplorer) {
+        std::vector<void*> tabs;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_cache.find(hExplorer);
+            if (it == m_cache.end()) return;
+            tabs.swap(it->second.tabs);
+            m_cache.erase(it);
+        }
+        ReleaseAll(tabs);
+    }
+
+    void Shutdown() {
+        std::vector<void*> tabs;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& kv : m_cache) tabs.insert(tabs.end(), kv.second.tabs.begin(), kv.second.tabs.end());
+            m_cache.clear();
+        }
+        ReleaseAll(tabs);
+        m_backend->Disconnect();
+    }
+
+    unsigned long long Hits() { std::lock_guard<std::mutex> lock(m_mutex); return m_hits; }
+    unsigned long long Misses() { std::lock_guard<std::mutex> lock(m_mutex); return m_misses; }
+
+private:
+    struct Entry {
+        std::vector<void*> tabs;
+        std::wstring title;
+        std::wstring path;
+        bool dirty = false;
+    };
+
+    // 활성 탭 판별: 창 제목에 탭 이름이 포함된 탭 (기존 GetExplorerPath 규칙 유지)
+    std::wstring MatchTabs(const std::vector<void*>& tabs, const std::wstring& windowTitle) {
+        for (void* t : tabs) {
+            std::wstring name, path;
+            if (!m_backend->ReadTab(t, name, path)) continue;
+            if (!path.empty() && windowTitle.find(name) != std::wstring::npos) return path;
+        }
+        return L"";
+    }
+
+    // 전체 나열 결과로 모든 창의 탭 토큰 교체 (소유권 이전)
+    void ReplaceTabs(const std::vector<ShellTab>& all) {
+        std::vector<void*> old;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& kv : m_cache) { old.insert(old.end(), kv.second.tabs.begin(), kv.second.tabs.end()); kv.second.tabs.clear(); }
+            for (const auto& t : all) m_cache[t.hwnd].tabs.push_back(t.token);
+        }
+        ReleaseAll(old);
+    }
+
+    void ReleaseAll(std::vector<void*>& tabs) {
+        for (void* t : tabs) m_backend->ReleaseTab(t);
+        tabs.clear();
+    }
+
+    IShellBackend* m_backend;
+    std::mutex m_mutex;
+    std::unordered_map<Handle, Entry> m_cache;
+    unsigned long long m_hits = 0;
+    unsigned long long m_misses = 0;
+};
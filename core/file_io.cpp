@@ -0,0 +1,261 @@
+#include "core/file_io.h"
+
+#ifdef _WIN32
+#ifndef UNICODE
+#define UNICODE
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+#ifdef _WIN32
+
+bool ReadWholeFile(const fs::path& p, std::string& out) {
+    out.clear();
+    HANDLE hFile = CreateFileW(p.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+    DWORD fileSize = GetFileSize(hFile, NULL);
+    if (fileSize > 0 && fileSize != INVALID_FILE_SIZE) {
+        out.resize(fileSize);
+        DWORD bytesRead = 0;
+        ReadFile(hFile, &out[0], fileSize, &bytesRead, NULL);
+        out.resize(bytesRead);
+    }
+    CloseHandle(hFile);
+    return true;
+}
+
+bool WriteFileAtomic(const fs::path& p, const std::string& bytes) {
+    fs::path tmp = p; tmp += L".tmp";
+
+    HANDLE hFile = CreateFileW(tmp.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+    DWORD bytesWritten = 0;
+    BOOL ok = bytes.empty() ? TRUE : WriteFile(hFile, bytes.data(), (DWORD)bytes.size(), &bytesWritten, NULL);
+    if (ok) ok = FlushFileBuffers(hFile);
+    CloseHandle(hFile);
+    if (!ok) { DeleteFileW(tmp.c_str()); return false; }
+
+    if (MoveFileExW(tmp.c_str(), p.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) return true;
+
+    // [Fallback] 다른 프로그램이 원본을 삭제 공유 없이 열고 있으면 교체 불가 -> 기존 방식(직접 덮어쓰기)으로 기록
+    DeleteFileW(tmp.c_str());
+    hFile = CreateFileW(p.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+    ok = bytes.empty() ? TRUE : WriteFile(hFile, bytes.data(), (DWORD)bytes.size(), &bytesWritten, NULL);
+    if (ok) ok = FlushFileBuffers(hFile);
+    CloseHandle(hFile);
+    return ok != FALSE;
+}
+
+bool AppendFileAt(const fs::path& p, uint64_t offset, const std::string& data) {
+    HANDLE hFile = CreateFileW(p.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER li; li.QuadPart = (LONGLONG)offset;
+    BOOL ok = SetFilePointerEx(hFile, li, NULL, FILE_BEGIN);
+    DWORD written = 0;
+    if (ok) ok = WriteFile(hFile, data.data(), (DWORD)data.size(), &written, NULL);
+    if (ok) ok = SetEndOfFile(hFile);
+    if (ok) ok = FlushFileBuffers(hFile);
+    CloseHandle(hFile);
+    return ok != FALSE;
+}
+
+
+bool MoveFileReplace(const fs::path& from, const fs::path& to) {
+    return MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+}
+
+bool RandomAccessFile::Open(const fs::path& p, bool truncate) {
+    Close();
+    HANDLE h = CreateFileW(p.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, truncate ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    m_handle = h;
+    return h != INVALID_HANDLE_VALUE;
+}
+
+void RandomAccessFile::Close() {
+    if (m_handle != INVALID_HANDLE_VALUE) CloseHandle((HANDLE)m_handle);
+    m_handle = INVALID_HANDLE_VALUE;
+}
+
+bool RandomAccessFile::IsOpen() const { return m_handle != INVALID_HANDLE_VALUE; }
+
+bool RandomAccessFile::Size(uint64_t& size) {
+    LARGE_INTEGER li;
+    if (!GetFileSizeEx((HANDLE)m_handle, &li)) return false;
+    size = (uint64_t)li.QuadPart;
+    return true;
+}
+
+bool RandomAccessFile::ReadAt(uint64_t offset, void* buf, uint32_t len) {
+    if (len == 0) return true;
+    LARGE_INTEGER li; li.QuadPart = (LONGLONG)offset;
+    if (!SetFilePointerEx((HANDLE)m_handle, li, NULL, FILE_BEGIN)) return false;
+    DWORD got = 0;
+    return ReadFile((HANDLE)m_handle, buf, len, &got, NULL) && got == len;
+}
+
+bool RandomAccessFile::WriteAt(uint64_t offset, const std::string& data) {
+    LARGE_INTEGER li; li.QuadPart = (LONGLONG)offset;
+    if (!SetFilePointerEx((HANDLE)m_handle, li, NULL, FILE_BEGIN)) return false;
+    DWORD written = 0;
+    return WriteFile((HANDLE)m_handle, data.data(), (DWORD)data.size(), &written, NULL) && written == data.size();
+}
+
+bool RandomAccessFile::Truncate(uint64_t size) {
+    LARGE_INTEGER li; li.QuadPart = (LONGLONG)size;
+    return SetFilePointerEx((HANDLE)m_handle, li, NULL, FILE_BEGIN) && SetEndOfFile((HANDLE)m_handle);
+}
+
+bool RandomAccessFile::Flush() { return FlushFileBuffers((HANDLE)m_handle) != FALSE; }
+
+bool MappedFile::Open(const fs::path& p) {
+    Close();
+    m_file = CreateFileW(p.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx((HANDLE)m_file, &size) || size.QuadPart == 0) { Close(); return false; }
+    m_mapping = CreateFileMappingW((HANDLE)m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!m_mapping) { Close(); return false; }
+    m_data = (const char*)MapViewOfFile((HANDLE)m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!m_data) { Close(); return false; }
+    m_size = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle((HANDLE)m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE) CloseHandle((HANDLE)m_file);
+    m_data = NULL; m_mapping = NULL; m_file = INVALID_HANDLE_VALUE; m_size = 0;
+}
+
+#else
+
+static bool WriteAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n; size -= (size_t)n;
+    }
+    return true;
+}
+
+bool ReadWholeFile(const fs::path& p, std::string& out) {
+    out.clear();
+    int fd = open(p.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        out.resize((size_t)st.st_size);
+        size_t got = 0;
+        while (got < out.size()) {
+            ssize_t n = read(fd, &out[got], out.size() - got);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            got += (size_t)n;
+        }
+        out.resize(got);
+    }
+    close(fd);
+    return true;
+}
+
+bool WriteFileAtomic(const fs::path& p, const std::string& bytes) {
+    fs::path tmp = p; tmp += ".tmp";
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    bool ok = WriteAll(fd, bytes.data(), bytes.size()) && fsync(fd) == 0;
+    close(fd);
+    if (!ok) { unlink(tmp.c_str()); return false; }
+    if (rename(tmp.c_str(), p.c_str()) == 0) return true;
+
+    unlink(tmp.c_str());
+    fd = open(p.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    ok = WriteAll(fd, bytes.data(), bytes.size()) && fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+
+bool AppendFileAt(const fs::path& p, uint64_t offset, const std::string& data) {
+    int fd = open(p.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    bool ok = lseek(fd, (off_t)offset, SEEK_SET) == (off_t)offset && WriteAll(fd, data.data(), data.size()) &&
+        ftruncate(fd, (off_t)(offset + data.size())) == 0 && fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+
+bool MoveFileReplace(const fs::path& from, const fs::path& to) {
+    return rename(from.c_str(), to.c_str()) == 0;
+}
+
+bool RandomAccessFile::Open(const fs::path& p, bool truncate) {
+    Close();
+    m_fd = open(p.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+    return m_fd >= 0;
+}
+
+void RandomAccessFile::Close() {
+    if (m_fd >= 0) close(m_fd);
+    m_fd = -1;
+}
+
+bool RandomAccessFile::IsOpen() const { return m_fd >= 0; }
+
+bool RandomAccessFile::Size(uint64_t& size) {
+    struct stat st;
+    if (fstat(m_fd, &st) != 0) return false;
+    size = (uint64_t)st.st_size;
+    return true;
+}
+
+bool RandomAccessFile::ReadAt(uint64_t offset, void* buf, uint32_t len) {
+    char* p = (char*)buf;
+    while (len > 0) {
+        ssize_t n = pread(m_fd, p, len, (off_t)offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n; offset += (uint64_t)n; len -= (uint32_t)n;
+    }
+    return true;
+}
+
+bool RandomAccessFile::WriteAt(uint64_t offset, const std::string& data) {
+    return lseek(m_fd, (off_t)offset, SEEK_SET) == (off_t)offset && WriteAll(m_fd, data.data(), data.size());
+}
+
+bool RandomAccessFile::Truncate(uint64_t size) { return ftruncate(m_fd, (off_t)size) == 0; }
+
+bool RandomAccessFile::Flush() { return fsync(m_fd) == 0; }
+
+bool MappedFile::Open(const fs::path& p) {
+    Close();
+    int fd = open(p.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return false; }
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+    m_data = (const char*)data;
+    m_size = (size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) munmap((void*)m_data, m_size);
+    m_data = nullptr; m_size = 0;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+// --- [파일 입출력] ---
+// Win32 구현은 main.cpp에서 옮겨 옴. 그 밖의 플랫폼은 POSIX (Linux 테스트/벤치용)
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// 파일 전체 읽기 (없으면 false, out은 비움)
+bool ReadWholeFile(const std::filesystem::path& p, std::string& out);
+
+// [PRD 5.3] 원자적 기록 (Temp + Rename)
+// -> 기록 도중 크래시/전원 차단이 나도 대상 파일이 반쯤 쓰인 상태로 남지 않도록 임시 파일에 먼저 기록 후 교체.
+bool WriteFileAtomic(const std::filesystem::path& p, const std::string& bytes);
+
+// [PRD 5.4] offset 위치에 덧붙이고 그 뒤(크래시로 남은 잘린 레코드)는 잘라냄. 파일이 없으면 만듦
+bool AppendFileAt(const std::filesystem::path& p, uint64_t offset, const std::string& data);
+
+// [PRD 5.7] 원자적 교체 (같은 볼륨 안 이름 변경, 대상이 있으면 덮어씀)
+bool MoveFileReplace(const std::filesystem::path& from, const std::filesystem::path& to);
+
+// [PRD 5.7] 위치 지정 읽기/쓰기 파일 하나 (중앙 로그 저장소). 다른 프로세스는 읽기만 공유
+class RandomAccessFile {
+public:
+    RandomAccessFile() {}
+    RandomAccessFile(const RandomAccessFile&) = delete;
+    RandomAccessFile& operator=(const RandomAccessFile&) = delete;
+    ~RandomAccessFile() { Close(); }
+
+    // truncate: 있으면 비우고 시작 (압축 임시 파일), 아니면 없을 때만 새로 만듦
+    bool Open(const std::filesystem::path& p, bool truncate);
+    void Close();
+    bool IsOpen() const;
+
+    bool Size(uint64_t& size);
+    bool ReadAt(uint64_t offset, void* buf, uint32_t len);
+    bool WriteAt(uint64_t offset, const std::string& data);
+    bool Truncate(uint64_t size);
+    bool Flush();
+
+private:
+#ifdef _WIN32
+    void* m_handle = (void*)(intptr_t)-1; // INVALID_HANDLE_VALUE
+#else
+    int m_fd = -1;
+#endif
+};
+
+// [PRD 6.1] 읽기 전용 메모리 매핑 파일 (빈 파일은 매핑하지 않음 -> Open 실패)
+// -> [PRD 5.5] 분할 로딩과 색인 이미지가 같이 씀. POSIX는 매핑 후 fd를 바로 닫음 (매핑은 유지됨)
+class MappedFile {
+public:
+    MappedFile() {}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { Close(); }
+
+    bool Open(const std::filesystem::path& p);
+    void Close();
+
+    const char* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+#ifdef _WIN32
+    void* m_file = (void*)(intptr_t)-1; // INVALID_HANDLE_VALUE
+    void* m_mapping = nullptr;
+#endif
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+};
\ No newline at end of file
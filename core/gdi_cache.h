@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// --- [GDI 리소스 캐시] ---
+// [PRD 4.4] 렌더링 팩토리 인터페이스 -> 실제 GDI 생성/삭제를 분리 (카운팅 가짜로 할당 횟수 검증 가능)
+// -> 객체 형식은 템플릿 인자 (Win32는 HGDIOBJ, 테스트는 가짜 번호). 색상은 COLORREF와 같은 0x00BBGGRR.
+template <typename Object>
+class BasicGdiFactory {
+public:
+    virtual ~BasicGdiFactory() {}
+    virtual Object CreateFontObject(const std::wstring& face, int size) = 0;
+    virtual Object CreateBrushObject(uint32_t color) = 0;
+    virtual Object CreatePenObject(uint32_t color, int width) = 0;
+    virtual void DestroyObject(Object obj) = 0;
+};
+
+// [PRD 4.4] 참조 카운트 GDI 캐시 (UI 스레드 전용)
+// -> Ctrl+휠/경로 갱신마다 CreateFontW 후 이전 폰트를 삭제하지 않아 GDI 핸들이 누수되던 문제 해결.
+// -> (글꼴, 크기) / 색상 / (색상, 두께)를 키로 모든 오버레이가 같은 객체를 공유. 참조가 0이 되면 즉시 삭제.
+template <typename Object>
+class BasicGdiResourceCache {
+public:
+    typedef BasicGdiFactory<Object> Factory;
+
+    explicit BasicGdiResourceCache(Factory* factory) : m_factory(factory) {}
+
+    Object AcquireFont(const std::wstring& face, int size) { return Acquire(L"F|" + face + L"|" + std::to_wstring(size), KIND_FONT, [&] { return m_factory->CreateFontObject(face, size); }); }
+    Object AcquireBrush(uint32_t color) { return Acquire(L"B|" + std::to_wstring(color), KIND_BRUSH, [&] { return m_factory->CreateBrushObject(color); }); }
+    Object AcquirePen(uint32_t color, int width) { return Acquire(L"P|" + std::to_wstring(color) + L"|" + std::to_wstring(width), KIND_PEN, [&] { return m_factory->CreatePenObject(color, width); }); }
+
+    // 캐시 소유가 아닌 핸들(예: 시스템 기본 폰트)은 무시
+    void Release(Object obj) {
+        if (!obj) return;
+        auto rit = m_keyByObject.find(obj);
+        if (rit == m_keyByObject.end()) return;
+        auto it = m_entries.find(rit->second);
+        if (--it->second.refs > 0) return;
+        m_factory->DestroyObject(obj);
+        m_live[it->second.kind]--;
+        m_entries.erase(it);
+        m_keyByObject.erase(rit);
+    }
+
+    bool Owns(Object obj) const { return m_keyByObject.count(obj) != 0; }
+
+    int LiveFonts() const { return m_live[KIND_FONT]; }
+    int LiveBrushes() const { return m_live[KIND_BRUSH]; }
+    int LivePens() const { return m_live[KIND_PEN]; }
+    unsigned long long Created() const { return m_created; }
+
+private:
+    enum Kind { KIND_FONT, KIND_BRUSH, KIND_PEN, KIND_COUNT };
+    struct Entry { Object obj; int refs; Kind kind; };
+
+    template <typename CreateFn>
+    Object Acquire(const std::wstring& key, Kind kind, CreateFn create) {
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) { it->second.refs++; return it->second.obj; }
+        Object obj = create();
+        if (!obj) return Object();
+        m_entries.emplace(key, Entry{ obj, 1, kind });
+        m_keyByObject.emplace(obj, key);
+        m_live[kind]++;
+        m_created++;
+        return obj;
+    }
+
+    Factory* m_factory;
+    std::unordered_map<std::wstring, Entry> m_entries;
+    std::unordered_map<Object, std::wstring> m_keyByObject;
+    int m_live[KIND_COUNT] = { 0, 0, 0 };
+    unsigned long long m_created = 0;
+};
\ No newline at end of file
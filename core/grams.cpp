@@ -0,0 +1,53 @@
+#include "core/grams.h"
+
+#include <algorithm>
+#include <cwctype>
+
+#include "core/utf.h"
+
+// 긴 메모는 같은 gram이 대부분 -> 전부 모아 정렬하지 않고 열린 주소 해시(호출 스레드 재사용)로 중복을 거른 뒤 고유한 것만 정렬
+// -> 0은 빈 칸 표시 (32비트 wchar_t의 U+10000 배수 글자만 0이 됨 -> 따로 기억)
+void ExtractGrams(const std::wstring& text, std::vector<uint32_t>& out) {
+    thread_local std::vector<uint32_t> table;
+    table.assign(1024, 0);
+    size_t mask = table.size() - 1, used = 0;
+    bool zero = false;
+    auto add = [&](uint32_t g) {
+        if (g == 0) { zero = true; return; }
+        size_t h = (g * 2654435761u) & mask;
+        while (table[h]) {
+            if (table[h] == g) return;
+            h = (h + 1) & mask;
+        }
+        table[h] = g;
+        if (++used * 2 <= mask) return;
+        std::vector<uint32_t> old;
+        old.swap(table);
+        table.assign(old.size() * 2, 0);
+        mask = table.size() - 1;
+        for (uint32_t v : old) {
+            if (!v) continue;
+            size_t k = (v * 2654435761u) & mask;
+            while (table[k]) k = (k + 1) & mask;
+            table[k] = v;
+        }
+    };
+    wchar_t prev = 0;
+    for (wchar_t raw : text) {
+        if (iswspace(raw) || iswpunct(raw) || raw == 0) { prev = 0; continue; }
+        wchar_t c = (wchar_t)towlower(raw);
+        add((uint32_t)c << 16);
+        if (prev) add(((uint32_t)prev << 16) | c);
+        prev = c;
+    }
+    out.clear();
+    if (zero) out.push_back(0);
+    for (uint32_t v : table) if (v) out.push_back(v);
+    std::sort(out.begin(), out.end());
+}
+
+void ExtractGramsUtf8(const char* data, size_t len, std::vector<uint32_t>& out) {
+    thread_local std::wstring text;
+    Utf8ToWide(data, len, text);
+    ExtractGrams(text, out);
+}
\ No newline at end of file
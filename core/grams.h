@@ -0,0 +1,14 @@
+#pragma once
+// --- [검색 gram] ---
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// [PRD 6.1] n-gram 토큰화 (한글/CJK 대응)
+// -> 형태소 분석 없이 공백/문장부호로 나눈 구간마다 글자 1-gram + 2-gram을 색인 -> 한국어 조사가 붙어도 부분 일치로 검색됨.
+// -> gram = (앞 글자 << 16) | 뒷 글자 (1-gram은 뒷 글자 0). 대소문자는 접어서 비교. 결과는 정렬 + 중복 제거.
+void ExtractGrams(const std::wstring& text, std::vector<uint32_t>& out);
+
+// [PRD 5.11] 저장 사본(UTF-8)에서 바로 -> 호출 스레드의 재사용 버퍼로 디코드 (결과는 ExtractGrams와 같음)
+void ExtractGramsUtf8(const char* data, size_t len, std::vector<uint32_t>& out);
\ No newline at end of file
@@ -0,0 +1,390 @@
+#include "core/history.h"
+
+#include <chrono>
+#include <cwchar>
+
+#include "core/central_store.h"
+#include "core/crc32.h"
+#include "core/file_io.h"
+#include "core/utf.h"
+
+void ChunkBoundaries(const char* data, size_t len, std::vector<size_t>& ends) {
+    static const std::array<uint64_t, 256> gear = [] {
+        std::array<uint64_t, 256> t{};
+        uint64_t x = 0x9E3779B97F4A7C15ULL; // splitmix64 -> 고정 표 (실행마다 같은 경계)
+        for (auto& v : t) {
+            uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            v = z ^ (z >> 31);
+        }
+        return t;
+    }();
+    const uint64_t maskStrict = 0xFFFE000000000000ULL; // 상위 15비트 (평균 8KB보다 어렵게)
+    const uint64_t maskLoose = 0xFFE0000000000000ULL;  // 상위 11비트
+    const unsigned char* p = (const unsigned char*)data;
+    ends.clear();
+    size_t start = 0;
+    while (start < len) {
+        size_t remain = len - start;
+        if (remain <= CHUNK_MIN_BYTES) { ends.push_back(len); break; }
+        size_t limit = std::min(remain, CHUNK_MAX_BYTES);
+        size_t normal = std::min(limit, CHUNK_AVG_BYTES);
+        uint64_t h = 0;
+        size_t i = CHUNK_MIN_BYTES;
+        size_t cut = limit;
+        for (; i < normal; i++) {
+            h = (h << 1) + gear[p[start + i]];
+            if (!(h & maskStrict)) { cut = i + 1; goto found; }
+        }
+        for (; i < limit; i++) {
+            h = (h << 1) + gear[p[start + i]];
+            if (!(h & maskLoose)) { cut = i + 1; goto found; }
+        }
+    found:
+        ends.push_back(start + cut);
+        start += cut;
+    }
+}
+
+std::vector<bool> SelectRetainedVersions(const std::vector<int64_t>& times, int64_t nowMs) {
+    const int64_t HOUR = 3600 * 1000LL, DAY = 24 * HOUR;
+    std::vector<bool> keep(times.size(), false);
+    if (times.empty()) return keep;
+    std::unordered_set<int64_t> hours, days;
+    size_t kept = 0;
+    for (size_t n = times.size(); n-- > 0;) {
+        int64_t age = nowMs - times[n];
+        bool k;
+        if (n + 1 == times.size() || age < DAY) k = true;
+        else if (age < 7 * DAY) k = hours.insert(times[n] / HOUR).second;   // 그 시간대의 가장 최신 1개
+        else if (age < 90 * DAY) k = days.insert(times[n] / DAY).second;
+        else k = false;
+        if (k && kept >= HISTORY_MAX_VERSIONS) k = false;
+        keep[n] = k;
+        if (k) kept++;
+    }
+    return keep;
+}
+
+bool MemoHistoryStore::Open(const std::filesystem::path& dir) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_open) return true;
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    m_packPath = dir / L"chunks.pack";
+    m_logPath = dir / L"versions.log";
+    m_chunks.clear();
+    m_versions.clear();
+    if (!OpenPackLocked() || !LoadVersionsLocked()) return false;
+    m_open = true;
+    MaintainLocked();
+    return true;
+}
+
+void MemoHistoryStore::Close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_open) return;
+    for (auto& kv : m_pending) CommitLocked(kv.second.path, *kv.second.bytes, kv.second.timeMs);
+    m_pending.clear();
+    MaintainLocked();
+    m_pack.close();
+    m_logFile.close();
+    m_open = false;
+    wchar_t buf[200];
+    swprintf(buf, 200, L"[FolderMemo] history: versions=%llu logical=%llu bytes stored=%llu bytes (dedup %.1fx)\n",
+        m_committed, m_logicalBytes, m_storedBytes, m_storedBytes ? (double)m_logicalBytes / m_storedBytes : 0.0);
+    Log(buf);
+}
+
+void MemoHistoryStore::OnSaved(const std::wstring& folderPath, const std::shared_ptr<const std::string>& bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_open) return;
+    std::wstring key = CentralLogStore::NormalizeKey(folderPath);
+    int64_t now = NowMs();
+    auto pit = m_pending.find(key);
+    if (pit != m_pending.end()) {
+        size_t before = pit->second.bytes->size();
+        if (bytes->size() * 2 < before && before - bytes->size() >= HISTORY_SHRINK_MIN_BYTES) {
+            CommitLocked(pit->second.path, *pit->second.bytes, pit->second.timeMs); // 지우기 직전 내용 보존
+        }
+        m_pending.erase(pit);
+    }
+    auto vit = m_versions.find(key);
+    int64_t last = (vit != m_versions.end() && !vit->second.list.empty()) ? vit->second.list.back().timeMs : 0;
+    if (now - last >= HISTORY_INTERVAL_MS) CommitLocked(folderPath, *bytes, now);
+    else m_pending[key] = { folderPath, bytes, now };
+}
+
+bool MemoHistoryStore::Snapshot(const std::wstring& folderPath, const std::string& bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_open) return false;
+    m_pending.erase(CentralLogStore::NormalizeKey(folderPath));
+    return CommitLocked(folderPath, bytes, NowMs());
+}
+
+std::vector<MemoVersionInfo> MemoHistoryStore::List(const std::wstring& folderPath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<MemoVersionInfo> out;
+    auto it = m_versions.find(CentralLogStore::NormalizeKey(folderPath));
+    if (it == m_versions.end()) return out;
+    for (const auto& v : it->second.list) out.push_back({ v.timeMs, v.size });
+    return out;
+}
+
+bool MemoHistoryStore::Read(const std::wstring& folderPath, size_t index, std::string& bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bytes.clear();
+    auto it = m_versions.find(CentralLogStore::NormalizeKey(folderPath));
+    if (!m_open || it == m_versions.end() || index >= it->second.list.size()) return false;
+    const Version& v = it->second.list[index];
+    bytes.reserve((size_t)v.size);
+    std::string chunk;
+    for (const auto& d : v.chunks) {
+        if (!ReadChunkLocked(d, chunk)) return false;
+        bytes += chunk;
+    }
+    return bytes.size() == v.size;
+}
+
+int64_t MemoHistoryStore::NowMs() const {
+    if (m_clock) return m_clock();
+    return (int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::string MemoHistoryStore::FileHeader(uint32_t magic) {
+    uint32_t hdr[2] = { magic, 1 };
+    return std::string((const char*)hdr, sizeof(hdr));
+}
+
+bool MemoHistoryStore::OpenAppend(std::fstream& f, const std::filesystem::path& p, uint32_t magic, uint64_t& size) {
+    f.open(p, std::ios::in | std::ios::out | std::ios::binary);
+    if (!f.is_open()) {
+        std::ofstream create(p, std::ios::binary);
+        std::string hdr = FileHeader(magic);
+        create.write(hdr.data(), hdr.size());
+        create.close();
+        f.open(p, std::ios::in | std::ios::out | std::ios::binary);
+        if (!f.is_open()) return false;
+    }
+    f.seekg(0, std::ios::end);
+    size = (uint64_t)f.tellg();
+    uint32_t hdr[2] = { 0, 0 };
+    f.seekg(0);
+    if (size < FILE_HEADER_SIZE || !f.read((char*)hdr, sizeof(hdr)) || hdr[0] != magic) {
+        // 손상/다른 형식 -> 새로 시작 (기록 보관은 안전망이므로 메모 자체에는 영향 없음)
+        f.close();
+        std::ofstream create(p, std::ios::binary | std::ios::trunc);
+        std::string h = FileHeader(magic);
+        create.write(h.data(), h.size());
+        create.close();
+        f.open(p, std::ios::in | std::ios::out | std::ios::binary);
+        size = FILE_HEADER_SIZE;
+        return f.is_open();
+    }
+    return true;
+}
+
+// 잘린 꼬리는 다음 기록이 덮어쓰도록 크기만 되돌림 (파일 길이는 압축/다음 열기 때 정리)
+void MemoHistoryStore::TruncateTo(std::fstream& f, const std::filesystem::path& p, uint64_t size) {
+    f.close();
+    std::error_code ec;
+    std::filesystem::resize_file(p, size, ec);
+    f.open(p, std::ios::in | std::ios::out | std::ios::binary);
+}
+
+bool MemoHistoryStore::OpenPackLocked() {
+    uint64_t fileSize = 0;
+    if (!OpenAppend(m_pack, m_packPath, PACK_MAGIC, fileSize)) return false;
+    uint64_t pos = FILE_HEADER_SIZE;
+    m_pack.seekg((std::streamoff)pos);
+    for (;;) {
+        uint32_t hdr[2];
+        Sha256::Digest d;
+        if (pos + CHUNK_HEADER_SIZE > fileSize) break;
+        if (!m_pack.read((char*)hdr, sizeof(hdr)) || !m_pack.read((char*)d.data(), 32)) break;
+        if (hdr[0] != CHUNK_MAGIC || pos + CHUNK_HEADER_SIZE + hdr[1] > fileSize) break;
+        m_chunks.emplace(d, ChunkLoc{ pos + CHUNK_HEADER_SIZE, hdr[1] });
+        pos += CHUNK_HEADER_SIZE + hdr[1];
+        m_pack.seekg((std::streamoff)pos);
+    }
+    m_pack.clear();
+    if (pos < fileSize) TruncateTo(m_pack, m_packPath, pos);
+    m_packSize = pos;
+    return m_pack.is_open();
+}
+
+bool MemoHistoryStore::LoadVersionsLocked() {
+    uint64_t fileSize = 0;
+    if (!OpenAppend(m_logFile, m_logPath, LOG_MAGIC, fileSize)) return false;
+    std::string all((size_t)fileSize, '\0');
+    m_logFile.seekg(0);
+    m_logFile.read(&all[0], (std::streamsize)fileSize);
+    m_logFile.clear();
+    uint64_t pos = FILE_HEADER_SIZE;
+    while (pos + 12 <= fileSize) {
+        uint32_t hdr[3];
+        memcpy(hdr, all.data() + pos, 12);
+        if (hdr[0] != VER_MAGIC || pos + 12 + hdr[1] > fileSize) break;
+        const char* body = all.data() + pos + 12;
+        if (Crc32(body, hdr[1]) != hdr[2]) break;
+        std::wstring path;
+        Version v;
+        if (!DecodeVersion(body, hdr[1], path, v)) break;
+        Folder& f = m_versions[CentralLogStore::NormalizeKey(path)];
+        if (f.path.empty()) f.path = path;
+        f.list.push_back(std::move(v));
+        pos += 12 + hdr[1];
+    }
+    if (pos < fileSize) TruncateTo(m_logFile, m_logPath, pos);
+    m_logSize = pos;
+    return m_logFile.is_open();
+}
+
+std::string MemoHistoryStore::EncodeVersion(const std::wstring& path, const Version& v) {
+    std::string utf8 = WideToUtf8(path);
+    std::string body;
+    uint32_t pathLen = (uint32_t)utf8.size(), count = (uint32_t)v.chunks.size();
+    body.append((const char*)&v.timeMs, 8);
+    body.append((const char*)&v.size, 8);
+    body.append((const char*)&pathLen, 4);
+    body += utf8;
+    body.append((const char*)&count, 4);
+    for (const auto& d : v.chunks) body.append((const char*)d.data(), 32);
+    uint32_t hdr[3] = { VER_MAGIC, (uint32_t)body.size(), Crc32(body.data(), body.size()) };
+    return std::string((const char*)hdr, sizeof(hdr)) + body;
+}
+
+bool MemoHistoryStore::DecodeVersion(const char* body, size_t len, std::wstring& path, Version& v) {
+    if (len < 20) return false;
+    uint32_t pathLen, count;
+    memcpy(&v.timeMs, body, 8);
+    memcpy(&v.size, body + 8, 8);
+    memcpy(&pathLen, body + 16, 4);
+    if (20 + (uint64_t)pathLen + 4 > len) return false;
+    path = Utf8ToWide(std::string(body + 20, pathLen));
+    memcpy(&count, body + 20 + pathLen, 4);
+    size_t at = 24 + pathLen;
+    if (at + (uint64_t)count * 32 != len) return false;
+    v.chunks.resize(count);
+    for (uint32_t i = 0; i < count; i++) memcpy(v.chunks[i].data(), body + at + i * 32, 32);
+    return true;
+}
+
+bool MemoHistoryStore::ReadChunkLocked(const Sha256::Digest& d, std::string& out) {
+    auto it = m_chunks.find(d);
+    if (it == m_chunks.end()) return false;
+    out.resize(it->second.len);
+    m_pack.seekg((std::streamoff)it->second.offset);
+    if (it->second.len && !m_pack.read(&out[0], it->second.len)) { m_pack.clear(); return false; }
+    return Sha256::Of(out.data(), out.size()) == d;
+}
+
+bool MemoHistoryStore::CommitLocked(const std::wstring& folderPath, const std::string& bytes, int64_t timeMs) {
+    Version v;
+    v.timeMs = timeMs;
+    v.size = bytes.size();
+    ChunkBoundaries(bytes.data(), bytes.size(), m_ends);
+    size_t start = 0;
+    uint64_t added = 0;
+    for (size_t end : m_ends) {
+        Sha256::Digest d = Sha256::Of(bytes.data() + start, end - start);
+        if (!m_chunks.count(d)) {
+            uint32_t hdr[2] = { CHUNK_MAGIC, (uint32_t)(end - start) };
+            m_pack.seekp((std::streamoff)m_packSize);
+            m_pack.write((const char*)hdr, sizeof(hdr));
+            m_pack.write((const char*)d.data(), 32);
+            m_pack.write(bytes.data() + start, end - start);
+            if (!m_pack.flush()) { m_pack.clear(); return false; }
+            m_chunks.emplace(d, ChunkLoc{ m_packSize + CHUNK_HEADER_SIZE, (uint32_t)(end - start) });
+            m_packSize += CHUNK_HEADER_SIZE + (end - start);
+            added += end - start;
+        }
+        v.chunks.push_back(d);
+        start = end;
+    }
+
+    Folder& f = m_versions[CentralLogStore::NormalizeKey(folderPath)];
+    if (!f.list.empty() && f.list.back().chunks == v.chunks) return true; // 내용 그대로 -> 버전 추가 안 함
+    std::string rec = EncodeVersion(folderPath, v);
+    m_logFile.seekp((std::streamoff)m_logSize);
+    m_logFile.write(rec.data(), rec.size());
+    if (!m_logFile.flush()) { m_logFile.clear(); return false; }
+    m_logSize += rec.size();
+    if (f.path.empty()) f.path = folderPath;
+    f.list.push_back(std::move(v));
+    m_committed++;
+    m_logicalBytes += bytes.size();
+    m_storedBytes += added;
+    return true;
+}
+
+// 보존 정책 적용 -> 버전 로그 재작성, 참조 없는 청크가 많으면 pack 재작성
+void MemoHistoryStore::MaintainLocked() {
+    int64_t now = NowMs();
+    bool dropped = false;
+    for (auto it = m_versions.begin(); it != m_versions.end();) {
+        auto& list = it->second.list;
+        std::vector<int64_t> times;
+        for (const auto& v : list) times.push_back(v.timeMs);
+        std::vector<bool> keep = SelectRetainedVersions(times, now);
+        if (std::find(keep.begin(), keep.end(), false) != keep.end()) {
+            std::vector<Version> kept;
+            for (size_t i = 0; i < list.size(); i++) if (keep[i]) kept.push_back(std::move(list[i]));
+            list.swap(kept);
+            dropped = true;
+        }
+        if (list.empty()) it = m_versions.erase(it); else ++it;
+    }
+    if (dropped) RewriteLogLocked();
+
+    std::unordered_set<Sha256::Digest, DigestHash> live;
+    for (const auto& kv : m_versions) for (const auto& v : kv.second.list) live.insert(v.chunks.begin(), v.chunks.end());
+    uint64_t liveBytes = 0;
+    for (const auto& d : live) { auto it = m_chunks.find(d); if (it != m_chunks.end()) liveBytes += CHUNK_HEADER_SIZE + it->second.len; }
+    uint64_t deadBytes = m_packSize - FILE_HEADER_SIZE - liveBytes;
+    if (deadBytes >= HISTORY_COMPACT_MIN_DEAD_BYTES && deadBytes > liveBytes) RewritePackLocked(live);
+}
+
+void MemoHistoryStore::RewriteLogLocked() {
+    std::string all = FileHeader(LOG_MAGIC);
+    for (const auto& kv : m_versions) for (const auto& v : kv.second.list) all += EncodeVersion(kv.second.path, v);
+    m_logFile.close();
+    WriteFileAtomic(m_logPath, all);
+    m_logFile.open(m_logPath, std::ios::in | std::ios::out | std::ios::binary);
+    m_logSize = all.size();
+}
+
+void MemoHistoryStore::RewritePackLocked(const std::unordered_set<Sha256::Digest, DigestHash>& live) {
+    std::filesystem::path tmp = m_packPath; tmp += L".tmp";
+    std::unordered_map<Sha256::Digest, ChunkLoc, DigestHash> moved;
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        std::string hdr = FileHeader(PACK_MAGIC);
+        out.write(hdr.data(), hdr.size());
+        uint64_t pos = FILE_HEADER_SIZE;
+        std::string chunk;
+        for (const auto& d : live) {
+            if (!ReadChunkLocked(d, chunk)) continue; // 손상 청크는 버림 (해당 버전 읽기는 실패로 보고됨)
+            uint32_t h[2] = { CHUNK_MAGIC, (uint32_t)chunk.size() };
+            out.write((const char*)h, sizeof(h));
+            out.write((const char*)d.data(), 32);
+            out.write(chunk.data(), chunk.size());
+            moved.emplace(d, ChunkLoc{ pos + CHUNK_HEADER_SIZE, (uint32_t)chunk.size() });
+            pos += CHUNK_HEADER_SIZE + chunk.size();
+        }
+        if (!out.flush()) { out.close(); std::error_code ec; std::filesystem::remove(tmp, ec); return; }
+    }
+    m_pack.close();
+    std::error_code ec;
+    std::filesystem::rename(tmp, m_packPath, ec);
+    m_pack.open(m_packPath, std::ios::in | std::ios::out | std::ios::binary);
+    if (ec) return; // 교체 실패 -> 기존 pack 그대로 사용
+    uint64_t before = m_packSize;
+    m_chunks.swap(moved);
+    m_packSize = FILE_HEADER_SIZE;
+    for (const auto& kv : m_chunks) m_packSize += CHUNK_HEADER_SIZE + kv.second.len;
+    wchar_t buf[160];
+    swprintf(buf, 160, L"[FolderMemo] history: pack compacted %llu -> %llu bytes\n", (unsigned long long)before, (unsigned long long)m_packSize);
+    Log(buf);
+}
\ No newline at end of file
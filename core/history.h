@@ -0,0 +1,212 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// --- [메모 기록 보관] ---
+// [PRD 5.9] 내용 주소 기반 버전 기록 (실수로 전체 삭제/덮어쓰기 후 복구)
+// -> 저장할 때마다 전체 사본을 남기면 큰 메모는 금방 수백 MB. 대신 내용 정의 청크(Gear 롤링 해시 경계)로 자르고
+//    SHA-256으로 주소를 매겨 같은 청크는 한 번만 보관 -> 앞부분 한 줄을 고쳐도 새로 쌓이는 것은 바뀐 청크 1~2개.
+// -> 버전 = 청크 주소 목록. 저장소는 %LOCALAPPDATA%\FolderMemo\history 아래 두 파일 (chunks.pack, versions.log, 모두 덧붙이기만).
+// -> 스냅샷 시점: 폴더별로 마지막 버전 후 HISTORY_INTERVAL_MS가 지난 저장. 그 사이 저장은 메모리에 '대기본'으로만 들고 있다가
+//    내용이 크게 줄어드는 저장(전체 선택 후 삭제 등)이 오면 직전 대기본을 먼저 버전으로 남김. 종료 시 대기본 모두 기록.
+// -> 보존 정책: 최근 1일 전부 / 7일 안은 시간당 1개 / 90일 안은 하루 1개 / 그 이전 삭제, 최신 1개는 항상 유지.
+//    열기/닫기 때 적용 -> 참조 없는 청크가 일정량 넘으면 pack을 다시 씀 (중앙 저장소와 같은 압축 조건).
+// -> 청크 분할/해시/보존 선택은 OS 의존성 없음. 파일 입출력도 표준 스트림만 사용 -> 저장소까지 Linux 테스트/벤치가 같은 코드.
+const int64_t HISTORY_INTERVAL_MS = 60 * 1000;
+const size_t HISTORY_SHRINK_MIN_BYTES = 256;          // 이보다 작게 줄면 '크게 줄어듦'으로 보지 않음
+const size_t HISTORY_MAX_VERSIONS = 1000;             // 폴더당 상한 (보존 정책 이후에도 넘으면 오래된 것부터)
+const uint64_t HISTORY_COMPACT_MIN_DEAD_BYTES = 4 * 1024 * 1024;
+const size_t CHUNK_MIN_BYTES = 2 * 1024;
+const size_t CHUNK_AVG_BYTES = 8 * 1024;
+const size_t CHUNK_MAX_BYTES = 64 * 1024;
+
+// SHA-256 (FIPS 180-4). 청크 주소용 -> 충돌 걱정 없이 내용 비교를 주소 비교로 대신함.
+class Sha256 {
+public:
+    typedef std::array<uint8_t, 32> Digest;
+
+    static Digest Of(const void* data, size_t len) {
+        Sha256 h;
+        h.Update((const uint8_t*)data, len);
+        return h.Final();
+    }
+
+    void Update(const uint8_t* p, size_t len) {
+        m_total += len;
+        while (len > 0) {
+            size_t n = std::min(len, (size_t)64 - m_fill);
+            memcpy(m_block + m_fill, p, n);
+            m_fill += n; p += n; len -= n;
+            if (m_fill == 64) { Compress(m_block); m_fill = 0; }
+        }
+    }
+
+    Digest Final() {
+        uint64_t bits = m_total * 8;
+        uint8_t pad = 0x80;
+        Update(&pad, 1);
+        uint8_t zero = 0;
+        while (m_fill != 56) Update(&zero, 1);
+        uint8_t len[8];
+        for (int i = 0; i < 8; i++) len[i] = (uint8_t)(bits >> (56 - 8 * i));
+        Update(len, 8);
+        Digest out;
+        for (int i = 0; i < 8; i++) for (int j = 0; j < 4; j++) out[i * 4 + j] = (uint8_t)(m_h[i] >> (24 - 8 * j));
+        return out;
+    }
+
+private:
+    static uint32_t Rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    void Compress(const uint8_t* b) {
+        static const uint32_t K[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+        };
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++) w[i] = (uint32_t)b[i * 4] << 24 | (uint32_t)b[i * 4 + 1] << 16 | (uint32_t)b[i * 4 + 2] << 8 | b[i * 4 + 3];
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = m_h[0], bb = m_h[1], c = m_h[2], d = m_h[3], e = m_h[4], f = m_h[5], g = m_h[6], h = m_h[7];
+        for (int i = 0; i < 64; i++) {
+            uint32_t t1 = h + (Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+            uint32_t t2 = (Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22)) + ((a & bb) ^ (a & c) ^ (bb & c));
+            h = g; g = f; f = e; e = d + t1; d = c; c = bb; bb = a; a = t1 + t2;
+        }
+        m_h[0] += a; m_h[1] += bb; m_h[2] += c; m_h[3] += d; m_h[4] += e; m_h[5] += f; m_h[6] += g; m_h[7] += h;
+    }
+
+    uint32_t m_h[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    uint8_t m_block[64];
+    size_t m_fill = 0;
+    uint64_t m_total = 0;
+};
+
+struct DigestHash {
+    size_t operator()(const Sha256::Digest& d) const { size_t h; memcpy(&h, d.data(), sizeof(h)); return h; }
+};
+
+// 내용 정의 청크 경계 (FastCDC 방식 Gear 해시)
+// -> 경계가 내용으로 정해지므로 앞쪽에 글자를 끼워 넣어도 그 뒤 경계는 다시 같은 자리에서 잡힘 (고정 크기 분할은 전부 밀림).
+// -> 평균 크기 전에는 엄격한 마스크, 이후에는 느슨한 마스크 -> 청크 크기가 평균 근처로 모임.
+// ends: 각 청크의 끝 위치 (마지막 값 = len)
+void ChunkBoundaries(const char* data, size_t len, std::vector<size_t>& ends);
+
+// [PRD 5.9] 보존할 버전 선택 (times: 오래된 -> 최신 순, ms). 반환: 같은 순서의 유지 여부.
+std::vector<bool> SelectRetainedVersions(const std::vector<int64_t>& times, int64_t nowMs);
+
+struct MemoVersionInfo {
+    int64_t timeMs;
+    uint64_t size;
+};
+
+// [PRD 5.9] 버전 저장소 (chunks.pack + versions.log). 모든 메서드는 스레드 안전 (Writer 스레드와 명령줄 복원이 함께 씀)
+class MemoHistoryStore {
+public:
+    using ClockFn = std::function<int64_t()>; // ms (기본: 시스템 시각)
+    using LogFn = std::function<void(const std::wstring&)>;
+
+    ~MemoHistoryStore() { Close(); }
+
+    // 테스트/벤치가 시각을 정함 (Open 전에 설정)
+    void SetClock(ClockFn clock) { m_clock = std::move(clock); }
+    void SetLog(LogFn log) { m_log = std::move(log); }
+
+    bool Open(const std::filesystem::path& dir);
+    void Close();
+
+    // Writer 스레드: 저장 성공 직후 호출 (bytes = 방금 기록한 UTF-8)
+    void OnSaved(const std::wstring& folderPath, const std::shared_ptr<const std::string>& bytes);
+    // 지금 내용을 즉시 버전으로 (복원 직전/직후 등). 마지막 버전과 같으면 아무것도 안 함.
+    bool Snapshot(const std::wstring& folderPath, const std::string& bytes);
+    // 오래된 -> 최신 순 (대기본 제외)
+    std::vector<MemoVersionInfo> List(const std::wstring& folderPath);
+    // index: List() 순서. 청크 해시가 맞지 않으면 false (손상된 pack)
+    bool Read(const std::wstring& folderPath, size_t index, std::string& bytes);
+
+    // 이번 실행에서 남긴 버전 수 / 그 내용 합계 / 그중 새로 쌓인 청크 바이트 (중복 제거율 = logical / stored)
+    unsigned long long Committed() { std::lock_guard<std::mutex> lock(m_mutex); return m_committed; }
+    unsigned long long LogicalBytes() { std::lock_guard<std::mutex> lock(m_mutex); return m_logicalBytes; }
+    unsigned long long StoredBytes() { std::lock_guard<std::mutex> lock(m_mutex); return m_storedBytes; }
+    uint64_t PackBytes() { std::lock_guard<std::mutex> lock(m_mutex); return m_packSize; }
+
+private:
+    struct Version {
+        int64_t timeMs = 0;
+        uint64_t size = 0;
+        std::vector<Sha256::Digest> chunks;
+    };
+    struct Folder {
+        std::wstring path; // 원래 경로 (표시용)
+        std::vector<Version> list;
+    };
+    struct ChunkLoc {
+        uint64_t offset; // 내용 시작
+        uint32_t len;
+    };
+    struct Pending {
+        std::wstring path;
+        std::shared_ptr<const std::string> bytes; // [PRD 5.11] Writer의 저장 사본 공유 (저장마다 복사 없음)
+        int64_t timeMs;
+    };
+    static constexpr uint32_t PACK_MAGIC = 0x50484D46;  // "FMHP"
+    static constexpr uint32_t CHUNK_MAGIC = 0x43484D46; // "FMHC"
+    static constexpr uint32_t LOG_MAGIC = 0x56484D46;   // "FMHV"
+    static constexpr uint32_t VER_MAGIC = 0x52564D46;   // "FMVR"
+    static constexpr uint64_t FILE_HEADER_SIZE = 8;
+    static constexpr uint64_t CHUNK_HEADER_SIZE = 8 + 32;
+
+    int64_t NowMs() const;
+    void Log(const std::wstring& line) { if (m_log) m_log(line); }
+    static std::string FileHeader(uint32_t magic);
+    static bool OpenAppend(std::fstream& f, const std::filesystem::path& p, uint32_t magic, uint64_t& size);
+    static void TruncateTo(std::fstream& f, const std::filesystem::path& p, uint64_t size);
+    bool OpenPackLocked();
+    bool LoadVersionsLocked();
+    static std::string EncodeVersion(const std::wstring& path, const Version& v);
+    static bool DecodeVersion(const char* body, size_t len, std::wstring& path, Version& v);
+    bool ReadChunkLocked(const Sha256::Digest& d, std::string& out);
+    bool CommitLocked(const std::wstring& folderPath, const std::string& bytes, int64_t timeMs);
+    void MaintainLocked();
+    void RewriteLogLocked();
+    void RewritePackLocked(const std::unordered_set<Sha256::Digest, DigestHash>& live);
+
+    std::mutex m_mutex;
+    ClockFn m_clock;
+    LogFn m_log;
+    bool m_open = false;
+    std::filesystem::path m_packPath;
+    std::filesystem::path m_logPath;
+    std::fstream m_pack;
+    std::fstream m_logFile;
+    uint64_t m_packSize = 0;
+    uint64_t m_logSize = 0;
+    std::unordered_map<Sha256::Digest, ChunkLoc, DigestHash> m_chunks;
+    std::unordered_map<std::wstring, Folder> m_versions; // 정규화 경로 -> 버전 (오래된 -> 최신)
+    std::unordered_map<std::wstring, Pending> m_pending;  // 정규화 경로 -> 아직 버전으로 남기지 않은 마지막 저장
+    std::vector<size_t> m_ends; // 재사용 버퍼
+    unsigned long long m_committed = 0;
+    unsigned long long m_logicalBytes = 0;
+    unsigned long long m_storedBytes = 0;
+};
\ No newline at end of file
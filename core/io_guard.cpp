@@ -0,0 +1,42 @@
+#include "core/io_guard.h"
+
+#include <cwctype>
+
+std::wstring VolumeKeyOf(const std::wstring& path) {
+    std::wstring p;
+    if (path.compare(0, 8, L"\\\\?\\UNC\\") == 0) p = L"\\\\" + path.substr(8);
+    else if (path.compare(0, 4, L"\\\\?\\") == 0) p = path.substr(4);
+    else p = path;
+    for (wchar_t& c : p) c = c == L'/' ? L'\\' : (wchar_t)towlower(c);
+    if (p.size() > 2 && p[0] == L'\\' && p[1] == L'\\') {
+        size_t server = p.find(L'\\', 2);
+        if (server == std::wstring::npos) return p;
+        size_t share = p.find(L'\\', server + 1);
+        return share == std::wstring::npos ? p : p.substr(0, share);
+    }
+    if (p.size() >= 2 && p[1] == L':') return p.substr(0, 2);
+    return std::wstring();
+}
+
+bool GuardIo(VolumeHealth& health, DeadlineIoPool& pool, IIoPlatform* platform, const std::wstring& folderPath,
+             std::function<bool()> op, std::function<void()> finished) {
+    std::wstring volume = VolumeKeyOf(folderPath);
+    VolumeHealth::Admission a = health.Admit(volume, IoNowMs());
+    if (!a.run) {
+        if (finished) finished();
+        return false;
+    }
+    VolumeHealth* h = &health;
+    double latencyMs = 0;
+    IoOutcome outcome = pool.Run([op, platform] {
+        if (platform) platform->ResetError();
+        if (op()) return IoOutcome::Ok;
+        return platform && platform->LastErrorUnreachable() ? IoOutcome::Unreachable : IoOutcome::Failed;
+    }, a.deadlineMs, latencyMs, [h, volume, finished](IoOutcome late, double lateMs) {
+        h->ReportLate(volume, late, lateMs);
+        if (finished) finished();
+    });
+    health.Report(volume, a, outcome, latencyMs, IoNowMs());
+    if (outcome != IoOutcome::TimedOut && finished) finished();
+    return outcome == IoOutcome::Ok;
+}
\ No newline at end of file
@@ -0,0 +1,376 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cwchar>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/trace.h"
+
+// --- [볼륨별 I/O 보호] ---
+// [PRD 5.10] 느리거나 끊긴 볼륨에서 메모 I/O가 스레드를 붙잡지 않도록 (Deadline + Circuit Breaker)
+// -> 끊긴 네트워크 드라이브/잠든 NAS에서는 존재 확인(stat)과 CreateFileW가 수십 초씩 멈춤.
+//    그동안 경로 탐색 워커가 묶이고, 편집창 채우기/닫을 때 저장(Flush)은 UI 스레드가 그대로 멈춤.
+// -> 저장소 호출은 I/O 워커에서 실행하고 호출자는 마감까지만 기다림. 넘기면 '시간 초과'로 돌아오고
+//    워커의 동기 I/O는 취소를 시도 (CancelSynchronousIo. 안 되면 끝날 때까지 그 워커 하나만 묶임).
+// -> 볼륨(드라이브 문자 또는 \\서버\공유)마다 응답 지연 EWMA로 빠름/느림을 나누고 분류별 마감 적용.
+//    시간 초과 1회 또는 연결 오류 IO_BREAKER_FAILURES회 연속이면 차단기가 열림(사용 불가) -> 그 볼륨 호출은 디스크에 가지 않고 즉시 실패.
+//    대기 시간이 지나면 호출 하나만 시험으로 통과 -> 응답하면 닫히고, 아니면 대기 시간 두 배 (최대 IO_BREAKER_MAX_MS).
+//    마감을 넘긴 작업이 나중에라도 끝나면 (잠든 디스크가 깨어남) 그 지연을 반영하고 차단기를 닫음.
+// -> 실패한 저장은 버리지 않고 저장 큐가 재시험 시각에 다시 시도 (그 사이 입력은 최신 내용 하나로 병합).
+//    마감을 넘긴 기록이 아직 진행 중인 폴더는 그 기록이 끝날 때까지 새 기록을 미룸 -> 늦게 끝난 옛 내용이 새 내용을 덮는 역전 방지.
+// -> 정책(VolumeHealth)과 워커(DeadlineIoPool)는 OS 의존 없음 (시각은 호출자가 넘기고, 취소/오류 분류는 IIoPlatform으로 주입).
+//    Win32 앱은 main.cpp의 Win32IoPlatform + GuardedStorage(IMemoStorage 감싸기), 테스트는 결함 주입 가짜 파일 시스템.
+const int IO_DEADLINE_FIRST_MS = 4000; // 아직 잰 적 없는 볼륨 (잠든 디스크가 깨어나는 시간 일부 허용)
+const int IO_DEADLINE_FAST_MS = 1500;
+const int IO_DEADLINE_SLOW_MS = 6000;
+const double IO_SLOW_LATENCY_MS = 150.0;  // 응답 지연 EWMA가 이보다 크면 느린 볼륨
+const double IO_LATENCY_ALPHA = 0.2;
+const int IO_BREAKER_FAILURES = 2;        // 연속 연결 오류 (시간 초과는 1회로 열림)
+const int IO_BREAKER_FIRST_MS = 2000;
+const int IO_BREAKER_MAX_MS = 60000;
+const int IO_MAX_ABANDONED_PER_VOLUME = 2; // 마감을 넘겨 아직 도는 작업이 이만큼이면 새 호출 거절 (워커 고갈 방지)
+const size_t IO_MAX_WORKERS = 16;
+const int IO_RETRY_MIN_MS = 500;
+
+enum class IoOutcome { Ok, Failed, Unreachable, TimedOut, Rejected };
+enum class VolumeClass { Unknown, Fast, Slow, Unavailable };
+
+inline const wchar_t* VolumeClassName(VolumeClass c) {
+    switch (c) {
+    case VolumeClass::Fast: return L"fast";
+    case VolumeClass::Slow: return L"slow";
+    case VolumeClass::Unavailable: return L"unavailable";
+    default: return L"unknown";
+    }
+}
+
+// 볼륨 키: \\server\share\... (\\?\UNC\ 포함) -> "\\server\share", X:\... -> "x:". 그 밖의 경로는 한 묶음("")
+std::wstring VolumeKeyOf(const std::wstring& path);
+
+inline int64_t IoNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 볼륨별 지연 분류 + 차단기. 모든 메서드는 여러 스레드에서 호출 가능
+class VolumeHealth {
+public:
+    struct Admission {
+        bool run = false;   // false -> 디스크에 가지 말고 즉시 실패
+        bool probe = false; // 열린 차단기의 시험 호출
+        int deadlineMs = 0;
+    };
+
+    struct Stats {
+        std::wstring volume;
+        VolumeClass cls;
+        double latencyMs;
+        unsigned long long ops, timeouts, rejected, trips;
+    };
+
+    Admission Admit(const std::wstring& volume, int64_t nowMs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Volume& v = m_volumes[volume];
+        Admission a;
+        if (v.abandoned >= IO_MAX_ABANDONED_PER_VOLUME || (v.open && (nowMs < v.openUntil || v.probing))) {
+            v.rejected++;
+            return a;
+        }
+        if (v.open) { v.probing = true; a.probe = true; }
+        a.run = true;
+        a.deadlineMs = v.samples == 0 ? IO_DEADLINE_FIRST_MS : v.latencyMs < IO_SLOW_LATENCY_MS ? IO_DEADLINE_FAST_MS : IO_DEADLINE_SLOW_MS;
+        v.ops++;
+        return a;
+    }
+
+    // 호출자가 받은 결과. TimedOut이면 작업은 워커에서 계속 -> 끝나면 ReportLate
+    void Report(const std::wstring& volume, const Admission& a, IoOutcome outcome, double latencyMs, int64_t nowMs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Volume& v = m_volumes[volume];
+        if (a.probe) v.probing = false;
+        switch (outcome) {
+        case IoOutcome::Ok:
+        case IoOutcome::Failed: // 없음/권한 등 -> 볼륨은 응답함
+            Sample(v, latencyMs);
+            v.failures = 0;
+            if (v.open) CloseLocked(volume, v);
+            break;
+        case IoOutcome::Unreachable:
+            if (++v.failures >= IO_BREAKER_FAILURES || v.open) TripLocked(volume, v, nowMs, L"unreachable");
+            break;
+        case IoOutcome::TimedOut:
+            Sample(v, latencyMs);
+            v.abandoned++;
+            v.timeouts++;
+            v.failures++;
+            TripLocked(volume, v, nowMs, L"timeout");
+            break;
+        case IoOutcome::Rejected:
+            break;
+        }
+    }
+
+    // 마감을 넘겼던 작업이 끝남 (Rejected = 시작 전에 버려짐)
+    void ReportLate(const std::wstring& volume, IoOutcome outcome, double latencyMs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Volume& v = m_volumes[volume];
+        v.abandoned--; // Report(TimedOut)보다 먼저 올 수 있음 -> 잠시 음수였다가 맞춰짐
+        if (outcome != IoOutcome::Ok && outcome != IoOutcome::Failed) return;
+        Sample(v, latencyMs);
+        v.failures = 0;
+        if (v.open && !v.probing) CloseLocked(volume, v);
+    }
+
+    VolumeClass ClassOf(const std::wstring& volume) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_volumes.find(volume);
+        return it == m_volumes.end() ? VolumeClass::Unknown : ClassLocked(it->second);
+    }
+
+    // 실패한 저장을 다시 시도할 때까지 (ms). 볼륨이 멀쩡하면 -1 (권한 오류 등은 다시 해도 같음)
+    int RetryDelayMs(const std::wstring& volume, int64_t nowMs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_volumes.find(volume);
+        if (it == m_volumes.end()) return -1;
+        const Volume& v = it->second;
+        if (v.open) return (int)std::max<int64_t>(0, v.openUntil - nowMs);
+        return v.failures > 0 || v.abandoned > 0 ? 0 : -1;
+    }
+
+    // 차단기 열림/닫힘 기록 (Win32 앱: 디버그 출력). 시작 전에 한 번만 설정
+    void SetLog(std::function<void(const std::wstring&)> log) { m_log = std::move(log); }
+
+    std::vector<Stats> Snapshot() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<Stats> out;
+        for (const auto& kv : m_volumes) {
+            const Volume& v = kv.second;
+            out.push_back(Stats{ kv.first, ClassLocked(v), v.latencyMs, v.ops, v.timeouts, v.rejected, v.trips });
+        }
+        return out;
+    }
+
+private:
+    struct Volume {
+        double latencyMs = 0;
+        unsigned long long samples = 0;
+        int failures = 0;  // 연속 연결 오류/시간 초과
+        int abandoned = 0; // 마감을 넘겨 아직 끝나지 않은 작업
+        bool open = false;
+        bool probing = false;
+        int64_t openUntil = 0;
+        int cooldownMs = IO_BREAKER_FIRST_MS;
+        unsigned long long ops = 0, timeouts = 0, rejected = 0, trips = 0;
+    };
+
+    static VolumeClass ClassLocked(const Volume& v) {
+        if (v.open) return VolumeClass::Unavailable;
+        if (v.samples == 0) return VolumeClass::Unknown;
+        return v.latencyMs < IO_SLOW_LATENCY_MS ? VolumeClass::Fast : VolumeClass::Slow;
+    }
+
+    static void Sample(Volume& v, double ms) {
+        v.latencyMs = v.samples++ == 0 ? ms : v.latencyMs + IO_LATENCY_ALPHA * (ms - v.latencyMs);
+    }
+
+    void TripLocked(const std::wstring& volume, Volume& v, int64_t nowMs, const wchar_t* why) {
+        if (v.open) {
+            v.cooldownMs = std::min(v.cooldownMs * 2, IO_BREAKER_MAX_MS); // 시험 실패 -> 더 오래 쉼
+        } else {
+            v.open = true;
+            v.cooldownMs = IO_BREAKER_FIRST_MS;
+            v.trips++;
+        }
+        v.openUntil = nowMs + v.cooldownMs;
+        wchar_t buf[200];
+        swprintf(buf, 200, L"[FolderMemo] io: %ls unavailable (%ls), retry in %d ms\n", volume.c_str(), why, v.cooldownMs);
+        if (m_log) m_log(buf);
+    }
+
+    void CloseLocked(const std::wstring& volume, Volume& v) {
+        v.open = false;
+        v.cooldownMs = IO_BREAKER_FIRST_MS;
+        wchar_t buf[200];
+        swprintf(buf, 200, L"[FolderMemo] io: %ls available again (%.0f ms)\n", volume.c_str(), v.latencyMs);
+        if (m_log) m_log(buf);
+    }
+
+    std::mutex m_mutex;
+    std::unordered_map<std::wstring, Volume> m_volumes;
+    std::function<void(const std::wstring&)> m_log;
+};
+
+// 워커 취소/오류 분류 (OS 의존 부분)
+class IIoPlatform {
+public:
+    virtual ~IIoPlatform() {}
+    virtual void* EnterWorker() = 0;             // 워커 시작 시 1회 -> Cancel에 넘길 값
+    virtual void LeaveWorker(void* worker) = 0;  // 워커가 끝날 때 1회 (EnterWorker가 연 것 해제)
+    virtual void CancelWorker(void* worker) = 0; // 워커가 지금 기다리는 동기 I/O 취소 시도
+    virtual void ResetError() = 0;               // 호출 직전 (이전 호출의 오류가 남지 않게)
+    virtual bool LastErrorUnreachable() = 0;     // 방금 실패한 호출이 연결 문제인지 (없음/권한과 구분)
+};
+
+// 마감 있는 I/O 워커. 모든 워커가 바쁘면 IO_MAX_WORKERS까지 늘림 (묶인 워커는 끝날 때까지 돌아오지 않으므로)
+// -> 워커는 분리(detach)되어 공유 상태만 붙잡음 -> 끝나지 않는 I/O가 있어도 종료를 막지 않음
+// -> Stop 뒤에는 줄 선 작업을 버리고(기다리던 Run은 즉시 Rejected) 쉬는 워커는 끝남. 늦게 끝난 작업은 late를 부르지 않음
+//    (late가 가리키는 볼륨 정책/저장소는 종료 중 정리될 수 있음). Stop은 이미 돌고 있는 late가 끝날 때까지만 기다림.
+class DeadlineIoPool {
+public:
+    using Task = std::function<IoOutcome()>;
+    using LateFn = std::function<void(IoOutcome outcome, double latencyMs)>;
+
+    explicit DeadlineIoPool(IIoPlatform* platform) : m_shared(std::make_shared<Shared>()) { m_shared->platform = platform; }
+    ~DeadlineIoPool() { Stop(); }
+
+    // 마감까지 기다림. 넘기면 TimedOut을 돌려주고 작업은 계속 -> 끝나면(또는 시작 전에 버려지면) late 호출
+    IoOutcome Run(Task task, int deadlineMs, double& latencyMs, LateFn late) {
+        auto job = std::make_shared<Job>();
+        job->task = std::move(task);
+        job->late = std::move(late);
+        latencyMs = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_shared->mutex);
+            if (m_shared->stopping) return IoOutcome::Rejected;
+            m_shared->jobs.push_back(job);
+            if (m_shared->idle == 0 && m_shared->workers < IO_MAX_WORKERS) {
+                m_shared->workers++;
+                std::thread(&DeadlineIoPool::WorkerLoop, m_shared).detach();
+            }
+        }
+        m_shared->cv.notify_one();
+
+        std::unique_lock<std::mutex> lock(job->mutex);
+        if (job->cv.wait_for(lock, std::chrono::milliseconds(deadlineMs), [&] { return job->done; })) {
+            latencyMs = job->latencyMs;
+            return job->outcome;
+        }
+        job->abandoned = true;
+        if (job->worker && m_shared->platform) m_shared->platform->CancelWorker(job->worker); // 완료 표시는 이 락 안에서만 -> 다음 작업을 취소할 일 없음
+        latencyMs = deadlineMs;
+        return IoOutcome::TimedOut;
+    }
+
+    void Stop() {
+        std::deque<std::shared_ptr<Job>> dropped;
+        {
+            std::unique_lock<std::mutex> lock(m_shared->mutex);
+            m_shared->stopping = true;
+            dropped.swap(m_shared->jobs);
+            m_shared->cv.notify_all();
+            m_shared->lateCv.wait(lock, [&] { return m_shared->lateRunning == 0; });
+        }
+        for (auto& job : dropped) {
+            {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                job->done = true;
+                job->outcome = IoOutcome::Rejected;
+            }
+            job->cv.notify_all();
+        }
+    }
+
+    size_t Workers() { std::lock_guard<std::mutex> lock(m_shared->mutex); return m_shared->workers; }
+
+private:
+    struct Job {
+        Task task;
+        LateFn late;
+        std::mutex mutex;
+        std::condition_variable cv;
+        void* worker = nullptr; // 실행 중인 워커 (취소 대상)
+        bool done = false;
+        bool abandoned = false;
+        IoOutcome outcome = IoOutcome::Failed;
+        double latencyMs = 0;
+    };
+
+    struct Shared {
+        IIoPlatform* platform = nullptr;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::condition_variable lateCv; // lateRunning이 0이 됨 -> Stop
+        std::deque<std::shared_ptr<Job>> jobs;
+        size_t workers = 0;
+        size_t idle = 0;
+        size_t lateRunning = 0;
+        bool stopping = false;
+    };
+
+    // 종료 전일 때만 late 호출. 확인과 진행 표시를 한 락 안에서 -> Stop이 돌려준 뒤에는 호출되지 않음
+    static void CallLate(Shared& shared, const LateFn& late, IoOutcome outcome, double ms) {
+        if (!late) return;
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            if (shared.stopping) return;
+            shared.lateRunning++;
+        }
+        late(outcome, ms);
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        if (--shared.lateRunning == 0) shared.lateCv.notify_all();
+    }
+
+    static void WorkerLoop(std::shared_ptr<Shared> shared) {
+        FM_TRACE_THREAD("io-worker"); // [PRD 7.1]
+        void* self = shared->platform ? shared->platform->EnterWorker() : nullptr;
+        for (;;) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(shared->mutex);
+                shared->idle++;
+                shared->cv.wait(lock, [&] { return !shared->jobs.empty() || shared->stopping; });
+                shared->idle--;
+                if (shared->stopping) break;
+                job = std::move(shared->jobs.front());
+                shared->jobs.pop_front();
+            }
+            LateFn late;
+            bool skipped = false;
+            {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                if (job->abandoned) { // 줄 서는 동안 마감이 지남 -> 실행하지 않음
+                    late = std::move(job->late);
+                    job->done = skipped = true;
+                } else {
+                    job->worker = self;
+                }
+            }
+            if (skipped) {
+                CallLate(*shared, late, IoOutcome::Rejected, 0);
+                continue;
+            }
+            auto start = std::chrono::steady_clock::now();
+            IoOutcome outcome = job->task();
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                job->worker = nullptr;
+                job->done = true;
+                job->outcome = outcome;
+                job->latencyMs = ms;
+                if (job->abandoned) late = std::move(job->late);
+            }
+            job->cv.notify_all();
+            CallLate(*shared, late, outcome, ms);
+        }
+        // 이 워커를 가리키는 작업은 없음 (job->worker는 완료 때 비움) -> 취소용 핸들 해제
+        if (shared->platform) shared->platform->LeaveWorker(self);
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->workers--;
+    }
+
+    std::shared_ptr<Shared> m_shared;
+};
+
+// [PRD 5.10] 볼륨 정책을 거쳐 op를 마감 있는 워커에서 실행 (성공이면 true)
+// -> finished: 작업이 실제로 끝난 뒤 (또는 실행되지 않음이 확정된 뒤) 정확히 한 번. 종료(Stop) 뒤 늦게 끝난 작업은 부르지 않음
+bool GuardIo(VolumeHealth& health, DeadlineIoPool& pool, IIoPlatform* platform, const std::wstring& folderPath,
+             std::function<bool()> op, std::function<void()> finished = nullptr);
\ No newline at end of file
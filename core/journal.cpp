@@ -0,0 +1,206 @@
+#include "core/journal.h"
+
+#include <cstring>
+#include <fstream>
+
+#include "core/crc32.h"
+#include "core/file_io.h"
+
+namespace fs = std::filesystem;
+
+std::string ReplayJournal(const std::string& base, const std::string& journal, uint64_t& validLen) {
+    validLen = 0;
+    if (journal.size() < JOURNAL_HEADER_SIZE) return base;
+    uint32_t magic, baseCrc; uint64_t baseSize;
+    memcpy(&magic, journal.data(), 4);
+    memcpy(&baseSize, journal.data() + 4, 8);
+    memcpy(&baseCrc, journal.data() + 12, 4);
+    if (magic != JOURNAL_MAGIC || baseSize != base.size() || baseCrc != Crc32(base.data(), base.size())) return base;
+
+    std::string content = base;
+    size_t pos = JOURNAL_HEADER_SIZE;
+    validLen = pos;
+    while (pos + JOURNAL_RECORD_HEADER_SIZE <= journal.size()) {
+        uint32_t hdr[5];
+        memcpy(hdr, journal.data() + pos, sizeof(hdr));
+        uint32_t offset = hdr[1], removeLen = hdr[2], insertLen = hdr[3], crc = hdr[4];
+        if (hdr[0] != JOURNAL_RECORD_MAGIC) break;
+        if (pos + JOURNAL_RECORD_HEADER_SIZE + insertLen > journal.size()) break; // 잘린 레코드
+        const char* insert = journal.data() + pos + JOURNAL_RECORD_HEADER_SIZE;
+        uint32_t actual = Crc32(hdr, 16);
+        actual = Crc32(insert, insertLen, actual);
+        if (actual != crc) break;
+        if ((uint64_t)offset + removeLen > content.size()) break;
+        content.replace(offset, removeLen, insert, insertLen);
+        pos += JOURNAL_RECORD_HEADER_SIZE + insertLen;
+        validLen = pos;
+    }
+    return content;
+}
+
+void MemoJournalStore::Start() {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    if (m_thread.joinable()) return;
+    m_stop = false;
+    m_thread = std::thread(&MemoJournalStore::CompactorLoop, this);
+}
+
+void MemoJournalStore::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        if (!m_thread.joinable()) return;
+        m_stop = true;
+    }
+    m_queueCv.notify_one();
+    m_thread.join();
+    std::vector<std::wstring> paths;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& kv : m_states) paths.push_back(kv.first);
+    }
+    for (const auto& path : paths) Compact(path);
+}
+
+std::string MemoJournalStore::Load(const std::wstring& folderPath) {
+    DiskView disk = ProbeDisk(folderPath); // 락 밖에서 stat + 헤더 읽기
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_states.find(folderPath);
+        if (it != m_states.end()) {
+            if (it->second.disk == disk) return it->second.content;
+            m_states.erase(it); // 디스크가 바뀜 -> 캐시 폐기 (기록된 레코드는 이미 디스크에 있으므로 잃는 것 없음)
+        }
+    }
+    std::string base, journal;
+    bool hasJournal = ReadWholeFile(JournalPath(folderPath), journal);
+    ReadWholeFile(BasePath(folderPath), base);
+    if (!hasJournal) return base;
+    uint64_t validLen = 0;
+    return ReplayJournal(base, journal, validLen);
+}
+
+bool MemoJournalStore::Save(const std::wstring& folderPath, const std::string& bytes) {
+    bool needCompact = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        State& st = GetState(folderPath);
+        const std::string& old = st.content;
+        size_t prefix = 0;
+        size_t maxPrefix = old.size() < bytes.size() ? old.size() : bytes.size();
+        while (prefix < maxPrefix && old[prefix] == bytes[prefix]) prefix++;
+        size_t suffix = 0;
+        while (suffix < maxPrefix - prefix && old[old.size() - 1 - suffix] == bytes[bytes.size() - 1 - suffix]) suffix++;
+        if (prefix == old.size() && prefix == bytes.size()) return true; // 변경 없음
+
+        uint32_t hdr[5];
+        hdr[0] = JOURNAL_RECORD_MAGIC;
+        hdr[1] = (uint32_t)prefix;
+        hdr[2] = (uint32_t)(old.size() - prefix - suffix);
+        hdr[3] = (uint32_t)(bytes.size() - prefix - suffix);
+        hdr[4] = Crc32(bytes.data() + prefix, hdr[3], Crc32(hdr, 16));
+
+        std::string record;
+        if (st.journalBytes == 0) {
+            // 새 저널: 현재 내용(= 기준 파일)을 헤더에 기록
+            uint32_t magic = JOURNAL_MAGIC, baseCrc = Crc32(old.data(), old.size());
+            uint64_t baseSize = old.size();
+            record.append((const char*)&magic, 4);
+            record.append((const char*)&baseSize, 8);
+            record.append((const char*)&baseCrc, 4);
+        }
+        record.append((const char*)hdr, sizeof(hdr));
+        record.append(bytes.data() + prefix, hdr[3]);
+
+        if (!AppendFileAt(JournalPath(folderPath), st.journalBytes, record)) {
+            m_states.erase(folderPath); // 일부만 기록됐을 수 있음 -> 다음에 디스크에서 다시 재생
+            return false;
+        }
+        if (st.journalBytes == 0) st.firstRecord = Clock::now();
+        st.journalBytes += record.size();
+        st.content = bytes;
+        st.disk = ProbeDisk(folderPath);
+        needCompact = st.journalBytes >= COMPACT_BYTES ||
+            Clock::now() - st.firstRecord >= std::chrono::seconds(COMPACT_AGE_SEC);
+    }
+    if (needCompact) RequestCompact(folderPath);
+    return true;
+}
+
+void MemoJournalStore::RequestCompact(const std::wstring& folderPath) {
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_compactQueue.push_back(folderPath);
+    }
+    m_queueCv.notify_one();
+}
+
+void MemoJournalStore::Compact(const std::wstring& folderPath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // 저널이 없으면 접을 것 없음 (이미 접혔거나, 메모가 작아져 전체 기록으로 바뀌며 지워짐) -> 캐시만 버림
+    if (!StampOf(JournalPath(folderPath)).exists) { m_states.erase(folderPath); return; }
+    // 캐시된 상태는 디스크와 맞을 때만 (GetState가 검증) -> 다른 경로로 바뀐 기준 파일을 옛 내용으로 덮어쓰지 않음
+    State& st = GetState(folderPath);
+    if (st.journalBytes == 0) { m_states.erase(folderPath); return; }
+    if (!WriteFileAtomic(BasePath(folderPath), st.content)) return; // 실패 시 저널 유지 -> 다음 기회에 재시도
+    std::error_code ec;
+    fs::remove(JournalPath(folderPath), ec);
+    m_states.erase(folderPath);
+}
+
+MemoJournalStore::FileStamp MemoJournalStore::StampOf(const fs::path& p) {
+    FileStamp st;
+    std::error_code ec;
+    auto t = fs::last_write_time(p, ec);
+    if (ec) return st;
+    st.size = (uint64_t)fs::file_size(p, ec);
+    st.mtime = (int64_t)t.time_since_epoch().count();
+    st.exists = !ec;
+    return st;
+}
+
+MemoJournalStore::DiskView MemoJournalStore::ProbeDisk(const std::wstring& folderPath) {
+    DiskView v;
+    v.base = StampOf(BasePath(folderPath));
+    v.journal = StampOf(JournalPath(folderPath));
+    if (v.journal.exists) {
+        std::ifstream in(JournalPath(folderPath), std::ios::binary);
+        char hdr[JOURNAL_HEADER_SIZE];
+        in.read(hdr, sizeof(hdr));
+        v.header.assign(hdr, (size_t)in.gcount());
+    }
+    return v;
+}
+
+MemoJournalStore::State& MemoJournalStore::GetState(const std::wstring& folderPath) {
+    DiskView disk = ProbeDisk(folderPath);
+    auto it = m_states.find(folderPath);
+    if (it != m_states.end()) {
+        if (it->second.disk == disk) return it->second;
+        m_states.erase(it);
+    }
+    State st;
+    st.disk = disk;
+    std::string base, journal;
+    ReadWholeFile(BasePath(folderPath), base);
+    if (ReadWholeFile(JournalPath(folderPath), journal)) {
+        st.content = ReplayJournal(base, journal, st.journalBytes);
+    } else {
+        st.content = base;
+    }
+    st.firstRecord = Clock::now();
+    return m_states.emplace(folderPath, std::move(st)).first->second;
+}
+
+void MemoJournalStore::CompactorLoop() {
+    for (;;) {
+        std::wstring path;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCv.wait(lock, [this] { return m_stop || !m_compactQueue.empty(); });
+            if (m_stop) return;
+            path = std::move(m_compactQueue.front());
+            m_compactQueue.erase(m_compactQueue.begin());
+        }
+        Compact(path);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+// --- [저널 저장 모드] ---
+// [PRD 5.4] 추가 전용 편집 저널 (Append-Only Journal)
+// -> 저장 비용이 '메모 크기'가 아닌 '편집 크기'에 비례하도록, 변경 구간만 folder_memo.journal에 범위 치환 레코드로 덧붙임.
+// -> 파일 포맷: [헤더: 'FMJ1' | 기준 파일 크기(u64) | 기준 파일 CRC(u32)] + [레코드: 'FMJR' | offset | removeLen | insertLen | CRC | 삽입 바이트]...
+// -> 복구: 헤더가 현재 folder_memo.txt와 다르면(압축 완료 후 저널 삭제 전 크래시, 외부 도구 수정) 저널은 무시됨 -> 일반 텍스트 파일이 항상 진실.
+// -> 복구: 잘리거나 CRC가 깨진 첫 레코드에서 재생을 멈추고, 다음 기록 때 그 뒤의 쓰레기를 잘라냄.
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+const uint32_t JOURNAL_MAGIC = 0x314A4D46;        // "FMJ1"
+const uint32_t JOURNAL_RECORD_MAGIC = 0x524A4D46; // "FMJR"
+const size_t JOURNAL_HEADER_SIZE = 16;
+const size_t JOURNAL_RECORD_HEADER_SIZE = 20;
+// [PRD 5.4] 저널 모드가 꺼져 있어도 이 크기 이상인 메모는 저널로 저장 (저장마다 수 MB 전체 재기록 대신 바뀐 구간만)
+// -> 오버레이가 닫힐 때/종료 시 접히므로 디스크에는 평소처럼 folder_memo.txt 하나가 남음
+const size_t JOURNAL_AUTO_BYTES = 1024 * 1024;
+
+// 저널을 기준 내용 위에 재생 -> 유효한 마지막 레코드 끝 위치(validLen)를 함께 반환 (0이면 저널 무시)
+std::string ReplayJournal(const std::string& base, const std::string& journal, uint64_t& validLen);
+
+class MemoJournalStore {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr uint64_t COMPACT_BYTES = 64 * 1024; // 저널이 이 크기를 넘으면 압축
+    static constexpr int COMPACT_AGE_SEC = 60;          // 첫 레코드 후 이 시간이 지나면 압축
+
+    ~MemoJournalStore() { Stop(); }
+
+    void Start();
+
+    // 종료 시 남은 저널을 모두 일반 텍스트 파일로 접음
+    void Stop();
+
+    // 기준 파일 + 저널 재생 결과 (LoadMemo에서 사용)
+    // [PRD 6.2] 파일 읽기는 락 밖에서 (병렬 아카이브 순회가 여기서 줄 서지 않도록)
+    // -> 저널을 먼저 읽음: 그 뒤 압축이 끝나 기준 파일이 바뀌었으면 저널 헤더(기준 크기/CRC)가 맞지 않아 새 기준 파일만 사용,
+    //    덧붙이는 중이면 CRC가 맞는 레코드까지만 재생 -> 어느 쪽이든 한 시점의 온전한 내용.
+    // -> 캐시된 상태는 기준 파일 스탬프(크기/수정 시각) + 저널 스탬프/헤더가 기록 당시와 같을 때만 사용.
+    //    외부 도구가 folder_memo.txt를 고쳤거나 다른 프로세스가 저널을 접었으면 캐시를 버리고 디스크에서 다시 재생.
+    std::string Load(const std::wstring& folderPath);
+
+    // Writer 스레드 -> 이전 내용과의 공통 접두/접미를 제외한 구간만 레코드로 추가
+    bool Save(const std::wstring& folderPath, const std::string& bytes);
+
+    // 오버레이 종료 또는 임계값 초과 시 -> 압축 스레드에 위임 (UI/Writer 스레드 비차단)
+    void RequestCompact(const std::wstring& folderPath);
+
+    // 저널을 기준 파일로 접기 -> 원자적 교체 후 저널 삭제 (삭제 전 크래시는 헤더 불일치로 안전)
+    void Compact(const std::wstring& folderPath);
+
+    static std::filesystem::path BasePath(const std::wstring& folderPath) { std::filesystem::path p(folderPath); p /= L"folder_memo.txt"; return p; }
+    static std::filesystem::path JournalPath(const std::wstring& folderPath) { std::filesystem::path p(folderPath); p /= L"folder_memo.journal"; return p; }
+
+private:
+    struct FileStamp {
+        bool exists = false;
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        bool operator==(const FileStamp& o) const { return exists == o.exists && size == o.size && mtime == o.mtime; }
+    };
+
+    // 상태가 만들어진(또는 마지막으로 기록한) 시점의 디스크 모습 -> 캐시 검증용
+    struct DiskView {
+        FileStamp base;
+        FileStamp journal;
+        std::string header; // 저널 앞 JOURNAL_HEADER_SIZE 바이트 (기준 크기/CRC)
+        bool operator==(const DiskView& o) const { return base == o.base && journal == o.journal && header == o.header; }
+    };
+
+    struct State {
+        std::string content;       // 기준 파일 + 저널 재생 결과 (UTF-8)
+        uint64_t journalBytes = 0; // 유효한 저널 길이 (다음 레코드 기록 위치)
+        Clock::time_point firstRecord;
+        DiskView disk;
+    };
+
+    static FileStamp StampOf(const std::filesystem::path& p);
+    static DiskView ProbeDisk(const std::wstring& folderPath);
+
+    // 처음 보는 경로(또는 디스크가 캐시와 달라진 경로)는 디스크에서 재생해 상태 복원 (m_mutex 보유 상태에서 호출)
+    State& GetState(const std::wstring& folderPath);
+
+    void CompactorLoop();
+
+    std::mutex m_mutex; // m_states 및 경로별 디스크 기록 직렬화
+    std::unordered_map<std::wstring, State> m_states;
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCv;
+    std::vector<std::wstring> m_compactQueue;
+    std::thread m_thread;
+    bool m_stop = false;
+};
@@ -0,0 +1,7 @@
+#include "core/memo_buffer.h"
+
+std::shared_ptr<MemoBuffer> MakeMemoBuffer(const std::string& bytes, const std::wstring& text) {
+    auto buffer = std::make_shared<MemoBuffer>();
+    if (!buffer->LoadUtf8(bytes)) buffer->LoadText(text.data(), text.size());
+    return buffer;
+}
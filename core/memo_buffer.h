@@ -0,0 +1,400 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/utf.h"
+
+// --- [메모 편집 버퍼] ---
+// [PRD 5.11] 조각 표(Piece Table) 편집 버퍼 + 증분 UTF-8
+// -> EN_CHANGE마다 전체 내용을 std::wstring으로 복사하고, 저장 때 다시 전체를 UTF-8로 인코딩하던 방식은
+//    키 입력 하나에 문서 크기만큼의 일과 할당 여러 번 (10MB 메모면 입력마다 수십 MB 복사).
+// -> 내용 = 조각 목록. 조각은 '원본'(읽은 UTF-8 그대로, MEMO_PIECE_CHUNK 단위로 나눔) 또는
+//    '추가'(입력된 글자를 그때 한 번 UTF-8로 인코딩해 덧붙인 버퍼)의 구간. 조각마다 UTF-16 길이를 들고 있어 편집창 위치로 바로 찾아감.
+// -> 편집 = 구간 치환 하나. 추가 버퍼 끝에 이어 입력/지우기는 마지막 조각 길이만 바꿈 -> 꾸준한 입력은 할당 없음 (버퍼는 배수로 늘어남).
+// -> 바뀐 구간은 편집창 새 내용과 버퍼를 캐럿 주변 창(MEMO_BUFFER_WINDOW)에서만 비교해 찾음 (IME 조합/붙여넣기/선택 영역 덮어쓰기 공통).
+//    창 가장자리까지 다르면 창 밖에서 바뀐 것일 수 있음 -> 편집창 내용으로 다시 채움 (실행 취소 등, 드묾).
+//    MEMO_BUFFER_VERIFY_EDITS번마다 편집창 전체와 대조 -> 어긋나면 다시 채움 (안전망).
+// -> 저장: 마지막 저장 사본에서 바뀐 바이트 구간(앞/뒤 그대로인 길이로 추적)만 다시 복사 -> 인코딩 없음.
+//    사본은 공유 포인터로 넘김 -> Writer가 기록하는 동안 UI가 계속 편집해도 사본은 그대로.
+// -> 캐럿을 옮겨 가며 오래 고치면 조각/추가 버퍼가 계속 늘어남 -> 사본을 만든 김에 그 사본을 새 원본으로 (Writer 스레드에서, 가끔).
+// -> 편집은 UI 스레드, 사본은 Writer 스레드 (짧게만 잠금). 편집창과 무관한 부분은 OS 의존 없음.
+const size_t MEMO_PIECE_CHUNK = 4096;         // 원본 조각 최대 바이트 (조각 안 위치 찾기 상한)
+const size_t MEMO_BUFFER_WINDOW = 64;         // 캐럿 앞뒤 비교 창 (UTF-16 단위)
+const unsigned MEMO_BUFFER_VERIFY_EDITS = 64;
+const size_t MEMO_PIECE_SLACK = 1024;         // 원본 조각 수의 2배 + 이만큼을 넘으면 정리
+
+class MemoBuffer {
+public:
+    MemoBuffer() {
+        m_add.reserve(4096);
+        m_pieces.reserve(64);
+    }
+
+    // 잘못된 UTF-8이면 false (편집창에는 U+FFFD로 보이므로 호출자가 LoadText로)
+    bool LoadUtf8(const std::string& bytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t units = 0;
+        if (!CountUnits(bytes.data(), bytes.size(), units)) return false;
+        ResetLocked(bytes, units);
+        return true;
+    }
+
+    void LoadText(const wchar_t* text, size_t len) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::string bytes;
+        WideToUtf8(text, len, bytes); // 짝 없는 서로게이트는 U+FFFD (한 단위 -> 길이는 같음)
+        ResetLocked(std::move(bytes), len);
+    }
+
+    // 편집창의 새 전체 내용(text, len)과 변경 후 캐럿 -> 캐럿 주변 창에서 바뀐 구간을 찾아 치환.
+    // 창 밖에서 바뀐 것으로 보이면 false (호출자가 LoadText로 다시 채움)
+    bool ApplyChange(const wchar_t* text, size_t len, size_t caret) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t old = m_len16;
+        if (caret > len) caret = len;
+        size_t grow = len > old ? len - old : 0;
+        size_t lo = caret > MEMO_BUFFER_WINDOW + grow ? caret - MEMO_BUFFER_WINDOW - grow : 0;
+        size_t hiNew = std::min(len, caret + MEMO_BUFFER_WINDOW);
+        size_t hiOld = hiNew + old - len;
+        size_t on = hiOld - lo, nn = hiNew - lo;
+        CopyUnitsLocked(lo, on + (hiOld < old ? 1 : 0), m_window); // 끝 다음 한 단위는 서로게이트 확인용
+        const wchar_t* nw = text + lo;
+        // 같은 글자가 이어지면 위치가 모호 -> 뒤쪽 일치를 캐럿까지만 세어 변경이 캐럿에서 끝나게 (이어 입력이 한 조각에 모임)
+        size_t suffix = 0, suffixMax = std::min(nn, std::min(on, hiNew - caret));
+        while (suffix < suffixMax && nw[nn - 1 - suffix] == m_window[on - 1 - suffix]) suffix++;
+        size_t prefix = 0;
+        while (prefix < nn - suffix && prefix < on - suffix && nw[prefix] == m_window[prefix]) prefix++;
+        if (prefix + suffix == nn && prefix + suffix == on) return len == old; // 창 안은 그대로 -> 길이도 같아야 변경 없음
+        if (lo > 0 && prefix == 0) return false;            // 창 앞에서 시작했을 수 있음
+        if (hiNew < len && suffix == 0) return false;       // 창 뒤까지 이어졌을 수 있음
+        size_t pos = lo + prefix, removeLen = on - prefix - suffix, insertLen = nn - prefix - suffix;
+        if (sizeof(wchar_t) == 2) {
+            // 서로게이트 쌍 가운데서 자르지 않음 -> 같은 단위를 양쪽에 하나씩 넣어 넓힘
+            if (prefix > 0 && prefix < m_window.size() && IsLowSurrogate(m_window[prefix]) && IsHighSurrogate(m_window[prefix - 1])) {
+                pos--; removeLen++; insertLen++; prefix--;
+            }
+            size_t end = prefix + removeLen;
+            if (end > 0 && end < m_window.size() && IsLowSurrogate(m_window[end]) && IsHighSurrogate(m_window[end - 1])) {
+                removeLen++; insertLen++;
+            }
+        }
+        if (!ReplaceLocked(pos, removeLen, text + pos, insertLen)) return false;
+        m_edits++;
+        return true;
+    }
+
+    // 편집창 전체와 대조할 차례인지 (ApplyChange 성공 MEMO_BUFFER_VERIFY_EDITS번마다)
+    bool DueForVerify() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_edits % MEMO_BUFFER_VERIFY_EDITS == 0;
+    }
+
+    bool Equals(const wchar_t* text, size_t len) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (len != m_len16) return false;
+        size_t o = 0;
+        for (const Piece& p : m_pieces) {
+            const unsigned char* s = DataOf(p);
+            for (size_t b = 0; b < p.len8;) {
+                wchar_t u[2];
+                size_t n = 0;
+                b += DecodeUnits(s + b, u, n);
+                for (size_t k = 0; k < n; k++) if (text[o++] != u[k]) return false;
+            }
+        }
+        return o == len;
+    }
+
+    // Writer 스레드: 지금 내용의 UTF-8 사본. 지난 사본에서 바뀐 구간만 다시 복사
+    std::shared_ptr<const std::string> Snapshot() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // 아직 기록 중이거나 캐시/버전 기록이 들고 있는 이전 사본은 건드리지 않음 (바뀐 것이 없으면 그 사본 그대로)
+        if (m_flat && m_dirty && m_flat.use_count() > 1) m_flat = std::make_shared<std::string>(*m_flat);
+        if (!m_flat) {
+            m_flat = std::make_shared<std::string>();
+            m_flat->resize(m_len8);
+            CopyBytesLocked(0, m_len8, m_len8 ? &(*m_flat)[0] : nullptr);
+        } else if (m_dirty) {
+            std::string& f = *m_flat;
+            size_t oldMid = f.size() - m_cleanPrefix - m_cleanSuffix;
+            size_t newMid = m_len8 - m_cleanPrefix - m_cleanSuffix;
+            f.replace(m_cleanPrefix, oldMid, newMid, '\0'); // 뒤쪽은 그대로 밀기만 (capacity 안이면 할당 없음)
+            CopyBytesLocked(m_cleanPrefix, newMid, newMid ? &f[m_cleanPrefix] : nullptr);
+        }
+        m_dirty = false;
+        if (m_pieces.size() > m_len8 / MEMO_PIECE_CHUNK * 2 + MEMO_PIECE_SLACK) {
+            // 사본 = 지금 내용 -> 새 원본으로 (사본과 편집 횟수는 그대로)
+            std::shared_ptr<std::string> flat = m_flat;
+            unsigned long long edits = m_edits;
+            ResetLocked(*flat, m_len16);
+            m_flat = flat;
+            m_edits = edits;
+            m_compactions++;
+        }
+        return m_flat;
+    }
+
+    void Text(std::wstring& out) {
+        std::shared_ptr<const std::string> bytes = Snapshot();
+        Utf8ToWide(bytes->data(), bytes->size(), out);
+    }
+
+    size_t Length() { std::lock_guard<std::mutex> lock(m_mutex); return m_len16; }
+    size_t Bytes() { std::lock_guard<std::mutex> lock(m_mutex); return m_len8; }
+    size_t Pieces() { std::lock_guard<std::mutex> lock(m_mutex); return m_pieces.size(); }
+    unsigned long long Compactions() { std::lock_guard<std::mutex> lock(m_mutex); return m_compactions; }
+
+private:
+    struct Piece {
+        bool add;      // false = 원본, true = 추가 버퍼
+        size_t off;    // 버퍼 안 시작 바이트
+        size_t len8;   // 바이트
+        size_t len16;  // UTF-16 단위
+    };
+
+    static constexpr size_t PAIR_UNITS = sizeof(wchar_t) == 2 ? 2 : 1; // 4바이트 문자의 단위 수
+    static bool IsHighSurrogate(wchar_t c) { return c >= 0xD800 && c <= 0xDBFF; }
+    static bool IsLowSurrogate(wchar_t c) { return c >= 0xDC00 && c <= 0xDFFF; }
+    static size_t SeqLen(unsigned char lead) { return lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4; }
+
+    // 검증 + UTF-16 단위 수 (utf::Utf8ToUtf16이 U+FFFD로 바꿀 입력은 false)
+    static bool CountUnits(const char* data, size_t len, size_t& units) {
+        const unsigned char* p = (const unsigned char*)data;
+        units = 0;
+        for (size_t i = 0; i < len;) {
+            unsigned char c = p[i];
+            if (c < 0x80) { i++; units++; continue; }
+            size_t need;
+            unsigned char lo = 0x80, hi = 0xBF;
+            if (c >= 0xC2 && c <= 0xDF) need = 1;
+            else if (c >= 0xE0 && c <= 0xEF) { need = 2; if (c == 0xE0) lo = 0xA0; if (c == 0xED) hi = 0x9F; }
+            else if (c >= 0xF0 && c <= 0xF4) { need = 3; if (c == 0xF0) lo = 0x90; if (c == 0xF4) hi = 0x8F; }
+            else return false;
+            if (len - i <= need || p[i + 1] < lo || p[i + 1] > hi) return false;
+            for (size_t k = 2; k <= need; k++) if ((p[i + k] & 0xC0) != 0x80) return false;
+            units += need == 3 ? PAIR_UNITS : 1;
+            i += need + 1;
+        }
+        return true;
+    }
+
+    // 유효한 UTF-8 문자 하나 -> UTF-16 단위 (n개). 반환 = 바이트 수
+    static size_t DecodeUnits(const unsigned char* s, wchar_t* u, size_t& n) {
+        unsigned char c = s[0];
+        if (c < 0x80) { u[0] = c; n = 1; return 1; }
+        if (c < 0xE0) { u[0] = (wchar_t)(((c & 0x1F) << 6) | (s[1] & 0x3F)); n = 1; return 2; }
+        if (c < 0xF0) { u[0] = (wchar_t)(((c & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F)); n = 1; return 3; }
+        uint32_t cp = ((uint32_t)(c & 0x07) << 18) | ((uint32_t)(s[1] & 0x3F) << 12) | ((uint32_t)(s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+        if (PAIR_UNITS == 2) {
+            cp -= 0x10000;
+            u[0] = (wchar_t)(0xD800 + (cp >> 10));
+            u[1] = (wchar_t)(0xDC00 + (cp & 0x3FF));
+            n = 2;
+        } else {
+            u[0] = (wchar_t)cp;
+            n = 1;
+        }
+        return 4;
+    }
+
+    const unsigned char* DataOf(const Piece& p) const {
+        return (const unsigned char*)(p.add ? m_add.data() : m_orig.data()) + p.off;
+    }
+
+    void ResetLocked(std::string bytes, size_t units) {
+        m_orig = std::move(bytes);
+        m_add.clear();
+        m_pieces.clear();
+        for (size_t off = 0; off < m_orig.size();) {
+            size_t end = std::min(m_orig.size(), off + MEMO_PIECE_CHUNK);
+            while (end < m_orig.size() && end > off + 1 && ((unsigned char)m_orig[end] & 0xC0) == 0x80) end--; // 문자 경계에서
+            size_t u = 0;
+            CountUnits(m_orig.data() + off, end - off, u);
+            m_pieces.push_back(Piece{ false, off, end - off, u });
+            off = end;
+        }
+        m_len8 = m_orig.size();
+        m_len16 = units;
+        m_cursor = m_cursor16 = m_cursor8 = 0;
+        m_flat.reset();
+        m_dirty = false;
+        m_edits = 0;
+    }
+
+    // pos(UTF-16)를 포함하는 조각 (pos == 전체 길이면 m_pieces.size()). 마지막 위치에서 출발 -> 이어 입력은 O(1)
+    size_t LocateLocked(size_t pos, size_t& start16, size_t& start8) {
+        size_t i = m_cursor, s16 = m_cursor16, s8 = m_cursor8;
+        while (i > 0 && pos < s16) { i--; s16 -= m_pieces[i].len16; s8 -= m_pieces[i].len8; }
+        while (i < m_pieces.size() && pos >= s16 + m_pieces[i].len16) { s16 += m_pieces[i].len16; s8 += m_pieces[i].len8; i++; }
+        m_cursor = i; m_cursor16 = s16; m_cursor8 = s8;
+        start16 = s16;
+        start8 = s8;
+        return i;
+    }
+
+    // 조각 앞쪽 units 단위의 바이트 수 (가까운 쪽 끝에서 셈). 서로게이트 쌍 가운데면 SIZE_MAX
+    size_t ByteOffsetLocked(const Piece& p, size_t units) const {
+        const unsigned char* s = DataOf(p);
+        if (units * 2 <= p.len16) {
+            size_t b = 0, u = 0;
+            while (u < units) {
+                size_t n = SeqLen(s[b]);
+                u += n == 4 ? PAIR_UNITS : 1;
+                b += n;
+            }
+            return u == units ? b : SIZE_MAX;
+        }
+        size_t b = p.len8, u = p.len16;
+        while (u > units) {
+            do { b--; } while ((s[b] & 0xC0) == 0x80);
+            u -= SeqLen(s[b]) == 4 ? PAIR_UNITS : 1;
+        }
+        return u == units ? b : SIZE_MAX;
+    }
+
+    // pos에서 조각을 나눔 -> pos에서 시작하는 조각 번호 (커서도 그 조각으로). 쌍 가운데면 SIZE_MAX
+    size_t SplitLocked(size_t pos) {
+        size_t s16, s8;
+        size_t i = LocateLocked(pos, s16, s8);
+        if (i == m_pieces.size() || pos == s16) return i;
+        size_t b = ByteOffsetLocked(m_pieces[i], pos - s16);
+        if (b == SIZE_MAX) return SIZE_MAX;
+        Piece tail = m_pieces[i];
+        tail.off += b;
+        tail.len8 -= b;
+        tail.len16 -= pos - s16;
+        m_pieces[i].len8 = b;
+        m_pieces[i].len16 = pos - s16;
+        m_pieces.insert(m_pieces.begin() + i + 1, tail);
+        m_cursor = i + 1; m_cursor16 = pos; m_cursor8 = s8 + b;
+        return i + 1;
+    }
+
+    size_t AppendAddLocked(const wchar_t* text, size_t len) {
+        WideToUtf8(text, len, m_scratch); // 재사용 버퍼 -> 할당 없음
+        m_add.append(m_scratch);
+        return m_scratch.size();
+    }
+
+    // 마지막 사본 기준: 앞 m_cleanPrefix / 뒤 m_cleanSuffix 바이트는 그대로
+    void MarkDirtyLocked(size_t bytePos, size_t removed) {
+        size_t after = m_len8 - bytePos - removed;
+        if (!m_dirty) { m_cleanPrefix = bytePos; m_cleanSuffix = after; m_dirty = true; return; }
+        m_cleanPrefix = std::min(m_cleanPrefix, bytePos);
+        m_cleanSuffix = std::min(m_cleanSuffix, after);
+    }
+
+    bool ReplaceLocked(size_t pos, size_t removeLen, const wchar_t* insert, size_t insertLen) {
+        if (pos + removeLen > m_len16) return false;
+        size_t s16, s8;
+        size_t i = LocateLocked(pos, s16, s8);
+        // 빠른 경로: 추가 버퍼 끝 조각 바로 뒤에 이어 입력 -> 조각만 늘림
+        if (removeLen == 0 && pos == s16 && i > 0) {
+            Piece& p = m_pieces[i - 1];
+            if (p.add && p.off + p.len8 == m_add.size()) {
+                MarkDirtyLocked(s8, 0);
+                size_t n = AppendAddLocked(insert, insertLen);
+                m_cursor = i - 1; m_cursor16 = s16 - p.len16; m_cursor8 = s8 - p.len8;
+                p.len8 += n;
+                p.len16 += insertLen;
+                m_len8 += n;
+                m_len16 += insertLen;
+                return true;
+            }
+        }
+        // 빠른 경로: 그 조각 끝에서 지우기 (Backspace) -> 조각과 추가 버퍼를 함께 줄임 (끝 바이트는 이 조각만 가리킴)
+        if (insertLen == 0 && i < m_pieces.size() && pos > s16 && pos + removeLen == s16 + m_pieces[i].len16) {
+            Piece& p = m_pieces[i];
+            if (p.add && p.off + p.len8 == m_add.size()) {
+                size_t keep = ByteOffsetLocked(p, pos - s16);
+                if (keep == SIZE_MAX) return false;
+                size_t removed = p.len8 - keep;
+                MarkDirtyLocked(s8 + keep, removed);
+                m_add.resize(m_add.size() - removed);
+                p.len8 = keep;
+                p.len16 -= removeLen;
+                m_len8 -= removed;
+                m_len16 -= removeLen;
+                return true;
+            }
+        }
+        // 일반: 양 끝에서 나누고 사이 조각을 새 조각 하나로
+        size_t a = SplitLocked(pos);
+        if (a == SIZE_MAX) return false;
+        size_t bytePos = m_cursor8;
+        size_t b = SplitLocked(pos + removeLen);
+        if (b == SIZE_MAX) return false;
+        size_t removed = 0;
+        for (size_t k = a; k < b; k++) removed += m_pieces[k].len8;
+        MarkDirtyLocked(bytePos, removed);
+        m_pieces.erase(m_pieces.begin() + a, m_pieces.begin() + b);
+        size_t n = 0;
+        if (insertLen) {
+            n = AppendAddLocked(insert, insertLen);
+            m_pieces.insert(m_pieces.begin() + a, Piece{ true, m_add.size() - n, n, insertLen });
+        }
+        m_len8 = m_len8 - removed + n;
+        m_len16 = m_len16 - removeLen + insertLen;
+        m_cursor = a; m_cursor16 = pos; m_cursor8 = bytePos;
+        return true;
+    }
+
+    // pos부터 count 단위를 out에 (재사용 버퍼)
+    void CopyUnitsLocked(size_t pos, size_t count, std::wstring& out) {
+        out.clear();
+        if (count == 0) return;
+        size_t s16, s8;
+        size_t i = LocateLocked(pos, s16, s8);
+        size_t skip = pos - s16;
+        for (; i < m_pieces.size() && out.size() < count; i++) {
+            const Piece& p = m_pieces[i];
+            const unsigned char* s = DataOf(p);
+            for (size_t b = 0; b < p.len8 && out.size() < count;) {
+                wchar_t u[2];
+                size_t n = 0;
+                b += DecodeUnits(s + b, u, n);
+                for (size_t k = 0; k < n; k++) {
+                    if (skip) { skip--; continue; } // 쌍 가운데서 시작하면 뒤 단위부터
+                    if (out.size() < count) out.push_back(u[k]);
+                }
+            }
+        }
+    }
+
+    // UTF-8 바이트 [pos, pos + count)를 dst로
+    void CopyBytesLocked(size_t pos, size_t count, char* dst) const {
+        size_t start = 0;
+        for (const Piece& p : m_pieces) {
+            if (count == 0) return;
+            if (pos < start + p.len8) {
+                size_t from = pos - start, n = std::min(count, p.len8 - from);
+                memcpy(dst, DataOf(p) + from, n);
+                dst += n; pos += n; count -= n;
+            }
+            start += p.len8;
+        }
+    }
+
+    std::mutex m_mutex;
+    std::string m_orig;                 // 불러온 내용 (변하지 않음)
+    std::string m_add;                  // 입력된 글자 (덧붙이기만, 끝 조각 지우기는 잘라냄)
+    std::vector<Piece> m_pieces;
+    size_t m_len8 = 0, m_len16 = 0;
+    size_t m_cursor = 0, m_cursor16 = 0, m_cursor8 = 0; // 마지막으로 찾은 조각과 그 시작 위치
+    std::string m_scratch;              // 삽입 인코딩용
+    std::wstring m_window;              // 비교 창
+    std::shared_ptr<std::string> m_flat; // 마지막 사본
+    bool m_dirty = false;
+    size_t m_cleanPrefix = 0, m_cleanSuffix = 0;
+    unsigned long long m_edits = 0;
+    unsigned long long m_compactions = 0;
+};
+
+// 읽은 바이트(bytes)와 편집창에 넣을 텍스트(text) -> 편집 버퍼 (잘못된 UTF-8이면 text 기준)
+std::shared_ptr<MemoBuffer> MakeMemoBuffer(const std::string& bytes, const std::wstring& text);
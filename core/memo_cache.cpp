@@ -0,0 +1,136 @@
+#include "core/memo_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cwchar>
+#include <random>
+#include <vector>
+
+#include "core/file_io.h"
+
+namespace fs = std::filesystem;
+
+static const size_t MEMO_BENCH_FOLDERS = 512;
+static const int MEMO_BENCH_TABS = 6;
+
+struct MemoBenchStep {
+    size_t folder;
+    bool edit;
+};
+
+static void GenerateNavigationReplay(size_t folders, size_t steps, std::vector<MemoBenchStep>& out) {
+    struct Tab {
+        std::vector<size_t> history;
+        size_t pos = 0;
+    };
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    auto pick = [&] { double u = uniform(rng); return std::min(folders - 1, (size_t)(u * u * u * folders)); };
+    std::vector<Tab> tabs(MEMO_BENCH_TABS);
+    for (Tab& t : tabs) t.history.push_back(pick());
+    size_t current = 0;
+    out.clear();
+    for (size_t i = 0; i < steps; i++) {
+        double r = uniform(rng);
+        if (r < 0.45) {
+            current = (current + 1 + rng() % (MEMO_BENCH_TABS - 1)) % MEMO_BENCH_TABS;
+        } else if (r < 0.70) {
+            Tab& t = tabs[current];
+            bool back = r < 0.575 ? t.pos > 0 : t.pos + 1 >= t.history.size();
+            if (back && t.pos > 0) t.pos--;
+            else if (!back && t.pos + 1 < t.history.size()) t.pos++;
+        } else {
+            Tab& t = tabs[current];
+            t.history.resize(t.pos + 1); // 새 이동 -> 앞으로 기록 버림
+            t.history.push_back(pick());
+            t.pos++;
+        }
+        const Tab& t = tabs[current];
+        out.push_back(MemoBenchStep{ t.history[t.pos], i % 50 == 49 });
+    }
+}
+
+struct MemoBenchPass {
+    long long us = 0;
+    unsigned long long shownChars = 0; // 두 방식이 같은 내용을 보였는지 확인용
+};
+
+static bool RunMemoBenchPass(const std::vector<fs::path>& folders, const std::vector<std::string>& seeds,
+                             const std::vector<MemoBenchStep>& steps, MemoContentCache* cache, MemoBenchPass& pass) {
+    for (size_t i = 0; i < folders.size(); i++) {
+        if (!WriteFileAtomic(folders[i] / L"folder_memo.txt", seeds[i])) return false;
+    }
+    auto stampOf = [](const fs::path& file, MemoStat& st) {
+        std::error_code ec;
+        auto t = fs::last_write_time(file, ec);
+        if (ec) return false;
+        st.size = (unsigned long long)fs::file_size(file, ec);
+        st.mtime = (long long)t.time_since_epoch().count();
+        st.exists = !ec;
+        return st.exists;
+    };
+    std::string bytes;
+    std::wstring text;
+    auto t0 = std::chrono::steady_clock::now();
+    for (const MemoBenchStep& s : steps) {
+        const std::wstring folder = folders[s.folder].wstring();
+        fs::path file = folders[s.folder] / L"folder_memo.txt";
+        MemoStat stamp;
+        if (s.edit) {
+            if (!ReadWholeFile(file, bytes)) return false;
+            bytes += "편집 edit\r\n";
+            if (!WriteFileAtomic(file, bytes)) return false;
+            if (cache && stampOf(file, stamp)) cache->Store(folder, std::make_shared<std::string>(bytes), stamp); // 저장과 같이 텍스트는 적중 때
+            continue;
+        }
+        if (cache && stampOf(file, stamp)) {
+            if (auto hit = cache->Lookup(folder, stamp)) { pass.shownChars += hit->Text().size(); continue; }
+        }
+        if (!ReadWholeFile(file, bytes)) return false;
+        Utf8ToWide(bytes.data(), bytes.size(), text);
+        pass.shownChars += text.size();
+        if (cache && stamp.exists) cache->Store(folder, std::make_shared<std::string>(bytes), stamp, &text);
+    }
+    pass.us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+    return true;
+}
+
+bool RunMemoCacheBench(const fs::path& dir, size_t navigations, size_t budgetMb, const std::function<void(const std::wstring&)>& print) {
+    std::error_code ec;
+    std::vector<fs::path> folders;
+    std::vector<std::string> seeds;
+    std::mt19937 rng(11);
+    for (size_t i = 0; i < MEMO_BENCH_FOLDERS; i++) {
+        fs::path folder = dir / (L"folder" + std::to_wstring(i));
+        fs::create_directories(folder, ec);
+        size_t target = 1024 + rng() % (63 * 1024);
+        std::string memo;
+        while (memo.size() < target) memo += "메모 줄 " + std::to_string(memo.size()) + " - synthetic memo line for cache benchmark\r\n";
+        folders.push_back(folder);
+        seeds.push_back(std::move(memo));
+    }
+    std::vector<MemoBenchStep> steps;
+    GenerateNavigationReplay(folders.size(), navigations, steps);
+
+    MemoBenchPass plain, cached;
+    MemoContentCache cache(budgetMb * 1024 * 1024);
+    if (!RunMemoBenchPass(folders, seeds, steps, nullptr, plain) || !RunMemoBenchPass(folders, seeds, steps, &cache, cached)) {
+        print(L"benchmark I/O failed under " + dir.wstring());
+        return false;
+    }
+    double n = steps.empty() ? 1.0 : (double)steps.size();
+    wchar_t buf[300];
+    swprintf(buf, 300, L"no cache: %zu navigations in %lld ms (%.1f us/nav)", steps.size(), plain.us / 1000, plain.us / n);
+    print(buf);
+    unsigned long long hits = cache.Hits(), misses = cache.Misses();
+    swprintf(buf, 300, L"cache %zu MB: %lld ms (%.1f us/nav, %.1fx), hits=%llu misses=%llu (%.1f%% hit) stale=%llu evictions=%llu, %zu entries / %.1f MB",
+        budgetMb, cached.us / 1000, cached.us / n, cached.us ? (double)plain.us / cached.us : 0.0, hits, misses,
+        hits + misses ? 100.0 * hits / (hits + misses) : 0.0, cache.Stale(), cache.Evictions(), cache.Entries(), cache.Bytes() / 1048576.0);
+    print(buf);
+    if (plain.shownChars != cached.shownChars) {
+        print(L"mismatch: cached pass showed different content");
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
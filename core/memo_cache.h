@@ -0,0 +1,145 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/central_store.h"
+#include "core/stat_cache.h"
+#include "core/utf.h"
+
+// --- [메모 내용 캐시] ---
+// [PRD 3.4] 디코드된 메모 내용 캐시 (LRU + 바이트 예산)
+// -> 탭 전환/뒤로/앞으로마다 방금 본 폴더도 디스크에서 다시 읽고 UTF-8을 다시 디코드하던 비용 제거.
+// -> 키: 정규화 경로. 값: 디코드된 텍스트 + 병합 기준 원본(UTF-8) + 저장소 스탬프(mtime/size).
+// -> 검증: 조회 시 저장소 스탬프가 같아야 적중. 폴더 저장소의 스탬프는 [PRD 3.3] 존재 캐시 경유라
+//    보고 있는 폴더(변경 알림 등록됨)는 디스크 접근 없이 확인되고, 알림이 오면 다음 조회 때 다시 stat -> 바뀌었으면 버림.
+//    우리 저장은 기록 직후 새 내용/스탬프로 교체 (자기 기록의 알림 메아리로 버려지지 않음). 실시간 반영이 디스크 변경을 적용하면 즉시 제거.
+// -> 예산: 텍스트(UTF-16) + 원본 바이트 합이 --memo-cache-mb(기본 32MB, 0이면 끔)를 넘으면 가장 오래 안 쓴 것부터 제거.
+//    예산의 1/4보다 큰 메모는 넣지 않음 (하나가 나머지를 모두 밀어내지 않게, 아주 큰 메모는 어차피 분할 로딩).
+// -> 편집창을 채울 때와 저장할 때만 채움 (색인기 크롤/시작 시 일괄 읽기가 자주 보는 폴더를 밀어내지 않게).
+// -> 내용은 불변 공유 포인터로 넘김 -> 적중 시 큰 메모도 복사 없이 SetWindowTextW로. OS 의존 없음 (Win32 앱의 g_memoCache와 벤치/테스트가 같은 코드).
+// -> [PRD 5.11] 저장이 채운 항목은 Writer의 저장 사본을 그대로 공유하고 텍스트는 처음 적중할 때 한 번 디코드
+//    (저장마다 전체 디코드 없음). 예산은 디코드 전에도 텍스트 몫을 미리 셈 (UTF-16 단위 수 <= 바이트 수).
+const size_t MEMO_CACHE_ENTRY_OVERHEAD = 96; // 목록/색인 노드 대략치
+
+struct CachedMemo {
+    std::shared_ptr<const std::string> bytes;
+    MemoStat stamp;
+
+    const std::wstring& Text() const {
+        std::call_once(decoded, [this] { Utf8ToWide(bytes->data(), bytes->size(), text); });
+        return text;
+    }
+
+    mutable std::once_flag decoded;
+    mutable std::wstring text;
+};
+
+class MemoContentCache {
+public:
+    explicit MemoContentCache(size_t budgetBytes) : m_budget(budgetBytes) {}
+
+    void SetBudget(size_t budgetBytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_budget = budgetBytes;
+        TrimLocked();
+    }
+
+    // stamp: 지금 저장소 스탬프. 다르면 옛 내용 -> 제거하고 nullptr
+    std::shared_ptr<const CachedMemo> Lookup(const std::wstring& folderPath, const MemoStat& stamp) {
+        std::wstring key = CentralLogStore::NormalizeKey(folderPath);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it == m_index.end()) { m_misses++; return nullptr; }
+        const CachedMemo& m = *it->second->memo;
+        if (m.stamp.mtime != stamp.mtime || m.stamp.size != stamp.size) {
+            EraseLocked(it);
+            m_stale++;
+            m_misses++;
+            return nullptr;
+        }
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        m_hits++;
+        return it->second->memo;
+    }
+
+    // text: 이미 디코드한 내용이 있으면 (편집창을 채울 때), 없으면 첫 적중 때 디코드
+    void Store(const std::wstring& folderPath, std::shared_ptr<const std::string> bytes, const MemoStat& stamp, const std::wstring* text = nullptr) {
+        std::wstring key = CentralLogStore::NormalizeKey(folderPath);
+        size_t units = text ? text->size() : bytes->size();
+        size_t cost = units * sizeof(wchar_t) + bytes->size() + key.size() * sizeof(wchar_t) + MEMO_CACHE_ENTRY_OVERHEAD;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it != m_index.end()) EraseLocked(it);
+        if (cost > m_budget / 4) return;
+        auto memo = std::make_shared<CachedMemo>();
+        memo->bytes = std::move(bytes);
+        memo->stamp = stamp;
+        if (text) std::call_once(memo->decoded, [&] { memo->text = *text; });
+        m_lru.push_front(Node{ key, std::move(memo), cost });
+        m_index.emplace(std::move(key), m_lru.begin());
+        m_bytes += cost;
+        TrimLocked();
+    }
+
+    void Invalidate(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(CentralLogStore::NormalizeKey(folderPath));
+        if (it == m_index.end()) return;
+        EraseLocked(it);
+        m_invalidations++;
+    }
+
+    unsigned long long Hits() { std::lock_guard<std::mutex> lock(m_mutex); return m_hits; }
+    unsigned long long Misses() { std::lock_guard<std::mutex> lock(m_mutex); return m_misses; }
+    unsigned long long Stale() { std::lock_guard<std::mutex> lock(m_mutex); return m_stale; }
+    unsigned long long Evictions() { std::lock_guard<std::mutex> lock(m_mutex); return m_evictions; }
+    unsigned long long Invalidations() { std::lock_guard<std::mutex> lock(m_mutex); return m_invalidations; }
+    size_t Entries() { std::lock_guard<std::mutex> lock(m_mutex); return m_index.size(); }
+    size_t Bytes() { std::lock_guard<std::mutex> lock(m_mutex); return m_bytes; }
+
+private:
+    struct Node {
+        std::wstring key;
+        std::shared_ptr<const CachedMemo> memo; // 조회한 쪽이 쓰는 동안 제거되어도 안전
+        size_t cost;
+    };
+    typedef std::list<Node>::iterator NodeIt;
+
+    void EraseLocked(std::unordered_map<std::wstring, NodeIt>::iterator it) {
+        m_bytes -= it->second->cost;
+        m_lru.erase(it->second);
+        m_index.erase(it);
+    }
+
+    void TrimLocked() {
+        while (m_bytes > m_budget && !m_lru.empty()) {
+            EraseLocked(m_index.find(m_lru.back().key));
+            m_evictions++;
+        }
+    }
+
+    std::mutex m_mutex;
+    size_t m_budget;
+    size_t m_bytes = 0;
+    std::list<Node> m_lru; // 앞 = 최근
+    std::unordered_map<std::wstring, NodeIt> m_index;
+    unsigned long long m_hits = 0;
+    unsigned long long m_misses = 0;
+    unsigned long long m_stale = 0;
+    unsigned long long m_evictions = 0;
+    unsigned long long m_invalidations = 0;
+};
+
+// [PRD 3.4] --memo-cache-bench <폴더> <이동 수> (Win32 앱) / memo_cache_test --bench: 합성 탐색 재생으로 내용 캐시 효과 측정
+// -> MEMO_BENCH_FOLDERS개 폴더에 1~64KB 메모(한글/영문 섞음)를 만들고 탭 MEMO_BENCH_TABS개를 오가는 이동 열을 재생:
+//    다른 탭으로 전환 45% / 같은 탭에서 뒤로·앞으로 25% / 새 폴더로 이동 30% (앞쪽 폴더에 몰리는 분포). 50번에 1번은 보던 메모를 고쳐 저장.
+// -> 같은 이동 열을 캐시 없이(매번 읽기 + 디코드)와 캐시로(스탬프 확인 후 적중이면 그대로) 돌려 이동당 시간/적중률 비교.
+//    스탬프는 매번 실제 stat (앱에서는 존재 캐시 경유라 더 쌈) -> 보수적인 수치. 예산은 --memo-cache-mb (테스트는 --mb).
+bool RunMemoCacheBench(const std::filesystem::path& dir, size_t navigations, size_t budgetMb,
+                       const std::function<void(const std::wstring&)>& print);
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "core/memo_merge.h"
+
+#include <algorithm>
+#include <cstdint>
+
+void SplitLines(const std::string& text, std::vector<std::string>& out) {
+    out.clear();
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        end = (end == std::string::npos) ? text.size() : end + 1;
+        out.emplace_back(text, start, end - start);
+        start = end;
+    }
+}
+
+std::vector<int> MatchLines(const std::vector<std::string>& base, const std::vector<std::string>& other) {
+    std::vector<int> match(base.size(), -1);
+    size_t n = base.size(), m = other.size();
+    size_t pre = 0;
+    while (pre < n && pre < m && base[pre] == other[pre]) { match[pre] = (int)pre; pre++; }
+    size_t suf = 0;
+    while (suf < n - pre && suf < m - pre && base[n - 1 - suf] == other[m - 1 - suf]) { match[n - 1 - suf] = (int)(m - 1 - suf); suf++; }
+    size_t bn = n - pre - suf, on = m - pre - suf;
+    if (bn == 0 || on == 0 || bn * on > MERGE_MAX_CELLS) return match;
+
+    // 가운데 LCS (뒤에서부터 채운 길이 표)
+    std::vector<uint32_t> len((bn + 1) * (on + 1), 0);
+    auto at = [&](size_t i, size_t j) -> uint32_t& { return len[i * (on + 1) + j]; };
+    for (size_t i = bn; i-- > 0;) {
+        for (size_t j = on; j-- > 0;) {
+            at(i, j) = (base[pre + i] == other[pre + j]) ? at(i + 1, j + 1) + 1 : std::max(at(i + 1, j), at(i, j + 1));
+        }
+    }
+    size_t i = 0, j = 0;
+    while (i < bn && j < on) {
+        if (base[pre + i] == other[pre + j]) { match[pre + i] = (int)(pre + j); i++; j++; }
+        else if (at(i + 1, j) >= at(i, j + 1)) i++;
+        else j++;
+    }
+    return match;
+}
+
+bool MergeMemoText(const std::string& base, const std::string& ours, const std::string& theirs, std::string& out) {
+    out.clear();
+    if (ours == theirs || theirs == base) { out = ours; return true; }
+    if (ours == base) { out = theirs; return true; }
+
+    std::vector<std::string> b, o, t;
+    SplitLines(base, b); SplitLines(ours, o); SplitLines(theirs, t);
+    std::vector<int> mo = MatchLines(b, o), mt = MatchLines(b, t);
+
+    bool clean = true;
+    auto slice = [](const std::vector<std::string>& v, size_t from, size_t to) {
+        std::string s;
+        for (size_t k = from; k < to; k++) s += v[k];
+        return s;
+    };
+    auto emitConflict = [&](const std::string& mine, const std::string& disk) {
+        if (!out.empty() && out.back() != '\n') out += '\n';
+        out += "<<<<<<< 내 편집\n";
+        out += mine;
+        if (!mine.empty() && mine.back() != '\n') out += '\n';
+        out += "=======\n";
+        out += disk;
+        if (!disk.empty() && disk.back() != '\n') out += '\n';
+        out += ">>>>>>> 디스크\n";
+        clean = false;
+    };
+
+    size_t i = 0, j = 0, k = 0;
+    for (;;) {
+        // 세 쪽 모두 같은 다음 base 줄 (안정 구간)
+        size_t p = i;
+        while (p < b.size() && !(mo[p] >= (int)j && mt[p] >= (int)k)) p++;
+        size_t oj = (p < b.size()) ? (size_t)mo[p] : o.size();
+        size_t tk = (p < b.size()) ? (size_t)mt[p] : t.size();
+        std::string bs = slice(b, i, p), os = slice(o, j, oj), ts = slice(t, k, tk);
+        if (os == bs) out += ts;
+        else if (ts == bs || os == ts) out += os;
+        else emitConflict(os, ts);
+        if (p >= b.size()) break;
+        out += b[p];
+        i = p + 1; j = oj + 1; k = tk + 1;
+    }
+    return clean;
+}
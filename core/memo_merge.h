@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// --- [줄 단위 병합] ---
+// [PRD 5.8] 줄 단위 3-way 병합 (diff3 방식, 플랫폼 독립)
+// -> base(마지막으로 맞춰 본 디스크 내용) 대비 ours(화면)와 theirs(디스크)의 변경을 합침. 같은 구간을 서로 다르게 고쳤으면 충돌 표시.
+// -> 공통 접두/접미 줄을 먼저 잘라낸 뒤 가운데만 LCS로 맞춤 -> 보통의 편집은 가운데가 짧아 비용이 작음.
+// -> 가운데가 너무 크면(MERGE_MAX_CELLS 초과) 맞추기를 포기하고 통째로 한 구간으로 취급 (한쪽만 바뀌었으면 그대로 병합, 아니면 충돌).
+const size_t MERGE_MAX_CELLS = 4 * 1024 * 1024;
+
+void SplitLines(const std::string& text, std::vector<std::string>& out);
+
+// base 줄 -> other 줄 대응 (없으면 -1). 대응은 단조 증가
+std::vector<int> MatchLines(const std::vector<std::string>& base, const std::vector<std::string>& other);
+
+// 병합 결과를 out에 기록 -> 충돌 없이 합쳐졌으면 true
+bool MergeMemoText(const std::string& base, const std::string& ours, const std::string& theirs, std::string& out);
@@ -0,0 +1,67 @@
+#pragma once
+#include "core/trace.h"
+
+// --- [창 이벤트 라우팅] ---
+// [PRD 3.2.2] 탐색기 창 이벤트 -> 오버레이 생성/경로 요청/종료/위치 예약 (WinEventProc 본체)
+// -> Win32 이벤트 코드/창 API는 Host가 감쌈 (Win32는 WinEventProc, 재생 테스트는 가짜 창). 판단 순서는 여기 한 곳에만.
+// -> Host: Handle/Pair 형식, IsAlive/IsExplorer/IsVisible, FindByExplorer/CreateOverlay/ForEachOverlay,
+//    RequestPath(새 경로 탐색 + 추측 표시), ForgetExplorer/MarkPathDirty(해석기 캐시), CancelPath, CloseOverlay, SchedulePosition/SettlePosition.
+enum class OverlayEvent { Create, Show, Hide, Destroy, Cloaked, Location, Foreground, NameChange, MoveSizeEnd };
+
+template <typename Host>
+void RouteOverlayEvent(Host& host, OverlayEvent event, typename Host::Handle hwnd) {
+    typedef typename Host::Pair Pair;
+    switch (event) {
+    // Case 1: 탐색기 창이 생성되거나 보일 때
+    case OverlayEvent::Create:
+    case OverlayEvent::Show: {
+        if (!host.IsAlive(hwnd) || !host.IsExplorer(hwnd)) return;
+        if (host.FindByExplorer(hwnd)) return;
+        FM_TRACE_INSTANT(WinEvent, hwnd); // [PRD 7.1]
+        Pair* pair = host.CreateOverlay(hwnd);
+        if (pair) {
+            pair->traceEventNs = FM_TRACE_NOW();
+            host.RequestPath(*pair); // [PRD 3.1.2] 워커 풀에 위임
+        }
+        return;
+    }
+    // Case 2: 숨김, 파괴, 또는 🔥 [Cloaked(닫기/가려짐)] 감지
+    // -> 탐색기가 사라지면 즉시 오버레이에게 종료를 요청 (정리는 오버레이 쪽에서)
+    case OverlayEvent::Hide:
+    case OverlayEvent::Destroy:
+    case OverlayEvent::Cloaked:
+        if (event == OverlayEvent::Destroy) host.ForgetExplorer(hwnd); // [PRD 3.1.5] 닫힌 창의 캐시/COM 참조 해제
+        if (host.FindByExplorer(hwnd)) host.CancelPath(hwnd); // [PRD 3.1.6] 재시도 대기 중인 탐색 즉시 중단
+        host.ForEachOverlay([&host, hwnd](const Pair& pair) {
+            // 해당 탐색기(hwnd)가 이벤트 대상이거나, 이미 유효하지 않은 핸들인 경우
+            if (pair.hExplorer == hwnd || !host.IsAlive(pair.hExplorer)) host.CloseOverlay(pair);
+        });
+        return;
+    // Case 3: 위치 변경
+    // [PRD 3.2.2] LOCATIONCHANGE 폭주는 스케줄러가 프레임 단위로 병합
+    case OverlayEvent::Location:
+    case OverlayEvent::Foreground:
+        if (!host.IsAlive(hwnd)) return;
+        if (const Pair* pair = host.FindByExplorer(hwnd)) host.SchedulePosition(*pair);
+        return;
+    // [PRD 3.2.2] 드래그/크기 조절 끝 -> 다음 프레임을 기다리지 않고 최종 위치
+    case OverlayEvent::MoveSizeEnd:
+        if (!host.IsAlive(hwnd)) return;
+        if (const Pair* pair = host.FindByExplorer(hwnd)) host.SettlePosition(*pair);
+        return;
+    // Case 4: 이름 변경
+    case OverlayEvent::NameChange: {
+        if (!host.IsAlive(hwnd)) return;
+        // 창이 보이지 않거나 닫히는 중이면 탐색 요청하지 않음
+        if (!host.IsVisible(hwnd)) return;
+        Pair* pair = host.FindByExplorer(hwnd);
+        FM_TRACE_INSTANT(WinEvent, hwnd); // [PRD 7.1]
+        host.MarkPathDirty(hwnd); // [PRD 3.1.5] 바뀐 창만 재조회
+        if (pair) {
+            if (!pair->traceEventNs) pair->traceEventNs = FM_TRACE_NOW(); // 연속 이동이면 첫 이벤트 기준
+            host.RequestPath(*pair); // [PRD 3.1.2] 같은 창 요청은 최신 하나로 병합
+        }
+        return;
+    }
+    }
+}
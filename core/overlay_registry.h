@@ -0,0 +1,79 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
+// --- [오버레이 레지스트리] ---
+// [PRD 4.3] O(1) 오버레이 레지스트리 (UI 스레드 전용)
+// -> 뜨거운 메시지(WM_PAINT, LOCATIONCHANGE 등)마다 벡터 전체를 전역 뮤텍스 아래서 훑던 구조 제거.
+// -> 탐색기 핸들/오버레이 핸들 양쪽으로 해시 조회. WindowProc/WinEventProc(OUTOFCONTEXT 훅)은 모두 UI 스레드에서 돌기 때문에 락이 필요 없음.
+// -> 워커 스레드는 절대 직접 접근하지 않고 g_pathResults(Lock-Free 큐)로 결과만 넘김.
+// -> 창 핸들/오버레이 레코드 형식은 템플릿 인자 (Win32는 HWND + OverlayPair, 테스트는 가짜 창). Pair는 hExplorer/hOverlay 필드 필요.
+template <typename Pair, typename Handle>
+class BasicOverlayRegistry {
+public:
+    Pair* Add(const Pair& pair) {
+        auto res = m_byOverlay.emplace(pair.hOverlay, pair);
+        m_overlayByExplorer[pair.hExplorer] = pair.hOverlay;
+        return &res.first->second; // unordered_map 노드 주소는 삭제 전까지 고정
+    }
+
+    Pair* FindByOverlay(Handle hOverlay) {
+        auto it = m_byOverlay.find(hOverlay);
+        return it != m_byOverlay.end() ? &it->second : nullptr;
+    }
+
+    Pair* FindByExplorer(Handle hExplorer) {
+        auto it = m_overlayByExplorer.find(hExplorer);
+        return it != m_overlayByExplorer.end() ? FindByOverlay(it->second) : nullptr;
+    }
+
+    void RemoveByOverlay(Handle hOverlay) {
+        auto it = m_byOverlay.find(hOverlay);
+        if (it == m_byOverlay.end()) return;
+        auto eit = m_overlayByExplorer.find(it->second.hExplorer);
+        if (eit != m_overlayByExplorer.end() && eit->second == hOverlay) m_overlayByExplorer.erase(eit);
+        m_byOverlay.erase(it);
+    }
+
+    template <typename Fn> void ForEach(Fn fn) {
+        for (auto& kv : m_byOverlay) fn(kv.second);
+    }
+
+    size_t Size() const { return m_byOverlay.size(); }
+
+private:
+    std::unordered_map<Handle, Pair> m_byOverlay;
+    std::unordered_map<Handle, Handle> m_overlayByExplorer;
+};
+
+// [PRD 4.3] 워커 -> UI 결과 전달용 MPSC Lock-Free 큐
+// -> Push: CAS 스택 (여러 워커 동시 가능), Drain: UI 스레드가 한 번에 통째로 가져간 뒤 순서를 뒤집어 FIFO 복원
+template <typename T>
+class MpscQueue {
+public:
+    ~MpscQueue() { DrainTo([](T&) {}); }
+
+    void Push(T value) {
+        Node* node = new Node{ std::move(value), nullptr };
+        node->next = m_head.load(std::memory_order_relaxed);
+        while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    template <typename Fn> void DrainTo(Fn fn) {
+        Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+        Node* reversed = nullptr;
+        while (node) { Node* next = node->next; node->next = reversed; reversed = node; node = next; }
+        while (reversed) {
+            Node* next = reversed->next;
+            fn(reversed->value);
+            delete reversed;
+            reversed = next;
+        }
+    }
+
+private:
+    struct Node { T value; Node* next; };
+    std::atomic<Node*> m_head{ nullptr };
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "core/file_io.h"
+#include "core/history.h"
+#include "core/memo_cache.h"
+#include "core/utf.h"
+
+// --- [대용량 메모 로딩] ---
+// [PRD 5.5] 페이지 단위 로딩 (Paged, Memory-Mapped Load)
+// -> 수 MB짜리 로그형 메모를 UI 스레드에서 통째로 읽고(복사 1) 변환하고(복사 2~3) 넣던(복사 4) 구조 대신,
+//    파일을 매핑해 첫 화면 분량만 즉시 표시하고 나머지는 백그라운드에서 청크 단위로 변환해 이어 붙임.
+// -> 로딩 중 최대 메모리 ≈ 편집창 안의 텍스트 1벌 + 전송 중 청크 몇 개 (PAGED_MAX_INFLIGHT로 상한). 매핑은 페이지 캐시를 그대로 봄.
+// -> [PRD 5.8] 병합 기준도 내용 사본 대신 스탬프 + SHA-256 (워커가 변환하면서 함께 계산, 완료 시 등록).
+// -> 창 핸들 형식과 청크 전달(Win32는 PostMessage)은 호출자 몫 -> Linux 벤치가 같은 워커를 가짜 UI 큐로 구동.
+const unsigned long long PAGED_LOAD_THRESHOLD = 1024 * 1024;
+const size_t PAGED_FIRST_BYTES = 16 * 1024;
+const size_t PAGED_CHUNK_BYTES = 256 * 1024;
+const int PAGED_MAX_INFLIGHT = 4;
+
+// UTF-8 문자 중간에서 자르지 않도록 경계 조정 (가능하면 줄 끝에서 자름)
+inline size_t Utf8ChunkEnd(const char* data, size_t begin, size_t size, size_t maxBytes, bool preferNewline) {
+    if (size - begin <= maxBytes) return size;
+    size_t end = begin + maxBytes;
+    if (preferNewline) {
+        for (size_t i = end; i > begin + maxBytes / 2; i--) if (data[i - 1] == '\n') return i;
+    }
+    while (end > begin && ((unsigned char)data[end] & 0xC0) == 0x80) end--;
+    return end;
+}
+
+template <typename Handle>
+struct BasicPagedMemoLoad {
+    Handle hOverlay = Handle();
+    MappedFile map;
+    MemoStat stamp; // [PRD 5.8] 매핑 전 스탬프 -> 완료 시 병합 기준으로
+    size_t firstEnd = 0;
+    std::atomic<bool> cancelled{ false };
+    std::mutex mutex;
+    std::condition_variable cv;
+    int inFlight = 0;
+    std::chrono::steady_clock::time_point started;
+
+    // 매핑 + 첫 화면 경계 (UI 스레드)
+    bool Open(const std::filesystem::path& p) {
+        started = std::chrono::steady_clock::now();
+        if (!map.Open(p)) return false;
+        firstEnd = Utf8ChunkEnd(map.Data(), 0, map.Size(), PAGED_FIRST_BYTES, true);
+        return true;
+    }
+
+    void FirstScreen(std::wstring& out) const { Utf8ToWide(map.Data(), firstEnd, out); }
+    bool Complete() const { return firstEnd >= map.Size(); }
+
+    void Cancel() {
+        cancelled = true;
+        cv.notify_all();
+    }
+
+    // UI가 청크 하나를 받아 처리함 -> 워커가 다음 청크를 만들 수 있음
+    void ChunkConsumed() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight--;
+        }
+        cv.notify_all();
+    }
+};
+
+template <typename Handle>
+struct BasicMemoChunk {
+    std::shared_ptr<BasicPagedMemoLoad<Handle>> load;
+    std::wstring text;
+    bool last;
+    Sha256::Digest digest; // last일 때만: 파일 전체 해시
+};
+
+// 백그라운드 변환 -> post(chunk)가 false면(창이 사라짐) 청크를 지우고 중단. 받는 쪽은 처리 후 ChunkConsumed + delete
+template <typename Handle, typename PostFn>
+void RunPagedLoadWorker(std::shared_ptr<BasicPagedMemoLoad<Handle>> load, PostFn post) {
+    const char* data = load->map.Data();
+    size_t size = load->map.Size();
+    size_t pos = load->firstEnd;
+    Sha256 hash;
+    hash.Update((const uint8_t*)data, pos);
+    while (pos < size && !load->cancelled) {
+        {
+            std::unique_lock<std::mutex> lock(load->mutex);
+            load->cv.wait(lock, [&] { return load->inFlight < PAGED_MAX_INFLIGHT || load->cancelled; });
+            if (load->cancelled) return;
+            load->inFlight++;
+        }
+        size_t end = Utf8ChunkEnd(data, pos, size, PAGED_CHUNK_BYTES, false);
+        BasicMemoChunk<Handle>* chunk = new BasicMemoChunk<Handle>{ load, std::wstring(), end >= size, Sha256::Digest{} };
+        Utf8ToWide(data + pos, end - pos, chunk->text); // 매핑된 뷰에서 바로 변환 (중간 복사 없음)
+        hash.Update((const uint8_t*)data + pos, end - pos);
+        if (chunk->last) chunk->digest = hash.Final();
+        pos = end;
+        if (!post(chunk)) { delete chunk; return; }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/trace.h"
+
+// --- [경로 탐색 워커 풀] ---
+// [PRD 3.1.2] 고정 크기 워커 풀 + 창별 중복 제거 (Bounded Worker Pool)
+// -> 이벤트마다 새 스레드(+CoInitializeEx)를 만들던 구조 제거. COM 초기화는 워커당 1회.
+// -> 같은 탐색기 창의 요청은 직렬화하고, 대기 중인 요청은 최신 하나로 병합 (빠른 폴더 이동 시 중간 경로는 건너뜀).
+// -> 요청마다 세대(generation) 번호 부여 -> 실행 중에도 더 새 요청이 오면 재시도를 멈추고, UI는 옛 세대 결과를 버림.
+// -> [PRD 3.1.6] 재시도 대기는 sleep이 아니라 조건 변수 -> 새 요청/취소/종료 시 즉시 깨어나 중단.
+const int PATH_WORKER_COUNT = 3;
+
+// -> 창 핸들 형식은 템플릿 인자. 워커 시작/종료 시 호출할 함수를 받음 (Win32는 COM 초기화/해제, 테스트는 없음)
+template <typename Handle>
+class BasicPathJobPool {
+public:
+    using JobFn = std::function<void(Handle hOverlay, Handle hExplorer, unsigned long long generation)>;
+    using ThreadHook = std::function<void()>;
+
+    explicit BasicPathJobPool(JobFn job, ThreadHook onThreadStart = nullptr, ThreadHook onThreadExit = nullptr)
+        : m_job(std::move(job)), m_onThreadStart(std::move(onThreadStart)), m_onThreadExit(std::move(onThreadExit)) {}
+    ~BasicPathJobPool() { Stop(); }
+
+    void Start(int workerCount) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_workers.empty()) return;
+        m_stop = false;
+        for (int i = 0; i < workerCount; i++) m_workers.emplace_back(&BasicPathJobPool::WorkerLoop, this);
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_workers.empty()) return;
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_retryCv.notify_all();
+        for (auto& t : m_workers) t.join();
+        m_workers.clear();
+    }
+
+    // UI 스레드 -> 반환된 세대 번호를 OverlayPair에 기록해 두고 결과 수신 시 비교
+    unsigned long long Submit(Handle hOverlay, Handle hExplorer) {
+        unsigned long long gen;
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            gen = ++m_nextGeneration;
+            Slot& slot = m_slots[hExplorer];
+            slot.hOverlay = hOverlay;
+            slot.latestGeneration = gen;
+            slot.cancelled = false;
+            m_submitted++;
+            if (!slot.queued && !slot.running) {
+                slot.queued = true;
+                m_ready.push_back(hExplorer);
+                wake = true;
+            } else {
+                m_coalesced++; // 이미 대기/실행 중 -> 최신 세대로 덮어쓰기만
+            }
+        }
+        if (wake) m_cv.notify_one();
+        m_retryCv.notify_all(); // [PRD 3.1.6] 같은 창의 재시도 대기 중인 작업 -> 즉시 깨워 최신 세대로 재실행
+        return gen;
+    }
+
+    // [PRD 3.1.6] 창이 닫힘/숨김 -> 대기 중인 요청은 버리고, 실행 중인 작업은 재시도 대기에서 깨워 중단
+    void Cancel(Handle hExplorer) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_slots.find(hExplorer);
+            if (it == m_slots.end()) return;
+            it->second.cancelled = true;
+            it->second.latestGeneration = ++m_nextGeneration; // 실행 중 작업의 IsLatest -> false
+            m_cancelled++;
+        }
+        m_retryCv.notify_all();
+    }
+
+    // [PRD 3.1.6] 재시도 대기 -> 시간이 다 되면 true, 그 전에 새 요청/취소/종료로 밀리면 false (작업 종료)
+    bool WaitForRetry(Handle hExplorer, unsigned long long generation, int ms) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        bool superseded = m_retryCv.wait_for(lock, std::chrono::milliseconds(ms), [&] {
+            auto it = m_slots.find(hExplorer);
+            return m_stop || it == m_slots.end() || it->second.latestGeneration != generation;
+        });
+        return !superseded;
+    }
+
+    // 작업 도중 호출 -> 더 새 요청이 들어왔으면 false (재시도 중단용)
+    bool IsLatest(Handle hExplorer, unsigned long long generation) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_slots.find(hExplorer);
+        return it != m_slots.end() && it->second.latestGeneration == generation && !m_stop;
+    }
+
+    // [PRD 3.2.3] 워커에 맡기지 않고 세대 번호만 발급 (시작 시 일괄 해석 결과용)
+    // -> 그 사이 NAMECHANGE로 Submit되면 더 큰 세대가 기록되어 일괄 결과는 자연히 폐기됨
+    unsigned long long Reserve() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return ++m_nextGeneration;
+    }
+
+    unsigned long long SubmittedCount() { std::lock_guard<std::mutex> lock(m_mutex); return m_submitted; }
+    unsigned long long CoalescedCount() { std::lock_guard<std::mutex> lock(m_mutex); return m_coalesced; }
+    unsigned long long CancelledCount() { std::lock_guard<std::mutex> lock(m_mutex); return m_cancelled; }
+
+private:
+    struct Slot {
+        Handle hOverlay = Handle();
+        unsigned long long latestGeneration = 0;
+        bool queued = false;
+        bool running = false;
+        bool cancelled = false; // [PRD 3.1.6] 창이 사라짐 -> 다시 대기열에 넣지 않음
+    };
+
+    void WorkerLoop() {
+        if (m_onThreadStart) m_onThreadStart();
+        FM_TRACE_THREAD("path-worker"); // [PRD 7.1]
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_cv.wait(lock, [this] { return m_stop || !m_ready.empty(); });
+            if (m_stop) break;
+            Handle hExplorer = m_ready.front();
+            m_ready.pop_front();
+            Slot& slot = m_slots[hExplorer];
+            if (slot.cancelled) { m_slots.erase(hExplorer); continue; } // [PRD 3.1.6]
+            slot.queued = false;
+            slot.running = true;
+            Handle hOverlay = slot.hOverlay;
+            unsigned long long gen = slot.latestGeneration;
+
+            lock.unlock();
+            m_job(hOverlay, hExplorer, gen);
+            lock.lock();
+
+            Slot& done = m_slots[hExplorer];
+            done.running = false;
+            if (done.latestGeneration != gen && !done.cancelled) {
+                // 실행 중 새 요청 도착 -> 최신 것만 다시 대기열로
+                done.queued = true;
+                m_ready.push_back(hExplorer);
+                m_cv.notify_one();
+            } else {
+                m_slots.erase(hExplorer);
+            }
+        }
+        lock.unlock();
+        if (m_onThreadExit) m_onThreadExit();
+    }
+
+    JobFn m_job;
+    ThreadHook m_onThreadStart;
+    ThreadHook m_onThreadExit;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_retryCv; // [PRD 3.1.6] 재시도 대기 깨우기
+    std::deque<Handle> m_ready;
+    std::unordered_map<Handle, Slot> m_slots;
+    std::vector<std::thread> m_workers;
+    bool m_stop = false;
+    unsigned long long m_nextGeneration = 0;
+    unsigned long long m_submitted = 0;
+    unsigned long long m_coalesced = 0;
+    unsigned long long m_cancelled = 0;
+};
+
+// [PRD 3.1.6] 경로 해석 재시도: 고정 300ms x 5회 대신 짧게 시작해 두 배씩 늘리는 대기 (총 PATH_RESOLVE_BUDGET_MS까지).
+//    대기 중 같은 창의 NAMECHANGE(제목 설정 = 경로 준비됨)가 오면 즉시 깨어나 최신 세대로 다시 시도, 창이 닫히면 즉시 중단.
+// -> 상한은 예전 폴링 간격 (더 길면 1초 언저리에 준비되는 창이 예전보다 늦게 잡힘, title_hints_test --bench)
+const int PATH_RETRY_FIRST_MS = 25;
+const int PATH_RETRY_MAX_MS = 300;
+const int PATH_RESOLVE_BUDGET_MS = 8000;
+
+enum class PathRetryResult { Resolved, ExplorerGone, Superseded };
+
+// 재시도 루프 본체 (경로 해석/창 생존 확인은 호출자가 넘김). Resolved면 path가 비어 있을 수 있음 (시한 초과)
+template <typename Handle, typename AliveFn, typename ResolveFn>
+PathRetryResult RunPathRetry(BasicPathJobPool<Handle>& jobs, Handle hExplorer, unsigned long long generation,
+                             AliveFn isAlive, ResolveFn resolve, std::wstring& path) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(PATH_RESOLVE_BUDGET_MS);
+    int delayMs = PATH_RETRY_FIRST_MS;
+    for (;;) {
+        if (!isAlive(hExplorer)) return PathRetryResult::ExplorerGone; // 🔥 [Fast-Fail] 닫힌 창은 더 기다리지 않음
+        if (!jobs.IsLatest(hExplorer, generation)) return PathRetryResult::Superseded; // 새 탐색 요청에 밀림 -> 결과 불필요
+        {
+            FM_TRACE_SCOPE(ResolvePath, hExplorer); // [PRD 7.1] 재시도마다 기록
+            path = resolve(hExplorer);
+        }
+        if (!path.empty()) return PathRetryResult::Resolved;
+        if (std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs) > deadline) return PathRetryResult::Resolved;
+        if (!jobs.WaitForRetry(hExplorer, generation, delayMs)) return PathRetryResult::Superseded; // [PRD 3.1.6] 새 요청/취소 -> 즉시 중단
+        delayMs = std::min(delayMs * 2, PATH_RETRY_MAX_MS);
+    }
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// --- [위치 동기화 스케줄러] ---
+// [PRD 3.2.2] 창 백엔드 인터페이스 -> 스케줄링 로직을 Win32 호출과 분리 (가짜 백엔드로 이벤트/이동 횟수 검증 가능)
+// -> 창 핸들 형식은 템플릿 인자 (Win32는 HWND + DeferWindowPos, 테스트는 가짜 창)
+struct OverlayRect {
+    int x, y, w, h;
+    bool operator==(const OverlayRect& o) const { return x == o.x && y == o.y && w == o.w && h == o.h; }
+};
+
+template <typename Handle>
+class BasicOverlayWindowOps {
+public:
+    virtual ~BasicOverlayWindowOps() {}
+    // 탐색기 창의 실제 프레임 (사라졌으면 false)
+    virtual bool GetExplorerFrame(Handle hExplorer, int& right, int& bottom) = 0;
+    // 여러 오버레이 이동을 한 번의 트랜잭션으로 적용
+    virtual void MoveOverlays(const std::vector<std::pair<Handle, OverlayRect>>& moves) = 0;
+};
+
+// [PRD 3.2.2] 프레임 단위 위치 동기화 스케줄러 (UI 스레드 전용)
+// -> 탐색기 드래그/리사이즈 시 쏟아지는 LOCATIONCHANGE를 매번 처리하지 않고 Dirty 표시만 함.
+// -> Flow: 첫 이벤트는 즉시 반영(반응성) -> 이후는 POSITION_FRAME_MS마다 Dirty 전체를 한 트랜잭션으로 이동 -> 한 프레임 동안 변화가 없으면 멈춤.
+//    드래그가 끝나면(MOVESIZEEND) 다음 프레임을 기다리지 않고 최종 위치 반영 후 바로 멈춤 (Settle).
+// -> 박자는 전역 타이머(SetTimer)가 아니라 메시지 대기 시한: 메시지 루프가 FrameWaitMs만큼만 기다리고 RunDueFrame 호출.
+//    박자가 멈춰 있으면 무기한 대기 -> 유휴 시 깨어나지 않음 (코딩 스타일 ④ Polling-Free).
+// -> 계산된 위치가 마지막 적용 위치와 같으면 이동 자체를 생략.
+const unsigned POSITION_FRAME_MS = 16;
+const unsigned POSITION_WAIT_FOREVER = 0xFFFFFFFF; // Win32 INFINITE와 같은 값
+
+template <typename Handle>
+class BasicOverlayPositionScheduler {
+public:
+    typedef BasicOverlayWindowOps<Handle> WindowOps;
+    using TargetFn = std::function<bool(Handle hOverlay, OverlayRect& out)>;
+    using ClockFn = std::function<int64_t()>; // ms (기본: steady_clock)
+
+    explicit BasicOverlayPositionScheduler(WindowOps* ops) : m_ops(ops) {}
+
+    void SetClock(ClockFn clock) { m_clock = std::move(clock); }
+
+    void MarkDirty(Handle hOverlay) {
+        m_eventsReceived++;
+        if (m_dirtySet.insert(hOverlay).second) m_dirty.push_back(hOverlay);
+    }
+
+    bool HasDirty() const { return !m_dirty.empty(); }
+    bool Pacing() const { return m_pacing; }
+
+    // LOCATIONCHANGE/FOREGROUND 진입점 -> 박자가 멈춰 있으면 즉시 반영하고 true (호출자가 프레임 박자 시작)
+    bool Schedule(Handle hOverlay, const TargetFn& targetOf) {
+        MarkDirty(hOverlay);
+        if (m_pacing) return false; // 다음 프레임에 일괄 처리
+        Flush(targetOf); // 드래그 첫 이벤트는 지연 없이 반영
+        m_pacing = true;
+        m_frameDue = Now() + POSITION_FRAME_MS;
+        return true;
+    }
+
+    // 드래그/크기 조절 끝 -> 남은 Dirty와 함께 최종 위치를 바로 반영하고 박자 정지
+    void Settle(Handle hOverlay, const TargetFn& targetOf) {
+        MarkDirty(hOverlay);
+        Flush(targetOf);
+        m_pacing = false;
+    }
+
+    // 메시지 루프의 대기 시한 -> 다음 프레임까지 남은 ms (박자가 멈춰 있으면 POSITION_WAIT_FOREVER)
+    unsigned FrameWaitMs() const {
+        if (!m_pacing) return POSITION_WAIT_FOREVER;
+        int64_t left = m_frameDue - Now();
+        return left > 0 ? (unsigned)left : 0;
+    }
+
+    // 메시지 처리 사이마다 -> 프레임 시각이 지났으면 OnFrame. 박자가 계속되면 true
+    bool RunDueFrame(const TargetFn& targetOf) {
+        if (!m_pacing) return false;
+        int64_t now = Now();
+        if (now < m_frameDue) return true;
+        m_frameDue = now + POSITION_FRAME_MS; // 늦었으면 밀린 프레임을 몰아서 돌지 않음
+        return OnFrame(targetOf);
+    }
+
+    // 프레임마다 -> 이번 프레임에 Dirty가 없었으면 false (박자 정지, 유휴 시 CPU 0%)
+    bool OnFrame(const TargetFn& targetOf) {
+        if (!HasDirty()) { m_pacing = false; return false; }
+        Flush(targetOf);
+        return true;
+    }
+
+    // Dirty 오버레이 일괄 이동 -> 실제로 이동한 개수 반환
+    size_t Flush(const TargetFn& targetOf) {
+        m_moves.clear();
+        for (Handle hOverlay : m_dirty) {
+            OverlayRect rc;
+            if (!targetOf(hOverlay, rc)) continue;
+            auto it = m_lastApplied.find(hOverlay);
+            if (it != m_lastApplied.end() && it->second == rc) { m_movesSkipped++; continue; }
+            m_lastApplied[hOverlay] = rc;
+            m_moves.emplace_back(hOverlay, rc);
+        }
+        m_dirty.clear();
+        m_dirtySet.clear();
+        if (!m_moves.empty()) {
+            m_ops->MoveOverlays(m_moves);
+            m_movesIssued += m_moves.size();
+            m_transactions++;
+        }
+        return m_moves.size();
+    }
+
+    // 상태 변경(최소화/확장 등)으로 즉시 이동한 경우 -> 캐시 동기화
+    void NoteApplied(Handle hOverlay, const OverlayRect& rc) { m_lastApplied[hOverlay] = rc; m_movesIssued++; }
+
+    void Forget(Handle hOverlay) {
+        m_lastApplied.erase(hOverlay);
+        if (m_dirtySet.erase(hOverlay)) m_dirty.erase(std::remove(m_dirty.begin(), m_dirty.end(), hOverlay), m_dirty.end());
+    }
+
+    unsigned long long EventsReceived() const { return m_eventsReceived; }
+    unsigned long long MovesIssued() const { return m_movesIssued; }
+    unsigned long long MovesSkipped() const { return m_movesSkipped; }
+    unsigned long long Transactions() const { return m_transactions; }
+
+private:
+    int64_t Now() const {
+        if (m_clock) return m_clock();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    WindowOps* m_ops;
+    ClockFn m_clock;
+    bool m_pacing = false;
+    int64_t m_frameDue = 0;
+    std::vector<Handle> m_dirty;
+    std::unordered_set<Handle> m_dirtySet;
+    std::unordered_map<Handle, OverlayRect> m_lastApplied;
+    std::vector<std::pair<Handle, OverlayRect>> m_moves; // 재사용 버퍼
+    unsigned long long m_eventsReceived = 0;
+    unsigned long long m_movesIssued = 0;
+    unsigned long long m_movesSkipped = 0;
+    unsigned long long m_transactions = 0;
+};
\ No newline at end of file
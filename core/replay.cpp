@@ -0,0 +1,118 @@
+#include "core/replay.h"
+
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <random>
+
+#include "core/utf.h"
+
+bool ParseReplayTrace(const std::string& bytes, std::vector<ReplayEvent>& out, std::wstring& error) {
+    std::wstring text = Utf8ToWide(bytes);
+    size_t pos = 0;
+    int lineNo = 0;
+    while (pos < text.size()) {
+        size_t end = text.find(L'\n', pos);
+        if (end == std::wstring::npos) end = text.size();
+        std::wstring line = text.substr(pos, end - pos);
+        pos = end + 1;
+        lineNo++;
+        if (!line.empty() && line.back() == L'\r') line.pop_back();
+        size_t first = line.find_first_not_of(L" \t");
+        if (first == std::wstring::npos || line[first] == L'#') continue;
+
+        wchar_t kind[32] = { 0 };
+        double at = 0;
+        int consumed = 0;
+        if (swscanf(line.c_str(), L"%lf %31ls %n", &at, kind, &consumed) < 2) {
+            error = L"line " + std::to_wstring(lineNo) + L": expected '<ms> <event> ...'";
+            return false;
+        }
+        std::wstring rest = line.substr(consumed);
+        ReplayEvent e;
+        e.atMs = at;
+        bool needWindow = true, needPath = false;
+        if (wcscmp(kind, L"create") == 0) { e.kind = ReplayEvent::Create; needPath = true; }
+        else if (wcscmp(kind, L"show") == 0) e.kind = ReplayEvent::Show;
+        else if (wcscmp(kind, L"namechange") == 0) { e.kind = ReplayEvent::NameChange; needPath = true; }
+        else if (wcscmp(kind, L"location") == 0) e.kind = ReplayEvent::Location;
+        else if (wcscmp(kind, L"cloaked") == 0) e.kind = ReplayEvent::Cloaked;
+        else if (wcscmp(kind, L"destroy") == 0) e.kind = ReplayEvent::Destroy;
+        else if (wcscmp(kind, L"memo") == 0) { e.kind = ReplayEvent::Memo; needWindow = false; needPath = true; }
+        else if (wcscmp(kind, L"check") == 0) { e.kind = ReplayEvent::Check; needWindow = false; }
+        else {
+            error = L"line " + std::to_wstring(lineNo) + L": unknown event '" + kind + L"'";
+            return false;
+        }
+        if (needWindow) {
+            int n = 0;
+            if (swscanf(rest.c_str(), L"%d %n", &e.window, &n) < 1) {
+                error = L"line " + std::to_wstring(lineNo) + L": missing window number";
+                return false;
+            }
+            rest = rest.substr(n);
+        }
+        if (e.kind == ReplayEvent::Location) swscanf(rest.c_str(), L"%d %d", &e.x, &e.y);
+        if (needPath) {
+            e.path = rest;
+            while (!e.path.empty() && (e.path.back() == L' ' || e.path.back() == L'\t')) e.path.pop_back();
+            if (e.path.empty()) {
+                error = L"line " + std::to_wstring(lineNo) + L": missing path";
+                return false;
+            }
+        }
+        out.push_back(std::move(e));
+    }
+    return true;
+}
+
+void GenerateReplayEvents(int windows, int events, int rate, std::vector<ReplayEvent>& out) {
+    std::mt19937 rng(20240611);
+    int folders = std::max(1, windows * 4);
+    auto folderName = [](int i) { return L"f" + std::to_wstring(i / 16) + L"\\d" + std::to_wstring(i); };
+    for (int i = 0; i < folders; i += 2) {
+        ReplayEvent e;
+        e.kind = ReplayEvent::Memo;
+        e.path = folderName(i);
+        out.push_back(e);
+    }
+
+    std::vector<int> state(windows, 0); // 0 = 없음, 1 = 보임, 2 = 숨김
+    double stepMs = rate > 0 ? 1000.0 / rate : 0;
+    for (int n = 0; n < events; n++) {
+        int w = (int)(rng() % windows);
+        ReplayEvent e;
+        e.atMs = n * stepMs;
+        e.window = w;
+        unsigned roll = rng() % 100;
+        if (state[w] == 0) {
+            e.kind = ReplayEvent::Create;
+            e.path = folderName((int)(rng() % folders));
+            out.push_back(e);
+            e.kind = ReplayEvent::Show;
+            state[w] = 1;
+        } else if (state[w] == 2) {
+            e.kind = roll < 60 ? ReplayEvent::Show : ReplayEvent::Destroy;
+            state[w] = roll < 60 ? 1 : 0;
+        } else if (roll < 55) {
+            e.kind = ReplayEvent::Location;
+            e.x = (int)(rng() % 400);
+            e.y = (int)(rng() % 300);
+        } else if (roll < 88) {
+            e.kind = ReplayEvent::NameChange;
+            e.path = folderName((int)(rng() % folders));
+        } else if (roll < 95) {
+            e.kind = ReplayEvent::Cloaked;
+            state[w] = 2;
+        } else {
+            e.kind = ReplayEvent::Destroy;
+            state[w] = 0;
+        }
+        out.push_back(e);
+        if ((n + 1) % REPLAY_SYNTHETIC_CHECK_EVERY == 0) {
+            ReplayEvent c;
+            c.atMs = e.atMs;
+            out.push_back(c);
+        }
+    }
+}
@@ -0,0 +1,321 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/explorer_paths.h"
+#include "core/overlay_events.h"
+
+// --- [이벤트 재생] ---
+// [PRD 7.2] 헤드리스 이벤트 재생 (실제 탐색기 없이 상태 머신 구동 + 측정)
+// -> 이벤트 라우팅/경로 해석/워커 풀은 실제 코드 그대로 (Win32는 WindowProc/저장소까지). 바꾸는 것은 바깥 경계 두 곳뿐:
+//    탐색기 창 = IReplayWindows (Win32는 이 프로세스가 만든 화면 밖 CabinetWClass 창, Linux 테스트는 가짜 창),
+//    Shell = BasicReplayShellBackend (창별 경로 표).
+// -> 이벤트는 기록 파일(--replay) 또는 무작위 생성(--replay-synthetic)으로 주입, 이벤트 사이마다 메시지 펌프.
+// -> 측정: 처리량(이벤트/초), 이벤트 -> 오버레이 경로 반영 지연 백분위, 상태 불변식 위반 수.
+//    불변식 (안정된 뒤 검사): 유령(사라진/숨은 창의 오버레이), 누락(보이는 창에 오버레이 없음), 중복, 옛 경로.
+// -> 메모 폴더는 호출자가 정한 루트 아래 (Win32는 %TEMP%\FolderMemoReplay, 매 실행 시 비움). 위반이 있으면 종료 코드 1.
+//
+// 기록 파일 형식 (UTF-8, 한 줄에 하나, '#'은 주석, 시각은 시작 기준 ms, 경로는 재생 폴더 기준 상대 경로):
+//   <ms> create <창> <경로>      : 숨은 창 생성 + EVENT_OBJECT_CREATE
+//   <ms> show <창>               : 표시 + EVENT_OBJECT_SHOW
+//   <ms> namechange <창> <경로>  : 폴더 이동 + EVENT_OBJECT_NAMECHANGE
+//   <ms> location <창> <x> <y>   : 이동 + EVENT_OBJECT_LOCATIONCHANGE
+//   <ms> cloaked <창>            : 숨김 + EVENT_OBJECT_CLOAKED
+//   <ms> destroy <창>            : 파괴 + EVENT_OBJECT_DESTROY
+//   <ms> memo <경로>             : 폴더에 메모 생성
+//   <ms> check                   : 안정될 때까지 대기 후 불변식 검사
+const int REPLAY_SETTLE_TIMEOUT_MS = 5000;
+const int REPLAY_SYNTHETIC_CHECK_EVERY = 500;
+
+struct ReplayEvent {
+    enum Kind { Create, Show, NameChange, Location, Cloaked, Destroy, Memo, Check };
+    double atMs = 0;
+    Kind kind = Check;
+    int window = 0;
+    std::wstring path;
+    int x = 0, y = 0;
+};
+
+bool ParseReplayTrace(const std::string& bytes, std::vector<ReplayEvent>& out, std::wstring& error);
+
+// 무작위 이벤트열 (고정 시드 -> 같은 인자면 같은 결과). 폴더는 창 수의 4배, 그중 절반에 메모.
+// rate = 초당 이벤트 수 (0이면 시각 없이 연달아 주입)
+void GenerateReplayEvents(int windows, int events, int rate, std::vector<ReplayEvent>& out);
+
+// 가짜 Shell: 창마다 현재 폴더 1개 (탭 1개). 토큰 = 창 핸들 -> 참조 계수 불필요.
+// [PRD 3.1.6] initDelay: 새 창은 그 시간이 지나야 나열됨 (초기화 중인 탐색기 -> 재시도 간격 측정용)
+template <typename Handle>
+class BasicReplayShellBackend : public BasicShellBackend<Handle> {
+public:
+    typedef BasicShellTab<Handle> ShellTab;
+
+    void SetInitDelay(int ms) { m_initDelay = std::chrono::milliseconds(ms); }
+
+    void SetPath(Handle hwnd, const std::wstring& path) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto res = m_windows.emplace(hwnd, Window());
+        if (res.second) res.first->second.readyAt = std::chrono::steady_clock::now() + m_initDelay;
+        res.first->second.path = path;
+    }
+    void Remove(Handle hwnd) { std::lock_guard<std::mutex> lock(m_mutex); m_windows.erase(hwnd); }
+
+    bool ListTabs(std::vector<ShellTab>& out) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_listCalls++;
+        auto now = std::chrono::steady_clock::now();
+        for (const auto& kv : m_windows) if (kv.second.readyAt <= now) out.push_back({ kv.first, (void*)kv.first });
+        return true;
+    }
+
+    bool ReadTab(void* token, std::wstring& name, std::wstring& path) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_readCalls++;
+        auto it = m_windows.find((Handle)token);
+        if (it == m_windows.end() || it->second.readyAt > std::chrono::steady_clock::now()) return false;
+        path = it->second.path;
+        name = std::filesystem::path(path).filename().wstring();
+        return true;
+    }
+
+    void RetainTab(void*) override {}
+    void ReleaseTab(void*) override {}
+    void Disconnect() override {}
+
+    unsigned long long ListCalls() { std::lock_guard<std::mutex> lock(m_mutex); return m_listCalls; }
+    unsigned long long ReadCalls() { std::lock_guard<std::mutex> lock(m_mutex); return m_readCalls; }
+
+private:
+    struct Window {
+        std::wstring path;
+        std::chrono::steady_clock::time_point readyAt;
+    };
+    std::mutex m_mutex;
+    std::unordered_map<Handle, Window> m_windows;
+    std::chrono::steady_clock::duration m_initDelay{ 0 };
+    unsigned long long m_listCalls = 0;
+    unsigned long long m_readCalls = 0;
+};
+
+// 재생 대상 창/메시지 펌프 (Win32 또는 가짜). 모두 UI 스레드에서 호출됨
+template <typename Handle>
+class IReplayWindows {
+public:
+    virtual ~IReplayWindows() {}
+    virtual void WriteMemo(const std::wstring& folderPath) = 0;
+    virtual Handle CreateExplorer(int id, const std::wstring& title) = 0; // 숨은 창 (실패 시 빈 핸들)
+    virtual void ShowExplorer(Handle hwnd, bool visible) = 0;
+    virtual void MoveExplorer(Handle hwnd, int x, int y) = 0;
+    virtual void SetExplorerTitle(Handle hwnd, const std::wstring& title) = 0;
+    virtual void DestroyExplorer(Handle hwnd) = 0; // 소유된 오버레이도 함께 파괴 (실제 탐색기 종료와 같음)
+    virtual void Inject(OverlayEvent event, Handle hwnd) = 0;
+    virtual void Pump() = 0;                       // 쌓인 메시지/워커 결과 처리
+    virtual void Wait(int ms) = 0;                 // 새 메시지가 오거나 ms가 지날 때까지
+    virtual bool OverlayPath(Handle hExplorer, std::wstring& path) = 0; // 오버레이가 없으면 false
+    virtual void ForEachOverlay(const std::function<void(Handle hExplorer)>& fn) = 0;
+};
+
+struct ReplayStats {
+    size_t injected = 0;
+    double injectMs = 0;
+    std::vector<double> latencyMs; // 오름차순
+    unsigned long long checks = 0;
+    unsigned long long ghost = 0;
+    unsigned long long missing = 0;
+    unsigned long long duplicate = 0;
+    unsigned long long stale = 0;
+
+    double Percentile(double q) const {
+        if (latencyMs.empty()) return 0.0;
+        size_t i = (size_t)(q * (latencyMs.size() - 1) + 0.5);
+        return latencyMs[i];
+    }
+    bool Clean() const { return !ghost && !missing && !duplicate && !stale; }
+};
+
+template <typename Handle>
+class BasicReplaySession {
+public:
+    BasicReplaySession(IReplayWindows<Handle>& windows, BasicReplayShellBackend<Handle>& shell, const std::filesystem::path& root)
+        : m_host(windows), m_shell(shell), m_root(root) {}
+
+    ReplayStats Run(const std::vector<ReplayEvent>& events) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (const ReplayEvent& e : events) {
+            WaitUntil(t0, e.atMs);
+            Apply(e);
+            if (e.kind != ReplayEvent::Memo && e.kind != ReplayEvent::Check) m_stats.injected++;
+            Pump();
+        }
+        auto tInjected = std::chrono::steady_clock::now();
+        Settle();
+        Check();
+
+        // 남은 창 정리 -> 오버레이가 하나도 남지 않아야 함
+        std::vector<int> alive;
+        for (const auto& kv : m_windows) alive.push_back(kv.first);
+        for (int id : alive) { ReplayEvent d; d.kind = ReplayEvent::Destroy; d.window = id; Apply(d); }
+        Settle();
+        Check();
+
+        m_stats.injectMs = std::chrono::duration<double, std::milli>(tInjected - t0).count();
+        std::sort(m_stats.latencyMs.begin(), m_stats.latencyMs.end());
+        return m_stats;
+    }
+
+private:
+    struct FakeWindow {
+        Handle hwnd = Handle();
+        bool visible = false;
+        std::wstring path;
+    };
+    struct Expect {
+        std::wstring path;
+        std::chrono::steady_clock::time_point at;
+    };
+
+    // 기록 파일의 경로는 '\' 구분 -> 다른 플랫폼에서는 그 플랫폼 구분자로
+    std::wstring FullPath(const std::wstring& rel) {
+        std::wstring r = rel;
+        if (std::filesystem::path::preferred_separator != '\\') std::replace(r.begin(), r.end(), L'\\', (wchar_t)std::filesystem::path::preferred_separator);
+        std::filesystem::path p = (m_root / r).lexically_normal();
+        std::error_code ec;
+        std::filesystem::create_directories(p, ec);
+        return p.wstring();
+    }
+
+    static std::wstring TitleOf(const std::wstring& path) { return std::filesystem::path(path).filename().wstring(); }
+
+    bool HasOverlay(Handle hwnd) { std::wstring path; return m_host.OverlayPath(hwnd, path); }
+
+    void Await(Handle hwnd, const std::wstring& path) { m_expect[hwnd] = { path, std::chrono::steady_clock::now() }; }
+
+    void Apply(const ReplayEvent& e) {
+        if (e.kind == ReplayEvent::Memo) { m_host.WriteMemo(FullPath(e.path)); return; }
+        if (e.kind == ReplayEvent::Check) { Settle(); Check(); return; }
+
+        auto it = m_windows.find(e.window);
+        if (e.kind == ReplayEvent::Create) {
+            if (it != m_windows.end()) return; // 이미 있는 창 -> 무시
+            FakeWindow w;
+            w.path = FullPath(e.path);
+            w.hwnd = m_host.CreateExplorer(e.window, TitleOf(w.path));
+            if (!w.hwnd) return;
+            m_shell.SetPath(w.hwnd, w.path);
+            m_windows[e.window] = w;
+            bool had = HasOverlay(w.hwnd);
+            m_host.Inject(OverlayEvent::Create, w.hwnd);
+            if (!had) Await(w.hwnd, w.path);
+            return;
+        }
+        if (it == m_windows.end()) return;
+        FakeWindow& w = it->second;
+        switch (e.kind) {
+        case ReplayEvent::Show: {
+            m_host.ShowExplorer(w.hwnd, true);
+            w.visible = true;
+            bool had = HasOverlay(w.hwnd);
+            m_host.Inject(OverlayEvent::Show, w.hwnd);
+            if (!had) Await(w.hwnd, w.path);
+            break;
+        }
+        case ReplayEvent::NameChange:
+            w.path = FullPath(e.path);
+            m_shell.SetPath(w.hwnd, w.path);
+            m_host.SetExplorerTitle(w.hwnd, TitleOf(w.path));
+            m_host.Inject(OverlayEvent::NameChange, w.hwnd);
+            if (w.visible) Await(w.hwnd, w.path);
+            break;
+        case ReplayEvent::Location:
+            m_host.MoveExplorer(w.hwnd, e.x, e.y);
+            m_host.Inject(OverlayEvent::Location, w.hwnd);
+            break;
+        case ReplayEvent::Cloaked:
+            m_host.ShowExplorer(w.hwnd, false);
+            w.visible = false;
+            m_expect.erase(w.hwnd);
+            m_host.Inject(OverlayEvent::Cloaked, w.hwnd);
+            break;
+        case ReplayEvent::Destroy: {
+            Handle hwnd = w.hwnd;
+            m_windows.erase(it);
+            m_expect.erase(hwnd);
+            m_shell.Remove(hwnd);
+            m_host.DestroyExplorer(hwnd);
+            m_host.Inject(OverlayEvent::Destroy, hwnd);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    void Pump() {
+        m_host.Pump();
+        // 기대 경로가 반영된 창 -> 지연 기록
+        auto now = std::chrono::steady_clock::now();
+        std::wstring path;
+        for (auto it = m_expect.begin(); it != m_expect.end();) {
+            if (m_host.OverlayPath(it->first, path) && path == it->second.path) {
+                m_stats.latencyMs.push_back(std::chrono::duration<double, std::milli>(now - it->second.at).count());
+                it = m_expect.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void WaitUntil(std::chrono::steady_clock::time_point t0, double atMs) {
+        for (;;) {
+            double left = atMs - std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            if (left <= 0) return;
+            m_host.Wait((int)std::max(1.0, left));
+            Pump();
+        }
+    }
+
+    // 기대 경로가 모두 반영되고 대기 메시지가 없을 때까지 (시한 초과분은 옛 경로로 집계됨)
+    void Settle() {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(REPLAY_SETTLE_TIMEOUT_MS);
+        int quiet = 0;
+        while (quiet < 3 && std::chrono::steady_clock::now() < deadline) {
+            Pump();
+            quiet = m_expect.empty() ? quiet + 1 : 0;
+            m_host.Wait(10);
+        }
+        Pump();
+    }
+
+    void Check() {
+        m_stats.checks++;
+        std::unordered_map<Handle, int> perExplorer;
+        std::unordered_set<Handle> visible;
+        for (const auto& kv : m_windows) if (kv.second.visible) visible.insert(kv.second.hwnd);
+        m_host.ForEachOverlay([&](Handle hExplorer) {
+            perExplorer[hExplorer]++;
+            if (!visible.count(hExplorer)) m_stats.ghost++;
+        });
+        std::wstring path;
+        for (const auto& kv : m_windows) {
+            const FakeWindow& w = kv.second;
+            if (!w.visible) continue;
+            int n = perExplorer[w.hwnd];
+            if (n == 0) { m_stats.missing++; continue; }
+            if (n > 1) m_stats.duplicate++;
+            if (!m_host.OverlayPath(w.hwnd, path) || path != w.path) m_stats.stale++;
+        }
+    }
+
+    IReplayWindows<Handle>& m_host;
+    BasicReplayShellBackend<Handle>& m_shell;
+    std::filesystem::path m_root;
+    std::unordered_map<int, FakeWindow> m_windows;
+    std::unordered_map<Handle, Expect> m_expect;
+    ReplayStats m_stats;
+};
@@ -0,0 +1,211 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/memo_buffer.h"
+#include "core/trace.h"
+
+// --- [저장 파이프라인] ---
+// [PRD 5.3] 백그라운드 저장 큐 (Coalescing Save Queue)
+// -> 키 입력마다 UI 스레드에서 파일 전체를 다시 쓰던 병목 제거. 경로별 '최신 내용'만 보관하고 전용 Writer 스레드가 기록.
+// -> Flow: Submit(경로, 내용) -> 입력이 SAVE_IDLE_MS 동안 멈추면 기록 (계속 입력 중이어도 SAVE_MAX_LATENCY_MS 안에는 반드시 기록)
+// -> 스케줄링은 std만 사용하고 실제 기록은 주입된 writer가 담당 (플랫폼 독립, 가짜 writer로 벤치마크 가능)
+// -> [PRD 5.10] 기록 실패 시 주입된 retry가 대기 시간을 주면 그 시각 이후로 다시 대기열에 (그 사이 새 입력이 오면 최신 내용으로)
+// -> [PRD 5.11] 내용 = 편집 버퍼 자체 (제출은 포인터만). Writer가 기록 직전에 버퍼의 UTF-8 사본을 받아 씀
+//    사본은 공유 포인터 그대로 writer에 -> 내용 캐시/버전 기록/색인이 복사 없이 같은 사본을 들고 감
+const int SAVE_IDLE_MS = 500;
+const int SAVE_MAX_LATENCY_MS = 3000;
+
+class MemoSaveQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+    using WriteFn = std::function<bool(const std::wstring& folderPath, const std::shared_ptr<const std::string>& bytes)>;
+    using RetryFn = std::function<int(const std::wstring& folderPath)>; // 실패한 기록을 다시 시도할 대기(ms), 음수면 포기
+
+    explicit MemoSaveQueue(WriteFn writer, RetryFn retry = nullptr) : m_writer(std::move(writer)), m_retry(std::move(retry)) {}
+    ~MemoSaveQueue() { Stop(); }
+
+    void Start() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_thread.joinable()) return;
+        m_stop = false;
+        m_thread = std::thread(&MemoSaveQueue::Run, this);
+    }
+
+    // UI 스레드: 버퍼만 넘기고 즉시 반환 (복사/인코딩/디스크 I/O 없음)
+    void Submit(const std::wstring& folderPath, std::shared_ptr<MemoBuffer> buffer) {
+        if (folderPath.empty() || !buffer) return;
+        Clock::time_point now = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_pending.find(folderPath);
+            if (it == m_pending.end()) {
+                m_pending.emplace(folderPath, Pending{ std::move(buffer), now, now });
+            } else {
+                it->second.buffer = std::move(buffer); // 연속 입력은 최신 내용 하나로 병합
+                it->second.last = now;
+            }
+            m_submitted++;
+        }
+        m_cv.notify_one();
+    }
+
+    // 아직 디스크에 반영되지 않은 최신 내용 조회 -> 저장 직후 같은 폴더로 돌아왔을 때 옛 내용이 보이는 문제 방지
+    std::shared_ptr<MemoBuffer> TryGetPending(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pending.find(folderPath);
+        if (it != m_pending.end()) return it->second.buffer;
+        auto fit = m_inFlight.find(folderPath);
+        if (fit != m_inFlight.end()) return fit->second;
+        return nullptr;
+    }
+
+    // [PRD 5.8] 아직 기록 안 된 내용이 있는지 (대기 + 기록 중)
+    bool HasPending(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending.count(folderPath) != 0 || m_inFlight.count(folderPath) != 0;
+    }
+
+    // [PRD 5.8] 대기 중인 내용 폐기 (병합 충돌 -> 화면 내용이 디스크 변경을 덮어쓰지 않도록)
+    void Discard(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.erase(folderPath);
+    }
+
+    // [PRD 5.3.1] 종료 시 즉시 기록 -> WM_CLOSE/WM_DESTROY에서 호출, 기록 완료까지 대기
+    void Flush(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> writeLock(m_writeMutex);
+        std::shared_ptr<MemoBuffer> buffer;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_pending.find(folderPath);
+            if (it == m_pending.end()) return;
+            buffer = std::move(it->second.buffer);
+            m_pending.erase(it);
+        }
+        WriteOne(folderPath, buffer);
+    }
+
+    void FlushAll() {
+        std::lock_guard<std::mutex> writeLock(m_writeMutex);
+        std::unordered_map<std::wstring, Pending> batch;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            batch.swap(m_pending);
+        }
+        for (auto& kv : batch) WriteOne(kv.first, kv.second.buffer);
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_thread.joinable()) return;
+            m_stop = true;
+        }
+        m_cv.notify_one();
+        m_thread.join();
+        FlushAll();
+    }
+
+    unsigned long long SubmittedCount() { std::lock_guard<std::mutex> lock(m_mutex); return m_submitted; }
+    unsigned long long WrittenCount() { std::lock_guard<std::mutex> lock(m_mutex); return m_written; }
+    unsigned long long RetriedCount() { std::lock_guard<std::mutex> lock(m_mutex); return m_retried; }
+    size_t PendingCount() { std::lock_guard<std::mutex> lock(m_mutex); return m_pending.size(); }
+
+private:
+    struct Pending {
+        std::shared_ptr<MemoBuffer> buffer;
+        Clock::time_point first; // 병합 구간의 첫 입력 (최대 지연 기준)
+        Clock::time_point last;  // 마지막 입력 (유휴 기준)
+        Clock::time_point retryAt = Clock::time_point::min(); // [PRD 5.10] 실패한 기록 -> 이 시각 전에는 다시 쓰지 않음
+    };
+
+    static Clock::time_point DueTime(const Pending& p) {
+        Clock::time_point idleDue = p.last + std::chrono::milliseconds(SAVE_IDLE_MS);
+        Clock::time_point maxDue = p.first + std::chrono::milliseconds(SAVE_MAX_LATENCY_MS);
+        Clock::time_point due = idleDue < maxDue ? idleDue : maxDue;
+        return due < p.retryAt ? p.retryAt : due;
+    }
+
+    void WriteOne(const std::wstring& folderPath, const std::shared_ptr<MemoBuffer>& buffer) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_inFlight[folderPath] = buffer;
+        }
+        std::shared_ptr<const std::string> bytes = buffer->Snapshot(); // 이후 입력은 다음 기록으로
+        bool ok = m_writer(folderPath, bytes);
+        int retryMs = !ok && m_retry ? m_retry(folderPath) : -1;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_inFlight.erase(folderPath);
+            m_written++;
+            if (retryMs < 0) return;
+            // [PRD 5.10] 다시 대기열로. 기록 중에 새 입력이 들어왔으면 그 내용을 같은 시각 이후로 미룸
+            Clock::time_point now = Clock::now(), at = now + std::chrono::milliseconds(retryMs);
+            auto it = m_pending.find(folderPath);
+            if (it == m_pending.end()) it = m_pending.emplace(folderPath, Pending{ buffer, now, now }).first;
+            if (it->second.retryAt < at) it->second.retryAt = at;
+            m_retried++;
+        }
+        m_cv.notify_one(); // UI 스레드의 Flush에서 실패한 경우 Writer가 새 마감을 보도록
+    }
+
+    // Writer 스레드 -> 가장 빠른 마감 시각까지만 대기 (Polling 없음)
+    // -> 락 순서: m_writeMutex -> m_mutex (Flush와 동일, 오래된 내용이 새 내용을 덮어쓰는 역전 방지)
+    void Run() {
+        FM_TRACE_THREAD("writer"); // [PRD 7.1]
+        for (;;) {
+            std::vector<std::pair<std::wstring, std::shared_ptr<MemoBuffer>>> due;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                for (;;) {
+                    if (m_stop) return;
+                    if (m_pending.empty()) { m_cv.wait(lock); continue; }
+                    Clock::time_point next = Clock::time_point::max();
+                    for (const auto& kv : m_pending) {
+                        Clock::time_point t = DueTime(kv.second);
+                        if (t < next) next = t;
+                    }
+                    if (next <= Clock::now()) break;
+                    m_cv.wait_until(lock, next);
+                }
+            }
+
+            std::lock_guard<std::mutex> writeLock(m_writeMutex);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                Clock::time_point now = Clock::now();
+                for (auto it = m_pending.begin(); it != m_pending.end();) {
+                    if (DueTime(it->second) <= now) {
+                        due.emplace_back(it->first, std::move(it->second.buffer));
+                        it = m_pending.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            for (auto& item : due) WriteOne(item.first, item.second);
+        }
+    }
+
+    WriteFn m_writer;
+    RetryFn m_retry;
+    std::mutex m_mutex;      // m_pending / m_inFlight / 카운터 보호
+    std::mutex m_writeMutex; // 디스크 기록 직렬화
+    std::condition_variable m_cv;
+    std::unordered_map<std::wstring, Pending> m_pending;
+    std::unordered_map<std::wstring, std::shared_ptr<MemoBuffer>> m_inFlight;
+    std::thread m_thread;
+    bool m_stop = false;
+    unsigned long long m_submitted = 0;
+    unsigned long long m_written = 0;
+    unsigned long long m_retried = 0;
+};
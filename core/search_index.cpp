@@ -0,0 +1,311 @@
+#include "core/search_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "core/grams.h"
+
+namespace fs = std::filesystem;
+
+bool MemoSearchIndex::Open(const fs::path& imagePath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_imagePath = imagePath;
+    return MapImageLocked();
+}
+
+void MemoSearchIndex::UpdateDocument(const std::wstring& folderPath, const std::string& bytes, long long mtime, unsigned long long size) {
+    DeltaDoc doc;
+    doc.mtime = mtime;
+    doc.size = size;
+    ExtractGramsUtf8(bytes.data(), bytes.size(), doc.grams);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_deferred.erase(folderPath);
+    ApplyLocked(folderPath, std::move(doc));
+}
+
+void MemoSearchIndex::UpdateDocumentLater(const std::wstring& folderPath, std::shared_ptr<const std::string> bytes, long long mtime, unsigned long long size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_deferred[folderPath] = Deferred{ std::move(bytes), mtime, size };
+    if (m_deferred.size() > DEFERRED_MAX_DOCS) FlushDeferredLocked();
+}
+
+void MemoSearchIndex::RemoveDocument(const std::wstring& folderPath) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_deferred.erase(folderPath);
+    TombstoneBaseLocked(folderPath);
+    m_delta.erase(folderPath);
+    m_removed.insert(folderPath);
+}
+
+bool MemoSearchIndex::IsUpToDate(const std::wstring& folderPath, long long mtime, unsigned long long size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto pit = m_deferred.find(folderPath);
+    if (pit != m_deferred.end()) return pit->second.mtime == mtime && pit->second.size == size;
+    auto dit = m_delta.find(folderPath);
+    if (dit != m_delta.end()) return dit->second.mtime == mtime && dit->second.size == size;
+    if (m_removed.count(folderPath)) return false;
+    auto bit = m_baseIdByPath.find(folderPath);
+    if (bit == m_baseIdByPath.end()) return false;
+    const DocEntry& d = BaseDocs()[bit->second];
+    return d.mtime == mtime && d.size == size;
+}
+
+std::vector<std::wstring> MemoSearchIndex::AllPaths() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FlushDeferredLocked();
+    std::vector<std::wstring> out;
+    for (const auto& kv : m_baseIdByPath) if (!m_tombstones.count(kv.second)) out.push_back(kv.first);
+    for (const auto& kv : m_delta) out.push_back(kv.first);
+    return out;
+}
+
+std::vector<std::wstring> MemoSearchIndex::Query(const std::wstring& query, size_t limit) {
+    std::vector<uint32_t> grams;
+    ExtractGrams(query, grams);
+    std::vector<std::wstring> results;
+    if (grams.empty()) return results;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FlushDeferredLocked();
+    if (m_map.Data()) {
+        std::vector<std::pair<const uint32_t*, uint32_t>> lists;
+        for (uint32_t g : grams) {
+            const GramEntry* e = FindGramLocked(g);
+            if (!e) { lists.clear(); break; }
+            lists.emplace_back(Postings() + e->postingOffset, e->count);
+        }
+        if (!lists.empty()) {
+            std::sort(lists.begin(), lists.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+            std::vector<uint32_t> cur(lists[0].first, lists[0].first + lists[0].second), next;
+            for (size_t i = 1; i < lists.size() && !cur.empty(); i++) {
+                next.clear();
+                std::set_intersection(cur.begin(), cur.end(), lists[i].first, lists[i].first + lists[i].second, std::back_inserter(next));
+                cur.swap(next);
+            }
+            for (uint32_t id : cur) {
+                if (m_tombstones.count(id)) continue;
+                results.push_back(BasePathLocked(id));
+                if (results.size() >= limit) return results;
+            }
+        }
+    }
+    for (const auto& kv : m_delta) {
+        if (std::includes(kv.second.grams.begin(), kv.second.grams.end(), grams.begin(), grams.end())) {
+            results.push_back(kv.first);
+            if (results.size() >= limit) break;
+        }
+    }
+    return results;
+}
+
+bool MemoSearchIndex::NeedsMerge() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_delta.size() + m_removed.size() + m_deferred.size() >= MERGE_DELTA_DOCS;
+}
+
+bool MemoSearchIndex::Merge() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FlushDeferredLocked();
+    if (m_delta.empty() && m_removed.empty() && m_tombstones.empty() && m_map.Data()) return true;
+
+    std::vector<std::wstring> paths;
+    std::vector<DocEntry> docs;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+    std::vector<uint32_t> remap(BaseDocCount(), UINT32_MAX);
+
+    for (uint32_t id = 0; id < BaseDocCount(); id++) {
+        if (m_tombstones.count(id)) continue;
+        remap[id] = (uint32_t)docs.size();
+        docs.push_back(BaseDocs()[id]);
+        paths.push_back(BasePathLocked(id));
+    }
+    if (m_map.Data()) {
+        const GramEntry* grams = Grams();
+        for (uint32_t i = 0; i < Header()->gramCount; i++) {
+            const uint32_t* list = Postings() + grams[i].postingOffset;
+            for (uint32_t k = 0; k < grams[i].count; k++) {
+                if (remap[list[k]] != UINT32_MAX) postings[grams[i].gram].push_back(remap[list[k]]);
+            }
+        }
+    }
+    for (const auto& kv : m_delta) {
+        uint32_t id = (uint32_t)docs.size();
+        DocEntry d = {};
+        d.mtime = kv.second.mtime;
+        d.size = kv.second.size;
+        docs.push_back(d);
+        paths.push_back(kv.first);
+        for (uint32_t g : kv.second.grams) postings[g].push_back(id); // id가 증가 순이라 정렬 유지
+    }
+
+    std::string image;
+    BuildImage(paths, docs, postings, image);
+    m_map.Close(); // 교체 전 매핑 해제 (Windows는 매핑된 파일 교체 불가)
+    bool ok = WriteFileAtomic(m_imagePath, image);
+    MapImageLocked();
+    if (ok) { m_delta.clear(); m_removed.clear(); m_tombstones.clear(); }
+    return ok;
+}
+
+size_t MemoSearchIndex::DocumentCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FlushDeferredLocked();
+    return BaseDocCount() - m_tombstones.size() + m_delta.size();
+}
+
+void MemoSearchIndex::ApplyLocked(const std::wstring& folderPath, DeltaDoc&& doc) {
+    TombstoneBaseLocked(folderPath);
+    if (doc.grams.empty()) { m_delta.erase(folderPath); m_removed.insert(folderPath); return; }
+    m_removed.erase(folderPath);
+    m_delta[folderPath] = std::move(doc);
+}
+
+void MemoSearchIndex::FlushDeferredLocked() {
+    for (auto& kv : m_deferred) {
+        DeltaDoc doc;
+        doc.mtime = kv.second.mtime;
+        doc.size = kv.second.size;
+        ExtractGramsUtf8(kv.second.bytes->data(), kv.second.bytes->size(), doc.grams);
+        ApplyLocked(kv.first, std::move(doc));
+    }
+    m_deferred.clear();
+}
+
+std::wstring MemoSearchIndex::BasePathLocked(uint32_t id) const {
+    const DocEntry& d = BaseDocs()[id];
+    const uint16_t* p = Pool() + d.pathOffset;
+    return std::wstring(p, p + d.pathLen);
+}
+
+const MemoSearchIndex::GramEntry* MemoSearchIndex::FindGramLocked(uint32_t gram) const {
+    const GramEntry* first = Grams();
+    const GramEntry* last = first + Header()->gramCount;
+    const GramEntry* it = std::lower_bound(first, last, gram, [](const GramEntry& e, uint32_t g) { return e.gram < g; });
+    return (it != last && it->gram == gram) ? it : nullptr;
+}
+
+void MemoSearchIndex::TombstoneBaseLocked(const std::wstring& folderPath) {
+    auto it = m_baseIdByPath.find(folderPath);
+    if (it != m_baseIdByPath.end()) m_tombstones.insert(it->second);
+}
+
+bool MemoSearchIndex::MapImageLocked() {
+    m_baseIdByPath.clear();
+    if (!m_map.Open(m_imagePath)) return false;
+    const ImageHeader* h = Header();
+    bool valid = m_map.Size() >= sizeof(ImageHeader) && h->magic == IMAGE_MAGIC && h->version == 1;
+    if (valid) {
+        uint64_t need = sizeof(ImageHeader) + (uint64_t)h->docCount * sizeof(DocEntry) + (uint64_t)h->gramCount * sizeof(GramEntry) +
+                        h->postingCount * sizeof(uint32_t) + h->poolChars * sizeof(uint16_t);
+        valid = m_map.Size() >= need;
+    }
+    if (!valid) { m_map.Close(); return false; }
+    for (uint32_t id = 0; id < h->docCount; id++) m_baseIdByPath[BasePathLocked(id)] = id;
+    return true;
+}
+
+void MemoSearchIndex::BuildImage(const std::vector<std::wstring>& paths, std::vector<DocEntry>& docs,
+                                 const std::unordered_map<uint32_t, std::vector<uint32_t>>& postings, std::string& out) {
+    std::vector<uint32_t> gramKeys;
+    gramKeys.reserve(postings.size());
+    uint64_t postingCount = 0;
+    for (const auto& kv : postings) { gramKeys.push_back(kv.first); postingCount += kv.second.size(); }
+    std::sort(gramKeys.begin(), gramKeys.end());
+
+    // 경로 풀은 u16 (Windows wchar_t 그대로, Linux의 u32 wchar_t는 BMP 밖 글자가 잘림 -> 폴더 이름에서는 드묾)
+    std::vector<uint16_t> pool;
+    for (size_t i = 0; i < docs.size(); i++) {
+        docs[i].pathOffset = pool.size();
+        docs[i].pathLen = (uint32_t)paths[i].size();
+        for (wchar_t c : paths[i]) pool.push_back((uint16_t)c);
+    }
+
+    ImageHeader h = { IMAGE_MAGIC, 1, (uint32_t)docs.size(), (uint32_t)gramKeys.size(), postingCount, pool.size() };
+    out.clear();
+    out.append((const char*)&h, sizeof(h));
+    out.append((const char*)docs.data(), docs.size() * sizeof(DocEntry));
+    uint64_t offset = 0;
+    for (uint32_t g : gramKeys) {
+        GramEntry e = { g, (uint32_t)postings.at(g).size(), offset };
+        out.append((const char*)&e, sizeof(e));
+        offset += e.count;
+    }
+    for (uint32_t g : gramKeys) {
+        const std::vector<uint32_t>& list = postings.at(g);
+        out.append((const char*)list.data(), list.size() * sizeof(uint32_t));
+    }
+    out.append((const char*)pool.data(), pool.size() * sizeof(uint16_t));
+}
+
+bool FolderMemoIndexSource::Read(const std::wstring& folderPath, std::string& bytes) {
+    std::error_code ec;
+    if (!fs::is_regular_file(MemoJournalStore::BasePath(folderPath), ec)) return false;
+    bytes = m_journal.Load(folderPath);
+    return true;
+}
+
+bool FolderMemoIndexSource::Stamp(const std::wstring& folderPath, long long& mtime, unsigned long long& size) {
+    std::error_code ec;
+    fs::path p = MemoJournalStore::BasePath(folderPath);
+    auto t = fs::last_write_time(p, ec);
+    if (ec) return false;
+    size = (unsigned long long)fs::file_size(p, ec);
+    mtime = (long long)t.time_since_epoch().count();
+    return !ec;
+}
+
+void MemoIndexer::Start(IMemoIndexSource* source, const std::vector<std::wstring>& roots) {
+    if (m_thread.joinable() || roots.empty()) return;
+    m_stop = false;
+    m_thread = std::thread([this, source, roots] { Crawl(*source, roots); });
+}
+
+void MemoIndexer::Stop() {
+    m_stop = true;
+    if (m_thread.joinable()) m_thread.join();
+}
+
+MemoIndexer::CrawlStats MemoIndexer::Crawl(IMemoIndexSource& source, const std::vector<std::wstring>& roots) {
+    CrawlStats stats;
+    std::unordered_set<std::wstring> seen;
+    auto visit = [&](const std::wstring& folder) {
+        seen.insert(folder);
+        stats.visited++;
+        long long mtime; unsigned long long size;
+        if (!source.Stamp(folder, mtime, size)) return;
+        if (m_index.IsUpToDate(folder, mtime, size)) return;
+        std::string bytes;
+        if (!source.Read(folder, bytes)) return;
+        m_index.UpdateDocument(folder, bytes, mtime, size);
+        stats.indexed++;
+        stats.bytes += bytes.size();
+        if (m_index.NeedsMerge()) m_index.Merge();
+    };
+    std::vector<std::wstring> listed;
+    if (source.ListFolders(listed)) {
+        for (const auto& folder : listed) {
+            if (m_stop) break;
+            if (IsUnderRoots(folder, roots)) visit(folder);
+        }
+    } else {
+        for (const auto& root : roots) {
+            std::error_code ec;
+            fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+            for (; !ec && it != end && !m_stop; it.increment(ec)) {
+                if (it->path().filename() != L"folder_memo.txt") continue;
+                visit(it->path().parent_path().wstring());
+            }
+        }
+    }
+    if (m_stop) return stats;
+    for (const auto& path : m_index.AllPaths()) {
+        if (IsUnderRoots(path, roots) && !seen.count(path)) { m_index.RemoveDocument(path); stats.removed++; }
+    }
+    m_index.Merge();
+    return stats;
+}
+
+bool MemoIndexer::IsUnderRoots(const std::wstring& path, const std::vector<std::wstring>& roots) {
+    for (const auto& root : roots) if (path.compare(0, root.size(), root) == 0) return true;
+    return false;
+}
\ No newline at end of file
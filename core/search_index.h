@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/file_io.h"
+#include "core/journal.h"
+
+// --- [전역 메모 검색] ---
+// [PRD 6.1] 전역 역색인 (Persistent Inverted Index)
+// -> 디스크 이미지(memo_index.bin)는 메모리 매핑해 그대로 질의 (시작 시 전체 로드 없음).
+// -> 이후 변경(오버레이 저장, 크롤 결과)은 메모리 델타에 쌓고, 기준 이미지의 해당 문서는 Tombstone 처리 -> 주기적으로 병합해 새 이미지로 교체.
+// -> 이미지 포맷: [Header][DocEntry × docCount][GramEntry × gramCount (gram 오름차순)][u32 posting × postingCount][u16 경로 풀]
+// -> [PRD 5.11] 오버레이 저장은 gram 추출을 미룸 (UpdateDocumentLater): 저장 사본 포인터만 들고 있다가 질의/병합/목록 조회 때 한 번 추출.
+//    같은 메모를 계속 저장하면 사본만 바뀜 -> 저장마다 수 MB 디코드 + gram 추출이 없음. 미룬 문서가 쌓이면 Writer가 한 번에 추출.
+// -> 매핑/기록은 MappedFile/WriteFileAtomic(core/file_io.h)만 사용 -> Win32 앱과 fm_search/Linux 벤치가 같은 코드.
+class MemoSearchIndex {
+public:
+    static constexpr size_t MERGE_DELTA_DOCS = 256; // 델타가 이만큼 쌓이면 병합
+    static constexpr size_t DEFERRED_MAX_DOCS = 32; // 미룬 문서 상한 (사본을 오래 붙잡지 않도록)
+
+    bool Open(const std::filesystem::path& imagePath);
+
+    // 오버레이 저장/크롤러 -> 문서 하나 갱신 (빈 내용이면 제거)
+    // 크롤러 (bytes = 저장소에서 읽은 UTF-8)
+    void UpdateDocument(const std::wstring& folderPath, const std::string& bytes, long long mtime, unsigned long long size);
+    // 오버레이 저장 (Writer 스레드) -> 사본 포인터만 보관, 추출은 필요할 때
+    void UpdateDocumentLater(const std::wstring& folderPath, std::shared_ptr<const std::string> bytes, long long mtime, unsigned long long size);
+    void RemoveDocument(const std::wstring& folderPath);
+
+    // 크롤러의 증분 판단 -> 색인 시점과 mtime/크기가 같으면 다시 읽지 않음
+    bool IsUpToDate(const std::wstring& folderPath, long long mtime, unsigned long long size);
+    // 색인된 전체 경로 (크롤 후 사라진 메모 정리용)
+    std::vector<std::wstring> AllPaths();
+    // 질의의 모든 gram을 포함하는 폴더 목록 (짧은 posting부터 교집합)
+    std::vector<std::wstring> Query(const std::wstring& query, size_t limit = 100);
+
+    bool NeedsMerge();
+    // 기준 이미지 + 델타 -> 새 이미지 기록(원자적 교체) 후 다시 매핑
+    bool Merge();
+    size_t DocumentCount();
+
+private:
+    struct ImageHeader {
+        uint32_t magic;   // 'FMIX'
+        uint32_t version;
+        uint32_t docCount;
+        uint32_t gramCount;
+        uint64_t postingCount;
+        uint64_t poolChars;
+    };
+    struct DocEntry {
+        uint64_t pathOffset; // 경로 풀 내 위치 (u16 단위)
+        uint32_t pathLen;
+        uint32_t reserved;
+        int64_t mtime;
+        uint64_t size;
+    };
+    struct GramEntry {
+        uint32_t gram;
+        uint32_t count;
+        uint64_t postingOffset;
+    };
+    struct DeltaDoc {
+        long long mtime = 0;
+        unsigned long long size = 0;
+        std::vector<uint32_t> grams;
+    };
+    struct Deferred {
+        std::shared_ptr<const std::string> bytes;
+        long long mtime;
+        unsigned long long size;
+    };
+    static constexpr uint32_t IMAGE_MAGIC = 0x58494D46; // "FMIX"
+
+    void ApplyLocked(const std::wstring& folderPath, DeltaDoc&& doc);
+    void FlushDeferredLocked();
+
+    const ImageHeader* Header() const { return (const ImageHeader*)m_map.Data(); }
+    uint32_t BaseDocCount() const { return m_map.Data() ? Header()->docCount : 0; }
+    const DocEntry* BaseDocs() const { return (const DocEntry*)(m_map.Data() + sizeof(ImageHeader)); }
+    const GramEntry* Grams() const { return (const GramEntry*)(BaseDocs() + Header()->docCount); }
+    const uint32_t* Postings() const { return (const uint32_t*)(Grams() + Header()->gramCount); }
+    const uint16_t* Pool() const { return (const uint16_t*)(Postings() + Header()->postingCount); }
+
+    std::wstring BasePathLocked(uint32_t id) const;
+    const GramEntry* FindGramLocked(uint32_t gram) const;
+    void TombstoneBaseLocked(const std::wstring& folderPath);
+    // 이미지 매핑 + 구조 검증 (손상 시 빈 색인으로 시작 -> 다음 크롤에서 재구축)
+    bool MapImageLocked();
+    static void BuildImage(const std::vector<std::wstring>& paths, std::vector<DocEntry>& docs,
+                           const std::unordered_map<uint32_t, std::vector<uint32_t>>& postings, std::string& out);
+
+    std::mutex m_mutex;
+    std::filesystem::path m_imagePath;
+    MappedFile m_map;
+    std::unordered_map<std::wstring, uint32_t> m_baseIdByPath;
+    std::unordered_set<uint32_t> m_tombstones;
+    std::unordered_map<std::wstring, DeltaDoc> m_delta;
+    std::unordered_set<std::wstring> m_removed;
+    std::unordered_map<std::wstring, Deferred> m_deferred; // 추출을 미룬 오버레이 저장분
+};
+
+// [PRD 6.1] 색인기가 메모를 읽는 경계 -> Win32 앱은 IMemoStorage(폴더/중앙 저장소), CLI/벤치는 FolderMemoIndexSource
+// -> 여러 스레드에서 호출될 수 있음
+class IMemoIndexSource {
+public:
+    virtual ~IMemoIndexSource() {}
+    virtual bool Read(const std::wstring& folderPath, std::string& bytes) = 0;
+    virtual bool Stamp(const std::wstring& folderPath, long long& mtime, unsigned long long& size) = 0;
+    // 저장소가 메모 목록을 직접 알면 true (색인기가 디렉터리를 훑지 않아도 됨)
+    virtual bool ListFolders(std::vector<std::wstring>& folders) = 0;
+};
+
+// [PRD 6.1] 폴더별 folder_memo.txt (+ 남은 저널 재생, LoadMemo와 같은 읽기). 스탬프는 파일 수정 시각/크기
+class FolderMemoIndexSource : public IMemoIndexSource {
+public:
+    bool Read(const std::wstring& folderPath, std::string& bytes) override;
+    bool Stamp(const std::wstring& folderPath, long long& mtime, unsigned long long& size) override;
+    bool ListFolders(std::vector<std::wstring>&) override { return false; }
+
+private:
+    MemoJournalStore m_journal;
+};
+
+// [PRD 6.1] 백그라운드 색인기 (Crawler)
+// -> 설정된 루트 아래 folder_memo.txt를 찾아 바뀐 것만 다시 읽음 (gram은 UTF-8에서 바로).
+// -> 크롤이 끝나면 사라진 메모를 색인에서 제거하고 이미지 병합. 우선순위를 낮게 두고 한 번만 돈 뒤 종료 (상시 감시 없음).
+class MemoIndexer {
+public:
+    struct CrawlStats {
+        unsigned long long visited = 0;  // 찾은 메모
+        unsigned long long indexed = 0;  // 새로/다시 읽은 메모
+        unsigned long long bytes = 0;    // 읽은 UTF-8 바이트
+        unsigned long long removed = 0;  // 사라져서 뺀 메모
+    };
+
+    explicit MemoIndexer(MemoSearchIndex& index) : m_index(index) {}
+    ~MemoIndexer() { Stop(); }
+
+    void Start(IMemoIndexSource* source, const std::vector<std::wstring>& roots);
+    void Stop();
+
+    // 동기 크롤 (명령줄 --reindex, fm_search index)
+    // [PRD 5.7] 저장소가 목록을 알면(중앙 저장소) 디렉터리를 훑지 않고 루트 아래 항목만 확인
+    CrawlStats Crawl(IMemoIndexSource& source, const std::vector<std::wstring>& roots);
+
+private:
+    static bool IsUnderRoots(const std::wstring& path, const std::vector<std::wstring>& roots);
+
+    MemoSearchIndex& m_index;
+    std::thread m_thread;
+    std::atomic<bool> m_stop{ false };
+};
\ No newline at end of file
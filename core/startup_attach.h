@@ -0,0 +1,67 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/explorer_paths.h"
+
+// --- [시작 시 일괄 부착] ---
+// [PRD 3.2.3] 프로그램 시작 시 이미 열려 있던 탐색기 창에 한꺼번에 부착
+// -> 창마다 경로 작업을 넣으면 창 수만큼 Shell 전체 나열 + 메모 읽기가 워커 3개에서 줄을 섬.
+// -> 창 목록을 한 번에 모아 Shell 나열 1회(ResolveAll)로 모든 경로를 해석하고, 메모는 여러 스레드로 나눠 미리 읽음.
+// -> 창 나열/오버레이 생성/결과 전달은 호출자 몫 (Win32는 main.cpp의 AttachExistingExplorers) -> Linux 벤치가 가짜 Shell로 구동.
+const int STARTUP_PRELOAD_THREADS = 8;
+
+template <typename Handle>
+struct BasicStartupWindow {
+    Handle hExplorer;
+    Handle hOverlay;
+    std::wstring title;
+    unsigned long long generation;
+};
+
+struct StartupAttachStats {
+    double resolveMs = 0;
+    double preloadMs = 0;
+    size_t resolved = 0;
+    size_t preloaded = 0;
+};
+
+// 해석 후 창마다 preload(i, path)를 스레드 여러 개에 나눠 호출 (경로를 못 찾은 창도 호출됨 -> path가 비어 있음)
+// -> preload는 메모를 미리 읽었으면 true. 모두 끝난 뒤 반환 -> 호출자가 결과를 한꺼번에 전달
+template <typename Handle, typename PreloadFn>
+StartupAttachStats RunStartupAttach(BasicExplorerPathResolver<Handle>& resolver, const std::vector<BasicStartupWindow<Handle>>& windows,
+    std::vector<std::wstring>& paths, PreloadFn preload, size_t maxThreads = STARTUP_PRELOAD_THREADS) {
+    StartupAttachStats stats;
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::pair<Handle, std::wstring>> query;
+    query.reserve(windows.size());
+    for (const auto& w : windows) query.emplace_back(w.hExplorer, w.title);
+    resolver.ResolveAll(query, paths);
+    for (const auto& p : paths) stats.resolved += !p.empty();
+    auto tResolved = std::chrono::steady_clock::now();
+
+    std::atomic<size_t> next{ 0 };
+    std::atomic<size_t> preloaded{ 0 };
+    auto work = [&] {
+        for (size_t i; (i = next.fetch_add(1)) < windows.size();) {
+            if (preload(i, paths[i])) preloaded++;
+        }
+    };
+    // 코어 수로 줄이지 않음 -> 미리 읽기는 대부분 I/O 대기 (네트워크/찬 디스크). 코어 1~2개 PC에서도 읽기가 겹쳐야 함
+    size_t threadCount = std::min(windows.size(), maxThreads);
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < threadCount; i++) helpers.emplace_back(work);
+    work();
+    for (auto& t : helpers) t.join();
+    auto tLoaded = std::chrono::steady_clock::now();
+
+    stats.preloaded = preloaded;
+    stats.resolveMs = std::chrono::duration<double, std::milli>(tResolved - t0).count();
+    stats.preloadMs = std::chrono::duration<double, std::milli>(tLoaded - tResolved).count();
+    return stats;
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+#include "core/journal.h"
+
+// [PRD 3.3] 저장소 스탬프 (존재 캐시와 내용 캐시 공용)
+struct MemoStat {
+    bool exists = false;
+    long long mtime = 0;
+    unsigned long long size = 0;
+};
+
+// --- [메모 존재 캐시] ---
+// [PRD 3.3] 메모 존재/메타데이터 캐시 (Positive + Negative Cache)
+// -> 폴더 이동마다 folder_memo.txt를 stat하던 비용 제거 (UNC/클라우드 동기화 폴더는 한 번에 수백 ms, 재방문 때마다 반복).
+// -> '없음'도 캐시 -> 메모 없는 폴더를 다시 방문해도 디스크 접근 없음.
+// -> 정확성: 변경 알림이 걸린 폴더는 알림이 올 때까지 유효(긴 TTL은 안전망), 알림을 걸 수 없는 폴더는 짧은 TTL로 만료.
+// -> stat 도중 무효화가 끼어들면 그 결과는 캐시하지 않음 (무효화 세대 비교) -> 옛 결과가 알림 뒤에 덮어쓰는 경합 차단.
+// -> 알림 백엔드는 StatMemoCached의 템플릿 인자 (Win32는 main.cpp의 DirectoryWatcher, Linux는 InotifyDirectoryWatcher). 계약은 core/dir_watcher.h
+class MemoStatCache {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int UNWATCHED_TTL_MS = 5000; // 알림 없는 폴더
+    static constexpr int WATCHED_TTL_SEC = 600;   // 알림 누락 대비 안전망
+    static constexpr size_t MAX_ENTRIES = 4096;
+
+    // TTL은 테스트가 짧게 줄 수 있도록 인자로 (앱은 기본값)
+    explicit MemoStatCache(int unwatchedTtlMs = UNWATCHED_TTL_MS, int watchedTtlSec = WATCHED_TTL_SEC)
+        : m_unwatchedTtl(unwatchedTtlMs), m_watchedTtl(watchedTtlSec) {}
+
+    // 적중이면 true. 미스면 epoch를 받아 두었다가 Store에 그대로 넘김
+    bool Lookup(const std::wstring& folderPath, MemoStat& out, uint64_t& epoch) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        epoch = m_epoch;
+        auto it = m_entries.find(folderPath);
+        if (it != m_entries.end() && Clock::now() < it->second.expires) {
+            out = it->second.stat;
+            m_hits++;
+            return true;
+        }
+        m_misses++;
+        return false;
+    }
+
+    void Store(const std::wstring& folderPath, const MemoStat& stat, bool watched, uint64_t epoch) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (epoch != m_epoch) { m_raced++; return; }
+        auto now = Clock::now();
+        if (m_entries.size() >= MAX_ENTRIES) {
+            for (auto it = m_entries.begin(); it != m_entries.end();) it = (it->second.expires <= now) ? m_entries.erase(it) : std::next(it);
+            if (m_entries.size() >= MAX_ENTRIES) m_entries.clear();
+        }
+        Entry& e = m_entries[folderPath];
+        e.stat = stat;
+        e.expires = watched ? now + m_watchedTtl : now + m_unwatchedTtl;
+    }
+
+    void Invalidate(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_epoch++;
+        if (m_entries.erase(folderPath)) m_invalidations++;
+    }
+
+    unsigned long long Hits() { std::lock_guard<std::mutex> lock(m_mutex); return m_hits; }
+    unsigned long long Misses() { std::lock_guard<std::mutex> lock(m_mutex); return m_misses; }
+    unsigned long long Invalidations() { std::lock_guard<std::mutex> lock(m_mutex); return m_invalidations; }
+    unsigned long long Raced() { std::lock_guard<std::mutex> lock(m_mutex); return m_raced; }
+
+private:
+    struct Entry {
+        MemoStat stat;
+        Clock::time_point expires;
+    };
+
+    std::mutex m_mutex;
+    std::chrono::milliseconds m_unwatchedTtl;
+    std::chrono::seconds m_watchedTtl;
+    std::unordered_map<std::wstring, Entry> m_entries;
+    uint64_t m_epoch = 0;
+    unsigned long long m_hits = 0;
+    unsigned long long m_misses = 0;
+    unsigned long long m_invalidations = 0;
+    unsigned long long m_raced = 0;
+};
+
+// folder_memo.txt 실제 stat (없거나 읽을 수 없으면 exists = false)
+inline MemoStat StatMemoFile(const std::wstring& folderPath) {
+    MemoStat st;
+    std::error_code ec;
+    std::filesystem::path p = MemoJournalStore::BasePath(folderPath);
+    auto t = std::filesystem::last_write_time(p, ec);
+    if (!ec) {
+        st.size = (unsigned long long)std::filesystem::file_size(p, ec);
+        st.mtime = (long long)t.time_since_epoch().count();
+        st.exists = !ec;
+    }
+    return st;
+}
+
+// [PRD 3.3] 캐시 적중이면 디스크 접근 없음. track이면 미스 결과를 캐시하고 감시 등록 (Watcher::Watch(폴더) -> 걸었으면 true)
+// -> 감시는 stat보다 먼저 걸어야 그 사이 변경을 놓치지 않음
+template <typename Watcher>
+MemoStat StatMemoCached(MemoStatCache& cache, Watcher& watcher, const std::wstring& folderPath, bool track) {
+    MemoStat st;
+    uint64_t epoch = 0;
+    if (cache.Lookup(folderPath, st, epoch)) return st;
+    bool watched = track && watcher.Watch(folderPath);
+    st = StatMemoFile(folderPath);
+    if (track) cache.Store(folderPath, st, watched, epoch);
+    return st;
+}
\ No newline at end of file
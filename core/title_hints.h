@@ -0,0 +1,41 @@
+#pragma once
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// --- [제목 -> 경로 추측] ---
+// [PRD 3.1.6] 창 제목 -> 마지막으로 해석된 경로 (UI 스레드 전용, LRU)
+// -> 폴더 이동 직후 실제 해석(COM)이 끝나기 전에, 같은 제목으로 최근 본 폴더의 메모를 먼저 보여 주기 위함.
+// -> 제목은 폴더 이름이라 겹칠 수 있음 -> 추측 표시는 읽기 전용, 실제 결과가 다르면 그대로 교체.
+const size_t TITLE_HINT_CAPACITY = 256;
+
+class TitlePathHints {
+public:
+    std::wstring Find(const std::wstring& title) {
+        auto it = m_map.find(title);
+        if (it == m_map.end()) return L"";
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return it->second->second;
+    }
+
+    void Remember(const std::wstring& title, const std::wstring& path) {
+        if (title.empty() || path.empty()) return;
+        auto it = m_map.find(title);
+        if (it != m_map.end()) {
+            it->second->second = path;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return;
+        }
+        m_lru.emplace_front(title, path);
+        m_map[title] = m_lru.begin();
+        if (m_lru.size() > TITLE_HINT_CAPACITY) {
+            m_map.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+    }
+
+private:
+    std::list<std::pair<std::wstring, std::wstring>> m_lru;
+    std::unordered_map<std::wstring, std::list<std::pair<std::wstring, std::wstring>>::iterator> m_map;
+};
\ No newline at end of file
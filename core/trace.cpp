@@ -0,0 +1,42 @@
+#include "core/trace.h"
+
+#include <cstdio>
+
+#if FM_TRACE
+namespace trace {
+
+void Tracer::WriteChromeJson(std::string& out) {
+    std::vector<std::pair<std::string, std::vector<Event>>> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& r : m_rings) {
+            threads.emplace_back(r->name, std::vector<Event>());
+            r->Snapshot(threads.back().second);
+        }
+    }
+    out.clear();
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    char buf[256];
+    bool first = true;
+    for (size_t t = 0; t < threads.size(); t++) {
+        int tid = (int)t + 1;
+        snprintf(buf, sizeof(buf), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",", tid, threads[t].first.c_str());
+        out += buf;
+        first = false;
+        for (const Event& e : threads[t].second) {
+            if (e.dur > 0) {
+                snprintf(buf, sizeof(buf), ",{\"name\":\"%s\",\"cat\":\"fm\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"id\":\"0x%llx\"}}",
+                    StageName(e.stage), tid, e.start / 1000.0, e.dur / 1000.0, (unsigned long long)e.id);
+            } else {
+                snprintf(buf, sizeof(buf), ",{\"name\":\"%s\",\"cat\":\"fm\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"id\":\"0x%llx\"}}",
+                    StageName(e.stage), tid, e.start / 1000.0, (unsigned long long)e.id);
+            }
+            out += buf;
+        }
+    }
+    out += "]}\n";
+}
+
+} // namespace trace
+#endif
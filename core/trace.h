@@ -0,0 +1,283 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// --- [지연 추적] ---
+// [PRD 7.1] 이벤트 -> 오버레이 표시 구간별 지연 추적 (스레드별 Lock-Free 링 버퍼 + 로그-선형 히스토그램)
+// -> 기록: 스레드마다 자기 링에만 씀 (락/할당 없음). 슬롯마다 순번(seq)을 둬서 덤프 중 덮어쓴 칸은 읽는 쪽이 버림.
+// -> 히스토그램: 2의 거듭제곱 구간마다 16칸 (오차 6.25% 이내, HDR 방식). 단계별 원자 카운터라 스레드 간 합산 불필요.
+// -> 기본은 FM_TRACE=0: 매크로가 모두 비워져 호출/데이터 0. 측정할 때만 FM_TRACE=1로 빌드 (CMake: -DFM_TRACE=ON).
+// -> Ctrl+Alt+Shift+T: Chrome trace-event JSON(chrome://tracing, Perfetto) 덤프 + 히스토그램 요약을 디버그 출력으로.
+#ifndef FM_TRACE
+#define FM_TRACE 0
+#endif
+
+#if FM_TRACE
+namespace trace {
+
+enum Stage : uint32_t {
+    WinEvent,       // WinEventProc 수신 (순간)
+    PathJob,        // 경로 탐색 작업 (워커 시작 ~ 결과 전달)
+    ResolvePath,    // GetExplorerPath 1회 (재시도마다)
+    MemoExists,     // 메모 존재 확인
+    ApplyResult,    // WM_UPDATE_UI_FromThread 처리
+    LoadMemo,       // 메모 읽기 + 변환
+    FirstPaint,     // 결과 적용 후 첫 WM_PAINT
+    SaveMemo,       // 메모 기록
+    EventToOverlay, // WinEvent 수신 ~ 첫 WM_PAINT (전체 파이프라인)
+    Paint,          // [PRD 4.6] WM_PAINT 처리 (외곽 복사)
+    STAGE_COUNT
+};
+
+inline const char* StageName(uint32_t s) {
+    static const char* const names[STAGE_COUNT] = {
+        "WinEvent", "PathJob", "ResolvePath", "MemoExists", "ApplyResult",
+        "LoadMemo", "FirstPaint", "SaveMemo", "EventToOverlay", "Paint",
+    };
+    return s < STAGE_COUNT ? names[s] : "?";
+}
+
+inline uint64_t NowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline int Msb64(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(v);
+#else
+    int n = 0;
+    while (v >>= 1) n++;
+    return n;
+#endif
+}
+
+// 로그-선형 히스토그램 (값 단위: ns). 16 미만은 그대로, 그 이상은 상위 5비트로 구간 결정.
+class Histogram {
+public:
+    static const int SUB_BITS = 4;
+    static const int SUB_COUNT = 1 << SUB_BITS;
+    static const int MAX_MSB = 42; // 약 73분 -> 그 이상은 마지막 칸
+    static const int BUCKETS = (MAX_MSB - SUB_BITS + 2) * SUB_COUNT;
+
+    static int BucketOf(uint64_t v) {
+        if (v < (uint64_t)SUB_COUNT) return (int)v;
+        int msb = Msb64(v);
+        if (msb > MAX_MSB) return BUCKETS - 1;
+        int shift = msb - SUB_BITS;
+        return (shift + 1) * SUB_COUNT + (int)((v >> shift) & (SUB_COUNT - 1));
+    }
+
+    // 구간의 하한/상한 (상한은 포함하지 않음)
+    static uint64_t BucketLow(int b) {
+        if (b < SUB_COUNT) return (uint64_t)b;
+        int shift = b / SUB_COUNT - 1;
+        return (uint64_t)(SUB_COUNT + b % SUB_COUNT) << shift;
+    }
+    static uint64_t BucketHigh(int b) {
+        if (b < SUB_COUNT) return (uint64_t)b + 1;
+        return BucketLow(b) + ((uint64_t)1 << (b / SUB_COUNT - 1));
+    }
+
+    void Record(uint64_t v) {
+        m_counts[BucketOf(v)].fetch_add(1, std::memory_order_relaxed);
+        m_total.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(v, std::memory_order_relaxed);
+        uint64_t prev = m_max.load(std::memory_order_relaxed);
+        while (v > prev && !m_max.compare_exchange_weak(prev, v, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t Count() const { return m_total.load(std::memory_order_relaxed); }
+    uint64_t Max() const { return m_max.load(std::memory_order_relaxed); }
+    uint64_t Mean() const { uint64_t n = Count(); return n ? m_sum.load(std::memory_order_relaxed) / n : 0; }
+
+    // q(0~1) 백분위수 -> 해당 구간 상한 (실제 값보다 최대 6.25% 큼, 최대값을 넘지 않음)
+    uint64_t Percentile(double q) const {
+        uint64_t counts[BUCKETS];
+        uint64_t total = 0;
+        for (int b = 0; b < BUCKETS; b++) { counts[b] = m_counts[b].load(std::memory_order_relaxed); total += counts[b]; }
+        if (total == 0) return 0;
+        uint64_t rank = (uint64_t)(q * (double)total + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > total) rank = total;
+        uint64_t seen = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            seen += counts[b];
+            if (seen >= rank) return std::min(BucketHigh(b) - 1, Max());
+        }
+        return Max();
+    }
+
+private:
+    std::atomic<uint64_t> m_counts[BUCKETS] = {};
+    std::atomic<uint64_t> m_total{ 0 };
+    std::atomic<uint64_t> m_sum{ 0 };
+    std::atomic<uint64_t> m_max{ 0 };
+};
+
+struct Event {
+    uint64_t start; // ns
+    uint64_t dur;   // ns (0이면 순간 이벤트)
+    uint64_t id;    // 상관 관계 키 (HWND 등)
+    uint32_t stage;
+};
+
+// 스레드 하나가 쓰고 덤프가 읽는 고정 크기 링 (단일 생산자). 가득 차면 가장 오래된 것부터 덮어씀.
+class Ring {
+public:
+    static const size_t SIZE = 4096; // 2의 거듭제곱
+
+    void Push(const Event& e) {
+        uint64_t h = m_head.load(std::memory_order_relaxed);
+        Slot& s = m_slots[h & (SIZE - 1)];
+        s.seq.store(h * 2 + 1, std::memory_order_relaxed); // 홀수 = 쓰는 중
+        std::atomic_thread_fence(std::memory_order_release);
+        s.start.store(e.start, std::memory_order_relaxed);
+        s.dur.store(e.dur, std::memory_order_relaxed);
+        s.id.store(e.id, std::memory_order_relaxed);
+        s.stage.store(e.stage, std::memory_order_relaxed);
+        s.seq.store(h * 2 + 2, std::memory_order_release);
+        m_head.store(h + 1, std::memory_order_release);
+    }
+
+    // 아무 스레드에서나 호출 -> 읽는 도중 덮어쓴 칸은 건너뜀
+    void Snapshot(std::vector<Event>& out) const {
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        uint64_t from = head > SIZE ? head - SIZE : 0;
+        for (uint64_t h = from; h < head; h++) {
+            const Slot& s = m_slots[h & (SIZE - 1)];
+            uint64_t seq = s.seq.load(std::memory_order_acquire);
+            if (seq != h * 2 + 2) continue;
+            Event e;
+            e.start = s.start.load(std::memory_order_relaxed);
+            e.dur = s.dur.load(std::memory_order_relaxed);
+            e.id = s.id.load(std::memory_order_relaxed);
+            e.stage = s.stage.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.seq.load(std::memory_order_relaxed) != seq) continue;
+            out.push_back(e);
+        }
+    }
+
+    uint64_t Written() const { return m_head.load(std::memory_order_relaxed); }
+
+    std::string name; // 덤프 시 스레드 이름 (등록 시 1회 기록)
+    std::atomic<bool> inUse{ false };
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq{ 0 };
+        std::atomic<uint64_t> start{ 0 };
+        std::atomic<uint64_t> dur{ 0 };
+        std::atomic<uint64_t> id{ 0 };
+        std::atomic<uint32_t> stage{ 0 };
+    };
+    Slot m_slots[SIZE];
+    std::atomic<uint64_t> m_head{ 0 };
+};
+
+// 링 목록 + 단계별 히스토그램. 링 등록은 스레드당 1회 (그때만 락). 끝난 스레드의 링은 다음 새 스레드가 재사용.
+class Tracer {
+public:
+    Ring* Acquire(const char* threadName) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& r : m_rings) {
+            bool expected = false;
+            if (r->inUse.compare_exchange_strong(expected, true)) { r->name = threadName; return r.get(); }
+        }
+        m_rings.emplace_back(new Ring());
+        Ring* r = m_rings.back().get();
+        r->inUse = true;
+        r->name = threadName;
+        return r;
+    }
+
+    void Release(Ring* r) { r->inUse = false; } // 기록은 남겨 둠 (재사용될 때까지 덤프 가능)
+
+    void Rename(Ring* r, const char* threadName) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        r->name = threadName;
+    }
+
+    Histogram& Hist(uint32_t stage) { return m_hist[stage < STAGE_COUNT ? stage : 0]; }
+
+    // Chrome trace-event 형식 ("X" = 구간, "i" = 순간, "M" = 스레드 이름). 시간 단위는 µs.
+    void WriteChromeJson(std::string& out);
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Ring>> m_rings;
+    Histogram m_hist[STAGE_COUNT];
+};
+
+inline Tracer& Global() {
+    static Tracer tracer;
+    return tracer;
+}
+
+// 스레드별 링 (처음 기록할 때 등록, 스레드 종료 시 반납)
+struct ThreadRing {
+    Ring* ring = nullptr;
+    const char* name = "thread";
+    ~ThreadRing() { if (ring) Global().Release(ring); }
+};
+inline ThreadRing& Local() {
+    thread_local ThreadRing local;
+    return local;
+}
+inline Ring* LocalRing() {
+    ThreadRing& l = Local();
+    if (!l.ring) l.ring = Global().Acquire(l.name);
+    return l.ring;
+}
+
+// 덤프에 표시할 스레드 이름 (이름은 정적 문자열)
+inline void NameThread(const char* name) {
+    ThreadRing& l = Local();
+    l.name = name;
+    if (l.ring) Global().Rename(l.ring, name);
+}
+
+inline void Record(uint32_t stage, uint64_t id, uint64_t start, uint64_t dur) {
+    LocalRing()->Push({ start, dur, id, stage });
+    if (dur > 0) Global().Hist(stage).Record(dur);
+}
+
+inline void Instant(uint32_t stage, uint64_t id) { Record(stage, id, NowNs(), 0); }
+
+class Scope {
+public:
+    Scope(uint32_t stage, uint64_t id) : m_stage(stage), m_id(id), m_start(NowNs()) {}
+    ~Scope() { uint64_t end = NowNs(); Record(m_stage, m_id, m_start, end > m_start ? end - m_start : 1); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+private:
+    uint32_t m_stage;
+    uint64_t m_id;
+    uint64_t m_start;
+};
+
+} // namespace trace
+#endif
+
+#define FM_TRACE_CAT2(a, b) a##b
+#define FM_TRACE_CAT(a, b) FM_TRACE_CAT2(a, b)
+#if FM_TRACE
+#define FM_TRACE_SCOPE(stage, id) trace::Scope FM_TRACE_CAT(fmTraceScope, __LINE__)(trace::stage, (uint64_t)(uintptr_t)(id))
+#define FM_TRACE_INSTANT(stage, id) trace::Instant(trace::stage, (uint64_t)(uintptr_t)(id))
+#define FM_TRACE_SPAN(stage, id, startNs) do { uint64_t fmEnd = trace::NowNs(); trace::Record(trace::stage, (uint64_t)(uintptr_t)(id), (startNs), fmEnd > (startNs) ? fmEnd - (startNs) : 1); } while (0)
+#define FM_TRACE_NOW() trace::NowNs()
+#define FM_TRACE_THREAD(name) trace::NameThread(name)
+#else
+#define FM_TRACE_SCOPE(stage, id) ((void)0)
+#define FM_TRACE_INSTANT(stage, id) ((void)0)
+#define FM_TRACE_SPAN(stage, id, startNs) ((void)0)
+#define FM_TRACE_NOW() 0ULL
+#define FM_TRACE_THREAD(name) ((void)0)
+#endif
@@ -0,0 +1,21 @@
+#include "core/utf.h"
+
+void Utf8ToWide(const char* data, size_t len, std::wstring& out) {
+    utf::Utf8ToUtf16<wchar_t>(data, len, out);
+}
+
+void WideToUtf8(const wchar_t* data, size_t len, std::string& out) {
+    utf::Utf16ToUtf8(data, len, out);
+}
+
+std::wstring Utf8ToWide(const std::string& bytes) {
+    std::wstring out;
+    Utf8ToWide(bytes.data(), bytes.size(), out);
+    return out;
+}
+
+std::string WideToUtf8(const std::wstring& text) {
+    std::string out;
+    WideToUtf8(text.data(), text.size(), out);
+    return out;
+}
@@ -0,0 +1,267 @@
+#pragma once
+// --- [UTF 변환기] ---
+// main.cpp에서 분리 (플랫폼 독립 코어 -> Linux 테스트/벤치에서도 그대로 빌드)
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// [PRD 5.6] 단일 패스 UTF-8 <-> UTF-16 변환기 (SIMD + 스칼라 폴백, 런타임 디스패치)
+// -> MultiByteToWideChar/WideCharToMultiByte를 '크기 계산 1회 + 변환 1회'로 두 번 돌리던 방식 대신 최악 크기로 한 번에 변환.
+// -> ASCII 구간: SSE2(16바이트)/AVX2(32바이트) 일괄 처리. 한글 구간: 3바이트 시퀀스 전용 루프.
+// -> 잘못된 입력은 U+FFFD로 치환 (최대 유효 접두 단위, Windows API와 같은 규칙). OS 의존성 없음.
+// -> 출력 버퍼는 호출자가 재사용 (clear 후 채우므로 capacity 유지 -> 저장마다 새 할당 없음).
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FM_UTF_SIMD 1
+#if defined(__GNUC__) || defined(__clang__)
+#define FM_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define FM_TARGET_AVX2
+#endif
+#else
+#define FM_UTF_SIMD 0
+#endif
+
+namespace utf {
+
+// 디스패치 대상 (테스트/벤치는 ForceIsa로 고정해 스칼라 폴백과 비교)
+enum class Isa { Scalar, Sse2, Avx2 };
+
+#if FM_UTF_SIMD
+inline bool CpuHasAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuidex(info, 7, 0);
+    if (!(info[1] & (1 << 5))) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    return osxsave && (_xgetbv(0) & 6) == 6; // OS가 YMM 상태 저장을 지원해야 함
+#endif
+}
+#endif
+
+inline Isa DetectIsa() {
+#if FM_UTF_SIMD
+    return CpuHasAvx2() ? Isa::Avx2 : Isa::Sse2;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+inline Isa& ActiveIsa() {
+    static Isa isa = DetectIsa();
+    return isa;
+}
+
+// 테스트/벤치 전용: 디스패치 고정 (CPU가 지원하지 않는 수준은 거부). 변환 중인 다른 스레드가 없을 때만 호출
+inline bool ForceIsa(Isa isa) {
+    if (isa > DetectIsa()) return false;
+    ActiveIsa() = isa;
+    return true;
+}
+
+#if FM_UTF_SIMD
+// ASCII 연속 구간을 16비트로 확장 -> 처리한 바이트 수 반환
+template <typename U16>
+size_t AsciiToUtf16Sse2(const unsigned char* src, size_t len, U16* dst) {
+    size_t i = 0;
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        if (_mm_movemask_epi8(v) != 0) break;
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpackhi_epi8(v, zero));
+    }
+    return i;
+}
+
+template <typename U16>
+FM_TARGET_AVX2 size_t AsciiToUtf16Avx2(const unsigned char* src, size_t len, U16* dst) {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        if (_mm256_movemask_epi8(v) != 0) break;
+        __m256i lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v));
+        __m256i hi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1));
+        _mm256_storeu_si256((__m256i*)(dst + i), lo);
+        _mm256_storeu_si256((__m256i*)(dst + i + 16), hi);
+    }
+    return i;
+}
+
+// ASCII 연속 구간을 8비트로 축소 -> 처리한 코드 유닛 수 반환
+template <typename U16>
+size_t AsciiToUtf8Sse2(const U16* src, size_t len, unsigned char* dst) {
+    size_t i = 0;
+    const __m128i mask = _mm_set1_epi16((short)0xFF80);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= len; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, mask), zero)) != 0xFFFF) break;
+        _mm_storel_epi64((__m128i*)(dst + i), _mm_packus_epi16(v, v));
+    }
+    return i;
+}
+
+template <typename U16>
+FM_TARGET_AVX2 size_t AsciiToUtf8Avx2(const U16* src, size_t len, unsigned char* dst) {
+    size_t i = 0;
+    const __m256i mask = _mm256_set1_epi16((short)0xFF80);
+    for (; i + 16 <= len; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        if (!_mm256_testz_si256(v, mask)) break;
+        __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        _mm_storeu_si128((__m128i*)(dst + i), packed);
+    }
+    return i;
+}
+#endif
+
+// 디스패치된 ASCII 일괄 처리 (16비트 코드 유닛일 때만 SIMD)
+template <typename U16>
+inline size_t AsciiRunToUtf16(const unsigned char* src, size_t len, U16* dst) {
+#if FM_UTF_SIMD
+    if (sizeof(U16) == 2 && ActiveIsa() != Isa::Scalar)
+        return ActiveIsa() == Isa::Avx2 ? AsciiToUtf16Avx2(src, len, dst) : AsciiToUtf16Sse2(src, len, dst);
+#endif
+    (void)src; (void)len; (void)dst;
+    return 0;
+}
+
+template <typename U16>
+inline size_t AsciiRunToUtf8(const U16* src, size_t len, unsigned char* dst) {
+#if FM_UTF_SIMD
+    if (sizeof(U16) == 2 && ActiveIsa() != Isa::Scalar)
+        return ActiveIsa() == Isa::Avx2 ? AsciiToUtf8Avx2(src, len, dst) : AsciiToUtf8Sse2(src, len, dst);
+#endif
+    (void)src; (void)len; (void)dst;
+    return 0;
+}
+
+// UTF-8 -> UTF-16 (out은 지우고 채움)
+template <typename U16, typename Out>
+void Utf8ToUtf16(const char* input, size_t len, Out& out) {
+    const unsigned char* src = (const unsigned char*)input;
+    out.resize(len); // 최악: 바이트 1개당 코드 유닛 1개
+    U16* dst = (U16*)&out[0];
+    size_t i = 0, o = 0;
+    while (i < len) {
+        unsigned char c = src[i];
+        if (c < 0x80) {
+            // 블록 끝 바이트도 ASCII일 때만 SIMD 시도 (한글 단어 사이 공백 같은 짧은 구간은 헛된 적재 없이 스칼라)
+            size_t n = (len - i >= 16 && src[i + 15] < 0x80) ? AsciiRunToUtf16(src + i, len - i, dst + o) : 0;
+            i += n; o += n;
+            while (i < len && src[i] < 0x80) dst[o++] = src[i++];
+            continue;
+        }
+        // 한글(U+AC00~U+D7A3) 등 3바이트 연속 구간 전용 루프
+        while (i + 2 < len && (src[i] & 0xF0) == 0xE0) {
+            unsigned char c0 = src[i], c1 = src[i + 1], c2 = src[i + 2];
+            if ((c1 & 0xC0) != 0x80 || (c2 & 0xC0) != 0x80) break;
+            if (c0 == 0xE0 && c1 < 0xA0) break;  // overlong
+            if (c0 == 0xED && c1 >= 0xA0) break; // surrogate
+            dst[o++] = (U16)(((c0 & 0x0F) << 12) | ((c1 & 0x3F) << 6) | (c2 & 0x3F));
+            i += 3;
+        }
+        if (i >= len) break;
+        c = src[i];
+        if (c < 0x80) continue;
+
+        // 일반 경로 (검증 포함): 잘못된 시퀀스는 최대 유효 접두만큼 건너뛰고 U+FFFD 하나
+        uint32_t cp = 0;
+        size_t need = 0;
+        unsigned char lo = 0x80, hi = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF) { need = 1; cp = c & 0x1F; }
+        else if (c >= 0xE0 && c <= 0xEF) { need = 2; cp = c & 0x0F; if (c == 0xE0) lo = 0xA0; if (c == 0xED) hi = 0x9F; }
+        else if (c >= 0xF0 && c <= 0xF4) { need = 3; cp = c & 0x07; if (c == 0xF0) lo = 0x90; if (c == 0xF4) hi = 0x8F; }
+        else { dst[o++] = 0xFFFD; i++; continue; }
+
+        size_t k = 1;
+        for (; k <= need; k++) {
+            if (i + k >= len) break;
+            unsigned char cc = src[i + k];
+            if (cc < lo || cc > hi) break;
+            cp = (cp << 6) | (cc & 0x3F);
+            lo = 0x80; hi = 0xBF;
+        }
+        if (k <= need) { dst[o++] = 0xFFFD; i += k; continue; }
+        i += need + 1;
+        if (cp >= 0x10000) {
+            if (sizeof(U16) == 2) {
+                cp -= 0x10000;
+                dst[o++] = (U16)(0xD800 + (cp >> 10));
+                dst[o++] = (U16)(0xDC00 + (cp & 0x3FF));
+            } else {
+                dst[o++] = (U16)cp; // 32비트 wchar_t 플랫폼
+            }
+        } else {
+            dst[o++] = (U16)cp;
+        }
+    }
+    out.resize(o);
+}
+
+// UTF-16 -> UTF-8 (짝 없는 서로게이트는 U+FFFD)
+template <typename U16, typename Out>
+void Utf16ToUtf8(const U16* src, size_t len, Out& out) {
+    // 최악: 16비트 유닛 1개당 3바이트 (서로게이트 쌍은 2유닛 -> 4바이트). 32비트 wchar_t(Linux)는 유닛 1개가 4바이트일 수 있음
+    out.resize(len * (sizeof(U16) == 2 ? 3 : 4));
+    unsigned char* dst = (unsigned char*)&out[0];
+    size_t i = 0, o = 0;
+    while (i < len) {
+        uint32_t c = (uint32_t)src[i];
+        if (c < 0x80) {
+            size_t n = (len - i >= 8 && (uint32_t)src[i + 7] < 0x80) ? AsciiRunToUtf8(src + i, len - i, dst + o) : 0;
+            i += n; o += n;
+            while (i < len && (uint32_t)src[i] < 0x80) dst[o++] = (unsigned char)src[i++];
+            continue;
+        }
+        i++;
+        if (c < 0x800) {
+            dst[o++] = (unsigned char)(0xC0 | (c >> 6));
+            dst[o++] = (unsigned char)(0x80 | (c & 0x3F));
+            continue;
+        }
+        if (c >= 0xD800 && c <= 0xDFFF) {
+            if (c <= 0xDBFF && i < len && (uint32_t)src[i] >= 0xDC00 && (uint32_t)src[i] <= 0xDFFF) {
+                c = 0x10000 + ((c - 0xD800) << 10) + ((uint32_t)src[i] - 0xDC00);
+                i++;
+            } else {
+                c = 0xFFFD;
+            }
+        } else if (c > 0x10FFFF) {
+            c = 0xFFFD;
+        }
+        if (c < 0x10000) {
+            dst[o++] = (unsigned char)(0xE0 | (c >> 12));
+            dst[o++] = (unsigned char)(0x80 | ((c >> 6) & 0x3F));
+            dst[o++] = (unsigned char)(0x80 | (c & 0x3F));
+        } else {
+            dst[o++] = (unsigned char)(0xF0 | (c >> 18));
+            dst[o++] = (unsigned char)(0x80 | ((c >> 12) & 0x3F));
+            dst[o++] = (unsigned char)(0x80 | ((c >> 6) & 0x3F));
+            dst[o++] = (unsigned char)(0x80 | (c & 0x3F));
+        }
+    }
+    out.resize(o);
+}
+
+} // namespace utf
+
+// [PRD 5.4] 인코딩 헬퍼 -> 일반 저장과 저널 저장이 같은 UTF-8 변환/읽기 경로를 공유
+// [PRD 5.6] 변환은 utf:: 단일 패스 변환기 사용 -> 포인터+길이 오버로드는 out 버퍼를 재사용
+void Utf8ToWide(const char* data, size_t len, std::wstring& out);
+void WideToUtf8(const wchar_t* data, size_t len, std::string& out);
+std::wstring Utf8ToWide(const std::string& bytes);
+std::string WideToUtf8(const std::wstring& text);
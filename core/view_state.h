@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "core/crc32.h"
+
+// --- [폴더별 보기 상태] ---
+// [PRD 4.7] 폴더별 오버레이 보기 상태 (글꼴 크기, 최소화/확대, 스크롤/캐럿) 보관
+// -> 예전에는 OverlayPair에만 있어서 폴더를 옮기거나 다시 실행하면 기본값으로 돌아감.
+// -> %LOCALAPPDATA%\FolderMemo\view_state.bin 하나를 읽기/쓰기 매핑한 고정 크기 해시 표 (폴더 경로 해시 -> 32바이트 레코드).
+//    결과 적용 시 조회는 메모리 읽기 몇 번 (O(1), 폴더 자체에는 파일 접근 없음). 쓰기도 매핑된 메모리에 바로 -> 디스크 반영은 OS가 늦게.
+// -> 기록 시점은 폴더를 떠날 때/상태를 바꿀 때/창을 닫을 때만 (스크롤마다 쓰지 않음).
+// -> 레코드마다 seqlock(홀수 = 기록 중) + CRC: 기록 도중 프로세스가 죽으면 홀수로 남고, 페이지가 찢겨 저장되면 CRC가 틀림 -> 둘 다 '기록 없음'으로 보고 덮어씀.
+//    기록은 UI 스레드 하나만 (모든 오버레이가 같은 스레드). 읽기는 다른 스레드/프로세스에서도 안전.
+// -> 열린 주소 선형 탐사 (최대 VIEW_STATE_PROBE_LIMIT칸), 지우기 없음. 자리가 없으면 그 구간에서 가장 오래 안 쓴 레코드 교체.
+// -> 표 본체(ViewStateTable)는 메모리 영역만 다룸 (OS 의존 없음). 파일/매핑은 ViewStateStore.
+const int DEFAULT_FONT_SIZE = 22; // 오버레이 생성 시 기본값과 같음
+const uint32_t VIEW_STATE_SLOTS = 16384; // 2의 거듭제곱 (512KB)
+const size_t VIEW_STATE_PROBE_LIMIT = 16;
+const uint8_t VIEW_MINIMIZED = 1;
+const uint8_t VIEW_EXPANDED = 2;
+
+struct FolderViewState {
+    int fontSize = DEFAULT_FONT_SIZE;
+    bool minimized = false;
+    bool expanded = false;
+    uint32_t firstLine = 0; // 첫 표시 줄
+    uint32_t caret = 0;     // 캐럿 위치 (문자)
+};
+
+class ViewStateTable {
+public:
+    static constexpr uint32_t MAGIC = 0x53564D46; // "FMVS"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 64;
+    static constexpr size_t RECORD_WORDS = 8; // [키 lo, 키 hi, seq, crc, 글꼴|플래그, 첫 줄, 캐럿, 마지막 사용(분)]
+
+    static size_t BytesFor(uint32_t slots) { return HEADER_SIZE + (size_t)slots * RECORD_WORDS * 4; }
+
+    // 대소문자/구분자 정규화된 경로의 64비트 FNV-1a (0은 빈 칸 표시라 피함)
+    static uint64_t KeyOf(const std::wstring& normalizedPath) {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (wchar_t c : normalizedPath) {
+            h = (h ^ (uint8_t)(c & 0xFF)) * 0x100000001b3ULL;
+            h = (h ^ (uint8_t)((c >> 8) & 0xFF)) * 0x100000001b3ULL;
+        }
+        return h ? h : 1;
+    }
+
+    // base: BytesFor(slots) 바이트 (4바이트 정렬). 헤더가 다르면 (새 파일, 형식 변경) 전부 비우고 헤더는 마지막에 기록
+    bool Attach(void* base, size_t size, uint32_t slots) {
+        if (!base || slots == 0 || (slots & (slots - 1)) || size < BytesFor(slots)) return false;
+        m_words = (std::atomic<uint32_t>*)base;
+        m_slots = slots;
+        if (m_words[0].load() != MAGIC || m_words[1].load() != VERSION || m_words[2].load() != slots || m_words[3].load() != RECORD_WORDS) {
+            m_words[0].store(0);
+            for (size_t i = HEADER_SIZE / 4; i < BytesFor(slots) / 4; i++) m_words[i].store(0, std::memory_order_relaxed);
+            m_words[1].store(VERSION);
+            m_words[2].store(slots);
+            m_words[3].store((uint32_t)RECORD_WORDS);
+            m_words[0].store(MAGIC); // 중간에 죽으면 다음 실행이 다시 초기화
+        }
+        return true;
+    }
+
+    void Detach() { m_words = nullptr; m_slots = 0; }
+    bool Attached() const { return m_words != nullptr; }
+
+    bool Find(uint64_t key, FolderViewState& out) const {
+        if (!m_words) return false;
+        uint32_t w[RECORD_WORDS];
+        for (size_t p = 0; p < VIEW_STATE_PROBE_LIMIT; p++) {
+            size_t slot = (size_t)(key + p) & (m_slots - 1);
+            if (!ReadStable(slot, w)) continue; // 기록 도중 멈춘 레코드 -> 건너뜀
+            uint64_t k = (uint64_t)w[0] | ((uint64_t)w[1] << 32);
+            if (k == 0) return false; // 빈 칸 -> 탐사 끝
+            if (k != key) continue;
+            if (Checksum(w) != w[3]) return false;
+            out.fontSize = (int)(w[4] & 0xFFFF);
+            out.minimized = ((w[4] >> 16) & VIEW_MINIMIZED) != 0;
+            out.expanded = ((w[4] >> 16) & VIEW_EXPANDED) != 0;
+            out.firstLine = w[5];
+            out.caret = w[6];
+            return true;
+        }
+        return false;
+    }
+
+    // 단일 기록자 전용
+    void Store(uint64_t key, const FolderViewState& st, uint32_t nowMinutes) {
+        if (!m_words) return;
+        size_t target = SIZE_MAX, torn = SIZE_MAX, empty = SIZE_MAX, oldest = SIZE_MAX;
+        uint32_t oldestUse = UINT32_MAX;
+        uint32_t w[RECORD_WORDS];
+        for (size_t p = 0; p < VIEW_STATE_PROBE_LIMIT; p++) {
+            size_t slot = (size_t)(key + p) & (m_slots - 1);
+            if (!ReadStable(slot, w)) { if (torn == SIZE_MAX) torn = slot; continue; }
+            uint64_t k = (uint64_t)w[0] | ((uint64_t)w[1] << 32);
+            if (k == key) { target = slot; break; }
+            if (k == 0) { empty = slot; break; }
+            if (w[7] < oldestUse) { oldest = slot; oldestUse = w[7]; }
+        }
+        // 같은 키 > 깨진 레코드 (탐사 구간을 계속 차지하지 않게 먼저 재사용) > 빈 칸 > 가장 오래 안 쓴 레코드
+        if (target == SIZE_MAX) target = torn != SIZE_MAX ? torn : empty != SIZE_MAX ? empty : oldest;
+
+        w[0] = (uint32_t)key;
+        w[1] = (uint32_t)(key >> 32);
+        w[4] = ((uint32_t)st.fontSize & 0xFFFF) | ((uint32_t)((st.minimized ? VIEW_MINIMIZED : 0) | (st.expanded ? VIEW_EXPANDED : 0)) << 16);
+        w[5] = st.firstLine;
+        w[6] = st.caret;
+        w[7] = nowMinutes;
+        w[3] = Checksum(w);
+        std::atomic<uint32_t>* rec = Record(target);
+        uint32_t odd = rec[2].load(std::memory_order_relaxed) | 1; // 이미 홀수(이전 기록 중 종료)면 그대로 이어서
+        rec[2].store(odd, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < RECORD_WORDS; i++) if (i != 2) rec[i].store(w[i], std::memory_order_relaxed);
+        rec[2].store(odd + 1, std::memory_order_release);
+    }
+
+private:
+    std::atomic<uint32_t>* Record(size_t slot) const { return m_words + HEADER_SIZE / 4 + slot * RECORD_WORDS; }
+
+    // seq가 짝수이고 읽는 동안 바뀌지 않은 사본만 true
+    bool ReadStable(size_t slot, uint32_t* w) const {
+        std::atomic<uint32_t>* rec = Record(slot);
+        for (int attempt = 0; attempt < 4; attempt++) {
+            uint32_t s1 = rec[2].load(std::memory_order_acquire);
+            if (s1 & 1) continue;
+            for (size_t i = 0; i < RECORD_WORDS; i++) w[i] = rec[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (rec[2].load(std::memory_order_relaxed) == s1) return true;
+        }
+        return false;
+    }
+
+    static uint32_t Checksum(const uint32_t* w) {
+        uint32_t body[6] = { w[0], w[1], w[4], w[5], w[6], w[7] };
+        return Crc32(body, sizeof(body));
+    }
+
+    std::atomic<uint32_t>* m_words = nullptr;
+    uint32_t m_slots = 0;
+};
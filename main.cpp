@@ -18,19 +18,70 @@
 #pragma comment(lib, "oleaut32.lib")
 #pragma comment(lib, "gdi32.lib")
 #pragma comment(lib, "uuid.lib")
+#pragma comment(lib, "shell32.lib")
+#pragma comment(lib, "psapi.lib")
 
 #include <windows.h>
 #include <dwmapi.h>
 #include <shlobj.h>
 #include <exdisp.h>
 #include <shlwapi.h>
+#include <shellapi.h>
+#include <psapi.h>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
 #include <mutex>
 #include <filesystem>
 #include <fstream>
 #include <thread>
+#include <atomic>
 #include <chrono>
+#include <deque>
+#include <memory>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <iterator>
+#include <cwctype>
+#include <random>
+#include <array>
+#include <string_view>
+#include <ctime>
+#include "core/archive.h"
+#include "core/central_store.h"
+#include "core/chrome_cache.h"
+#include "core/crc32.h"
+#include "core/edit_bench.h"
+#include "core/editor_pool.h"
+#include "core/explorer_paths.h"
+#include "core/file_io.h"
+#include "core/gdi_cache.h"
+#include "core/grams.h"
+#include "core/history.h"
+#include "core/io_guard.h"
+#include "core/journal.h"
+#include "core/memo_buffer.h"
+#include "core/memo_cache.h"
+#include "core/memo_merge.h"
+#include "core/overlay_events.h"
+#include "core/overlay_registry.h"
+#include "core/paged_load.h"
+#include "core/path_jobs.h"
+#include "core/position_scheduler.h"
+#include "core/replay.h"
+#include "core/save_queue.h"
+#include "core/search_index.h"
+#include "core/startup_attach.h"
+#include "core/stat_cache.h"
+#include "core/title_hints.h"
+#include "core/trace.h"
+#include "core/utf.h"
+#include "core/view_state.h"
 
 // 🔥 [추가] 닫기 애니메이션 감지를 위한 상수 정의
 #ifndef EVENT_OBJECT_CLOAKED
@@ -47,16 +98,22 @@ const int EXPANDED_WIDTH = 600;
 const int EXPANDED_HEIGHT = 900;     
 const int MINIMIZED_SIZE = 50;       // 🔥 [디자인] 최소화 크기 40 -> 50으로 변경
 const int BTN_SIZE = 25;             
-const int DEFAULT_FONT_SIZE = 22;    
 
 
 // 🔥 [디자인] 배경색 정의 (눈이 편한 연회색 #F3F3F3)
 const COLORREF BG_COLOR = RGB(243, 243, 243);
 
 #define IDC_MEMO_EDIT 101
+#define IDC_MEMO_SPARE 102 // [PRD 4.5] 반납된 예비 편집창 (편집창 조회/EN_CHANGE에서 제외)
 #define WM_UPDATE_UI_FromThread (WM_USER + 2)
+#define WM_MEMO_CHUNK (WM_USER + 3) // [PRD 5.5] 백그라운드 변환 청크 도착 (lParam = MemoChunk*)
+#define WM_MEMO_RELOAD (WM_USER + 4) // [PRD 5.8] 디스크 변경 감지 (g_memoReloads 큐 확인)
+#define TRACE_HOTKEY_ID 0x7101       // [PRD 7.1] 추적 덤프 단축키 (Ctrl+Alt+Shift+T)
 
 // --- [데이터 구조] ---
+typedef BasicPagedMemoLoad<HWND> PagedMemoLoad; // [PRD 5.5] core/paged_load.h
+class MemoBuffer;
+
 struct OverlayPair {
     HWND hExplorer;
     HWND hOverlay;
@@ -65,187 +122,1951 @@ struct OverlayPair {
     bool isExpanded;
     bool fileExists;
     int currentFontSize;
+    unsigned long long pathGeneration = 0; // [PRD 3.1.2] 마지막으로 요청한 경로 탐색 세대
+    bool settingText = false;              // [PRD 5.5] 프로그램이 내용을 채우는 중 -> EN_CHANGE 저장 생략
+    std::shared_ptr<PagedMemoLoad> pagedLoad; // [PRD 5.5] 진행 중인 대용량 로딩 (완료/취소 시 해제)
+    bool conflict = false;                 // [PRD 5.8] 병합 충돌 표시 중 (테두리 강조)
+    unsigned long long traceEventNs = 0;   // [PRD 7.1] 마지막 WinEvent 수신 시각 -> 결과 적용 후 첫 WM_PAINT에서 전체 지연 기록
+    bool tracePaintArmed = false;          // [PRD 7.1] 결과 적용됨, 아직 그리지 않음
+    bool speculative = false;              // [PRD 3.1.6] 제목으로 추측한 경로 표시 중 (확정 전까지 읽기 전용)
+    std::shared_ptr<MemoBuffer> buffer;    // [PRD 5.11] 편집 내용 (채울 때마다 새로, 저장 큐도 같은 객체를 참조)
+};
+
+// --- [실행 옵션] ---
+// [PRD 5.4] 명령줄 옵션 -> 기본 동작은 그대로 두고 선택 기능만 켜는 용도
+//  --journal : 저널 저장 모드 (편집 구간만 덧붙이고 백그라운드에서 folder_memo.txt로 압축)
+//  [PRD 6.1] --index-root <폴더> : 전역 검색 색인 대상 루트 (여러 번 지정 가능)
+//  [PRD 6.1] --search <검색어>   : 오버레이 없이 색인만 조회해 결과 폴더를 출력하고 종료
+//  [PRD 6.1] --reindex           : 오버레이 없이 루트 전체를 다시 색인하고 종료
+//  [PRD 5.7] --central-store     : 메모를 각 폴더 대신 %LOCALAPPDATA%\FolderMemo\store.log에 저장 (--journal 무시)
+//  [PRD 5.7] --import-memos <폴더> : 폴더 아래 folder_memo.txt를 중앙 저장소로 가져오고 종료 (여러 번 지정 가능)
+//  [PRD 5.7] --export-memos      : 중앙 저장소의 메모를 각 폴더의 folder_memo.txt로 내보내고 종료
+//  [PRD 7.2] --replay <파일>      : 탐색기 없이 기록된 WinEvent 열을 재생해 지연/불변식 위반을 출력하고 종료
+//  [PRD 7.2] --replay-synthetic <창 수> <이벤트 수> : 무작위 이벤트 열로 재생 (--replay-rate <초당 이벤트>, 0 = 최대 속도)
+//  [PRD 3.1.6] --replay-init-ms <ms> : 재생 시 새 창의 경로가 이 시간 뒤에야 Shell에 나타남 (탐색기 초기화 지연 모사)
+//  [PRD 5.9] --history <폴더>     : 폴더 메모의 보관된 버전 목록을 출력하고 종료 (1 = 최신)
+//  [PRD 5.9] --restore <폴더> <번호> : 목록의 해당 버전으로 메모를 되돌리고 종료 (되돌리기 전 내용도 버전으로 남김)
+//  [PRD 6.2] --archive <파일>      : 아카이브 명령 대상 파일
+//  [PRD 6.2] --archive-export <루트> : 루트 아래 모든 메모를 아카이브로 내보내고 종료 (여러 번 지정 가능)
+//  [PRD 6.2] --archive-restore   : 아카이브의 메모 중 내용이 다른 것만 원래 폴더에 기록하고 종료 (없는 폴더는 건너뜀)
+//  [PRD 6.2] --archive-diff      : 아카이브와 현재 트리를 비교해 추가/삭제/변경된 메모를 출력하고 종료
+//  [PRD 6.2] --archive-target <폴더> : 복원/비교 시 원래 루트 대신 이 폴더 기준 (다른 위치로 이전)
+//  [PRD 6.2] --archive-threads <n> : 병렬 순회 스레드 수 (기본: 코어 수 x2, 최대 32)
+//  [PRD 6.2] --archive-bench <폴더> <디렉터리 수> : 합성 트리를 만들어 내보내기/비교 처리량을 출력하고 종료
+//  [PRD 3.4] --memo-cache-mb <MB> : 디코드된 메모 내용 캐시 예산 (기본 32, 0 = 끔)
+//  [PRD 3.4] --memo-cache-bench <폴더> <이동 수> : 합성 탐색 재생으로 캐시 없음/있음을 비교해 출력하고 종료
+//  [PRD 5.11] --edit-bench <키 입력 수> : 합성 입력 세션을 10KB~10MB 메모에 재생해 전체 복사 방식과 편집 버퍼를 비교하고 종료
+struct AppConfig {
+    bool journalMode = false;
+    std::vector<std::wstring> indexRoots;
+    std::wstring searchQuery;
+    bool searchMode = false;
+    bool reindexMode = false;
+    bool centralStore = false;
+    std::vector<std::wstring> importRoots;
+    bool exportMode = false;
+    bool replayMode = false;
+    std::wstring replayTrace;
+    int replayWindows = 0;
+    int replayEvents = 0;
+    int replayRate = 5000;
+    int replayInitMs = 0;
+    std::wstring historyFolder;
+    int restoreVersion = 0; // [PRD 5.9] 0 = 목록만
+    std::wstring archivePath;
+    std::vector<std::wstring> archiveExportRoots;
+    bool archiveRestore = false;
+    bool archiveDiff = false;
+    std::wstring archiveTarget;
+    int archiveThreads = 0; // [PRD 6.2] 0 = 자동
+    std::wstring archiveBenchDir;
+    size_t archiveBenchDirs = 0;
+    size_t memoCacheMb = 32;
+    std::wstring memoCacheBenchDir;
+    size_t memoCacheBenchSteps = 0;
+    size_t editBenchKeys = 0;
+};
+AppConfig g_config;
+
+void ParseCommandLine() {
+    int argc = 0;
+    LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+    if (!argv) return;
+    for (int i = 1; i < argc; i++) {
+        if (wcscmp(argv[i], L"--journal") == 0) g_config.journalMode = true;
+        else if (wcscmp(argv[i], L"--index-root") == 0 && i + 1 < argc) g_config.indexRoots.push_back(argv[++i]);
+        else if (wcscmp(argv[i], L"--search") == 0 && i + 1 < argc) { g_config.searchMode = true; g_config.searchQuery = argv[++i]; }
+        else if (wcscmp(argv[i], L"--reindex") == 0) g_config.reindexMode = true;
+        else if (wcscmp(argv[i], L"--central-store") == 0) g_config.centralStore = true;
+        else if (wcscmp(argv[i], L"--import-memos") == 0 && i + 1 < argc) g_config.importRoots.push_back(argv[++i]);
+        else if (wcscmp(argv[i], L"--export-memos") == 0) g_config.exportMode = true;
+        else if (wcscmp(argv[i], L"--replay") == 0 && i + 1 < argc) { g_config.replayMode = true; g_config.replayTrace = argv[++i]; }
+        else if (wcscmp(argv[i], L"--replay-synthetic") == 0 && i + 2 < argc) {
+            g_config.replayMode = true;
+            g_config.replayWindows = _wtoi(argv[++i]);
+            g_config.replayEvents = _wtoi(argv[++i]);
+        }
+        else if (wcscmp(argv[i], L"--replay-rate") == 0 && i + 1 < argc) g_config.replayRate = _wtoi(argv[++i]);
+        else if (wcscmp(argv[i], L"--replay-init-ms") == 0 && i + 1 < argc) g_config.replayInitMs = _wtoi(argv[++i]);
+        else if (wcscmp(argv[i], L"--history") == 0 && i + 1 < argc) g_config.historyFolder = argv[++i];
+        else if (wcscmp(argv[i], L"--restore") == 0 && i + 2 < argc) {
+            g_config.historyFolder = argv[++i];
+            g_config.restoreVersion = _wtoi(argv[++i]);
+        }
+        else if (wcscmp(argv[i], L"--archive") == 0 && i + 1 < argc) g_config.archivePath = argv[++i];
+        else if (wcscmp(argv[i], L"--archive-export") == 0 && i + 1 < argc) g_config.archiveExportRoots.push_back(argv[++i]);
+        else if (wcscmp(argv[i], L"--archive-restore") == 0) g_config.archiveRestore = true;
+        else if (wcscmp(argv[i], L"--archive-diff") == 0) g_config.archiveDiff = true;
+        else if (wcscmp(argv[i], L"--archive-target") == 0 && i + 1 < argc) g_config.archiveTarget = argv[++i];
+        else if (wcscmp(argv[i], L"--archive-threads") == 0 && i + 1 < argc) g_config.archiveThreads = _wtoi(argv[++i]);
+        else if (wcscmp(argv[i], L"--archive-bench") == 0 && i + 2 < argc) {
+            g_config.archiveBenchDir = argv[++i];
+            g_config.archiveBenchDirs = (size_t)_wtoi(argv[++i]);
+        }
+        else if (wcscmp(argv[i], L"--memo-cache-mb") == 0 && i + 1 < argc) g_config.memoCacheMb = (size_t)std::max(0, _wtoi(argv[++i]));
+        else if (wcscmp(argv[i], L"--memo-cache-bench") == 0 && i + 2 < argc) {
+            g_config.memoCacheBenchDir = argv[++i];
+            g_config.memoCacheBenchSteps = (size_t)_wtoi(argv[++i]);
+        }
+        else if (wcscmp(argv[i], L"--edit-bench") == 0 && i + 1 < argc) g_config.editBenchKeys = (size_t)std::max(0, _wtoi(argv[++i]));
+    }
+    LocalFree(argv);
+}
+
+// [PRD 4.3] 오버레이 레지스트리/결과 큐 본체는 core/overlay_registry.h
+typedef BasicOverlayRegistry<OverlayPair, HWND> OverlayRegistry;
+
+struct PreloadedMemo;
+struct PathResult {
+    HWND hOverlay;
+    std::wstring path;
+    bool exists;
+    unsigned long long generation; // [PRD 3.1.2] 요청 세대 -> 옛 결과 폐기용
+    bool startup = false;                   // [PRD 3.2.3] 시작 시 일괄 부착 결과 (경로 못 찾으면 UI가 일반 탐색으로 재요청)
+    std::shared_ptr<PreloadedMemo> preload; // [PRD 3.2.3] 워커가 미리 읽어 둔 메모 (없으면 UI에서 읽음)
+    std::wstring title;                     // [PRD 3.1.6] 해석에 쓴 창 제목 -> 제목별 마지막 경로 기억
+    bool speculative = false;               // [PRD 3.1.6] 실제 해석 전 추측 표시용
 };
 
 // --- [전역 변수] ---
-std::vector<OverlayPair> g_overlays;
-std::mutex g_overlayMutex;
+OverlayRegistry g_overlays;          // UI 스레드 전용
+MpscQueue<PathResult> g_pathResults; // 워커 -> UI
 HWINEVENTHOOK g_hHookObject = NULL;
 HWINEVENTHOOK g_hHookSystem = NULL;
 
+// --- [GDI 리소스 캐시] ---
+// [PRD 4.4] 팩토리 인터페이스/참조 카운트 캐시는 core/gdi_cache.h (Linux 테스트가 카운팅 가짜로 구동)
+class Win32GdiFactory : public BasicGdiFactory<HGDIOBJ> {
+public:
+    HGDIOBJ CreateFontObject(const std::wstring& face, int size) override {
+        return CreateFontW(size, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, 
+            DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS, 
+            DEFAULT_QUALITY, DEFAULT_PITCH | FF_SWISS, face.c_str());
+    }
+    HGDIOBJ CreateBrushObject(uint32_t color) override { return CreateSolidBrush(color); }
+    HGDIOBJ CreatePenObject(uint32_t color, int width) override { return CreatePen(PS_SOLID, width, color); }
+    void DestroyObject(HGDIOBJ obj) override { DeleteObject(obj); }
+};
+
+// 핸들 형식만 구체화 (HFONT/HBRUSH/HPEN으로 돌려줌)
+class GdiResourceCache : public BasicGdiResourceCache<HGDIOBJ> {
+public:
+    using BasicGdiResourceCache<HGDIOBJ>::BasicGdiResourceCache;
+    HFONT AcquireFont(const std::wstring& face, int size) { return (HFONT)BasicGdiResourceCache<HGDIOBJ>::AcquireFont(face, size); }
+    HBRUSH AcquireBrush(COLORREF color) { return (HBRUSH)BasicGdiResourceCache<HGDIOBJ>::AcquireBrush(color); }
+    HPEN AcquirePen(COLORREF color, int width) { return (HPEN)BasicGdiResourceCache<HGDIOBJ>::AcquirePen(color, width); }
+};
+
+Win32GdiFactory g_gdiFactory;
+GdiResourceCache g_gdiCache(&g_gdiFactory);
+
+const wchar_t MEMO_FONT_FACE[] = L"Malgun Gothic";
+
+// [PRD 4.4] 오버레이 공통 페인트 도구 -> 첫 오버레이 생성 시 확보, 마지막 오버레이 파괴 시 반납
+// -> WM_PAINT마다 브러시/펜/아이콘 폰트를 만들고 지우던 비용 제거
+struct OverlayPaintKit {
+    int users = 0;
+    HBRUSH bg = NULL, border = NULL, line = NULL, conflict = NULL;
+    HPEN glyph = NULL;
+    HFONT icon = NULL;
+
+    void AddRef() {
+        if (users++ > 0) return;
+        bg = g_gdiCache.AcquireBrush(BG_COLOR);
+        border = g_gdiCache.AcquireBrush(RGB(100, 100, 100));
+        line = g_gdiCache.AcquireBrush(RGB(200, 200, 200));
+        conflict = g_gdiCache.AcquireBrush(RGB(220, 70, 50)); // [PRD 5.8]
+        glyph = g_gdiCache.AcquirePen(RGB(0, 0, 0), 1);
+        icon = g_gdiCache.AcquireFont(MEMO_FONT_FACE, 32);
+    }
+
+    void Release() {
+        if (users == 0 || --users > 0) return;
+        g_gdiCache.Release(bg); g_gdiCache.Release(border); g_gdiCache.Release(line); g_gdiCache.Release(conflict);
+        g_gdiCache.Release(glyph); g_gdiCache.Release(icon);
+        bg = border = line = conflict = NULL; glyph = NULL; icon = NULL;
+    }
+};
+OverlayPaintKit g_paintKit;
+
+// [PRD 4.4] GDI 사용량 보고 -> 캐시 관점(살아있는 객체 수)과 OS 관점(프로세스 GDI 핸들 수)을 함께 기록
+void LogGdiStats(const wchar_t* when) {
+    wchar_t buf[200];
+    swprintf(buf, 200, L"[FolderMemo] gdi(%ls) fonts=%d brushes=%d pens=%d created=%llu process=%lu\n",
+        when, g_gdiCache.LiveFonts(), g_gdiCache.LiveBrushes(), g_gdiCache.LivePens(),
+        g_gdiCache.Created(), GetGuiResources(GetCurrentProcess(), GR_GDIOBJECTS));
+    OutputDebugStringW(buf);
+}
+
+// --- [외곽 비트맵 캐시] ---
+// [PRD 4.6] 미리 그린 외곽을 복사만 (캐시 키/그리기 순서/무효화 영역은 core/chrome_cache.h, DC = HDC)
+class Win32ChromeDevice : public BasicChromeDevice<HDC, HBITMAP> {
+public:
+    void Fill(HDC hdc, const ChromeRect& rc, ChromeInk ink) override {
+        RECT r = { rc.left, rc.top, rc.right, rc.bottom };
+        FillRect(hdc, &r, Brush(ink));
+    }
+    void Frame(HDC hdc, const ChromeRect& rc, ChromeInk ink) override {
+        RECT r = { rc.left, rc.top, rc.right, rc.bottom };
+        FrameRect(hdc, &r, Brush(ink));
+    }
+    void Line(HDC hdc, int x0, int y0, int x1, int y1) override {
+        HPEN hOldPen = (HPEN)SelectObject(hdc, g_paintKit.glyph);
+        MoveToEx(hdc, x0, y0, NULL); LineTo(hdc, x1, y1);
+        SelectObject(hdc, hOldPen);
+    }
+    void Box(HDC hdc, const ChromeRect& rc) override {
+        HPEN hOldPen = (HPEN)SelectObject(hdc, g_paintKit.glyph);
+        Rectangle(hdc, rc.left, rc.top, rc.right, rc.bottom);
+        SelectObject(hdc, hOldPen);
+    }
+    void Icon(HDC hdc, const ChromeRect& rc, bool memo) override {
+        HFONT hOldFont = (HFONT)SelectObject(hdc, g_paintKit.icon);
+        SetBkMode(hdc, TRANSPARENT);
+        SetTextColor(hdc, RGB(50, 50, 50));
+        RECT rcIcon = { rc.left, rc.top, rc.right, rc.bottom };
+        DrawTextW(hdc, memo ? L"▤" : L"+", -1, &rcIcon, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+        SelectObject(hdc, hOldFont);
+    }
+    HBITMAP CreateBitmap(HDC like, int w, int h) override {
+        if (!m_memDC) m_memDC = CreateCompatibleDC(like);
+        return m_memDC ? CreateCompatibleBitmap(like, w, h) : NULL;
+    }
+    HDC BeginDraw(HBITMAP bmp) override {
+        m_oldBitmap = SelectObject(m_memDC, bmp);
+        return m_memDC;
+    }
+    void EndDraw(HBITMAP) override { SelectObject(m_memDC, m_oldBitmap); }
+    void Blit(HDC dst, HBITMAP src, int w, int h) override {
+        HGDIOBJ old = SelectObject(m_memDC, src);
+        BitBlt(dst, 0, 0, w, h, m_memDC, 0, 0, SRCCOPY);
+        SelectObject(m_memDC, old);
+    }
+    void DestroyBitmap(HBITMAP bmp) override { DeleteObject(bmp); }
+    void ReleaseScratch() override {
+        if (m_memDC) { DeleteDC(m_memDC); m_memDC = NULL; }
+    }
+
+private:
+    // [PRD 4.4] 공유 페인트 도구 (생성/삭제 없음)
+    static HBRUSH Brush(ChromeInk ink) {
+        switch (ink) {
+        case CHROME_INK_BORDER: return g_paintKit.border;
+        case CHROME_INK_LINE: return g_paintKit.line;
+        case CHROME_INK_CONFLICT: return g_paintKit.conflict;
+        default: return g_paintKit.bg;
+        }
+    }
+
+    HDC m_memDC = NULL;
+    HGDIOBJ m_oldBitmap = NULL;
+};
+typedef BasicChromeCache<HDC, HBITMAP> ChromeCache;
+
+Win32ChromeDevice g_chromeDevice;
+ChromeCache g_chromeCache(&g_chromeDevice, BTN_SIZE); // UI 스레드 전용
+
+// [PRD 4.6] 외곽 그리기 통계 (재렌더 수가 상태/크기 조합 수에 머무는지, 1회 그리기 비용)
+void LogChromeStats() {
+    unsigned long long paints = g_chromeCache.Paints();
+    wchar_t buf[200];
+    swprintf(buf, 200, L"[FolderMemo] chrome paints=%llu renders=%llu bitmaps=%zu avg=%.1fus\n",
+        paints, g_chromeCache.Renders(), g_chromeCache.Bitmaps(), paints ? g_chromeCache.PaintNs() / 1000.0 / paints : 0.0);
+    OutputDebugStringW(buf);
+}
+
+ChromeKey OverlayChromeKey(const OverlayPair& pair, const RECT& rcClient) {
+    int state = !pair.isMinimized ? CHROME_OPEN : (pair.fileExists ? CHROME_MIN_MEMO : CHROME_MIN_EMPTY);
+    return { state, pair.conflict, (int)rcClient.right, state == CHROME_OPEN ? 0 : (int)rcClient.bottom };
+}
+
+// [PRD 4.6] 바뀐 외곽만 무효화 (배경 지우기 없음, 영역은 ChromeDirtyRects)
+void InvalidateOverlayChrome(HWND hOverlay, bool whole) {
+    if (whole) { InvalidateRect(hOverlay, NULL, FALSE); return; }
+    RECT rc; GetClientRect(hOverlay, &rc);
+    std::vector<ChromeRect> dirty;
+    ChromeDirtyRects(rc.right, rc.bottom, BTN_SIZE, false, dirty);
+    for (const auto& d : dirty) {
+        RECT r = { d.left, d.top, d.right, d.bottom };
+        InvalidateRect(hOverlay, &r, FALSE);
+    }
+}
+
 // --- [헬퍼 함수: 폰트 적용] ---
+// [PRD 4.4] 캐시에서 공유 폰트를 받아 적용하고, 이전 폰트 참조는 반납 (같은 크기면 아무것도 안 함)
 void UpdateMemoFont(HWND hEdit, int fontSize) {
     if (!hEdit) return;
-    HFONT hNewFont = CreateFontW(fontSize, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, 
-        DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS, 
-        DEFAULT_QUALITY, DEFAULT_PITCH | FF_SWISS, L"Malgun Gothic");
+    HFONT hOldFont = (HFONT)SendMessage(hEdit, WM_GETFONT, 0, 0);
+    HFONT hNewFont = g_gdiCache.AcquireFont(MEMO_FONT_FACE, fontSize);
+    if (hNewFont == hOldFont) { g_gdiCache.Release(hNewFont); return; }
     SendMessage(hEdit, WM_SETFONT, (WPARAM)hNewFont, TRUE);
+    g_gdiCache.Release(hOldFont);
+}
+
+// 편집창 파괴 전 폰트 참조 반납
+void ReleaseMemoFont(HWND hEdit) {
+    if (!hEdit) return;
+    HFONT hFont = (HFONT)SendMessage(hEdit, WM_GETFONT, 0, 0);
+    SendMessage(hEdit, WM_SETFONT, 0, FALSE);
+    g_gdiCache.Release(hFont);
+}
+
+// --- [편집창 풀] ---
+// [PRD 4.5] 펼친 오버레이에만 편집창, 반납/재사용 규칙은 core/editor_pool.h (창 핸들 = HWND)
+class Win32EditorHost : public BasicEditorHost<HWND> {
+public:
+    HWND CreateEditor(HWND hOverlay) override {
+        HWND hEdit = CreateWindowW(L"EDIT", NULL, WS_CHILD | ES_LEFT | ES_MULTILINE | ES_AUTOVSCROLL | WS_VSCROLL,
+            0, 0, 0, 0, hOverlay, (HMENU)IDC_MEMO_EDIT, (HINSTANCE)GetWindowLongPtr(hOverlay, GWLP_HINSTANCE), NULL);
+        if (hEdit) SendMessage(hEdit, EM_SETLIMITTEXT, 0, 0); // [PRD 5.5] 기본 3만 자 제한 해제 (대용량 메모 이어 붙이기/입력)
+        return hEdit;
+    }
+    void AdoptEditor(HWND hEdit) override { SetWindowLongPtr(hEdit, GWLP_ID, IDC_MEMO_EDIT); }
+    void DetachEditor(HWND hEdit) override {
+        ReleaseMemoFont(hEdit);
+        ShowWindow(hEdit, SW_HIDE);
+    }
+    void ForgetEditor(HWND hEdit) override { ReleaseMemoFont(hEdit); }
+    size_t EditorTextLength(HWND hEdit) override { return (size_t)GetWindowTextLengthW(hEdit); }
+    void ParkEditor(HWND hEdit) override {
+        // 먼저 ID를 바꿈 -> 비우기의 EN_CHANGE는 만든 오버레이로 가지만 편집창 ID가 아니라 무시됨
+        SetWindowLongPtr(hEdit, GWLP_ID, IDC_MEMO_SPARE);
+        SetWindowTextW(hEdit, L"");
+        SendMessage(hEdit, EM_EMPTYUNDOBUFFER, 0, 0);
+        SendMessage(hEdit, EM_SETREADONLY, FALSE, 0);
+    }
+    void DestroyEditor(HWND hEdit) override { DestroyWindow(hEdit); }
+};
+typedef BasicEditorPool<HWND> EditorPool;
+
+Win32EditorHost g_editorHost;
+EditorPool g_editorPool(&g_editorHost); // UI 스레드 전용
+
+// [PRD 4.5] 오버레이당 자원 보고 -> 편집창 수와 프로세스 USER/GDI 객체, 작업 집합을 오버레이 수로 나눠 기록
+void LogOverlayResources(const wchar_t* when) {
+    size_t overlays = g_overlays.Size();
+    DWORD user = GetGuiResources(GetCurrentProcess(), GR_USEROBJECTS);
+    DWORD gdi = GetGuiResources(GetCurrentProcess(), GR_GDIOBJECTS);
+    PROCESS_MEMORY_COUNTERS pmc = { sizeof(pmc) };
+    SIZE_T workingSet = GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)) ? pmc.WorkingSetSize : 0;
+    double n = overlays ? (double)overlays : 1.0;
+    wchar_t buf[300];
+    swprintf(buf, 300, L"[FolderMemo] overlays(%ls) n=%zu editors=%zu spare=%zu created=%llu reused=%llu destroyed=%llu "
+        L"user=%lu (%.1f/overlay) gdi=%lu (%.1f/overlay) ws=%zuKB (%.0fKB/overlay)\n",
+        when, overlays, g_editorPool.Attached(), g_editorPool.Spare(), g_editorPool.Created(), g_editorPool.Reused(),
+        g_editorPool.Destroyed(), user, user / n, gdi, gdi / n, (size_t)(workingSet / 1024), workingSet / 1024.0 / n);
+    OutputDebugStringW(buf);
+}
+
+// 편집창 위치 (WM_SIZE, 부착 직후)
+void LayoutOverlayEditor(HWND hOverlay) {
+    HWND hEdit = GetDlgItem(hOverlay, IDC_MEMO_EDIT);
+    RECT rc; GetClientRect(hOverlay, &rc);
+    if (!hEdit || rc.bottom <= BTN_SIZE) return;
+    MoveWindow(hEdit, 1, BTN_SIZE + 1, rc.right - 2, rc.bottom - BTN_SIZE - 2, TRUE);
+    SendMessage(hEdit, EM_SETMARGINS, EC_RIGHTMARGIN, MAKELPARAM(0, 0));
+}
+
+// [PRD 4.5] 펼친 오버레이에 편집창 부착 (이미 있으면 그대로)
+HWND AttachOverlayEditor(OverlayPair& pair) {
+    HWND hEdit = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT);
+    if (hEdit) return hEdit;
+    hEdit = g_editorPool.Acquire(pair.hOverlay);
+    if (!hEdit) return NULL;
+    UpdateMemoFont(hEdit, pair.currentFontSize);
+    LayoutOverlayEditor(pair.hOverlay);
+    return hEdit;
 }
 
 // --- [헬퍼 함수] ---
 void SyncOverlayPosition(const OverlayPair& pair); 
 
 // --- [핵심 함수 1] 경로 가져오기 (COM) ---
-std::wstring GetExplorerPath(HWND hExplorer) {
-    std::wstring finalPath = L"";
-    IShellWindows* psw = NULL;
-    wchar_t szTitle[MAX_PATH] = { 0 };
-    GetWindowTextW(hExplorer, szTitle, MAX_PATH);
-    std::wstring windowTitle = szTitle;
+// [PRD 3.1.5] 셸 백엔드 인터페이스/캐시 해석기는 core/explorer_paths.h (창 핸들 = HWND)
+typedef BasicShellTab<HWND> ShellTab;
+typedef BasicShellBackend<HWND> IShellBackend;
+typedef BasicExplorerPathResolver<HWND> ExplorerPathResolver;
 
-    if (SUCCEEDED(CoCreateInstance(CLSID_ShellWindows, NULL, CLSCTX_LOCAL_SERVER, IID_IShellWindows, (void**)&psw))) {
+// [PRD 3.1.5] IShellWindows 기반 백엔드
+// -> 매번 CLSID_ShellWindows를 새로 만들지 않고 연결 하나를 유지. 탐색기 재시작 등으로 끊기면 한 번 재연결.
+// -> MTA에서 생성된 프록시라 다른 MTA 워커 스레드에서도 그대로 사용 가능.
+class ComShellBackend : public IShellBackend {
+public:
+    bool ListTabs(std::vector<ShellTab>& out) override {
+        out.clear();
+        std::lock_guard<std::mutex> lock(m_mutex);
         long count = 0;
-        psw->get_Count(&count);
+        if (!EnsureConnected() || FAILED(m_psw->get_Count(&count))) {
+            DisconnectLocked();
+            if (!EnsureConnected() || FAILED(m_psw->get_Count(&count))) return false;
+        }
         for (long i = 0; i < count; i++) {
             VARIANT v; v.vt = VT_I4; v.lVal = i;
             IDispatch* pDisp = NULL;
-            if (SUCCEEDED(psw->Item(v, &pDisp))) {
+            if (SUCCEEDED(m_psw->Item(v, &pDisp)) && pDisp) {
                 IWebBrowserApp* pApp = NULL;
                 if (SUCCEEDED(pDisp->QueryInterface(IID_IWebBrowserApp, (void**)&pApp))) {
                     HWND hHwnd = NULL;
-                    pApp->get_HWND((LONG_PTR*)&hHwnd);
-                    if (hHwnd == hExplorer) {
-                        BSTR bstrName = NULL;
-                        if (SUCCEEDED(pApp->get_LocationName(&bstrName)) && bstrName) {
-                            std::wstring tabName = bstrName;
-                            SysFreeString(bstrName);
-                            if (windowTitle.find(tabName) != std::wstring::npos) {
-                                BSTR bstrURL = NULL;
-                                if (SUCCEEDED(pApp->get_LocationURL(&bstrURL)) && bstrURL) {
-                                    wchar_t buf[MAX_PATH];
-                                    DWORD len = MAX_PATH;
-                                    if (PathCreateFromUrlW(bstrURL, buf, &len, 0) == S_OK) finalPath = buf;
-                                    SysFreeString(bstrURL);
-                                }
-                            }
+                    if (SUCCEEDED(pApp->get_HWND((LONG_PTR*)&hHwnd))) out.push_back({ hHwnd, pApp });
+                    else pApp->Release();
+                }
+                pDisp->Release();
+            }
+        }
+        return true;
+    }
+
+    bool ReadTab(void* token, std::wstring& name, std::wstring& path) override {
+        IWebBrowserApp* pApp = (IWebBrowserApp*)token;
+        name.clear(); path.clear();
+        BSTR bstrName = NULL;
+        if (FAILED(pApp->get_LocationName(&bstrName)) || !bstrName) return false;
+        name = bstrName;
+        SysFreeString(bstrName);
+        BSTR bstrURL = NULL;
+        if (SUCCEEDED(pApp->get_LocationURL(&bstrURL)) && bstrURL) {
+            wchar_t buf[MAX_PATH];
+            DWORD len = MAX_PATH;
+            if (PathCreateFromUrlW(bstrURL, buf, &len, 0) == S_OK) path = buf;
+            SysFreeString(bstrURL);
+        }
+        return true;
+    }
+
+    void RetainTab(void* token) override { ((IWebBrowserApp*)token)->AddRef(); }
+    void ReleaseTab(void* token) override { ((IWebBrowserApp*)token)->Release(); }
+
+    void Disconnect() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        DisconnectLocked();
+    }
+
+private:
+    bool EnsureConnected() {
+        if (m_psw) return true;
+        return SUCCEEDED(CoCreateInstance(CLSID_ShellWindows, NULL, CLSCTX_LOCAL_SERVER, IID_IShellWindows, (void**)&m_psw));
+    }
+    void DisconnectLocked() {
+        if (m_psw) { m_psw->Release(); m_psw = NULL; }
+    }
+
+    std::mutex m_mutex;
+    IShellWindows* m_psw = NULL;
+};
+
+ComShellBackend g_shellBackend;
+ExplorerPathResolver g_pathResolver(&g_shellBackend);
+
+std::wstring GetExplorerPath(HWND hExplorer, std::wstring* title = nullptr) {
+    wchar_t szTitle[MAX_PATH] = { 0 };
+    GetWindowTextW(hExplorer, szTitle, MAX_PATH);
+    if (title) *title = szTitle;
+    return g_pathResolver.Resolve(hExplorer, szTitle);
+}
+
+// --- [저널 저장 모드] ---
+// [PRD 5.4] 저널 형식/재생/압축은 core/journal.h
+
+MemoJournalStore g_journal;
+
+// --- [메모 존재 캐시] ---
+// [PRD 3.3] 존재/메타데이터 캐시(MemoStatCache)와 캐시 경유 stat은 core/stat_cache.h (Linux 테스트가 inotify 백엔드로 구동)
+
+// [PRD 3.3] 디렉터리 변경 알림 (ReadDirectoryChangesW + IOCP, 전용 스레드 1개)
+// -> 방문한 폴더마다 비재귀 감시 하나. folder_memo.* 이름 변경/기록(또는 알림 버퍼 넘침)이 보이면 해당 폴더 캐시 무효화.
+// -> 감시 수는 MAX_WATCHES로 제한 (가장 오래 안 쓴 것부터 해제 -> 해제된 폴더는 무효화되어 다음 조회 때 다시 stat).
+// -> [PRD 5.8] 오버레이가 열어 둔 폴더는 고정(Pin) -> 해제 대상에서 제외. 같은 폴더를 여러 오버레이가 봐도 감시는 하나.
+// -> 첫 요청은 호출 스레드(경로 탐색 워커, 세션 내내 유지)에서 걸고, 재요청은 감시 스레드가 완료 처리 중에 검.
+class DirectoryWatcher {
+public:
+    using ChangeFn = std::function<void(const std::wstring& folderPath)>;
+    static constexpr size_t MAX_WATCHES = 128;
+
+    explicit DirectoryWatcher(ChangeFn onChange) : m_onChange(std::move(onChange)) {}
+    ~DirectoryWatcher() { Stop(); }
+
+    void Start() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_thread.joinable()) return;
+        m_port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+        if (!m_port) return;
+        m_thread = std::thread(&DirectoryWatcher::Loop, this);
+    }
+
+    // 모든 감시 취소 -> 취소 완료를 전부 받은 뒤 스레드 종료 (커널이 버퍼를 쓰는 중에 해제하지 않도록)
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_thread.joinable()) return;
+        }
+        PostQueuedCompletionStatus(m_port, 0, 0, NULL);
+        m_thread.join();
+        CloseHandle(m_port);
+        m_port = NULL;
+    }
+
+    // 감시 중이거나 새로 걸었으면 true, 알림을 걸 수 없는 폴더(일부 네트워크 공유 등)면 false -> 호출자는 TTL 사용
+    bool Watch(const std::wstring& folderPath) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_port || m_stopping) return false;
+            auto it = m_byPath.find(folderPath);
+            if (it != m_byPath.end()) { it->second->lastUsed = ++m_tick; return true; }
+        }
+        // 느린 공유에서는 여는 데 오래 걸릴 수 있으므로 락 밖에서 열기
+        HANDLE dir = CreateFileW(folderPath.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+        std::wstring evicted;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (dir == INVALID_HANDLE_VALUE) { m_unwatchable++; return false; }
+            auto it = m_byPath.find(folderPath);
+            if (m_stopping || it != m_byPath.end()) { CloseHandle(dir); return !m_stopping; } // 다른 워커가 먼저 걸었음
+            WatchEntry* w = new WatchEntry();
+            w->path = folderPath;
+            w->dir = dir;
+            w->lastUsed = ++m_tick;
+            if (!CreateIoCompletionPort(dir, m_port, (ULONG_PTR)w, 0) || !Arm(w)) {
+                CloseHandle(dir);
+                delete w;
+                m_unwatchable++;
+                return false;
+            }
+            m_byPath[folderPath] = w;
+            m_alive++;
+            if (m_byPath.size() > MAX_WATCHES) evicted = EvictOldestLocked();
+        }
+        if (!evicted.empty()) m_onChange(evicted);
+        return true;
+    }
+
+    // [PRD 5.8] 오버레이가 보는 동안 해제 금지 (참조 카운트)
+    void Pin(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pins[folderPath]++;
+    }
+
+    void Unpin(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pins.find(folderPath);
+        if (it != m_pins.end() && --it->second <= 0) m_pins.erase(it);
+    }
+
+    bool IsWatching(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_byPath.count(folderPath) != 0;
+    }
+
+    size_t Watching() { std::lock_guard<std::mutex> lock(m_mutex); return m_byPath.size(); }
+    unsigned long long Notifications() { std::lock_guard<std::mutex> lock(m_mutex); return m_notifications; }
+    unsigned long long Unwatchable() { std::lock_guard<std::mutex> lock(m_mutex); return m_unwatchable; }
+
+private:
+    struct WatchEntry {
+        std::wstring path;
+        HANDLE dir = INVALID_HANDLE_VALUE;
+        OVERLAPPED ov = {};
+        DWORD buffer[1024]; // DWORD 정렬 필수, 네트워크 공유는 64KB 이하
+        unsigned long long lastUsed = 0;
+        bool closing = false;
+    };
+
+    bool Arm(WatchEntry* w) {
+        memset(&w->ov, 0, sizeof(w->ov));
+        return ReadDirectoryChangesW(w->dir, w->buffer, sizeof(w->buffer), FALSE,
+            FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE, NULL, &w->ov, NULL) != FALSE;
+    }
+
+    // 감시 해제 요청 -> 취소 완료가 도착하면 Loop에서 삭제
+    void CloseLocked(WatchEntry* w) {
+        w->closing = true;
+        m_byPath.erase(w->path);
+        CancelIoEx(w->dir, &w->ov);
+        CloseHandle(w->dir);
+        w->dir = INVALID_HANDLE_VALUE;
+    }
+
+    // 대기 중인 요청이 없는 감시 (방금 완료를 받았고 다시 걸지 못함) -> 바로 삭제
+    void DestroyLocked(WatchEntry* w) {
+        m_byPath.erase(w->path);
+        CloseHandle(w->dir);
+        delete w;
+        m_alive--;
+    }
+
+    std::wstring EvictOldestLocked() {
+        WatchEntry* oldest = nullptr;
+        for (const auto& kv : m_byPath) {
+            if (m_pins.count(kv.first)) continue;
+            if (!oldest || kv.second->lastUsed < oldest->lastUsed) oldest = kv.second;
+        }
+        if (!oldest) return std::wstring(); // 전부 고정 -> 잠시 한도 초과 허용
+        std::wstring path = oldest->path;
+        CloseLocked(oldest);
+        return path;
+    }
+
+    static bool IsMemoFileName(const FILE_NOTIFY_INFORMATION* info) {
+        static const wchar_t prefix[] = L"folder_memo.";
+        const size_t prefixLen = sizeof(prefix) / sizeof(wchar_t) - 1;
+        size_t len = info->FileNameLength / sizeof(WCHAR);
+        return len >= prefixLen && _wcsnicmp(info->FileName, prefix, prefixLen) == 0;
+    }
+
+    void Loop() {
+        for (;;) {
+            DWORD bytes = 0;
+            ULONG_PTR key = 0;
+            OVERLAPPED* ov = NULL;
+            BOOL ok = GetQueuedCompletionStatus(m_port, &bytes, &key, &ov, INFINITE);
+            if (!ov) {
+                if (key == 0) break; // Stop 신호
+                continue;
+            }
+            WatchEntry* w = (WatchEntry*)key;
+            std::wstring changed;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (w->closing) { delete w; m_alive--; continue; }
+                if (!ok) {
+                    // 폴더 삭제/공유 끊김 등 -> 감시 해제하고 TTL로 전환
+                    changed = w->path;
+                    DestroyLocked(w);
+                } else {
+                    m_notifications++;
+                    if (bytes == 0) {
+                        changed = w->path; // 버퍼 넘침 -> 무엇이 바뀌었는지 모르므로 무효화
+                    } else {
+                        const char* p = (const char*)w->buffer;
+                        for (;;) {
+                            const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*)p;
+                            if (IsMemoFileName(info)) { changed = w->path; break; }
+                            if (info->NextEntryOffset == 0) break;
+                            p += info->NextEntryOffset;
                         }
                     }
-                    pApp->Release();
+                    if (!Arm(w)) { changed = w->path; DestroyLocked(w); }
                 }
-                pDisp->Release();
             }
-            if (!finalPath.empty()) break;
+            if (!changed.empty()) m_onChange(changed);
+        }
+
+        // 종료: 남은 감시를 모두 취소하고 취소 완료를 기다림
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        std::vector<WatchEntry*> open;
+        for (const auto& kv : m_byPath) open.push_back(kv.second);
+        for (WatchEntry* w : open) CloseLocked(w);
+        while (m_alive > 0) {
+            lock.unlock();
+            DWORD bytes = 0; ULONG_PTR key = 0; OVERLAPPED* ov = NULL;
+            GetQueuedCompletionStatus(m_port, &bytes, &key, &ov, 1000);
+            lock.lock();
+            if (!ov) { if (key == 0) break; continue; } // 시간 초과 -> 남은 것은 프로세스 종료에 맡김
+            delete (WatchEntry*)key;
+            m_alive--;
+        }
+    }
+
+    ChangeFn m_onChange;
+    std::mutex m_mutex;
+    HANDLE m_port = NULL;
+    std::thread m_thread;
+    bool m_stopping = false;
+    std::unordered_map<std::wstring, WatchEntry*> m_byPath;
+    std::unordered_map<std::wstring, int> m_pins;
+    size_t m_alive = 0; // 완료를 아직 받지 않은 감시 (해제 중 포함)
+    unsigned long long m_tick = 0;
+    unsigned long long m_notifications = 0;
+    unsigned long long m_unwatchable = 0;
+};
+
+MemoStatCache g_statCache;
+void OnMemoFolderChanged(const std::wstring& folderPath); // [PRD 5.8] 캐시 무효화 + 실시간 반영 확인
+DirectoryWatcher g_dirWatcher(OnMemoFolderChanged);
+
+// --- [메모 저장소] ---
+// [PRD 5.7] 저장소 인터페이스 (Storage Backend)
+// -> LoadMemo/SaveMemo/CreateEmptyMemo, 경로 탐색 워커의 존재 확인, 색인기의 스탬프/목록이 모두 이 인터페이스를 거침 -> 백엔드 교체 가능.
+// -> 내용은 UTF-8 바이트로 주고받음 (변환은 호출자 몫). 모든 메서드는 여러 스레드에서 호출될 수 있음.
+// -> Read/Stamp/ListFolders는 색인기 경계(IMemoIndexSource, core/search_index.h)에서 물려받음
+class IMemoStorage : public IMemoIndexSource {
+public:
+    virtual bool Exists(const std::wstring& folderPath) = 0;
+    virtual bool Write(const std::wstring& folderPath, const std::string& bytes) = 0;
+    virtual bool Create(const std::wstring& folderPath) = 0;
+    // 메모리 매핑 가능한 실제 파일 (없으면 빈 경로 -> [PRD 5.5] 분할 로딩 생략)
+    virtual fs::path MappablePath(const std::wstring& folderPath) = 0;
+};
+
+// [PRD 5.7] 폴더별 파일 백엔드 (기본) -> 기존 folder_memo.txt + [PRD 5.4] 저널 동작 그대로
+// [PRD 3.3] 존재/스탬프는 g_statCache 경유 -> 오버레이가 보는 폴더만 감시 등록 (색인기 크롤은 캐시를 채우지 않음)
+class FolderFileStorage : public IMemoStorage {
+public:
+    bool Exists(const std::wstring& folderPath) override {
+        return Stat(folderPath, true).exists;
+    }
+
+    // [PRD 5.4] 남아 있는 저널이 있으면 기준 파일 위에 재생 (저널 모드가 꺼져 있어도 이전 세션의 편집 복구)
+    bool Read(const std::wstring& folderPath, std::string& bytes) override {
+        if (!Exists(folderPath)) return false;
+        bytes = g_journal.Load(folderPath);
+        return true;
+    }
+
+    // [PRD 5.4] 저널 모드거나 큰 메모(JOURNAL_AUTO_BYTES 이상)면 변경 구간만 덧붙이고, 아니면 전체를 원자적으로 교체
+    // -> 작아져 전체 기록으로 돌아오면 남은 저널은 지움 (저널 저장소의 캐시는 디스크와 달라져 다음 읽기/압축 때 버려짐)
+    bool Write(const std::wstring& folderPath, const std::string& bytes) override {
+        bool ok;
+        if (g_config.journalMode || bytes.size() >= JOURNAL_AUTO_BYTES) {
+            ok = g_journal.Save(folderPath, bytes);
+            g_statCache.Invalidate(folderPath); // 저널 기록도 스탬프/존재 캐시에 즉시 반영
+            return ok;
+        }
+        ok = WriteFileAtomic(MemoJournalStore::BasePath(folderPath), bytes);
+        // 이전 세션의 저널이 남아 있으면 새 기준 파일과 어긋나므로 제거
+        if (ok) DeleteFileW(MemoJournalStore::JournalPath(folderPath).c_str());
+        g_statCache.Invalidate(folderPath); // 알림 도착을 기다리지 않고 바로 반영
+        return ok;
+    }
+
+    bool Create(const std::wstring& folderPath) override {
+        bool ok;
+        {
+            std::ofstream ofs(MemoJournalStore::BasePath(folderPath));
+            ok = ofs.good();
         }
-        psw->Release();
+        g_statCache.Invalidate(folderPath);
+        return ok;
+    }
+
+    bool Stamp(const std::wstring& folderPath, long long& mtime, unsigned long long& size) override {
+        MemoStat st = Stat(folderPath, false);
+        mtime = st.mtime;
+        size = st.size;
+        return st.exists;
+    }
+
+    bool ListFolders(std::vector<std::wstring>&) override { return false; }
+    fs::path MappablePath(const std::wstring& folderPath) override { return MemoJournalStore::BasePath(folderPath); }
+
+private:
+    // [PRD 3.3] 캐시 적중이면 디스크 접근 없음. track이면 미스 결과를 캐시하고 감시 등록
+    static MemoStat Stat(const std::wstring& folderPath, bool track) {
+        return StatMemoCached(g_statCache, g_dirWatcher, folderPath, track);
+    }
+};
+
+// [PRD 5.7] 중앙 로그 저장소 (--central-store). 로그/색인/압축은 core/central_store.h, 여기는 IMemoStorage 연결만
+class CentralLogStorage : public IMemoStorage {
+public:
+    static std::wstring NormalizeKey(const std::wstring& folderPath) { return CentralLogStore::NormalizeKey(folderPath); }
+
+    bool Open(const fs::path& dir) {
+        if (!m_store.Open(dir)) return false;
+        CentralLogStore::OpenInfo info = m_store.LastOpen();
+        wchar_t buf[200];
+        swprintf(buf, 200, L"[FolderMemo] central store: %zu memos opened in %lld ms (snapshot=%d, scanned %llu bytes)\n",
+            info.memos, info.ms, info.fromSnapshot ? 1 : 0, (unsigned long long)info.scannedBytes);
+        OutputDebugStringW(buf);
+        return true;
+    }
+
+    void Close() { m_store.Close(); }
+
+    bool Exists(const std::wstring& folderPath) override { return m_store.Exists(folderPath); }
+    bool Read(const std::wstring& folderPath, std::string& bytes) override { return m_store.Read(folderPath, bytes); }
+    bool Write(const std::wstring& folderPath, const std::string& bytes) override { return m_store.Write(folderPath, bytes); }
+
+    bool Create(const std::wstring& folderPath) override {
+        if (m_store.Exists(folderPath)) return true;
+        return m_store.Write(folderPath, std::string());
+    }
+
+    bool Stamp(const std::wstring& folderPath, long long& mtime, unsigned long long& size) override {
+        return m_store.Stamp(folderPath, mtime, size);
+    }
+
+    bool ListFolders(std::vector<std::wstring>& folders) override {
+        m_store.ListFolders(folders);
+        return true;
+    }
+
+    fs::path MappablePath(const std::wstring&) override { return fs::path(); }
+
+    size_t Count() { return m_store.Count(); }
+
+private:
+    CentralLogStore m_store;
+};
+FolderFileStorage g_folderStorage;
+CentralLogStorage g_centralStore;
+
+// --- [볼륨별 I/O 보호] ---
+// [PRD 5.10] 마감 + 차단기 정책과 워커 (core/io_guard.h). 여기는 Win32 취소/오류 분류와 저장소 감싸기만
+// -> 중앙 저장소는 로컬 AppData의 로그 하나라 감싸지 않음.
+class Win32IoPlatform : public IIoPlatform {
+public:
+    void* EnterWorker() override { return OpenThread(THREAD_TERMINATE, FALSE, GetCurrentThreadId()); }
+    void LeaveWorker(void* worker) override { if (worker) CloseHandle((HANDLE)worker); }
+    void CancelWorker(void* worker) override { if (worker) CancelSynchronousIo((HANDLE)worker); }
+    void ResetError() override { SetLastError(ERROR_SUCCESS); }
+    bool LastErrorUnreachable() override {
+        switch (GetLastError()) {
+        case ERROR_NOT_READY:
+        case ERROR_BAD_NETPATH:
+        case ERROR_NETNAME_DELETED:
+        case ERROR_BAD_NET_NAME:
+        case ERROR_UNEXP_NET_ERR:
+        case ERROR_SEM_TIMEOUT:
+        case ERROR_DEV_NOT_EXIST:
+        case ERROR_NETWORK_UNREACHABLE:
+        case ERROR_HOST_UNREACHABLE:
+        case ERROR_DEVICE_NOT_CONNECTED:
+        case ERROR_NO_NET_OR_BAD_PATH:
+        case ERROR_OPERATION_ABORTED: // 취소된 이전 호출
+            return true;
+        default:
+            return false;
+        }
+    }
+};
+
+// [PRD 5.10] 저장소 감싸기 -> 모든 호출이 볼륨 정책을 거쳐 마감 있는 워커에서 실행
+// -> 결과는 워커가 채운 사본으로만 넘김 (마감을 넘기면 호출자 스택은 이미 없음)
+class GuardedStorage : public IMemoStorage {
+public:
+    GuardedStorage(IMemoStorage& inner, VolumeHealth& health, DeadlineIoPool& pool, IIoPlatform* platform)
+        : m_inner(inner), m_health(health), m_pool(pool), m_platform(platform) {}
+
+    bool Exists(const std::wstring& folderPath) override {
+        IMemoStorage* inner = &m_inner;
+        return Guard(folderPath, [inner, folderPath] { return inner->Exists(folderPath); });
+    }
+
+    bool Read(const std::wstring& folderPath, std::string& bytes) override {
+        IMemoStorage* inner = &m_inner;
+        return Call<std::string>(folderPath, bytes, [inner, folderPath](std::string& out) { return inner->Read(folderPath, out); });
+    }
+
+    bool Write(const std::wstring& folderPath, const std::string& bytes) override {
+        std::wstring key = CentralLogStorage::NormalizeKey(folderPath);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_writing.count(key)) { m_deferred++; return false; } // 마감을 넘긴 이전 기록이 아직 진행 중
+            m_writing.insert(key);
+        }
+        IMemoStorage* inner = &m_inner;
+        auto copy = std::make_shared<std::string>(bytes);
+        return Guard(folderPath, [inner, folderPath, copy] { return inner->Write(folderPath, *copy); }, [this, key] {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_writing.erase(key);
+        });
+    }
+
+    bool Create(const std::wstring& folderPath) override {
+        IMemoStorage* inner = &m_inner;
+        return Guard(folderPath, [inner, folderPath] { return inner->Create(folderPath); });
+    }
+
+    bool Stamp(const std::wstring& folderPath, long long& mtime, unsigned long long& size) override {
+        IMemoStorage* inner = &m_inner;
+        MemoStat st;
+        if (!Call<MemoStat>(folderPath, st, [inner, folderPath](MemoStat& out) { return inner->Stamp(folderPath, out.mtime, out.size); })) return false;
+        mtime = st.mtime;
+        size = st.size;
+        return true;
+    }
+
+    bool ListFolders(std::vector<std::wstring>& folders) override { return m_inner.ListFolders(folders); }
+    fs::path MappablePath(const std::wstring& folderPath) override { return m_inner.MappablePath(folderPath); }
+
+    // 저장소 밖의 직접 조회(디스크 스탬프 등)도 같은 마감/차단기로. out은 성공했을 때만 채움
+    template <typename T>
+    bool Call(const std::wstring& folderPath, T& out, std::function<bool(T&)> op) {
+        auto result = std::make_shared<T>();
+        if (!Guard(folderPath, [result, op] { return op(*result); })) return false;
+        out = std::move(*result);
+        return true;
+    }
+
+    // 차단기가 열린 볼륨 -> 편집 불가로 표시, 직접 매핑 생략
+    bool Reachable(const std::wstring& folderPath) { return m_health.ClassOf(VolumeKeyOf(folderPath)) != VolumeClass::Unavailable; }
+
+    // 저장 큐용: 실패한 저장을 다시 시도할 대기 시간 (ms), 다시 해도 소용없으면 -1
+    int RetryDelayMs(const std::wstring& folderPath) {
+        int ms = m_health.RetryDelayMs(VolumeKeyOf(folderPath), IoNowMs());
+        if (ms < 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_writing.count(CentralLogStorage::NormalizeKey(folderPath))) ms = 0;
+        }
+        return ms < 0 ? -1 : std::max(ms, IO_RETRY_MIN_MS);
+    }
+
+    void LogStats() {
+        wchar_t buf[256];
+        for (const VolumeHealth::Stats& s : m_health.Snapshot()) {
+            swprintf(buf, 256, L"[FolderMemo] io volume %ls: %ls latency=%.1fms ops=%llu timeouts=%llu rejected=%llu trips=%llu\n",
+                s.volume.empty() ? L"(other)" : s.volume.c_str(), VolumeClassName(s.cls), s.latencyMs, s.ops, s.timeouts, s.rejected, s.trips);
+            OutputDebugStringW(buf);
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        swprintf(buf, 256, L"[FolderMemo] io workers=%zu deferred writes=%llu\n", m_pool.Workers(), m_deferred);
+        OutputDebugStringW(buf);
+    }
+
+private:
+    bool Guard(const std::wstring& folderPath, std::function<bool()> op, std::function<void()> finished = nullptr) {
+        return GuardIo(m_health, m_pool, m_platform, folderPath, std::move(op), std::move(finished));
+    }
+
+    IMemoStorage& m_inner;
+    VolumeHealth& m_health;
+    DeadlineIoPool& m_pool;
+    IIoPlatform* m_platform;
+    std::mutex m_mutex;
+    std::unordered_set<std::wstring> m_writing; // 정규화 경로 -> 기록 진행 중 (마감을 넘긴 것 포함)
+    unsigned long long m_deferred = 0;
+};
+
+Win32IoPlatform g_ioPlatform;
+VolumeHealth g_volumeHealth;
+DeadlineIoPool g_ioPool(&g_ioPlatform);
+GuardedStorage g_guardedStorage(g_folderStorage, g_volumeHealth, g_ioPool, &g_ioPlatform);
+IMemoStorage* g_storage = &g_guardedStorage; // WinMain에서 --central-store면 교체
+
+// --- [메모 기록 보관] ---
+// [PRD 5.9] 버전 저장소 (청크 분할/SHA-256/보존 정책, 저장소 구현은 core/history.h)
+MemoHistoryStore g_memoHistory;
+
+// --- [메모 내용 캐시] ---
+// [PRD 3.4] LRU + 바이트 예산, 스탬프 검증 (설계 설명과 구현은 core/memo_cache.h)
+MemoContentCache g_memoCache(g_config.memoCacheMb * 1024 * 1024); // WinMain에서 --memo-cache-mb 반영
+
+// [PRD 3.4] 캐시 검증/저장용 스탬프 (폴더 저장소는 존재 캐시 경유, 중앙 저장소는 메모리 색인)
+bool MemoCacheStamp(const std::wstring& folderPath, MemoStat& out) {
+    if (!g_storage->Stamp(folderPath, out.mtime, out.size)) return false;
+    out.exists = true;
+    return true;
+}
+
+std::shared_ptr<const CachedMemo> FindCachedMemo(const std::wstring& folderPath) {
+    MemoStat stamp;
+    if (!MemoCacheStamp(folderPath, stamp)) {
+        g_memoCache.Invalidate(folderPath); // 지워졌거나 볼륨이 끊김
+        return nullptr;
+    }
+    return g_memoCache.Lookup(folderPath, stamp);
+}
+
+// rawBytes: [PRD 5.8] 병합 기준으로 쓸 원본 UTF-8 (필요한 호출자만)
+// found: [PRD 3.4] 실제로 읽었는지 (빈 메모와 읽기 실패 구분 -> 실패는 캐시하지 않음)
+std::wstring LoadMemo(const std::wstring& folderPath, std::string* rawBytes = nullptr, bool* found = nullptr) {
+    if (found) *found = false;
+    if (folderPath.empty()) return L"";
+    FM_TRACE_SCOPE(LoadMemo, 0); // [PRD 7.1]
+    std::string bytes;
+    if (!g_storage->Read(folderPath, bytes)) return L"";
+    if (found) *found = true;
+    std::wstring text = Utf8ToWide(bytes);
+    if (rawBytes) *rawBytes = std::move(bytes);
+    return text;
+}
+
+// [PRD 5.3] 저장 (Writer 스레드 전용, UI 스레드 직접 호출 금지)
+// [PRD 5.7] 실제 기록 방식(원자적 교체/저널/중앙 로그)은 선택된 저장소가 결정
+// [PRD 5.11] bytes = 편집 버퍼의 저장 사본 (저장 시 인코딩/디코드 없음, 캐시와 버전 기록은 같은 사본을 공유)
+bool SaveMemo(const std::wstring& folderPath, const std::shared_ptr<const std::string>& bytes) {
+    if (folderPath.empty()) return false;
+    FM_TRACE_SCOPE(SaveMemo, 0); // [PRD 7.1]
+    if (!g_storage->Write(folderPath, *bytes)) {
+        // [PRD 5.10] 볼륨이 끊겨 저장 큐가 다시 시도할 내용 -> 끝내 돌아오지 않아도 --restore로 되살리도록 로컬 기록에 남김
+        if (g_guardedStorage.RetryDelayMs(folderPath) >= 0) g_memoHistory.OnSaved(folderPath, bytes);
+        g_memoCache.Invalidate(folderPath);
+        return false;
+    }
+    g_memoHistory.OnSaved(folderPath, bytes); // [PRD 5.9]
+    MemoStat stamp;
+    if (MemoCacheStamp(folderPath, stamp)) g_memoCache.Store(folderPath, bytes, stamp); // [PRD 3.4] 다시 방문하면 읽지 않고 표시
+    else g_memoCache.Invalidate(folderPath);
+    return true;
+}
+
+bool CreateEmptyMemo(const std::wstring& folderPath) {
+    if (folderPath.empty()) return false;
+    return g_storage->Create(folderPath);
+}
+
+// --- [전역 메모 검색] ---
+// [PRD 6.1] 앱 데이터 폴더 (%LOCALAPPDATA%\FolderMemo) -> 색인 등 폴더 밖에 두는 파일의 위치
+fs::path AppDataDir() {
+    const wchar_t* base = _wgetenv(L"LOCALAPPDATA");
+    fs::path dir = base ? fs::path(base) : fs::temp_directory_path();
+    dir /= L"FolderMemo";
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    return dir;
+}
+
+// [PRD 6.1] 메모리 매핑 파일은 core/file_io.h, n-gram 토큰화는 core/grams.h, 역색인/색인기는 core/search_index.h (fm_search/Linux 벤치와 같은 코드)
+
+MemoSearchIndex g_searchIndex;
+
+// 메모 메타데이터 (증분 색인 판단용) -> [PRD 5.7] 선택된 저장소 기준
+bool GetMemoFileStamp(const std::wstring& folderPath, long long& mtime, unsigned long long& size) {
+    return g_storage->Stamp(folderPath, mtime, size);
+}
+
+MemoIndexer g_indexer(g_searchIndex); // [PRD 6.1] 백그라운드 색인기 (크롤 로직은 core/search_index.h)
+
+// [PRD 6.1] 색인 루트 목록 -> 명령줄 --index-root + %LOCALAPPDATA%\FolderMemo\index_roots.txt (한 줄에 하나, UTF-8)
+std::vector<std::wstring> LoadIndexRoots() {
+    std::vector<std::wstring> roots = g_config.indexRoots;
+    std::string bytes;
+    if (ReadWholeFile(AppDataDir() / L"index_roots.txt", bytes)) {
+        std::wstring text = Utf8ToWide(bytes);
+        size_t start = 0;
+        while (start <= text.size()) {
+            size_t end = text.find(L'\n', start);
+            if (end == std::wstring::npos) end = text.size();
+            std::wstring line = text.substr(start, end - start);
+            while (!line.empty() && (line.back() == L'\r' || line.back() == L' ')) line.pop_back();
+            if (!line.empty()) roots.push_back(line);
+            start = end + 1;
+        }
+    }
+    return roots;
+}
+
+// --- [실시간 반영] ---
+// [PRD 5.8] 디스크 변경 실시간 반영 (Live Reload + Conflict Guard)
+// -> 동료/동기화 클라이언트가 folder_memo.txt를 고쳐도 열린 오버레이가 옛 내용을 보여 주다가 다음 입력에 덮어쓰던 문제 해결.
+// -> base = 화면 내용이 마지막으로 반영한 디스크 내용. 폴더별로 하나 (같은 폴더를 보는 오버레이끼리 공유).
+// -> 감지: g_dirWatcher 알림(고정 감시) -> LiveReloader 워커가 디스크를 읽어 base와 다르면 UI로 전달 -> UI가 화면 내용과 3-way 병합.
+// -> 기록 보호: Writer는 기록 전에 디스크 스탬프를 확인, base 이후 바뀌었으면 덮어쓰지 않고 병합본을 기록 (충돌이면 기록 안 함 + 사본 보관).
+// [PRD 5.8] 줄 단위 3-way 병합(MergeMemoText)은 core/memo_merge.h
+
+// [PRD 5.8] 디스크 스탬프 직접 조회 (캐시 우회 -> 기록 직전 판단용). 실제 파일이 없는 저장소는 false
+// [PRD 5.10] 볼륨 마감/차단기를 거침 (UI 스레드에서도 호출됨)
+bool MemoDiskStamp(const std::wstring& folderPath, MemoStat& out) {
+    fs::path p = g_storage->MappablePath(folderPath);
+    if (p.empty()) return false;
+    return g_guardedStorage.Call<MemoStat>(folderPath, out, [p](MemoStat& st) {
+        std::error_code ec;
+        auto t = fs::last_write_time(p, ec);
+        if (ec) return false;
+        st.size = (unsigned long long)fs::file_size(p, ec);
+        if (ec) return false;
+        st.mtime = (long long)t.time_since_epoch().count();
+        st.exists = true;
+        return true;
+    });
+}
+
+// [PRD 5.8] 병합 충돌 시 내 편집본을 옆에 보관 -> 어떤 경우에도 편집 내용을 잃지 않음
+void WriteConflictCopy(const std::wstring& folderPath, const std::string& bytes) {
+    SYSTEMTIME st; GetLocalTime(&st);
+    wchar_t name[80];
+    swprintf(name, 80, L"folder_memo.conflict-%04d%02d%02d-%02d%02d%02d.txt", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+    fs::path p = g_storage->MappablePath(folderPath);
+    if (p.empty() || !WriteFileAtomic(p.parent_path() / name, bytes)) WriteFileAtomic(AppDataDir() / name, bytes);
+}
+
+// [PRD 5.8] 병합 기준 내용. [PRD 5.5] 분할 로딩한 큰 파일은 사본 대신 SHA-256만 (digestOnly)
+struct MemoBase {
+    std::string bytes;
+    Sha256::Digest digest{};
+    bool digestOnly = false;
+
+    bool Matches(const std::string& other) const {
+        return digestOnly ? Sha256::Of(other.data(), other.size()) == digest : other == bytes;
+    }
+};
+
+// 3-way 병합. 기준이 해시뿐이면 한쪽이 기준 그대로일 때만 깨끗이, 아니면 기준 없이 병합 (겹치는 부분은 충돌 표식)
+bool MergeWithBase(const MemoBase& base, const std::string& ours, const std::string& theirs, std::string& out) {
+    if (!base.digestOnly) return MergeMemoText(base.bytes, ours, theirs, out);
+    if (ours == theirs || base.Matches(theirs)) { out = ours; return true; }
+    if (base.Matches(ours)) { out = theirs; return true; }
+    return MergeMemoText(std::string(), ours, theirs, out);
+}
+
+// [PRD 5.8] 폴더별 병합 기준 + 보고 있는 오버레이 (UI 스레드가 등록/해제, Writer/LiveReloader가 조회)
+class MemoSyncTable {
+public:
+    void AddViewer(const std::wstring& folderPath, HWND hOverlay) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[folderPath].viewers.push_back(hOverlay);
+    }
+
+    // 마지막 오버레이가 떠나면 기준도 버림 (아무도 안 보는 폴더는 보호/감지 대상 아님)
+    // -> 단, 아직 기록 안 된 저장이 남아 있으면(keepForSave) 그 기록이 끝날 때까지 기준 유지
+    void RemoveViewer(const std::wstring& folderPath, HWND hOverlay, bool keepForSave) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(folderPath);
+        if (it == m_entries.end()) return;
+        auto& v = it->second.viewers;
+        v.erase(std::remove(v.begin(), v.end(), hOverlay), v.end());
+        if (v.empty() && !keepForSave) m_entries.erase(it);
+    }
+
+    // Writer 기록 후 -> 보는 오버레이가 없으면 기준 정리
+    void DropIfUnviewed(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(folderPath);
+        if (it != m_entries.end() && it->second.viewers.empty()) m_entries.erase(it);
+    }
+
+    void SetBase(const std::wstring& folderPath, std::string base, const MemoStat& stamp) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(folderPath);
+        if (it == m_entries.end()) return;
+        it->second.base.bytes = std::move(base);
+        it->second.base.digestOnly = false;
+        it->second.stamp = stamp;
+        it->second.known = true;
+    }
+
+    // [PRD 5.5] 분할 로딩 완료 -> 매핑 전체를 복사하지 않고 해시만 기준으로
+    void SetBaseDigest(const std::wstring& folderPath, const Sha256::Digest& digest, const MemoStat& stamp) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(folderPath);
+        if (it == m_entries.end()) return;
+        std::string().swap(it->second.base.bytes);
+        it->second.base.digest = digest;
+        it->second.base.digestOnly = true;
+        it->second.stamp = stamp;
+        it->second.known = true;
+    }
+
+    bool GetBase(const std::wstring& folderPath, MemoBase& base, MemoStat* stamp = nullptr, HWND* viewer = nullptr) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(folderPath);
+        if (it == m_entries.end() || !it->second.known) return false;
+        if (viewer && it->second.viewers.empty()) return false; // 화면이 없으면 반영할 곳도 없음
+        base = it->second.base;
+        if (stamp) *stamp = it->second.stamp;
+        if (viewer) *viewer = it->second.viewers.front();
+        return true;
+    }
+
+    bool IsViewed(const std::wstring& folderPath) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(folderPath);
+        return it != m_entries.end() && !it->second.viewers.empty();
+    }
+
+private:
+    struct Entry {
+        std::vector<HWND> viewers;
+        MemoBase base;
+        MemoStat stamp;     // base를 읽기 직전(또는 기록 직후)의 디스크 스탬프
+        bool known = false; // 저장 대기 내용으로 채운 경우 등은 기준 없음 -> 첫 기록 후 확정
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<std::wstring, Entry> m_entries;
+};
+
+MemoSyncTable g_memoSync;
+
+// [PRD 5.8] 워커 -> UI 전달 (디스크의 새 내용)
+struct MemoReload {
+    std::wstring folderPath;
+    std::string disk;
+    MemoStat stamp;
+};
+MpscQueue<MemoReload> g_memoReloads;
+
+// [PRD 5.8] 변경 확인 워커 -> 알림을 폴더 단위로 합쳐 디스크를 한 번만 읽음
+// -> 감시를 걸 수 없는 폴더(일부 네트워크 공유)는 RELOAD_POLL_MS마다 확인. 보는 폴더가 모두 감시 중이면 시한 없이 대기 (주기 깨우기 0회)
+class LiveReloader {
+public:
+    static constexpr int RELOAD_POLL_MS = 5000;
+
+    ~LiveReloader() { Stop(); }
+
+    void Start() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_thread.joinable()) return;
+        m_stop = false;
+        m_thread = std::thread(&LiveReloader::Run, this);
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_thread.joinable()) return;
+            m_stop = true;
+        }
+        m_cv.notify_one();
+        m_thread.join();
+    }
+
+    void Notify(const std::wstring& folderPath) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_queued.insert(folderPath).second) return; // 이미 대기 중 -> 합침
+            m_queue.push_back(folderPath);
+        }
+        m_cv.notify_one();
+    }
+
+    unsigned long long Reloads() { std::lock_guard<std::mutex> lock(m_mutex); return m_reloads; }
+
+private:
+    void Run() {
+        auto nextPoll = std::chrono::steady_clock::now() + std::chrono::milliseconds(RELOAD_POLL_MS);
+        for (;;) {
+            std::wstring folder;
+            std::vector<std::wstring> polled;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                auto ready = [this] { return m_stop || !m_queue.empty(); };
+                if (m_polled.empty()) {
+                    m_cv.wait(lock, ready); // 감시가 모두 살아 있음 -> 알림만 기다림
+                    nextPoll = std::chrono::steady_clock::now() + std::chrono::milliseconds(RELOAD_POLL_MS);
+                } else {
+                    m_cv.wait_until(lock, nextPoll, ready);
+                }
+                if (m_stop) return;
+                if (m_queue.empty()) {
+                    nextPoll = std::chrono::steady_clock::now() + std::chrono::milliseconds(RELOAD_POLL_MS);
+                    polled.assign(m_polled.begin(), m_polled.end());
+                } else {
+                    folder = std::move(m_queue.front());
+                    m_queue.pop_front();
+                    m_queued.erase(folder);
+                }
+            }
+            for (const auto& f : polled) Notify(f);
+            if (!folder.empty()) Check(folder);
+        }
+    }
+
+    void Check(const std::wstring& folderPath) {
+        // 감시가 없는(걸 수 없거나 풀린) 보는 폴더만 주기 확인 목록에 -> 감시가 다시 걸리거나 아무도 안 보면 빠짐
+        bool poll = g_memoSync.IsViewed(folderPath) && !g_dirWatcher.IsWatching(folderPath);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (poll) m_polled.insert(folderPath); else m_polled.erase(folderPath);
+        }
+        MemoBase base;
+        HWND viewer = NULL;
+        if (!g_memoSync.GetBase(folderPath, base, nullptr, &viewer)) return;
+        MemoReload r;
+        r.folderPath = folderPath;
+        MemoDiskStamp(folderPath, r.stamp); // 읽기 전에 스탬프 -> 그 사이 변경은 다음 확인에서 다시 잡힘
+        if (!g_storage->Read(folderPath, r.disk) || base.Matches(r.disk)) return; // 삭제됨 / 우리 기록의 메아리
+        g_memoReloads.Push(std::move(r));
+        PostMessage(viewer, WM_MEMO_RELOAD, 0, 0);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_reloads++;
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::wstring> m_queue;
+    std::unordered_set<std::wstring> m_queued;
+    std::unordered_set<std::wstring> m_polled; // 감시 없이 보는 폴더 (RELOAD_POLL_MS마다 확인)
+    std::thread m_thread;
+    bool m_stop = false;
+    unsigned long long m_reloads = 0;
+};
+
+LiveReloader g_liveReload;
+
+void OnMemoFolderChanged(const std::wstring& folderPath) {
+    g_statCache.Invalidate(folderPath);
+    g_liveReload.Notify(folderPath);
+}
+
+// [PRD 5.3] 기록 + [PRD 6.1] 검색 색인 증분 갱신
+// [PRD 5.11] 저장마다 전체 디코드/gram 추출 없음: 캐시는 첫 적중 때, 색인은 질의/병합 때 같은 사본에서 한 번
+// -> 디스크 기록도 큰 메모는 바뀐 구간만 ([PRD 5.4] JOURNAL_AUTO_BYTES 이상이면 저널)
+bool WriteMemoAndIndex(const std::wstring& folderPath, const std::shared_ptr<const std::string>& bytes) {
+    if (!SaveMemo(folderPath, bytes)) return false;
+    long long mtime = 0; unsigned long long size = 0;
+    GetMemoFileStamp(folderPath, mtime, size);
+    g_searchIndex.UpdateDocumentLater(folderPath, bytes, mtime, size);
+    return true;
+}
+
+// [PRD 5.3] Writer 함수
+// [PRD 5.8] 오버레이가 보는 폴더는 기록 전에 base 이후 디스크 변경 여부 확인 (스탬프가 같으면 읽지 않음)
+// -> 바뀌었으면 병합본을 기록하고 base는 그대로 둠 (화면은 아직 병합 전이므로 UI가 다시 병합해 맞춤)
+// -> 충돌이면 디스크는 건드리지 않고 내 편집본을 사본으로 보관 -> UI가 충돌 표시
+bool PersistMemo(const std::wstring& folderPath, const std::shared_ptr<const std::string>& bytes) {
+    MemoBase base;
+    MemoStat baseStamp, diskStamp;
+    if (g_memoSync.GetBase(folderPath, base, &baseStamp) && MemoDiskStamp(folderPath, diskStamp) &&
+        (diskStamp.mtime != baseStamp.mtime || diskStamp.size != baseStamp.size)) {
+        std::string disk;
+        if (g_storage->Read(folderPath, disk) && !base.Matches(disk)) {
+            auto merged = std::make_shared<std::string>();
+            bool clean = MergeWithBase(base, *bytes, disk, *merged);
+            g_liveReload.Notify(folderPath);
+            bool ok = false;
+            if (clean) ok = WriteMemoAndIndex(folderPath, merged);
+            else WriteConflictCopy(folderPath, *bytes);
+            g_memoSync.DropIfUnviewed(folderPath);
+            return ok;
+        }
+    }
+    if (!WriteMemoAndIndex(folderPath, bytes)) return false;
+    MemoStat stamp;
+    if (MemoDiskStamp(folderPath, stamp)) g_memoSync.SetBase(folderPath, *bytes, stamp);
+    g_memoSync.DropIfUnviewed(folderPath);
+    return true;
+}
+
+// --- [메모 편집 버퍼] / [저장 파이프라인] ---
+// [PRD 5.11] 편집 버퍼(MemoBuffer)는 core/memo_buffer.h, [PRD 5.3] 저장 큐(MemoSaveQueue)는 core/save_queue.h
+
+MemoSaveQueue g_saveQueue(PersistMemo, [](const std::wstring& folderPath) { return g_guardedStorage.RetryDelayMs(folderPath); });
+
+// --- [대용량 메모 로딩] ---
+// [PRD 5.5] 매핑/청크 경계/백그라운드 변환은 core/paged_load.h (Linux 벤치가 가짜 UI 큐로 구동). 여기는 편집창 연결만
+// -> 로딩 중에는 편집창을 읽기 전용으로 두고 저장을 막음 (일부만 로드된 내용으로 덮어쓰기 방지).
+typedef BasicMemoChunk<HWND> MemoChunk;
+
+void PagedLoadWorker(std::shared_ptr<PagedMemoLoad> load) {
+    RunPagedLoadWorker(load, [](MemoChunk* chunk) { return PostMessage(chunk->load->hOverlay, WM_MEMO_CHUNK, 0, (LPARAM)chunk) != FALSE; });
+}
+
+// 진행 중인 로딩 취소 (경로 이동, 오버레이 종료)
+void CancelPagedLoad(OverlayPair& pair) {
+    if (!pair.pagedLoad) return;
+    pair.pagedLoad->Cancel();
+    pair.pagedLoad.reset();
+    HWND hEdit = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT);
+    if (hEdit) SendMessage(hEdit, EM_SETREADONLY, pair.speculative, 0); // [PRD 3.1.6] 추측 표시 중이면 잠금 유지
+}
+
+// 큰 파일이면 첫 화면만 표시하고 true, 아니면 false (일반 로딩으로 진행)
+bool BeginPagedLoad(OverlayPair& pair) {
+    fs::path p = g_storage->MappablePath(pair.currentPath); // [PRD 5.7] 중앙 저장소는 실제 파일이 없으므로 일반 로딩
+    if (p.empty()) return false;
+    // [PRD 5.8] 매핑 전 스탬프. [PRD 5.10] 크기 확인을 겸해 마감 있는 조회로 (끊긴 볼륨이면 일반 로딩 -> 즉시 실패)
+    MemoStat stamp;
+    if (!MemoDiskStamp(pair.currentPath, stamp) || stamp.size < PAGED_LOAD_THRESHOLD) return false;
+    std::error_code ec;
+    if (fs::exists(MemoJournalStore::JournalPath(pair.currentPath), ec)) return false; // 저널 재생이 필요하면 일반 로딩
+
+    auto load = std::make_shared<PagedMemoLoad>();
+    if (!load->Open(p)) return false;
+    load->stamp = stamp;
+    load->hOverlay = pair.hOverlay;
+
+    HWND hEdit = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT);
+    pair.pagedLoad = load; // EN_CHANGE 저장 차단이 먼저 걸려야 함
+    if (hEdit) SendMessage(hEdit, EM_SETREADONLY, TRUE, 0);
+    std::wstring first;
+    load->FirstScreen(first);
+    SetDlgItemTextW(pair.hOverlay, IDC_MEMO_EDIT, first.c_str());
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - load->started).count();
+    wchar_t buf[160];
+    swprintf(buf, 160, L"[FolderMemo] paged load: first screen in %lld ms (%llu bytes total)\n", (long long)ms, (unsigned long long)load->map.Size());
+    OutputDebugStringW(buf);
+
+    if (load->Complete()) {
+        g_memoSync.SetBase(pair.currentPath, std::string(load->map.Data(), load->map.Size()), stamp); // 첫 화면이 전부
+        CancelPagedLoad(pair);
+        return true;
+    }
+    std::thread(PagedLoadWorker, load).detach();
+    return true;
+}
+
+// WM_MEMO_CHUNK -> 화면 위치/선택을 유지한 채 끝에 이어 붙임
+void AppendMemoChunk(HWND hwnd, MemoChunk* raw) {
+    std::unique_ptr<MemoChunk> chunk(raw);
+    chunk->load->ChunkConsumed();
+
+    OverlayPair* pair = g_overlays.FindByOverlay(hwnd);
+    if (!pair || pair->pagedLoad != chunk->load || chunk->load->cancelled) return; // 이미 다른 폴더로 이동
+
+    HWND hEdit = GetDlgItem(hwnd, IDC_MEMO_EDIT);
+    if (hEdit) {
+        DWORD selStart = 0, selEnd = 0;
+        SendMessage(hEdit, EM_GETSEL, (WPARAM)&selStart, (LPARAM)&selEnd);
+        int topLine = (int)SendMessage(hEdit, EM_GETFIRSTVISIBLELINE, 0, 0);
+        SendMessage(hEdit, WM_SETREDRAW, FALSE, 0);
+        int len = GetWindowTextLengthW(hEdit);
+        SendMessage(hEdit, EM_SETSEL, len, len);
+        SendMessage(hEdit, EM_REPLACESEL, FALSE, (LPARAM)chunk->text.c_str());
+        SendMessage(hEdit, EM_SETSEL, selStart, selEnd);
+        int newTop = (int)SendMessage(hEdit, EM_GETFIRSTVISIBLELINE, 0, 0);
+        SendMessage(hEdit, EM_LINESCROLL, 0, topLine - newTop);
+        SendMessage(hEdit, WM_SETREDRAW, TRUE, 0);
+        InvalidateRect(hEdit, NULL, TRUE);
+    }
+
+    if (chunk->last) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - chunk->load->started).count();
+        wchar_t buf[120];
+        swprintf(buf, 120, L"[FolderMemo] paged load: complete in %lld ms\n", (long long)ms);
+        OutputDebugStringW(buf);
+        g_memoSync.SetBaseDigest(pair->currentPath, chunk->digest, chunk->load->stamp); // [PRD 5.8]
+        CancelPagedLoad(*pair); // 정상 완료 -> 읽기 전용 해제
+    }
+}
+
+// --- [핵심 함수 2] 위치 동기화 ---
+// [PRD 3.2.2] 스케줄러/창 백엔드 인터페이스는 core/position_scheduler.h (Linux 테스트가 가짜 창으로 구동)
+typedef BasicOverlayWindowOps<HWND> IOverlayWindowOps;
+typedef BasicOverlayPositionScheduler<HWND> OverlayPositionScheduler;
+
+class Win32OverlayWindowOps : public IOverlayWindowOps {
+public:
+    bool GetExplorerFrame(HWND hExplorer, int& right, int& bottom) override {
+        if (!IsWindow(hExplorer)) return false;
+        RECT rcExp;
+        HRESULT res = DwmGetWindowAttribute(hExplorer, DWMWA_EXTENDED_FRAME_BOUNDS, &rcExp, sizeof(rcExp));
+        if (res != S_OK) GetWindowRect(hExplorer, &rcExp);
+        right = rcExp.right;
+        bottom = rcExp.bottom;
+        return true;
+    }
+
+    // DeferWindowPos 트랜잭션 -> 여러 창을 한 번에 재배치 (실패 시 개별 SetWindowPos)
+    void MoveOverlays(const std::vector<std::pair<HWND, OverlayRect>>& moves) override {
+        const UINT flags = SWP_NOACTIVATE | SWP_NOZORDER | SWP_SHOWWINDOW;
+        HDWP hdwp = BeginDeferWindowPos((int)moves.size());
+        for (const auto& m : moves) {
+            if (hdwp) hdwp = DeferWindowPos(hdwp, m.first, NULL, m.second.x, m.second.y, m.second.w, m.second.h, flags);
+        }
+        if (hdwp && EndDeferWindowPos(hdwp)) return;
+        for (const auto& m : moves) SetWindowPos(m.first, NULL, m.second.x, m.second.y, m.second.w, m.second.h, flags);
+    }
+};
+
+// 탐색기 우측 하단 기준 좌표 계산
+OverlayRect ComputeOverlayRect(int explorerRight, int explorerBottom, const OverlayPair& pair) {
+    bool smallMode = pair.isMinimized;
+    int targetW = smallMode ? MINIMIZED_SIZE : (pair.isExpanded ? EXPANDED_WIDTH : OVERLAY_WIDTH);
+    int targetH = smallMode ? MINIMIZED_SIZE : (pair.isExpanded ? EXPANDED_HEIGHT : OVERLAY_HEIGHT);
+    return { explorerRight - targetW - 25, explorerBottom - targetH - 25, targetW, targetH };
+}
+
+Win32OverlayWindowOps g_windowOps;
+OverlayPositionScheduler g_positionScheduler(&g_windowOps);
+
+// 즉시 동기화 (상태 토글, 탐색 결과 적용 등 사용자 동작에 대한 반응)
+void SyncOverlayPosition(const OverlayPair& pair) {
+    int right, bottom;
+    if (!g_windowOps.GetExplorerFrame(pair.hExplorer, right, bottom)) return;
+    OverlayRect rc = ComputeOverlayRect(right, bottom, pair);
+
+    SetWindowPos(pair.hOverlay, NULL, rc.x, rc.y, rc.w, rc.h, SWP_NOACTIVATE | SWP_NOZORDER | SWP_SHOWWINDOW);
+    g_positionScheduler.NoteApplied(pair.hOverlay, rc);
+    HWND hEdit = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT);
+    if (hEdit) ShowWindow(hEdit, pair.isMinimized ? SW_HIDE : SW_SHOW);
+}
+
+bool OverlayTargetRect(HWND hOverlay, OverlayRect& out) {
+    const OverlayPair* pair = g_overlays.FindByOverlay(hOverlay);
+    if (!pair) return false;
+    int right, bottom;
+    if (!g_windowOps.GetExplorerFrame(pair->hExplorer, right, bottom)) return false;
+    out = ComputeOverlayRect(right, bottom, *pair);
+    return true;
+}
+
+// [PRD 3.2.2] LOCATIONCHANGE/FOREGROUND 진입점 -> 이후 프레임은 메시지 루프가 대기 시한으로 박자를 맞춤 (PumpOverlayMessages)
+void SchedulePositionSync(HWND hOverlay) {
+    g_positionScheduler.Schedule(hOverlay, OverlayTargetRect);
+}
+
+// [PRD 3.2.2] MOVESIZEEND 진입점 -> 최종 위치 즉시 반영
+void SettlePositionSync(HWND hOverlay) {
+    g_positionScheduler.Settle(hOverlay, OverlayTargetRect);
+}
+
+// --- [경로 탐색 워커 풀] ---
+// [PRD 3.1.2] 워커 풀/재시도 정책 본체는 core/path_jobs.h. 워커마다 COM(MTA) 초기화 1회
+typedef BasicPathJobPool<HWND> PathJobPool;
+
+void PathFinderJob(HWND hOverlay, HWND hExplorer, unsigned long long generation);
+PathJobPool g_pathJobs(PathFinderJob, [] { CoInitializeEx(NULL, COINIT_MULTITHREADED); }, [] { CoUninitialize(); });
+
+// [PRD 3.1.1] 비동기 경로 탐색 (Async Pathfinder)
+// -> 메인 UI 멈춤 방지 및 파일 존재 여부 확인 후 보고
+// -> 🔥 [추가] 로딩 중 탐색기가 닫히면 즉시 감지하여 메모장 강제 종료 (반응 속도 향상)
+// -> [PRD 3.1.2] 워커 풀에서 실행 (COM은 워커가 이미 초기화). 더 새 요청이 오면 즉시 중단.
+// -> [PRD 3.1.6] 적응형 재시도 간격/시한은 core/path_jobs.h (RunPathRetry). 새 요청/취소 시 즉시 중단.
+
+void PathFinderJob(HWND hOverlay, HWND hExplorer, unsigned long long generation) {
+    FM_TRACE_SCOPE(PathJob, hExplorer); // [PRD 7.1]
+    std::wstring foundPath = L"";
+    std::wstring title;
+
+    // [Retry Policy] 탐색기가 초기화될 때까지 적응형 간격으로 재시도 (RunPathRetry)
+    PathRetryResult retry = RunPathRetry(g_pathJobs, hExplorer, generation,
+        [](HWND hwnd) { return IsWindow(hwnd) != FALSE; },
+        [&title](HWND hwnd) { return GetExplorerPath(hwnd, &title); }, foundPath);
+    if (retry == PathRetryResult::Superseded) return; // 새 요청/취소 -> 결과 불필요
+    if (retry == PathRetryResult::ExplorerGone) {
+        // 🔥 [Fast-Fail] 탐색기 윈도우가 사라졌다면(닫힘), 즉시 숨기고 종료 절차 시작
+        if (IsWindow(hOverlay)) {
+            ShowWindow(hOverlay, SW_HIDE);
+            PostMessage(hOverlay, WM_CLOSE, 0, 0);
+        }
+        return;
+    }
+
+    // 결과 처리
+    if (IsWindow(hOverlay) && g_pathJobs.IsLatest(hExplorer, generation)) {
+        bool exists = false;
+        if (!foundPath.empty()) {
+            FM_TRACE_SCOPE(MemoExists, hExplorer); // [PRD 7.1]
+            exists = g_storage->Exists(foundPath); // [PRD 5.7] 중앙 저장소면 메모리 색인 조회 (디스크 접근 없음)
+        }
+
+        // [PRD 4.2] 초기 상태 결정 및 레지스트리 갱신은 WindowProc에서만 수행 (Thread-Safety)
+        // [PRD 4.3] 공유 OverlayPair를 직접 수정하지 않고 Lock-Free 큐로 결과 전달 후 신호만 보냄
+        PathResult r = { hOverlay, foundPath, exists, generation };
+        r.title = std::move(title);
+        g_pathResults.Push(std::move(r));
+        PostMessage(hOverlay, WM_UPDATE_UI_FromThread, 0, 0);
+    }
+}
+
+// --- [시작 시 일괄 부착] ---
+// [PRD 3.2.3] 일괄 해석 + 병렬 미리 읽기(RunStartupAttach)는 core/startup_attach.h
+// -> 여기서는 결과를 한꺼번에 큐에 넣고 신호 -> UI는 한 번의 Drain으로 모든 오버레이를 표시.
+// -> 큰 메모(PAGED_LOAD_THRESHOLD 이상)는 미리 읽지 않음 -> UI에서 기존 분할 로딩 경로로.
+struct PreloadedMemo {
+    std::wstring memo;
+    std::string bytes; // [PRD 5.8] 병합 기준 원본
+    MemoStat stamp;    // 읽기 전 스탬프
+};
+
+typedef BasicStartupWindow<HWND> StartupWindow;
+
+std::chrono::steady_clock::time_point g_processStart; // WinMain 진입 시각
+std::thread g_startupThread;
+size_t g_startupPending = 0; // UI 스레드 전용 -> 아직 적용 안 된 일괄 부착 결과 수
+
+void StartupAttachJob(std::vector<StartupWindow> windows) {
+    CoInitializeEx(NULL, COINIT_MULTITHREADED);
+    FM_TRACE_THREAD("startup-attach"); // [PRD 7.1]
+    std::vector<PathResult> results(windows.size());
+    std::vector<std::wstring> paths;
+    StartupAttachStats stats = RunStartupAttach(g_pathResolver, windows, paths, [&](size_t i, const std::wstring& path) {
+        PathResult& r = results[i];
+        r.hOverlay = windows[i].hOverlay;
+        r.path = path;
+        r.exists = false;
+        r.generation = windows[i].generation;
+        r.startup = true;
+        r.title = windows[i].title;
+        if (r.path.empty() || !IsWindow(r.hOverlay)) return false;
+        r.exists = g_storage->Exists(r.path);
+        if (!r.exists) return false;
+        auto pre = std::make_shared<PreloadedMemo>();
+        if (MemoDiskStamp(r.path, pre->stamp) && pre->stamp.size >= PAGED_LOAD_THRESHOLD) return false;
+        pre->memo = LoadMemo(r.path, &pre->bytes);
+        r.preload = std::move(pre);
+        return true;
+    });
+
+    // 모두 준비된 뒤 한꺼번에 전달 -> 오버레이가 하나씩 늦게 나타나지 않음
+    for (auto& r : results) g_pathResults.Push(std::move(r));
+    for (const auto& w : windows) {
+        if (IsWindow(w.hOverlay)) { PostMessage(w.hOverlay, WM_UPDATE_UI_FromThread, 0, 0); break; }
+    }
+
+    wchar_t msg[200];
+    swprintf(msg, 200, L"[FolderMemo] startup attach: windows=%zu resolve=%lldms preload=%lldms (preloaded=%zu)\n",
+        windows.size(), (long long)stats.resolveMs, (long long)stats.preloadMs, stats.preloaded);
+    OutputDebugStringW(msg);
+    CoUninitialize();
+}
+
+// [PRD 3.2.3] 일괄 부착 결과 하나 적용됨 (UI 스레드) -> 마지막이면 시작부터 전체 표시까지 걸린 시간 기록
+void NoteStartupResultApplied() {
+    if (g_startupPending == 0 || --g_startupPending > 0) return;
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - g_processStart).count();
+    wchar_t msg[120];
+    swprintf(msg, 120, L"[FolderMemo] startup attach: all overlays ready %lldms after start\n", (long long)ms);
+    OutputDebugStringW(msg);
+}
+
+// [PRD 5.8] 오버레이가 보는 폴더 등록/해제 (UI 스레드) -> 감시 고정 + 병합 기준 공유
+void ViewMemoFolder(const std::wstring& folderPath, HWND hOverlay) {
+    if (folderPath.empty()) return;
+    g_memoSync.AddViewer(folderPath, hOverlay);
+    g_dirWatcher.Pin(folderPath);
+    if (!g_dirWatcher.IsWatching(folderPath)) g_liveReload.Notify(folderPath); // 감시 없는 폴더 -> 주기 확인 시작
+}
+
+void UnviewMemoFolder(const std::wstring& folderPath, HWND hOverlay) {
+    if (folderPath.empty()) return;
+    g_memoSync.RemoveViewer(folderPath, hOverlay, g_saveQueue.HasPending(folderPath));
+    g_dirWatcher.Unpin(folderPath);
+}
+
+// [PRD 5.8] 디스크 변경 반영 (UI 스레드)
+// -> 화면 내용이 base 그대로면 디스크 내용으로 교체, 편집 중이면 3-way 병합. 병합 결과가 디스크와 다르면 저장 요청.
+// -> 충돌이면 표식이 든 내용을 보여 주되 저장하지 않음 (대기 중 저장도 폐기, 내 편집본은 사본으로 보관) -> 사용자가 고치면 그때 저장.
+void ApplyMemoReload(const MemoReload& r) {
+    g_memoCache.Invalidate(r.folderPath); // [PRD 3.4] 디스크가 바뀜 -> 다음 방문은 새로 읽음
+    MemoBase base;
+    if (!g_memoSync.GetBase(r.folderPath, base) || base.Matches(r.disk)) return;
+    bool applied = false;
+    g_overlays.ForEach([&](OverlayPair& pair) {
+        if (pair.currentPath != r.folderPath || pair.pagedLoad) return;
+        HWND hEdit = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT);
+        if (!hEdit) return;
+        int len = GetWindowTextLengthW(hEdit);
+        std::wstring cur(len > 0 ? len : 0, L'\0');
+        if (len > 0) GetWindowTextW(hEdit, &cur[0], len + 1);
+        std::string ours = WideToUtf8(cur), shown;
+        bool clean = MergeWithBase(base, ours, r.disk, shown);
+
+        if (shown != ours) {
+            std::wstring text = Utf8ToWide(shown);
+            DWORD selStart = 0, selEnd = 0;
+            SendMessage(hEdit, EM_GETSEL, (WPARAM)&selStart, (LPARAM)&selEnd);
+            int firstLine = (int)SendMessage(hEdit, EM_GETFIRSTVISIBLELINE, 0, 0);
+            pair.settingText = true;
+            SetWindowTextW(hEdit, text.c_str());
+            pair.settingText = false;
+            SendMessage(hEdit, EM_SETSEL, selStart, selEnd); // 길이를 넘으면 컨트롤이 끝으로 맞춤
+            SendMessage(hEdit, EM_LINESCROLL, 0, firstLine);
+            pair.buffer = MakeMemoBuffer(shown, text); // [PRD 5.11] 통째로 바뀐 내용 -> 새 버퍼
+        } else if (!pair.buffer) {
+            pair.buffer = MakeMemoBuffer(ours, cur);
+        }
+        if (!clean) {
+            g_saveQueue.Discard(r.folderPath);
+            WriteConflictCopy(r.folderPath, ours);
+        } else if (shown != r.disk) {
+            g_saveQueue.Submit(r.folderPath, pair.buffer); // 내 편집이 섞인 병합본 -> 새 기준 위에서 저장
+        }
+        if (pair.conflict != !clean) { pair.conflict = !clean; InvalidateOverlayChrome(pair.hOverlay, pair.isMinimized); } // [PRD 4.6] 테두리만
+        applied = true;
+    });
+    if (applied) g_memoSync.SetBase(r.folderPath, r.disk, r.stamp);
+}
+
+// [PRD 3.1.6] 창 제목 -> 마지막 경로 LRU(TitlePathHints)는 core/title_hints.h
+TitlePathHints g_titleHints;
+unsigned long long g_speculativeShown = 0;     // [PRD 3.1.6] 추측 표시 횟수
+unsigned long long g_speculativeConfirmed = 0; // 실제 결과와 일치
+unsigned long long g_speculativeReplaced = 0;  // 실제 결과가 달라 교체
+
+// --- [폴더별 보기 상태] ---
+// [PRD 4.7] 표 본체(ViewStateTable, seqlock + CRC 레코드)는 core/view_state.h. 여기는 파일/매핑만
+
+// 보기 상태 파일 (읽기/쓰기 매핑)
+class ViewStateStore {
+public:
+    ~ViewStateStore() { Close(); }
+
+    bool Open(const fs::path& p) {
+        Close();
+        size_t bytes = ViewStateTable::BytesFor(VIEW_STATE_SLOTS);
+        m_file = CreateFileW(p.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (m_file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart != (LONGLONG)bytes) {
+            // 크기가 다르면 (새 파일/슬롯 수 변경) 맞춘 뒤 헤더 검사에서 초기화
+            LARGE_INTEGER li; li.QuadPart = (LONGLONG)bytes;
+            if (!SetFilePointerEx(m_file, li, NULL, FILE_BEGIN) || !SetEndOfFile(m_file)) { Close(); return false; }
+        }
+        m_mapping = CreateFileMappingW(m_file, NULL, PAGE_READWRITE, 0, (DWORD)bytes, NULL);
+        if (!m_mapping) { Close(); return false; }
+        m_view = MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, bytes);
+        if (!m_view || !m_table.Attach(m_view, bytes, VIEW_STATE_SLOTS)) { Close(); return false; }
+        return true;
+    }
+
+    // 종료 시 매핑 내용을 디스크로 (평소에는 OS가 알아서)
+    void Close() {
+        m_table.Detach();
+        if (m_view) { FlushViewOfFile(m_view, 0); UnmapViewOfFile(m_view); }
+        if (m_mapping) CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+        m_view = NULL; m_mapping = NULL; m_file = INVALID_HANDLE_VALUE;
+    }
+
+    bool Find(const std::wstring& folderPath, FolderViewState& out) const {
+        return m_table.Find(ViewStateTable::KeyOf(CentralLogStorage::NormalizeKey(folderPath)), out);
+    }
+
+    void Store(const std::wstring& folderPath, const FolderViewState& st) {
+        auto minutes = std::chrono::duration_cast<std::chrono::minutes>(std::chrono::system_clock::now().time_since_epoch()).count();
+        m_table.Store(ViewStateTable::KeyOf(CentralLogStorage::NormalizeKey(folderPath)), st, (uint32_t)minutes);
+    }
+
+private:
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = NULL;
+    void* m_view = NULL;
+    ViewStateTable m_table;
+};
+
+ViewStateStore g_viewStates; // 기록은 UI 스레드 전용
+
+// [PRD 4.7] 떠나는/바뀐 오버레이의 보기 상태 기록 (메모가 있는 확정된 폴더만)
+void SaveOverlayViewState(const OverlayPair& pair) {
+    if (pair.currentPath.empty() || pair.speculative || !pair.fileExists) return;
+    FolderViewState st;
+    g_viewStates.Find(pair.currentPath, st); // 편집창이 없으면(최소화) 이전 스크롤 위치 유지
+    st.fontSize = pair.currentFontSize;
+    st.minimized = pair.isMinimized;
+    st.expanded = pair.isExpanded;
+    HWND hEdit = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT);
+    if (hEdit && !pair.pagedLoad) {
+        DWORD selStart = 0, selEnd = 0;
+        SendMessage(hEdit, EM_GETSEL, (WPARAM)&selStart, (LPARAM)&selEnd);
+        st.firstLine = (uint32_t)SendMessage(hEdit, EM_GETFIRSTVISIBLELINE, 0, 0);
+        st.caret = selEnd;
     }
-    return finalPath;
+    g_viewStates.Store(pair.currentPath, st);
 }
 
-// --- [파일 입출력] ---
-std::wstring LoadMemo(const std::wstring& folderPath) {
-    if (folderPath.empty()) return L"";
-    fs::path p(folderPath); p /= L"folder_memo.txt";
-    if (!fs::exists(p)) return L"";
-
-    HANDLE hFile = CreateFileW(p.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-    if (hFile == INVALID_HANDLE_VALUE) return L"";
-    DWORD fileSize = GetFileSize(hFile, NULL);
-    if (fileSize == 0) { CloseHandle(hFile); return L""; }
-
-    std::vector<char> buffer(fileSize + 1);
-    DWORD bytesRead;
-    ReadFile(hFile, buffer.data(), fileSize, &bytesRead, NULL);
-    buffer[bytesRead] = '\0';
-    CloseHandle(hFile);
-    int wlen = MultiByteToWideChar(CP_UTF8, 0, buffer.data(), -1, NULL, 0);
-    if (wlen == 0) return L"";
-    std::vector<wchar_t> wbuf(wlen);
-    MultiByteToWideChar(CP_UTF8, 0, buffer.data(), -1, wbuf.data(), wlen);
-    return std::wstring(wbuf.data());
-}
-
-void SaveMemo(const std::wstring& folderPath, const std::wstring& content) {
-    if (folderPath.empty()) return;
-    fs::path p(folderPath); p /= L"folder_memo.txt";
-    HANDLE hFile = CreateFileW(p.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
-    if (hFile == INVALID_HANDLE_VALUE) return;
-    int len = WideCharToMultiByte(CP_UTF8, 0, content.c_str(), -1, NULL, 0, NULL, NULL);
-    if (len > 0) {
-        std::vector<char> buf(len);
-        WideCharToMultiByte(CP_UTF8, 0, content.c_str(), -1, buf.data(), len, NULL, NULL);
-        DWORD bytesWritten;
-        WriteFile(hFile, buf.data(), len - 1, &bytesWritten, NULL);
-        FlushFileBuffers(hFile);
-    }
-    CloseHandle(hFile);
+// [PRD 4.7] 내용을 채운 편집창에 캐럿/스크롤 복원 (대용량 로딩 중이면 뒤쪽 줄이 아직 없으므로 생략)
+void RestoreEditorView(const OverlayPair& pair, const FolderViewState& view) {
+    HWND hEdit = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT);
+    if (!hEdit || pair.pagedLoad) return;
+    SendMessage(hEdit, EM_SETSEL, view.caret, view.caret); // 길이를 넘으면 컨트롤이 끝으로 맞춤
+    int first = (int)SendMessage(hEdit, EM_GETFIRSTVISIBLELINE, 0, 0);
+    SendMessage(hEdit, EM_LINESCROLL, 0, (int)view.firstLine - first);
 }
 
-void CreateEmptyMemo(const std::wstring& folderPath) {
-    if (folderPath.empty()) return;
-    fs::path p(folderPath); p /= L"folder_memo.txt";
-    std::ofstream ofs(p); ofs.close();
+// [PRD 4.5] 편집창 반납 (없으면 아무것도 안 함)
+void DetachOverlayEditor(OverlayPair& pair) {
+    HWND hEdit = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT);
+    if (!hEdit) return;
+    pair.settingText = true; // 비우기의 EN_CHANGE가 빈 메모로 저장되지 않게
+    g_editorPool.Release(pair.hOverlay, hEdit);
+    pair.settingText = false;
 }
 
-// --- [핵심 함수 2] 위치 동기화 ---
-void SyncOverlayPosition(const OverlayPair& pair) {
-    if (!IsWindow(pair.hExplorer)) return;
-    RECT rcExp;
-    HRESULT res = DwmGetWindowAttribute(pair.hExplorer, DWMWA_EXTENDED_FRAME_BOUNDS, &rcExp, sizeof(rcExp));
-    if (res != S_OK) GetWindowRect(pair.hExplorer, &rcExp);
+// [PRD 5.11] 편집창 내용을 복사 없이 읽기 (여러 줄 편집창의 내부 버퍼, 다음 편집 전까지만 유효)
+// -> 핸들을 못 주는 경우만 재사용 버퍼로 복사
+class EditorTextView {
+public:
+    explicit EditorTextView(HWND hEdit) {
+        int len = GetWindowTextLengthW(hEdit);
+        m_len = len > 0 ? (size_t)len : 0;
+        m_mem = (HLOCAL)SendMessage(hEdit, EM_GETHANDLE, 0, 0);
+        if (m_mem) m_text = (const wchar_t*)LocalLock(m_mem);
+        if (!m_text) {
+            m_mem = NULL;
+            static std::wstring fallback; // UI 스레드 전용
+            fallback.resize(m_len + 1);
+            GetWindowTextW(hEdit, &fallback[0], (int)m_len + 1);
+            m_text = fallback.c_str();
+        }
+    }
+    ~EditorTextView() { if (m_mem) LocalUnlock(m_mem); }
+    EditorTextView(const EditorTextView&) = delete;
+    EditorTextView& operator=(const EditorTextView&) = delete;
 
-    bool smallMode = pair.isMinimized;
-    int targetW = smallMode ? MINIMIZED_SIZE : (pair.isExpanded ? EXPANDED_WIDTH : OVERLAY_WIDTH);
-    int targetH = smallMode ? MINIMIZED_SIZE : (pair.isExpanded ? EXPANDED_HEIGHT : OVERLAY_HEIGHT);
+    const wchar_t* Data() const { return m_text; }
+    size_t Length() const { return m_len; }
 
-    // 탐색기 우측 하단 기준 좌표 계산
-    int x = rcExp.right - targetW - 25;
-    int y = rcExp.bottom - targetH - 25;
+private:
+    HLOCAL m_mem = NULL;
+    const wchar_t* m_text = nullptr;
+    size_t m_len = 0;
+};
 
-    SetWindowPos(pair.hOverlay, NULL, x, y, targetW, targetH, SWP_NOACTIVATE | SWP_NOZORDER | SWP_SHOWWINDOW);
-    HWND hEdit = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT);
-    if (hEdit) ShowWindow(hEdit, smallMode ? SW_HIDE : SW_SHOW);
+unsigned long long g_bufferResyncs = 0; // [PRD 5.11] 바뀐 구간을 못 찾아 편집창 전체로 다시 채운 횟수
+unsigned long long g_bufferMismatches = 0; // [PRD 5.11] 주기 대조에서 어긋남 (0이어야 정상)
+
+// [PRD 5.11] EN_CHANGE -> 편집창의 새 내용을 버퍼에 구간 치환으로 반영 (UI 스레드)
+void SyncMemoBuffer(OverlayPair& pair, HWND hEdit, const EditorTextView& view) {
+    if (!pair.buffer) {
+        pair.buffer = std::make_shared<MemoBuffer>();
+        pair.buffer->LoadText(view.Data(), view.Length());
+        return;
+    }
+    DWORD selStart = 0, selEnd = 0;
+    SendMessage(hEdit, EM_GETSEL, (WPARAM)&selStart, (LPARAM)&selEnd);
+    if (!pair.buffer->ApplyChange(view.Data(), view.Length(), selEnd)) {
+        g_bufferResyncs++;
+        pair.buffer->LoadText(view.Data(), view.Length());
+    } else if (pair.buffer->DueForVerify() && !pair.buffer->Equals(view.Data(), view.Length())) {
+        g_bufferMismatches++;
+        OutputDebugStringW(L"[FolderMemo] memo buffer out of sync with editor, reloaded\n");
+        pair.buffer->LoadText(view.Data(), view.Length());
+    }
 }
 
-// [PRD 3.1.1] 비동기 경로 탐색 (Async Pathfinder)
-// -> 메인 UI 멈춤 방지 및 파일 존재 여부 확인 후 보고
-// -> 🔥 [추가] 로딩 중 탐색기가 닫히면 즉시 감지하여 메모장 강제 종료 (반응 속도 향상)
-void PathFinderThread(HWND hOverlay, HWND hExplorer) {
-    CoInitializeEx(NULL, COINIT_MULTITHREADED);
+// 현재 폴더 메모로 편집창 채우기 (편집창이 없으면 아무것도 안 함)
+// [PRD 5.5] 불러온 내용을 채우는 것은 편집이 아니므로 저장하지 않음 (폴더 이동마다 전체 재기록 방지)
+void FillOverlayEditor(OverlayPair& pair, PreloadedMemo* preload) {
+    HWND hEdit = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT);
+    if (!hEdit) return;
+    const std::wstring& currentPath = pair.currentPath;
+    pair.settingText = true;
+    // [PRD 5.11] 폴더마다 새 버퍼 (떠나는 폴더의 대기 중 저장은 옛 버퍼를 그대로 씀). 대용량 로딩은 첫 편집 때 편집창에서 만듦
+    pair.buffer.reset();
+    if (pair.fileExists && !currentPath.empty()) {
+        std::wstring memo;
+        if (auto pending = g_saveQueue.TryGetPending(currentPath)) {
+            // 아직 기록 안 된 내용 -> 사본으로 새 버퍼 (같은 버퍼를 두 오버레이가 함께 고치지 않게)
+            std::shared_ptr<const std::string> bytes = pending->Snapshot();
+            Utf8ToWide(bytes->data(), bytes->size(), memo);
+            pair.buffer = MakeMemoBuffer(*bytes, memo);
+            SetWindowTextW(hEdit, memo.c_str());
+        } else if (preload) {
+            // [PRD 3.2.3] 시작 시 워커가 미리 읽어 둔 내용 -> UI 스레드 디스크 접근 없음
+            pair.buffer = MakeMemoBuffer(preload->bytes, preload->memo);
+            g_memoSync.SetBase(currentPath, std::move(preload->bytes), preload->stamp);
+            SetWindowTextW(hEdit, preload->memo.c_str());
+        } else if (auto cached = FindCachedMemo(currentPath)) {
+            // [PRD 3.4] 최근 본 폴더 -> 읽기/디코드 없이 (스탬프가 같으니 병합 기준 스탬프로도 그대로 씀)
+            g_memoSync.SetBase(currentPath, *cached->bytes, cached->stamp);
+            pair.buffer = MakeMemoBuffer(*cached->bytes, cached->Text());
+            SetWindowTextW(hEdit, cached->Text().c_str());
+        } else if (!BeginPagedLoad(pair)) {
+            // [PRD 5.8] 읽기 전 스탬프 + 읽은 원본을 병합 기준으로 등록
+            MemoStat stamp, cacheStamp;
+            MemoDiskStamp(currentPath, stamp);
+            bool cacheable = MemoCacheStamp(currentPath, cacheStamp); // [PRD 3.4] 읽기 전에 -> 그 사이 바뀌면 다음 조회에서 버려짐
+            std::string bytes;
+            bool found = false;
+            memo = LoadMemo(currentPath, &bytes, &found);
+            if (cacheable && found) g_memoCache.Store(currentPath, std::make_shared<std::string>(bytes), cacheStamp, &memo);
+            pair.buffer = MakeMemoBuffer(bytes, memo);
+            g_memoSync.SetBase(currentPath, std::move(bytes), stamp);
+            SetWindowTextW(hEdit, memo.c_str());
+        }
+    } else {
+        SetWindowTextW(hEdit, L"");
+        pair.buffer = std::make_shared<MemoBuffer>();
+    }
+    pair.settingText = false;
+    // [PRD 3.1.6] 추측 표시는 편집 불가. [PRD 5.10] 끊긴 볼륨도 (읽지 못한 빈 내용이 돌아온 뒤 원본을 덮지 않게)
+    SendMessage(hEdit, EM_SETREADONLY, pair.speculative || pair.pagedLoad || !g_guardedStorage.Reachable(currentPath), 0);
+}
 
-    std::wstring foundPath = L"";
-    
-    // [Retry Policy] 탐색기가 초기화될 때까지 최대 5번(1.5초) 시도
-    for (int i = 0; i < 5; i++) {
-        // 🔥 [Fast-Fail] 탐색기 윈도우가 사라졌다면(닫힘), 더 기다리지 않고 즉시 종료
-        if (!IsWindow(hExplorer)) {
-            if (IsWindow(hOverlay)) {
-                // 즉시 숨기고 종료 절차 시작
-                ShowWindow(hOverlay, SW_HIDE); 
-                PostMessage(hOverlay, WM_CLOSE, 0, 0);
-            }
-            CoUninitialize();
-            return; 
+// [PRD 4.2] 스레드 탐색 결과 적용 및 초기 상태 결정 (UI 스레드)
+void ApplyPathResult(const PathResult& r) {
+    OverlayPair* pair = g_overlays.FindByOverlay(r.hOverlay);
+    if (!pair) return; // 결과 도착 전 이미 닫힌 오버레이
+    if (r.generation != pair->pathGeneration) return; // [PRD 3.1.2] 더 새 탐색이 진행 중 -> 늦게 끝난 옛 결과 폐기
+    HWND hwnd = r.hOverlay;
+    if (r.startup && r.path.empty()) {
+        // [PRD 3.2.3] 일괄 해석에서 못 찾음 (아직 초기화 중인 창 등) -> 재시도가 있는 일반 탐색으로
+        pair->pathGeneration = g_pathJobs.Submit(hwnd, pair->hExplorer);
+        return;
+    }
+    if (!r.speculative) g_titleHints.Remember(r.title, r.path); // [PRD 3.1.6]
+    if (!r.speculative && pair->speculative) {
+        if (r.path == pair->currentPath && r.exists == pair->fileExists) {
+            // [PRD 3.1.6] 추측이 맞음 -> 이미 보이는 내용 그대로 확정 (다시 읽지 않음)
+            g_speculativeConfirmed++;
+            pair->speculative = false;
+            SendMessage(GetDlgItem(hwnd, IDC_MEMO_EDIT), EM_SETREADONLY, pair->pagedLoad != nullptr, 0);
+            return;
         }
+        g_speculativeReplaced++;
+    }
+    SaveOverlayViewState(*pair); // [PRD 4.7] 떠나는 폴더의 보기 상태
+    pair->speculative = r.speculative;
+    RECT rcClient; GetClientRect(hwnd, &rcClient);
+    ChromeKey oldChrome = OverlayChromeKey(*pair, rcClient); // [PRD 4.6] 외곽이 바뀔 때만 다시 그림
 
-        foundPath = GetExplorerPath(hExplorer);
-        
-        if (!foundPath.empty()) break; 
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    UnviewMemoFolder(pair->currentPath, hwnd); // [PRD 5.8] 이전 폴더 감시 고정/병합 기준 해제
+    pair->currentPath = r.path;
+    pair->fileExists = r.exists;
+    pair->conflict = false;
+    ViewMemoFolder(pair->currentPath, hwnd);
+    // [PRD 4.2.2] 파일이 없으면 초기 상태를 '최소화(+)'로 설정
+    pair->isMinimized = !r.exists;
+    // [PRD 4.7] 이 폴더에서 마지막으로 본 상태 -> 매핑된 색인에서 바로 (폴더 쪽 파일 접근 없음). 기록이 없으면 지금 상태 유지.
+    FolderViewState view;
+    bool hasView = r.exists && g_viewStates.Find(pair->currentPath, view);
+    if (hasView) {
+        pair->isMinimized = view.minimized;
+        pair->isExpanded = view.expanded;
+        pair->currentFontSize = view.fontSize;
     }
+    // [PRD 4.5] 펼칠 때만 편집창 부착, 최소화면 풀에 반납 (이전 폴더 내용은 이미 저장 큐에 있음)
+    CancelPagedLoad(*pair);
+    if (pair->isMinimized) DetachOverlayEditor(*pair);
+    else UpdateMemoFont(AttachOverlayEditor(*pair), pair->currentFontSize); // 이미 붙어 있던 편집창도 폴더 글꼴로
+    // [PRD 4.2.3] 이제 화면에 보여줄 준비가 되었으니 위치를 잡고 표시
+    SyncOverlayPosition(*pair);
+    // [PRD 4.6] 경로만 바뀌면 외곽은 그대로 (편집창은 스스로 다시 그림). 처음 표시될 때는 OS가 전체를 무효화.
+    ChromeKey newChrome = OverlayChromeKey(*pair, rcClient);
+    if (newChrome.state != oldChrome.state) InvalidateOverlayChrome(hwnd, true);
+    else if (newChrome.conflict != oldChrome.conflict) InvalidateOverlayChrome(hwnd, pair->isMinimized);
+    else if (pair->traceEventNs) InvalidateOverlayChrome(hwnd, false); // [PRD 7.1] 전체 지연을 기록할 그리기 시점 확보
 
-    // 결과 처리
-    if (IsWindow(hOverlay)) {
-        bool exists = false;
-        if (!foundPath.empty()) {
-            fs::path p(foundPath); p /= L"folder_memo.txt";
-            exists = fs::exists(p);
-        }
+    FillOverlayEditor(*pair, r.preload.get());
+    if (hasView) RestoreEditorView(*pair, view); // [PRD 4.7]
+    pair->tracePaintArmed = pair->traceEventNs != 0; // [PRD 7.1] 다음 WM_PAINT에서 전체 지연 기록
+}
 
-        {
-            std::lock_guard<std::mutex> lock(g_overlayMutex);
-            for (auto& pair : g_overlays) {
-                if (pair.hOverlay == hOverlay) {
-                    pair.currentPath = foundPath;
-                    pair.fileExists = exists;
-                    // [PRD 4.2] 초기 상태 결정 로직을 여기서 제거하고 WindowProc으로 이관함 (Thread-Safety)
-                    break;
-                }
-            }
-        }
-        // 메인 스레드에 "탐색 완료(파일 존재 여부)" 신호 전송
-        PostMessage(hOverlay, WM_UPDATE_UI_FromThread, (WPARAM)exists, 0);
+// [PRD 4.5] 사용자가 최소화된 오버레이를 펼침 -> 편집창 부착 후 내용 다시 채움
+void ExpandOverlay(OverlayPair& pair) {
+    pair.isMinimized = false;
+    bool attached = GetDlgItem(pair.hOverlay, IDC_MEMO_EDIT) == NULL;
+    AttachOverlayEditor(pair);
+    SyncOverlayPosition(pair);
+    InvalidateOverlayChrome(pair.hOverlay, true); // [PRD 4.6]
+    if (attached) {
+        FillOverlayEditor(pair, nullptr);
+        FolderViewState view;
+        if (g_viewStates.Find(pair.currentPath, view)) RestoreEditorView(pair, view); // [PRD 4.7] 최소화 전 위치로
     }
-    CoUninitialize();
+    SaveOverlayViewState(pair); // [PRD 4.7]
+}
+
+// [PRD 4.5] 사용자가 오버레이를 최소화 -> 편집창 반납
+// -> 병합 충돌을 보여 주는 중이면 유지 (표식이 든 내용은 저장되지 않으므로 반납하면 사라짐)
+void MinimizeOverlay(OverlayPair& pair) {
+    pair.isMinimized = true;
+    SaveOverlayViewState(pair); // [PRD 4.7] 편집창을 반납하기 전에 스크롤 위치까지
+    if (!pair.conflict) {
+        CancelPagedLoad(pair);
+        DetachOverlayEditor(pair);
+    }
+    SyncOverlayPosition(pair);
+    InvalidateOverlayChrome(pair.hOverlay, true); // [PRD 4.6]
+}
+
+// [PRD 3.1.6] 제목으로 최근 경로를 추측해 즉시 표시 (UI 스레드, 실제 해석 요청 직후 호출)
+// -> 같은 세대로 적용 -> 실제 결과가 오면 ApplyPathResult에서 확정 또는 교체.
+// -> 존재 확인은 메모 존재 캐시가 대부분 적중 (최근 본 폴더라 감시 중).
+void ShowSpeculativePath(OverlayPair& pair) {
+    wchar_t title[MAX_PATH] = { 0 };
+    GetWindowTextW(pair.hExplorer, title, MAX_PATH);
+    std::wstring path = g_titleHints.Find(title);
+    if (path.empty() || path == pair.currentPath) return;
+    PathResult r = { pair.hOverlay, path, g_storage->Exists(path), pair.pathGeneration };
+    r.speculative = true;
+    g_speculativeShown++;
+    ApplyPathResult(r);
 }
 
 // [PRD 4.0] & [PRD 5.0] 메인 윈도우 프로시저
@@ -254,58 +2075,37 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
     switch (uMsg) {
     
     // [PRD 4.2] 스레드 탐색 결과 수신 및 초기 상태 결정
+    // [PRD 4.3] 큐에 쌓인 결과를 한 번에 적용 (다른 오버레이 몫이 먼저 도착해도 여기서 함께 처리)
     case WM_UPDATE_UI_FromThread: {
-        bool exists = (bool)wParam;
-        std::wstring currentPath = L"";
-        int currentFontSize = DEFAULT_FONT_SIZE;
-        
-        {
-            std::lock_guard<std::mutex> lock(g_overlayMutex);
-            for (auto& pair : g_overlays) {
-                if (pair.hOverlay == hwnd) {
-                    currentPath = pair.currentPath;
-                    pair.fileExists = exists;
-                    
-                    // [PRD 4.2.2] 파일이 없으면 초기 상태를 '최소화(+)'로 설정
-                    pair.isMinimized = !exists; 
-
-                    currentFontSize = pair.currentFontSize; 
-                    // [PRD 4.2.3] 이제 화면에 보여줄 준비가 되었으니 위치를 잡고 표시
-                    SyncOverlayPosition(pair);
-                    break;
-                }
-            }
-        }
-        
-        InvalidateRect(hwnd, NULL, TRUE);
-
-        if (exists && !currentPath.empty()) {
-            std::wstring memo = LoadMemo(currentPath);
-            SetDlgItemTextW(hwnd, IDC_MEMO_EDIT, memo.c_str());
-        } else {
-            SetDlgItemTextW(hwnd, IDC_MEMO_EDIT, L"");
-        }
-        
-        UpdateMemoFont(GetDlgItem(hwnd, IDC_MEMO_EDIT), currentFontSize);
+        FM_TRACE_SCOPE(ApplyResult, hwnd); // [PRD 7.1]
+        g_pathResults.DrainTo([](PathResult& r) {
+            ApplyPathResult(r);
+            if (r.startup) NoteStartupResultApplied(); // [PRD 3.2.3]
+        });
         return 0;
     }
 
+    // [PRD 5.5] 대용량 메모의 다음 청크 도착
+    case WM_MEMO_CHUNK:
+        AppendMemoChunk(hwnd, (MemoChunk*)lParam);
+        return 0;
+
+    // [PRD 5.8] 디스크 변경 반영 (다른 오버레이 몫도 함께 처리)
+    case WM_MEMO_RELOAD:
+        g_memoReloads.DrainTo([](MemoReload& r) { ApplyMemoReload(r); });
+        return 0;
+
     case WM_MOUSEWHEEL: {
         if (LOWORD(wParam) & MK_CONTROL) {
             int delta = GET_WHEEL_DELTA_WPARAM(wParam);
             int change = (delta > 0) ? 2 : -2; 
             int newSize = DEFAULT_FONT_SIZE;
-            {
-                std::lock_guard<std::mutex> lock(g_overlayMutex);
-                for (auto& pair : g_overlays) {
-                    if (pair.hOverlay == hwnd) {
-                        pair.currentFontSize += change;
-                        if (pair.currentFontSize < 8) pair.currentFontSize = 8;
-                        if (pair.currentFontSize > 72) pair.currentFontSize = 72;
-                        newSize = pair.currentFontSize;
-                        break;
-                    }
-                }
+            if (OverlayPair* pair = g_overlays.FindByOverlay(hwnd)) {
+                pair->currentFontSize += change;
+                if (pair->currentFontSize < 8) pair->currentFontSize = 8;
+                if (pair->currentFontSize > 72) pair->currentFontSize = 72;
+                newSize = pair->currentFontSize;
+                SaveOverlayViewState(*pair); // [PRD 4.7]
             }
             UpdateMemoFont(GetDlgItem(hwnd, IDC_MEMO_EDIT), newSize);
             return 0; 
@@ -316,151 +2116,84 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
     }
 
     case WM_COMMAND: {
-        if (LOWORD(wParam) == IDC_MEMO_EDIT && HIWORD(wParam) == EN_CHANGE) {
+        // [PRD 4.5] 이 오버레이에 붙어 있는 편집창의 알림만 (예비 편집창 비우기 등은 무시)
+        if (LOWORD(wParam) == IDC_MEMO_EDIT && HIWORD(wParam) == EN_CHANGE && (HWND)lParam == GetDlgItem(hwnd, IDC_MEMO_EDIT)) {
             std::wstring targetPath = L"";
-            {
-                std::lock_guard<std::mutex> lock(g_overlayMutex);
-                for (auto& pair : g_overlays) {
-                    if (pair.hOverlay == hwnd) { targetPath = pair.currentPath; break; }
-                }
+            OverlayPair* pair = g_overlays.FindByOverlay(hwnd);
+            if (pair) {
+                // [PRD 5.5] 프로그램이 채우는 중이거나 대용량 로딩이 끝나지 않았으면 저장하지 않음
+                if (pair->settingText || pair->pagedLoad) return 0;
+                targetPath = pair->currentPath;
             }
             
-            // [PRD 5.2 최적화] 입력 시 무조건 저장만 수행
+            // [PRD 3.1.3 최적화] 입력 시 무조건 저장만 수행
+            // [PRD 5.3] 디스크 기록은 Writer 스레드로 위임 -> UI 스레드는 버퍼만 넘기고 즉시 반환
+            // [PRD 5.11] 내용 복사 없이 바뀐 구간만 버퍼에 반영
             if (!targetPath.empty()) {
-                int len = GetWindowTextLengthW((HWND)lParam);
-                if (len >= 0) {
-                    std::vector<wchar_t> buf(len + 1);
-                    GetWindowTextW((HWND)lParam, buf.data(), len + 1);
-                    SaveMemo(targetPath, std::wstring(buf.data()));
+                EditorTextView view((HWND)lParam);
+                SyncMemoBuffer(*pair, (HWND)lParam, view);
+                // [PRD 5.8] 충돌 표식을 모두 정리했으면 강조 해제
+                if (pair->conflict && std::wstring_view(view.Data(), view.Length()).find(L"<<<<<<< ") == std::wstring_view::npos) {
+                    pair->conflict = false;
+                    InvalidateOverlayChrome(hwnd, false); // [PRD 4.6] 테두리만
                 }
+                g_saveQueue.Submit(targetPath, pair->buffer);
             }
         }
         return 0;
     }
 
-    case WM_CREATE: {
-        CreateWindowW(L"EDIT", NULL, WS_CHILD | WS_VISIBLE | ES_LEFT | ES_MULTILINE | ES_AUTOVSCROLL | WS_VSCROLL,
-            0, 0, 0, 0, hwnd, (HMENU)IDC_MEMO_EDIT, (HINSTANCE)GetWindowLongPtr(hwnd, GWLP_HINSTANCE), NULL);
-        UpdateMemoFont(GetDlgItem(hwnd, IDC_MEMO_EDIT), DEFAULT_FONT_SIZE);
+    // [PRD 4.5] 편집창은 여기서 만들지 않음 -> 펼칠 때 풀에서 부착 (AttachOverlayEditor)
+    case WM_CREATE:
+        g_paintKit.AddRef(); // [PRD 4.4]
         return 0;
-    }
 
-    case WM_SIZE: {
-        RECT rc; GetClientRect(hwnd, &rc);
-        HWND hEdit = GetDlgItem(hwnd, IDC_MEMO_EDIT);
-        if (rc.bottom > BTN_SIZE) {
-            MoveWindow(hEdit, 1, BTN_SIZE + 1, rc.right - 2, rc.bottom - BTN_SIZE - 2, TRUE);
-            SendMessage(hEdit, EM_SETMARGINS, EC_RIGHTMARGIN, MAKELPARAM(0, 0));
-        }
+    case WM_SIZE:
+        LayoutOverlayEditor(hwnd);
         return 0;
-    }
+
+    // [PRD 4.6] 외곽은 WM_PAINT에서 빈틈없이 덮으므로 배경 지우기 생략 (지웠다 그리는 깜빡임 제거)
+    case WM_ERASEBKGND:
+        return 1;
 
     case WM_PAINT: {
+        FM_TRACE_SCOPE(Paint, hwnd); // [PRD 7.1]
         PAINTSTRUCT ps; HDC hdc = BeginPaint(hwnd, &ps);
         RECT rcClient; GetClientRect(hwnd, &rcClient);
-        bool isMin = false, isExp = false, hasFile = false;
-        
-        {
-            std::lock_guard<std::mutex> lock(g_overlayMutex);
-            for (const auto& pair : g_overlays) {
-                if (pair.hOverlay == hwnd) { 
-                    isMin = pair.isMinimized; 
-                    isExp = pair.isExpanded; 
-                    hasFile = pair.fileExists; 
-                    break; 
-                }
-            }
-        }
-
-        HBRUSH hBgBrush = CreateSolidBrush(BG_COLOR);
-        FillRect(hdc, &rcClient, hBgBrush);
-        DeleteObject(hBgBrush);
-
-        if (isMin) {
-            HFONT hIconFont = CreateFontW(32, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, 
-                DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS, 
-                DEFAULT_QUALITY, DEFAULT_PITCH | FF_SWISS, L"Malgun Gothic");
-            
-            HFONT hOldFont = (HFONT)SelectObject(hdc, hIconFont);
-            SetBkMode(hdc, TRANSPARENT); 
-            SetTextColor(hdc, RGB(50, 50, 50)); 
-            
-            RECT rcIcon = rcClient;
-            DrawTextW(hdc, hasFile ? L"▤" : L"+", -1, &rcIcon, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
-            
-            SelectObject(hdc, hOldFont);
-            DeleteObject(hIconFont);
-
-            HBRUSH hBorderBrush = CreateSolidBrush(RGB(100, 100, 100)); 
-            FrameRect(hdc, &rcClient, hBorderBrush);
-            DeleteObject(hBorderBrush);
-
-        } else {
-            HPEN hPen = CreatePen(PS_SOLID, 1, RGB(0, 0, 0)); 
-            HPEN hOldPen = (HPEN)SelectObject(hdc, hPen);
-
-            int btnW = BTN_SIZE;
-            int right = rcClient.right;
-            
-            // X
-            MoveToEx(hdc, right - btnW + 8, 8, NULL); LineTo(hdc, right - 8, btnW - 8);
-            MoveToEx(hdc, right - 8, 8, NULL); LineTo(hdc, right - btnW + 8, btnW - 8);
-
-            // ㅁ
-            int expRight = right - btnW;
-            Rectangle(hdc, expRight - btnW + 8, 8, expRight - 8, btnW - 8);
-
-            // _
-            int minRight = expRight - btnW;
-            MoveToEx(hdc, minRight - btnW + 8, btnW - 8, NULL); LineTo(hdc, minRight - 8, btnW - 8);
-
-            SelectObject(hdc, hOldPen);
-            DeleteObject(hPen);
-
-            HBRUSH hBorderBrush = CreateSolidBrush(RGB(100, 100, 100)); 
-            FrameRect(hdc, &rcClient, hBorderBrush); 
-            
-            RECT rcLine = { 0, BTN_SIZE, rcClient.right, BTN_SIZE + 1 };
-            HBRUSH hLineBrush = CreateSolidBrush(RGB(200, 200, 200));
-            FillRect(hdc, &rcLine, hLineBrush);
-            
-            DeleteObject(hBorderBrush);
-            DeleteObject(hLineBrush);
-        }
+        OverlayPair* pair = g_overlays.FindByOverlay(hwnd);
+        ChromeKey key = { CHROME_MIN_EMPTY, false, (int)rcClient.right, (int)rcClient.bottom };
+        if (pair) key = OverlayChromeKey(*pair, rcClient);
+        // [PRD 4.4] 공유 페인트 도구로 한 번 그려 둔 외곽 복사 [PRD 4.6]
+        g_chromeCache.Paint(hdc, key, rcClient.right, rcClient.bottom);
         EndPaint(hwnd, &ps);
+        // [PRD 7.1] 결과 적용 후 첫 그리기 -> WinEvent 수신부터 화면 표시까지 전체 지연
+        if (pair && pair->tracePaintArmed) {
+            FM_TRACE_INSTANT(FirstPaint, hwnd);
+            FM_TRACE_SPAN(EventToOverlay, hwnd, pair->traceEventNs);
+            pair->tracePaintArmed = false;
+            pair->traceEventNs = 0;
+        }
         return 0;
     }
 
     case WM_LBUTTONDOWN: {
         int x = LOWORD(lParam); int y = HIWORD(lParam);
-        bool isMin = false;
-        
-        {
-            std::lock_guard<std::mutex> lock(g_overlayMutex);
-            for (const auto& pair : g_overlays) if (pair.hOverlay == hwnd) { isMin = pair.isMinimized; break; }
-        }
+        OverlayPair* pair = g_overlays.FindByOverlay(hwnd);
+        if (!pair) return 0;
 
-        if (isMin) {
-            {
-                std::lock_guard<std::mutex> lock(g_overlayMutex);
-                for (auto& pair : g_overlays) {
-                    if (pair.hOverlay == hwnd) { 
-                        // 🔥 [수정] 경로가 비어있으면(홈 등) 무시 (유령 메모장 방지)
-                        if (pair.currentPath.empty()) return 0;
-
-                        // [PRD 5.1] + 버튼 클릭 시 파일이 없으면 생성
-                        if (!pair.fileExists) {
-                            CreateEmptyMemo(pair.currentPath);
-                            pair.fileExists = true; 
-                        }
-                        
-                        pair.isMinimized = false; 
-                        SyncOverlayPosition(pair); 
-                        break; 
-                    }
-                }
+        if (pair->isMinimized) {
+            // 🔥 [수정] 경로가 비어있으면(홈 등) 무시 (유령 메모장 방지)
+            if (pair->currentPath.empty()) return 0;
+
+            // [PRD 3.1.4] + 버튼 클릭 시 파일이 없으면 생성
+            if (!pair->fileExists) {
+                if (pair->speculative) return 0; // [PRD 3.1.6] 추측한 폴더에 만들지 않음 (확정 후 다시 클릭)
+                // [PRD 5.10] 끊긴 볼륨 -> 펼치지 않음 (권한 등 다른 실패는 예전처럼 펼침)
+                if (!CreateEmptyMemo(pair->currentPath) && !g_guardedStorage.Reachable(pair->currentPath)) return 0;
+                pair->fileExists = true; 
             }
-            InvalidateRect(hwnd, NULL, TRUE);
+            
+            ExpandOverlay(*pair); // [PRD 4.5] 편집창 부착 + 내용 채우기
         } else {
             RECT rcClient; GetClientRect(hwnd, &rcClient);
             if (y < BTN_SIZE) { 
@@ -470,20 +2203,13 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     PostMessage(hwnd, WM_CLOSE, 0, 0); 
                 }
                 else if (x > rcClient.right - BTN_SIZE * 2) {
-                    {
-                        std::lock_guard<std::mutex> lock(g_overlayMutex);
-                        for (auto& pair : g_overlays) {
-                            if (pair.hOverlay == hwnd) { pair.isExpanded = !pair.isExpanded; SyncOverlayPosition(pair); break; }
-                        }
-                    }
-                    InvalidateRect(hwnd, NULL, TRUE);
+                    pair->isExpanded = !pair->isExpanded;
+                    SaveOverlayViewState(*pair); // [PRD 4.7]
+                    SyncOverlayPosition(*pair);
+                    InvalidateOverlayChrome(hwnd, false); // [PRD 4.6] 크기만 바뀜 -> 제목줄(버튼 위치) + 테두리
                 }
                 else if (x > rcClient.right - BTN_SIZE * 3) {
-                    {
-                        std::lock_guard<std::mutex> lock(g_overlayMutex);
-                        for (auto& pair : g_overlays) if (pair.hOverlay == hwnd) { pair.isMinimized = true; SyncOverlayPosition(pair); break; }
-                    }
-                    InvalidateRect(hwnd, NULL, TRUE);
+                    MinimizeOverlay(*pair); // [PRD 4.5] 편집창 반납
                 }
             }
         }
@@ -491,19 +2217,37 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
     }
     
     // 🔥 [추가] 닫기 메시지 처리: 즉시 숨기고 파괴
+    // -> 파괴는 WM_DESTROY에서 대기 중 저장을 기록(Flush)한 뒤 진행됨
     case WM_CLOSE:
         ShowWindow(hwnd, SW_HIDE);
         DestroyWindow(hwnd);
         return 0;
 
     // 🔥 [추가] 파괴 메시지 처리: 전역 벡터에서 안전하게 제거
+    // [PRD 5.3.1] 닫히는 오버레이의 대기 중 저장은 버리지 않고 즉시 기록
     case WM_DESTROY: {
-        std::lock_guard<std::mutex> lock(g_overlayMutex);
-        for (auto it = g_overlays.begin(); it != g_overlays.end(); ++it) {
-            if (it->hOverlay == hwnd) {
-                g_overlays.erase(it);
-                break;
-            }
+        std::wstring closingPath = L"";
+        if (OverlayPair* pair = g_overlays.FindByOverlay(hwnd)) {
+            SaveOverlayViewState(*pair); // [PRD 4.7] 닫히기 전 스크롤 위치 (편집창이 아직 살아 있음)
+            CancelPagedLoad(*pair); // [PRD 5.5] 로딩 워커 중단
+            closingPath = pair->currentPath;
+        }
+        g_overlays.RemoveByOverlay(hwnd);
+        g_positionScheduler.Forget(hwnd);
+
+        // [PRD 4.4] 이 오버레이가 잡고 있던 폰트/페인트 도구 참조 반납
+        g_editorPool.Forget(hwnd, GetDlgItem(hwnd, IDC_MEMO_EDIT)); // [PRD 4.5] 예비도 함께
+        g_paintKit.Release();
+        if (g_paintKit.users == 0) g_chromeCache.Clear(); // [PRD 4.6] 마지막 오버레이 -> 외곽 비트맵도 반납
+#if FM_TRACE
+        // [PRD 4.4] & [PRD 4.5] 닫을 때마다 보고는 추적 빌드만 (기본 빌드는 종료 요약만)
+        LogGdiStats(L"destroy");
+        LogOverlayResources(L"destroy");
+#endif
+        if (!closingPath.empty()) {
+            g_saveQueue.Flush(closingPath);
+            UnviewMemoFolder(closingPath, hwnd); // [PRD 5.8] 기록 보호가 끝난 뒤 해제
+            g_journal.RequestCompact(closingPath); // [PRD 5.4] 닫힐 때 저널 접기 (큰 메모는 저널 모드가 아니어도 저널로 저장됨, 없으면 압축 스레드가 건너뜀)
         }
         return 0;
     }
@@ -512,8 +2256,7 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
         HDC hdcEdit = (HDC)wParam; 
         SetBkColor(hdcEdit, BG_COLOR); 
         SetTextColor(hdcEdit, RGB(0, 0, 0));
-        static HBRUSH hEditBgBrush = CreateSolidBrush(BG_COLOR);
-        return (LRESULT)hEditBgBrush; 
+        return (LRESULT)g_paintKit.bg; // [PRD 4.4] 공유 브러시
     }
     }
     return DefWindowProc(hwnd, uMsg, wParam, lParam);
@@ -521,75 +2264,497 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 // [PRD 2.1.3] & [PRD 4.2.3] 윈도우 이벤트 훅 프로시저
 // -> 탐색기 생성 감지, 숨김, 파괴, 그리고 'Cloaked(닫기 동작)'을 감지하여 오버레이 제어
+// 탐색기 창 하나에 오버레이 생성 + 등록 (UI 스레드). 경로 탐색 요청은 호출자가 결정.
+OverlayPair* CreateExplorerOverlay(HWND hExplorer) {
+    // WS_VISIBLE 제거 -> 일단 숨겨진 상태로 생성 (깜빡임 방지)
+    HWND hNew = CreateWindowEx(WS_EX_TOOLWINDOW | WS_EX_LAYERED, CLASS_NAME, L"Memo", WS_POPUP | WS_CLIPCHILDREN, 
+                               0, 0, OVERLAY_WIDTH, OVERLAY_HEIGHT, hExplorer, NULL, GetModuleHandle(NULL), NULL);
+    if (!hNew) return nullptr;
+    SetLayeredWindowAttributes(hNew, 0, 200, LWA_ALPHA);
+    // 초기 상태 등록 (SyncOverlayPosition 호출 안 함 -> 스레드 위임)
+    return g_overlays.Add({ hExplorer, hNew, L"", false, false, false, DEFAULT_FONT_SIZE });
+}
+
+// [PRD 3.2.2] 창 이벤트 판단 순서는 core/overlay_events.h (RouteOverlayEvent). 여기는 Win32 창 API만
+struct Win32OverlayHost {
+    typedef HWND Handle;
+    typedef OverlayPair Pair;
+
+    bool IsAlive(HWND hwnd) { return IsWindow(hwnd) != FALSE; }
+    bool IsVisible(HWND hwnd) { return IsWindowVisible(hwnd) != FALSE; }
+    bool IsExplorer(HWND hwnd) {
+        wchar_t className[256];
+        return GetClassNameW(hwnd, className, 256) > 0 && wcscmp(className, L"CabinetWClass") == 0;
+    }
+    OverlayPair* FindByExplorer(HWND hwnd) { return g_overlays.FindByExplorer(hwnd); }
+    OverlayPair* CreateOverlay(HWND hwnd) { return CreateExplorerOverlay(hwnd); }
+    template <typename Fn> void ForEachOverlay(Fn fn) { g_overlays.ForEach(fn); }
+
+    void RequestPath(OverlayPair& pair) {
+        pair.pathGeneration = g_pathJobs.Submit(pair.hOverlay, pair.hExplorer);
+        ShowSpeculativePath(pair); // [PRD 3.1.6]
+    }
+    void ForgetExplorer(HWND hwnd) { g_pathResolver.Forget(hwnd); }
+    void MarkPathDirty(HWND hwnd) { g_pathResolver.MarkDirty(hwnd); }
+    void CancelPath(HWND hwnd) { g_pathJobs.Cancel(hwnd); }
+
+    // 1. 일단 즉시 숨김 (시각적 딜레이 제거) 2. 종료 메시지 전송 (직접 erase하지 않음 -> WM_DESTROY에서 처리)
+    void CloseOverlay(const OverlayPair& pair) {
+        ShowWindow(pair.hOverlay, SW_HIDE);
+        PostMessage(pair.hOverlay, WM_CLOSE, 0, 0);
+    }
+    void SchedulePosition(const OverlayPair& pair) { SchedulePositionSync(pair.hOverlay); }
+    void SettlePosition(const OverlayPair& pair) { SettlePositionSync(pair.hOverlay); }
+};
+
+Win32OverlayHost g_overlayHost;
+
 void CALLBACK WinEventProc(HWINEVENTHOOK hHook, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD dwEventThread, DWORD dwmsEventTime) {
     if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF) return;
+    OverlayEvent e;
+    switch (event) {
+    case EVENT_OBJECT_CREATE: e = OverlayEvent::Create; break;
+    case EVENT_OBJECT_SHOW: e = OverlayEvent::Show; break;
+    case EVENT_OBJECT_HIDE: e = OverlayEvent::Hide; break;
+    case EVENT_OBJECT_DESTROY: e = OverlayEvent::Destroy; break;
+    case EVENT_OBJECT_CLOAKED: e = OverlayEvent::Cloaked; break;
+    case EVENT_OBJECT_LOCATIONCHANGE: e = OverlayEvent::Location; break;
+    case EVENT_SYSTEM_FOREGROUND: e = OverlayEvent::Foreground; break;
+    case EVENT_OBJECT_NAMECHANGE: e = OverlayEvent::NameChange; break;
+    case EVENT_SYSTEM_MOVESIZEEND: e = OverlayEvent::MoveSizeEnd; break;
+    default: return;
+    }
+    RouteOverlayEvent(g_overlayHost, e, hwnd);
+}
 
-    // Case 1: 탐색기 창이 생성되거나 보일 때
-    if (event == EVENT_OBJECT_CREATE || event == EVENT_OBJECT_SHOW) {
-        if (!IsWindow(hwnd)) return;
-        wchar_t className[256];
-        if (GetClassNameW(hwnd, className, 256) > 0 && wcscmp(className, L"CabinetWClass") == 0) {
-            bool managed = false;
-            {
-                std::lock_guard<std::mutex> lock(g_overlayMutex);
-                for (const auto& pair : g_overlays) if (pair.hExplorer == hwnd) { managed = true; break; }
-            }
-            if (!managed) {
-                // WS_VISIBLE 제거 -> 일단 숨겨진 상태로 생성 (깜빡임 방지)
-                HWND hNew = CreateWindowEx(WS_EX_TOOLWINDOW | WS_EX_LAYERED, CLASS_NAME, L"Memo", WS_POPUP, 
-                                           0, 0, OVERLAY_WIDTH, OVERLAY_HEIGHT, hwnd, NULL, GetModuleHandle(NULL), NULL);
-                if (hNew) {
-                    SetLayeredWindowAttributes(hNew, 0, 200, LWA_ALPHA);
-                    UpdateMemoFont(GetDlgItem(hNew, IDC_MEMO_EDIT), DEFAULT_FONT_SIZE);
-                    {
-                        std::lock_guard<std::mutex> lock(g_overlayMutex);
-                        // 초기 상태 등록 (SyncOverlayPosition 호출 안 함 -> 스레드 위임)
-                        g_overlays.push_back({ hwnd, hNew, L"", false, false, false, DEFAULT_FONT_SIZE });
-                    }
-                    std::thread(PathFinderThread, hNew, hwnd).detach();
-                }
-            }
+// --- [명령줄 모드] ---
+// [PRD 6.1] 콘솔 출력 -> GUI 서브시스템 exe라 부모 콘솔에 붙어서 출력 (리다이렉트 시 UTF-8)
+void ConsolePrint(const std::wstring& line) {
+    static bool attached = AttachConsole(ATTACH_PARENT_PROCESS) != FALSE;
+    (void)attached;
+    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    std::wstring text = line + L"\n";
+    DWORD mode = 0, written = 0;
+    if (hOut && hOut != INVALID_HANDLE_VALUE && GetConsoleMode(hOut, &mode)) {
+        WriteConsoleW(hOut, text.c_str(), (DWORD)text.size(), &written, NULL);
+    } else if (hOut && hOut != INVALID_HANDLE_VALUE) {
+        std::string bytes = WideToUtf8(text);
+        WriteFile(hOut, bytes.data(), (DWORD)bytes.size(), &written, NULL);
+    } else {
+        OutputDebugStringW(text.c_str());
+    }
+}
+
+// [PRD 5.7] 폴더별 파일 -> 중앙 저장소 가져오기 (저널이 남아 있으면 재생한 내용으로)
+size_t ImportMemos(const std::wstring& root) {
+    size_t count = 0;
+    std::error_code ec;
+    fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+    for (; !ec && it != end; it.increment(ec)) {
+        if (it->path().filename() != L"folder_memo.txt") continue;
+        std::wstring folder = it->path().parent_path().wstring();
+        std::string bytes;
+        if (g_folderStorage.Read(folder, bytes) && g_centralStore.Write(folder, bytes)) count++;
+    }
+    return count;
+}
+
+// [PRD 5.7] 중앙 저장소 -> 폴더별 파일 내보내기 (사라진 폴더는 건너뜀)
+size_t ExportMemos(size_t& failed) {
+    size_t count = 0;
+    failed = 0;
+    std::vector<std::wstring> folders;
+    g_centralStore.ListFolders(folders);
+    for (const auto& folder : folders) {
+        std::error_code ec;
+        std::string bytes;
+        if (!fs::is_directory(folder, ec) || !g_centralStore.Read(folder, bytes) || !g_folderStorage.Write(folder, bytes)) { failed++; continue; }
+        count++;
+    }
+    return count;
+}
+
+// --- [메모 아카이브] ---
+// [PRD 6.2] 순회/형식/내보내기/복원/비교는 core/archive (Linux CLI tools/archive_cli와 공유). 여기는 앱 쪽 경계만.
+unsigned ArchiveThreadCount() {
+    if (g_config.archiveThreads > 0) return (unsigned)g_config.archiveThreads;
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? std::min(n * 2, 32u) : 4; // 열거는 I/O 대기가 많음 -> 코어 수보다 조금 많이
+}
+
+// 읽기는 폴더 저장소와 같은 경로(g_journal.Load: 남은 저널 재생) -> 오버레이가 보여 줄 내용 그대로 보관
+// [PRD 5.9] 복원으로 덮어쓰기 전 현재 내용은 버전 기록으로 남김 (--restore와 같은 안전망)
+class Win32ArchiveIo : public IArchiveMemoIo {
+public:
+    std::string Load(const std::wstring& folderPath) override { return g_journal.Load(folderPath); }
+    bool Restore(const std::wstring& folderPath, const std::string* live, const std::string& content) override {
+        if (live) g_memoHistory.Snapshot(folderPath, *live);
+        return g_folderStorage.Write(folderPath, content);
+    }
+    std::wstring NormalizeKey(const std::wstring& folderPath) override { return CentralLogStorage::NormalizeKey(folderPath); }
+};
+
+// [PRD 6.2] 아카이브 명령 (내보내기 -> 복원 -> 비교 순, 벤치는 단독)
+bool RunArchiveCommand(int& exitCode) {
+    Win32ArchiveIo io;
+    unsigned threads = ArchiveThreadCount();
+    if (!g_config.archiveBenchDir.empty()) {
+        if (!RunArchiveBench(io, g_config.archiveBenchDir, g_config.archiveBenchDirs, threads, ConsolePrint)) exitCode = 1;
+        return true;
+    }
+    if (g_config.archivePath.empty()) {
+        ConsolePrint(L"--archive <file> is required");
+        exitCode = 1;
+        return true;
+    }
+    if (!g_config.archiveExportRoots.empty()) {
+        ArchiveStats stats;
+        if (!ExportMemoArchive(io, g_config.archiveExportRoots, g_config.archivePath, threads, stats)) {
+            ConsolePrint(L"export failed: " + g_config.archivePath);
+            exitCode = 1;
+            return true;
         }
+        ConsolePrint(ArchiveStatsLine(L"export", stats, threads));
     }
-    // Case 2: 숨김, 파괴, 또는 🔥 [Cloaked(닫기/가려짐)] 감지
-    // -> 탐색기가 사라지면 즉시 오버레이에게 WM_CLOSE를 보내 스스로 종료하도록 유도 (WindowProc에서 벡터 정리)
-    else if (event == EVENT_OBJECT_HIDE || event == EVENT_OBJECT_DESTROY || event == EVENT_OBJECT_CLOAKED) {
-        std::lock_guard<std::mutex> lock(g_overlayMutex);
-        for (const auto& pair : g_overlays) {
-            // 해당 탐색기(hwnd)가 이벤트 대상이거나, 이미 유효하지 않은 핸들인 경우
-            if (pair.hExplorer == hwnd || !IsWindow(pair.hExplorer)) {
-                // 1. 일단 즉시 숨김 (시각적 딜레이 제거)
-                ShowWindow(pair.hOverlay, SW_HIDE);
-                
-                // 2. 종료 메시지 전송 (직접 erase하지 않음 -> WM_DESTROY에서 처리)
-                PostMessage(pair.hOverlay, WM_CLOSE, 0, 0);
-            }
+    if (g_config.archiveRestore) {
+        size_t restored, unchanged, skipped;
+        bool ok = RestoreMemoArchive(io, g_config.archivePath, g_config.archiveTarget, restored, unchanged, skipped);
+        ConsolePrint(L"restored " + std::to_wstring(restored) + L" memos (" + std::to_wstring(unchanged) + L" unchanged, " +
+            std::to_wstring(skipped) + L" skipped)" + (ok ? L"" : L" - archive is truncated or damaged"));
+        if (!ok || skipped) exitCode = 1;
+    }
+    if (g_config.archiveDiff) {
+        ArchiveStats stats;
+        std::vector<std::wstring> lines;
+        if (!DiffMemoArchive(io, g_config.archivePath, g_config.archiveTarget, threads, lines, stats)) {
+            ConsolePrint(L"archive is truncated or damaged: " + g_config.archivePath);
+            exitCode = 1;
+            return true;
+        }
+        for (const auto& line : lines) ConsolePrint(line);
+        ConsolePrint(ArchiveStatsLine(L"diff", stats, threads));
+        ConsolePrint(std::to_wstring(lines.size()) + L" difference(s)");
+        if (!lines.empty()) exitCode = 1;
+    }
+    return true;
+}
+
+// [PRD 5.9] --history / --restore (번호는 최신이 1)
+bool RunHistoryCommand(int& exitCode) {
+    const std::wstring& folder = g_config.historyFolder;
+    std::vector<MemoVersionInfo> versions = g_memoHistory.List(folder);
+    if (g_config.restoreVersion == 0) {
+        for (size_t n = versions.size(); n-- > 0;) {
+            std::time_t t = (std::time_t)(versions[n].timeMs / 1000);
+            std::tm local = *std::localtime(&t);
+            wchar_t line[128];
+            swprintf(line, 128, L"%3zu  %04d-%02d-%02d %02d:%02d:%02d  %llu bytes", versions.size() - n,
+                local.tm_year + 1900, local.tm_mon + 1, local.tm_mday, local.tm_hour, local.tm_min, local.tm_sec,
+                (unsigned long long)versions[n].size);
+            ConsolePrint(line);
         }
+        ConsolePrint(std::to_wstring(versions.size()) + L" version(s) of " + folder);
+        if (versions.empty()) exitCode = 1;
+        return true;
     }
-    // Case 3: 위치 변경
-    else if (event == EVENT_OBJECT_LOCATIONCHANGE || event == EVENT_SYSTEM_FOREGROUND) {
-        if (!IsWindow(hwnd)) return; 
-        std::lock_guard<std::mutex> lock(g_overlayMutex);
-        for (const auto& pair : g_overlays) if (pair.hExplorer == hwnd) { SyncOverlayPosition(pair); break; }
+    if (g_config.restoreVersion < 0 || (size_t)g_config.restoreVersion > versions.size()) {
+        ConsolePrint(L"no such version: " + std::to_wstring(g_config.restoreVersion));
+        exitCode = 1;
+        return true;
     }
-    // Case 4: 이름 변경
-    else if (event == EVENT_OBJECT_NAMECHANGE) {
-        if (!IsWindow(hwnd)) return;
-        // 창이 보이지 않거나 닫히는 중이면 스레드 시작하지 않음
-        if (!IsWindowVisible(hwnd)) return; 
+    std::string bytes;
+    if (!g_memoHistory.Read(folder, versions.size() - g_config.restoreVersion, bytes)) {
+        ConsolePrint(L"version " + std::to_wstring(g_config.restoreVersion) + L" is damaged");
+        exitCode = 1;
+        return true;
+    }
+    // 되돌리기 자체도 되돌릴 수 있도록 현재 내용을 먼저 버전으로 남김
+    std::string current;
+    if (g_storage->Read(folder, current)) g_memoHistory.Snapshot(folder, current);
+    if (!WriteMemoAndIndex(folder, std::make_shared<std::string>(bytes))) {
+        ConsolePrint(L"restore failed: " + folder);
+        exitCode = 1;
+        return true;
+    }
+    g_memoHistory.Snapshot(folder, bytes);
+    ConsolePrint(L"restored version " + std::to_wstring(g_config.restoreVersion) + L" (" + std::to_wstring(bytes.size()) + L" bytes) to " + folder);
+    return true;
+}
 
-        HWND hOverlay = NULL;
-        {
-            std::lock_guard<std::mutex> lock(g_overlayMutex);
-            for (const auto& pair : g_overlays) if (pair.hExplorer == hwnd) { hOverlay = pair.hOverlay; break; }
+// [PRD 6.1] 헤드리스 검색/재색인 -> 처리했으면 true (오버레이 실행 안 함)
+// [PRD 5.7] 중앙 저장소 가져오기/내보내기도 여기서 처리 (가져오기 -> 내보내기 -> 재색인 -> 검색 순)
+bool RunCommandLineMode(int& exitCode) {
+    bool archiveMode = !g_config.archiveExportRoots.empty() || g_config.archiveRestore || g_config.archiveDiff ||
+        !g_config.archiveBenchDir.empty();
+    if (!g_config.searchMode && !g_config.reindexMode && g_config.importRoots.empty() && !g_config.exportMode &&
+        g_config.historyFolder.empty() && !archiveMode && g_config.memoCacheBenchDir.empty() && !g_config.editBenchKeys) return false;
+    exitCode = 0;
+    if (g_config.editBenchKeys) {
+        if (!RunEditBench(g_config.editBenchKeys, fs::temp_directory_path() / L"FolderMemoEditBench", ConsolePrint)) exitCode = 1;
+        return true;
+    }
+    if (!g_config.memoCacheBenchDir.empty()) {
+        if (!RunMemoCacheBench(g_config.memoCacheBenchDir, g_config.memoCacheBenchSteps, g_config.memoCacheMb, ConsolePrint)) exitCode = 1;
+        return true;
+    }
+    if (!g_config.historyFolder.empty()) return RunHistoryCommand(exitCode);
+    if (archiveMode) return RunArchiveCommand(exitCode);
+    for (const auto& root : g_config.importRoots) {
+        auto t0 = std::chrono::steady_clock::now();
+        size_t n = ImportMemos(root);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+        ConsolePrint(L"imported " + std::to_wstring(n) + L" memos from " + root + L" in " + std::to_wstring(ms) + L" ms");
+    }
+    if (g_config.exportMode) {
+        size_t failed = 0;
+        size_t n = ExportMemos(failed);
+        ConsolePrint(L"exported " + std::to_wstring(n) + L" memos (" + std::to_wstring(failed) + L" skipped)");
+        if (failed) exitCode = 1;
+    }
+    if (g_config.reindexMode) {
+        std::vector<std::wstring> roots = LoadIndexRoots();
+        auto t0 = std::chrono::steady_clock::now();
+        g_indexer.Crawl(*g_storage, roots);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+        ConsolePrint(L"indexed " + std::to_wstring(g_searchIndex.DocumentCount()) + L" memos in " + std::to_wstring(ms) + L" ms");
+    }
+    if (g_config.searchMode) {
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::wstring> hits = g_searchIndex.Query(g_config.searchQuery);
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+        for (const auto& path : hits) ConsolePrint(path);
+        ConsolePrint(std::to_wstring(hits.size()) + L" result(s) in " + std::to_wstring(us) + L" us");
+        if (hits.empty()) exitCode = 1;
+    }
+    return true;
+}
+
+// [PRD 3.2.3] 이미 열린 탐색기 창 일괄 부착 (UI 스레드, 훅 설치 직후 1회)
+// -> 훅보다 먼저 나열하면 그 사이 열린 창을 놓칠 수 있음. 훅 이후라 겹치는 창은 FindByExplorer로 걸러짐.
+void AttachExistingExplorers() {
+    std::vector<HWND> found;
+    EnumWindows([](HWND hwnd, LPARAM lParam) -> BOOL {
+        wchar_t className[256];
+        if (IsWindowVisible(hwnd) && GetClassNameW(hwnd, className, 256) > 0 && wcscmp(className, L"CabinetWClass") == 0)
+            ((std::vector<HWND>*)lParam)->push_back(hwnd);
+        return TRUE;
+    }, (LPARAM)&found);
+
+    std::vector<StartupWindow> windows;
+    for (HWND hExplorer : found) {
+        if (g_overlays.FindByExplorer(hExplorer)) continue;
+        OverlayPair* pair = CreateExplorerOverlay(hExplorer);
+        if (!pair) continue;
+        pair->pathGeneration = g_pathJobs.Reserve();
+        pair->traceEventNs = FM_TRACE_NOW(); // [PRD 7.1]
+        wchar_t title[MAX_PATH] = { 0 };
+        GetWindowTextW(hExplorer, title, MAX_PATH);
+        windows.push_back({ hExplorer, pair->hOverlay, title, pair->pathGeneration });
+    }
+    if (windows.empty()) return;
+    g_startupPending = windows.size();
+    g_startupThread = std::thread(StartupAttachJob, std::move(windows));
+}
+
+// [PRD 7.1] 단계별 지연 히스토그램 요약 (디버그 출력)
+void LogTraceSummary() {
+#if FM_TRACE
+    for (uint32_t s = 0; s < trace::STAGE_COUNT; s++) {
+        const trace::Histogram& h = trace::Global().Hist(s);
+        if (h.Count() == 0) continue;
+        const char* name = trace::StageName(s);
+        std::wstring wname(name, name + strlen(name));
+        wchar_t line[200];
+        swprintf(line, 200, L"[FolderMemo] trace %ls n=%llu mean=%.2fms p50=%.2fms p90=%.2fms p99=%.2fms max=%.2fms\n",
+            wname.c_str(), h.Count(), h.Mean() / 1e6, h.Percentile(0.5) / 1e6, h.Percentile(0.9) / 1e6,
+            h.Percentile(0.99) / 1e6, h.Max() / 1e6);
+        OutputDebugStringW(line);
+    }
+#endif
+}
+
+// [PRD 7.1] Ctrl+Alt+Shift+T -> 앱 데이터 폴더에 trace-YYYYMMDD-HHMMSS.json 기록
+void DumpTrace() {
+#if FM_TRACE
+    std::string json;
+    trace::Global().WriteChromeJson(json);
+    SYSTEMTIME st; GetLocalTime(&st);
+    wchar_t name[64];
+    swprintf(name, 64, L"trace-%04d%02d%02d-%02d%02d%02d.json", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+    fs::path p = AppDataDir() / name;
+    std::error_code ec;
+    fs::create_directories(p.parent_path(), ec);
+    bool ok = WriteFileAtomic(p, json);
+    std::wstring msg = std::wstring(L"[FolderMemo] trace dump ") + (ok ? L"written: " : L"failed: ") + p.wstring() + L"\n";
+    OutputDebugStringW(msg.c_str());
+    LogTraceSummary();
+#endif
+}
+
+// --- [이벤트 재생] ---
+// [PRD 7.2] 재생 세션/기록 형식/가짜 Shell은 core/replay.h. 여기는 Win32 창 쪽 경계만:
+// -> 탐색기 창 = 이 프로세스가 만든 CabinetWClass 창 (화면 밖). 이벤트는 실제 WinEventProc과 같은 라우터로, 펌프는 실제 WindowProc으로.
+const wchar_t REPLAY_EXPLORER_CLASS[] = L"CabinetWClass";
+const int REPLAY_ORIGIN_X = -20000; // 화면 밖 (오버레이도 탐색기 기준으로 화면 밖에 배치됨)
+
+typedef BasicReplayShellBackend<HWND> ReplayShellBackend;
+typedef BasicReplaySession<HWND> ReplaySession;
+
+ReplayShellBackend g_replayShell; // 해석기가 종료 시 Disconnect 호출 -> 전역 수명
+
+class Win32ReplayWindows : public IReplayWindows<HWND> {
+public:
+    explicit Win32ReplayWindows(HINSTANCE hInstance) : m_hInstance(hInstance) {}
+
+    void WriteMemo(const std::wstring& folderPath) override { g_storage->Write(folderPath, "replay memo\r\n"); }
+
+    HWND CreateExplorer(int id, const std::wstring& title) override {
+        return CreateWindowExW(WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE, REPLAY_EXPLORER_CLASS, title.c_str(),
+            WS_POPUP, REPLAY_ORIGIN_X + id * 8, 0, 900, 700, NULL, NULL, m_hInstance, NULL);
+    }
+
+    void ShowExplorer(HWND hwnd, bool visible) override { ShowWindow(hwnd, visible ? SW_SHOWNOACTIVATE : SW_HIDE); }
+
+    void MoveExplorer(HWND hwnd, int x, int y) override {
+        SetWindowPos(hwnd, NULL, REPLAY_ORIGIN_X + x, y, 0, 0, SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE);
+    }
+
+    void SetExplorerTitle(HWND hwnd, const std::wstring& title) override { SetWindowTextW(hwnd, title.c_str()); }
+    void DestroyExplorer(HWND hwnd) override { DestroyWindow(hwnd); }
+    void Inject(OverlayEvent event, HWND hwnd) override { RouteOverlayEvent(g_overlayHost, event, hwnd); }
+
+    void Pump() override {
+        MSG msg;
+        while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+        }
+        g_positionScheduler.RunDueFrame(OverlayTargetRect); // [PRD 3.2.2]
+    }
+
+    // [PRD 3.2.2] 위치 동기화 박자 중이면 다음 프레임까지만
+    void Wait(int ms) override {
+        DWORD wait = std::min((DWORD)ms, (DWORD)g_positionScheduler.FrameWaitMs());
+        MsgWaitForMultipleObjects(0, NULL, FALSE, wait, QS_ALLINPUT);
+    }
+
+    bool OverlayPath(HWND hExplorer, std::wstring& path) override {
+        const OverlayPair* pair = g_overlays.FindByExplorer(hExplorer);
+        if (!pair) return false;
+        path = pair->currentPath;
+        return true;
+    }
+
+    void ForEachOverlay(const std::function<void(HWND)>& fn) override {
+        g_overlays.ForEach([&fn](OverlayPair& pair) { fn(pair.hExplorer); });
+    }
+
+private:
+    HINSTANCE m_hInstance;
+};
+
+// 재생 모드 진입 (UI 스레드, 오버레이 창 클래스 등록 후). 위반이 없으면 0
+int RunReplay(HINSTANCE hInstance) {
+    std::vector<ReplayEvent> events;
+    if (!g_config.replayTrace.empty()) {
+        std::string bytes;
+        std::wstring error;
+        if (!ReadWholeFile(g_config.replayTrace, bytes)) { ConsolePrint(L"replay: cannot read " + g_config.replayTrace); return 2; }
+        if (!ParseReplayTrace(bytes, events, error)) { ConsolePrint(L"replay: " + error); return 2; }
+    } else {
+        GenerateReplayEvents(std::max(1, g_config.replayWindows), std::max(0, g_config.replayEvents), g_config.replayRate, events);
+    }
+
+    WNDCLASSW wc = { 0 };
+    wc.lpfnWndProc = DefWindowProcW;
+    wc.hInstance = hInstance;
+    wc.lpszClassName = REPLAY_EXPLORER_CLASS;
+    RegisterClassW(&wc);
+
+    fs::path root = fs::temp_directory_path() / L"FolderMemoReplay";
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root, ec);
+
+    g_replayShell.SetInitDelay(g_config.replayInitMs);
+    g_pathResolver.SetBackend(&g_replayShell);
+    Win32ReplayWindows windows(hInstance);
+    ReplaySession session(windows, g_replayShell, root);
+    ReplayStats stats = session.Run(events);
+
+    wchar_t line[256];
+    swprintf(line, 256, L"replay: %zu events in %.1f ms (%.0f events/s)",
+        stats.injected, stats.injectMs, stats.injectMs > 0 ? stats.injected * 1000.0 / stats.injectMs : 0.0);
+    ConsolePrint(line);
+    swprintf(line, 256, L"path latency: n=%zu p50=%.2fms p90=%.2fms p99=%.2fms max=%.2fms",
+        stats.latencyMs.size(), stats.Percentile(0.5), stats.Percentile(0.9), stats.Percentile(0.99), stats.Percentile(1.0));
+    ConsolePrint(line);
+    swprintf(line, 256, L"shell: list=%llu read=%llu  resolver hits=%llu misses=%llu  path jobs submitted=%llu coalesced=%llu",
+        g_replayShell.ListCalls(), g_replayShell.ReadCalls(), g_pathResolver.Hits(), g_pathResolver.Misses(),
+        g_pathJobs.SubmittedCount(), g_pathJobs.CoalescedCount());
+    ConsolePrint(line);
+    swprintf(line, 256, L"speculative: shown=%llu confirmed=%llu replaced=%llu  path jobs cancelled=%llu",
+        g_speculativeShown, g_speculativeConfirmed, g_speculativeReplaced, g_pathJobs.CancelledCount());
+    ConsolePrint(line);
+    swprintf(line, 256, L"invariants: checks=%llu ghost=%llu missing=%llu duplicate=%llu stale=%llu",
+        stats.checks, stats.ghost, stats.missing, stats.duplicate, stats.stale);
+    ConsolePrint(line);
+    return stats.Clean() ? 0 : 1;
+}
+
+// [PRD 3.2.2] 쌓인 메시지 처리 + 위치 동기화 프레임 (WM_QUIT이면 false)
+// -> 전역 타이머 대신 대기 시한: 박자 중에만 FrameWaitMs 뒤 깨어나고, 멈춰 있으면 GetMessage처럼 메시지가 올 때까지 잠듦.
+// -> 메시지가 쉬지 않고 와도 처리 사이마다 프레임 시각을 확인 -> 드래그 중 이벤트 폭주에 프레임이 밀리지 않음.
+bool PumpOverlayMessages() {
+    g_positionScheduler.RunDueFrame(OverlayTargetRect);
+    MsgWaitForMultipleObjectsEx(0, NULL, g_positionScheduler.FrameWaitMs(), QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+    MSG msg;
+    while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+        if (msg.message == WM_QUIT) return false;
+        if (msg.message == WM_HOTKEY && msg.wParam == TRACE_HOTKEY_ID) { DumpTrace(); continue; } // [PRD 7.1]
+        if (msg.message == WM_KEYDOWN && msg.wParam == 'A' && (GetKeyState(VK_CONTROL) & 0x8000)) {
+            SendMessage(msg.hwnd, EM_SETSEL, 0, -1);
+            continue; 
         }
-        if (hOverlay) std::thread(PathFinderThread, hOverlay, hwnd).detach();
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        g_positionScheduler.RunDueFrame(OverlayTargetRect);
     }
+    return true;
+}
+
+// 실제 탐색기 훅 설치 + 메시지 루프 (WM_QUIT까지)
+void RunOverlayMessageLoop() {
+    // 기존 훅들
+    HWINEVENTHOOK hHook1 = SetWinEventHook(EVENT_OBJECT_CREATE, EVENT_OBJECT_HIDE, NULL, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    HWINEVENTHOOK hHook2 = SetWinEventHook(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_NAMECHANGE, NULL, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    HWINEVENTHOOK hHook3 = SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, NULL, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    
+    // 🔥 [추가] 닫기 애니메이션(Cloaked) 감지용 훅
+    HWINEVENTHOOK hHook4 = SetWinEventHook(EVENT_OBJECT_CLOAKED, EVENT_OBJECT_CLOAKED, NULL, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    // [PRD 3.2.2] 드래그/크기 조절 끝 -> 최종 위치 즉시 반영
+    HWINEVENTHOOK hHook5 = SetWinEventHook(EVENT_SYSTEM_MOVESIZEEND, EVENT_SYSTEM_MOVESIZEEND, NULL, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+
+    g_hHookObject = hHook1;
+#if FM_TRACE
+    RegisterHotKey(NULL, TRACE_HOTKEY_ID, MOD_CONTROL | MOD_ALT | MOD_SHIFT | MOD_NOREPEAT, 'T'); // [PRD 7.1] 추적 덤프
+#endif
+    AttachExistingExplorers(); // [PRD 3.2.3] 이미 열린 창 일괄 부착
+
+    while (PumpOverlayMessages()) {}
+
+    if (hHook1) UnhookWinEvent(hHook1);
+    if (hHook2) UnhookWinEvent(hHook2);
+    if (hHook3) UnhookWinEvent(hHook3);
+    if (hHook4) UnhookWinEvent(hHook4); // 🔥 [추가] 해제
+    if (hHook5) UnhookWinEvent(hHook5);
 }
 
 // --- [Main] ---
 typedef HRESULT (STDAPICALLTYPE *SetProcessDpiAwarenessType)(int);
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
+    FM_TRACE_THREAD("ui"); // [PRD 7.1]
+    g_processStart = std::chrono::steady_clock::now(); // [PRD 3.2.3] 시작 -> 전체 표시 시간 측정 기준
     HMODULE hShCore = LoadLibrary(L"Shcore.dll");
     if (hShCore) {
         auto pSetProcessDpiAwareness = (SetProcessDpiAwarenessType)GetProcAddress(hShCore, "SetProcessDpiAwareness");
@@ -597,7 +2762,29 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
         FreeLibrary(hShCore);
     }
     
+    ParseCommandLine();
+    g_volumeHealth.SetLog([](const std::wstring& line) { OutputDebugStringW(line.c_str()); }); // [PRD 5.10]
+    g_memoCache.SetBudget(g_config.memoCacheMb * 1024 * 1024); // [PRD 3.4]
+    // [PRD 5.7] 중앙 저장소 선택 (열기 실패해도 폴더로 되돌아가지 않음 -> 읽기 전용/동기화 폴더에 쓰지 않기 위함)
+    if (g_config.centralStore || !g_config.importRoots.empty() || g_config.exportMode) {
+        if (!g_centralStore.Open(AppDataDir())) OutputDebugStringW(L"[FolderMemo] central store: open failed\n");
+        if (g_config.centralStore) g_storage = &g_centralStore;
+    }
+    g_searchIndex.Open(AppDataDir() / L"memo_index.bin"); // [PRD 6.1] 기존 색인 이미지 매핑
+    g_memoHistory.SetLog([](const std::wstring& line) { OutputDebugStringW(line.c_str()); });
+    if (!g_memoHistory.Open(AppDataDir() / L"history")) OutputDebugStringW(L"[FolderMemo] history: open failed\n"); // [PRD 5.9]
+    int cliExitCode = 0;
+    if (RunCommandLineMode(cliExitCode)) { g_memoHistory.Close(); g_centralStore.Close(); return cliExitCode; }
+
     CoInitializeEx(NULL, COINIT_MULTITHREADED);
+    g_journal.Start();   // [PRD 5.4] 저널 압축 스레드 시작
+    g_saveQueue.Start(); // [PRD 5.3] Writer 스레드 시작
+    g_pathJobs.Start(PATH_WORKER_COUNT); // [PRD 3.1.2] 경로 탐색 워커 풀 시작
+    g_dirWatcher.Start(); // [PRD 3.3] 메모 존재 캐시 무효화용 변경 알림
+    g_liveReload.Start(); // [PRD 5.8] 열린 메모의 디스크 변경 반영
+    // [PRD 4.7] 폴더별 보기 상태 (재생 모드는 사용자 기록을 건드리지 않음)
+    if (!g_config.replayMode && !g_viewStates.Open(AppDataDir() / L"view_state.bin")) OutputDebugStringW(L"[FolderMemo] view state: open failed\n");
+    g_indexer.Start(g_storage, LoadIndexRoots());   // [PRD 6.1] 백그라운드 색인 (루트가 없으면 아무것도 안 함)
 
     WNDCLASSW wc = { 0 };
     wc.lpfnWndProc = WindowProc;
@@ -607,31 +2794,61 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
     wc.hCursor = LoadCursor(NULL, IDC_ARROW);
     RegisterClassW(&wc);
 
-    // 기존 훅들
-    HWINEVENTHOOK hHook1 = SetWinEventHook(EVENT_OBJECT_CREATE, EVENT_OBJECT_HIDE, NULL, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
-    HWINEVENTHOOK hHook2 = SetWinEventHook(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_NAMECHANGE, NULL, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
-    HWINEVENTHOOK hHook3 = SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, NULL, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
-    
-    // 🔥 [추가] 닫기 애니메이션(Cloaked) 감지용 훅
-    HWINEVENTHOOK hHook4 = SetWinEventHook(EVENT_OBJECT_CLOAKED, EVENT_OBJECT_CLOAKED, NULL, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    // [PRD 7.2] 재생 모드 -> 훅/기존 창 부착 없이 기록된 이벤트만 주입 (종료 처리는 아래 공통 경로)
+    if (g_config.replayMode) cliExitCode = RunReplay(hInstance);
+    else RunOverlayMessageLoop();
+    LogGdiStats(L"exit"); // [PRD 4.4]
+    LogChromeStats();     // [PRD 4.6]
+    LogOverlayResources(L"exit"); // [PRD 4.5]
+    g_editorPool.Clear();
+    LogTraceSummary();    // [PRD 7.1]
+#if FM_TRACE
+    UnregisterHotKey(NULL, TRACE_HOTKEY_ID);
+#endif
 
-    g_hHookObject = hHook1;
+    // [PRD 3.2.2] 위치 동기화 통계 (이벤트 수 대비 실제 이동 수)
+    wchar_t stats[160];
+    swprintf(stats, 160, L"[FolderMemo] position events=%llu moves=%llu skipped=%llu transactions=%llu\n",
+        g_positionScheduler.EventsReceived(), g_positionScheduler.MovesIssued(),
+        g_positionScheduler.MovesSkipped(), g_positionScheduler.Transactions());
+    OutputDebugStringW(stats);
 
-    MSG msg;
-    while (GetMessage(&msg, NULL, 0, 0)) {
-        if (msg.message == WM_KEYDOWN && msg.wParam == 'A' && (GetKeyState(VK_CONTROL) & 0x8000)) {
-            SendMessage(msg.hwnd, EM_SETSEL, 0, -1);
-            continue; 
-        }
-        TranslateMessage(&msg);
-        DispatchMessage(&msg);
-    }
+    // [PRD 3.3] 메모 존재 캐시 적중률
+    unsigned long long statHits = g_statCache.Hits(), statMisses = g_statCache.Misses();
+    swprintf(stats, 160, L"[FolderMemo] memo stat cache hits=%llu misses=%llu (%.1f%% hit) invalidations=%llu raced=%llu\n",
+        statHits, statMisses, (statHits + statMisses) ? 100.0 * statHits / (statHits + statMisses) : 0.0,
+        g_statCache.Invalidations(), g_statCache.Raced());
+    OutputDebugStringW(stats);
+    // [PRD 3.4] 메모 내용 캐시
+    unsigned long long memoHits = g_memoCache.Hits(), memoMisses = g_memoCache.Misses();
+    swprintf(stats, 160, L"[FolderMemo] memo cache hits=%llu misses=%llu (%.1f%% hit) stale=%llu evicted=%llu invalidated=%llu bytes=%zu\n",
+        memoHits, memoMisses, (memoHits + memoMisses) ? 100.0 * memoHits / (memoHits + memoMisses) : 0.0,
+        g_memoCache.Stale(), g_memoCache.Evictions(), g_memoCache.Invalidations(), g_memoCache.Bytes());
+    OutputDebugStringW(stats);
+    swprintf(stats, 160, L"[FolderMemo] dir watcher watching=%zu notifications=%llu unwatchable=%llu\n",
+        g_dirWatcher.Watching(), g_dirWatcher.Notifications(), g_dirWatcher.Unwatchable());
+    OutputDebugStringW(stats);
+    g_guardedStorage.LogStats(); // [PRD 5.10]
 
-    if (hHook1) UnhookWinEvent(hHook1);
-    if (hHook2) UnhookWinEvent(hHook2);
-    if (hHook3) UnhookWinEvent(hHook3);
-    if (hHook4) UnhookWinEvent(hHook4); // 🔥 [추가] 해제
+    g_liveReload.Stop();
+    if (g_startupThread.joinable()) g_startupThread.join(); // [PRD 3.2.3]
+    g_pathJobs.Stop();  // [PRD 3.1.2] 워커 종료 (COM 해제 전)
+    g_saveQueue.Stop(); // [PRD 5.3.1] 남은 저장 모두 기록 후 종료
+    if (size_t unsaved = g_saveQueue.PendingCount()) { // [PRD 5.10] 끝내 돌아오지 않은 볼륨 -> 기록 보관에만 남음
+        swprintf(stats, 160, L"[FolderMemo] %zu memo(s) not saved (volume unavailable), kept in history; retried=%llu\n", unsaved, g_saveQueue.RetriedCount());
+        OutputDebugStringW(stats);
+    }
+    g_memoHistory.Close(); // [PRD 5.9] 대기 중인 마지막 저장을 버전으로 남기고 보존 정책 적용
+    g_journal.Stop();   // [PRD 5.4] 남은 저널을 folder_memo.txt로 접음
+    g_dirWatcher.Stop();
+    g_centralStore.Close(); // [PRD 5.7] 색인 스냅샷 기록 (다음 시작 시 로그 재탐색 생략)
+    g_overlays.ForEach([](OverlayPair& pair) { SaveOverlayViewState(pair); }); // [PRD 4.7] 열린 채 종료되는 오버레이
+    g_viewStates.Close();
+    g_indexer.Stop();
+    g_searchIndex.Merge(); // [PRD 6.1] 세션 중 저장분을 색인 이미지에 반영
+    g_ioPool.Stop(); // [PRD 5.10] 남은 I/O 작업 버림, 쉬는 워커 종료 (묶인 워커의 늦은 완료는 무시)
+    g_pathResolver.Shutdown(); // [PRD 3.1.5] COM 참조는 CoUninitialize 전에 해제
     
     CoUninitialize();
-    return 0;
+    return cliExitCode;
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+// [PRD 6.2] 메모 아카이브: 병렬 순회(모든 폴더 한 번씩, 유휴 스레드는 잠듦), 내보내기 1/N 스레드, 비교(+/-/M), 잘린 아카이브 거부, 복원
+// --bench [--dirs N] [--threads N]: 합성 트리 내보내기/비교 처리량 (RunArchiveBench, fm_archive bench와 같음)
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "core/archive.h"
+#include "core/file_io.h"
+#include "core/utf.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+static fs::path Root(const char* name) {
+    fs::path root = fs::temp_directory_path() / "FolderMemoArchiveTest" / name;
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root, ec);
+    return root;
+}
+
+static void Memo(const fs::path& dir, const std::string& text) {
+    fs::create_directories(dir);
+    WriteFileAtomic(dir / "folder_memo.txt", text);
+}
+
+static std::map<std::string, std::string> ReadAll(const fs::path& archive, bool& ok) {
+    std::map<std::string, std::string> out;
+    std::vector<std::wstring> roots;
+    ok = ReadMemoArchive(archive, roots, [&](const ArchiveRecord& rec) { out[std::to_string(rec.root) + ":" + rec.relPath] = rec.content; });
+    return out;
+}
+
+// 한쪽만 깊은 사슬 + 넓은 가지: 대부분의 스레드가 오래 할 일이 없음 -> 잠들었다 깨어나도 모든 폴더를 정확히 한 번
+static void TestWalker() {
+    fs::path root = Root("walker");
+    fs::path deep = root / "deep";
+    size_t dirs = 2; // root, deep
+    for (int i = 0; i < 200; i++, dirs++) deep /= "d" + std::to_string(i);
+    fs::create_directories(deep);
+    for (int i = 0; i < 50; i++, dirs++) Memo(root / "wide" / std::to_string(i), "w");
+    dirs++; // wide
+    Memo(deep, "bottom");
+
+    for (unsigned threads : { 1u, 4u, 16u }) {
+        ParallelTreeWalker walker;
+        std::mutex mutex;
+        std::multiset<std::wstring> visited;
+        walker.Run({ root.wstring() }, threads, [&](unsigned worker, uint32_t r, const fs::path& folder) {
+            CHECK(worker < threads);
+            CHECK(r == 0);
+            std::lock_guard<std::mutex> lock(mutex);
+            visited.insert(folder.wstring());
+        });
+        CHECK(walker.Directories() == dirs);
+        CHECK(visited.size() == 51);
+        CHECK(visited.count(deep.wstring()) == 1);
+        if (threads == 1) CHECK(walker.Sleeps() == 0 && walker.Steals() == 0);
+    }
+
+    // 루트가 없거나 비어 있어도 끝남
+    ParallelTreeWalker walker;
+    walker.Run({ (root / "missing").wstring() }, 8, [](unsigned, uint32_t, const fs::path&) { CHECK(false); });
+    CHECK(walker.Directories() == 1);
+    walker.Run({}, 8, [](unsigned, uint32_t, const fs::path&) { CHECK(false); });
+}
+
+static void TestExportDiffRestore() {
+    fs::path root = Root("tree");
+    fs::path a = root / "a", b = root / "b";
+    Memo(a, "root memo");
+    Memo(a / "x", "x memo");
+    Memo(a / "x" / "y", "한글 메모\r\n");
+    Memo(b / "z", "z memo");
+    fs::create_directories(b / "empty");
+
+    // 저널이 남은 메모 -> 재생된 내용이 보관되어야 함
+    {
+        MemoJournalStore store;
+        CHECK(store.Save((a / "x").wstring(), "x memo, edited"));
+    }
+    CHECK(fs::exists(MemoJournalStore::JournalPath((a / "x").wstring())));
+
+    FileArchiveIo io;
+    std::vector<std::wstring> roots{ a.wstring(), b.wstring() };
+    fs::path one = root / "one.fma", many = root / "many.fma";
+    ArchiveStats s1, sN;
+    CHECK(ExportMemoArchive(io, roots, one, 1, s1));
+    CHECK(ExportMemoArchive(io, roots, many, 8, sN));
+    CHECK(s1.records == 4 && sN.records == 4);
+    CHECK(s1.directories == sN.directories);
+    bool ok1, okN;
+    auto r1 = ReadAll(one, ok1), rN = ReadAll(many, okN);
+    CHECK(ok1 && okN);
+    CHECK(r1 == rN); // 기록 순서는 달라도 내용은 같음
+    CHECK(r1["0:."] == "root memo");
+    CHECK(r1["0:x"] == "x memo, edited");
+    CHECK(r1["0:x/y"] == "한글 메모\r\n");
+    CHECK(r1["1:z"] == "z memo");
+
+    std::vector<std::wstring> lines;
+    ArchiveStats ds;
+    CHECK(DiffMemoArchive(io, many, std::wstring(), 4, lines, ds));
+    CHECK(lines.empty());
+
+    // 고침 / 지움 / 새로 씀 -> M / - / +
+    Memo(a / "x" / "y", "changed");
+    fs::remove(b / "z" / "folder_memo.txt");
+    Memo(b / "empty", "new");
+    CHECK(DiffMemoArchive(io, many, std::wstring(), 4, lines, ds));
+    CHECK(lines.size() == 3);
+    std::set<std::wstring> got(lines.begin(), lines.end());
+    CHECK(got.count(L"M " + (a / "x" / "y").wstring()));
+    CHECK(got.count(L"- " + (b / "z").wstring()));
+    CHECK(got.count(L"+ " + (b / "empty").wstring()));
+
+    // 복원: 다른 것만 기록, 폴더가 없으면 만들지 않고 건너뜀
+    fs::remove_all(a / "x" / "y");
+    size_t restored, unchanged, skipped;
+    CHECK(RestoreMemoArchive(io, many, std::wstring(), restored, unchanged, skipped));
+    CHECK(restored == 1 && unchanged == 2 && skipped == 1); // z 복원, a/x/y 폴더 없음
+    CHECK(!fs::exists(a / "x" / "y"));
+    CHECK(io.Load((b / "z").wstring()) == "z memo");
+
+    // 다른 대상 아래로 복원 (루트 번호는 무시하고 상대 경로만)
+    fs::path target = root / "target";
+    fs::create_directories(target / "x");
+    CHECK(RestoreMemoArchive(io, many, target.wstring(), restored, unchanged, skipped));
+    CHECK(restored == 2 && skipped == 2); // "." 과 x
+    CHECK(io.Load(target.wstring()) == "root memo");
+    CHECK(io.Load((target / "x").wstring()) == "x memo, edited");
+
+    // 잘린 아카이브 -> 거부 (끝 표식 없음), 어느 지점에서 잘려도
+    std::string bytes;
+    CHECK(ReadWholeFile(many, bytes));
+    for (size_t cut : { bytes.size() - 1, bytes.size() - 12, bytes.size() / 2, (size_t)20 }) {
+        fs::path cutPath = root / "cut.fma";
+        WriteFileAtomic(cutPath, bytes.substr(0, cut));
+        bool ok;
+        ReadAll(cutPath, ok);
+        CHECK(!ok);
+        CHECK(!DiffMemoArchive(io, cutPath, std::wstring(), 2, lines, ds));
+    }
+    // 내용 손상 -> 해시 불일치로 거부
+    std::string damaged = bytes;
+    size_t at = damaged.find("z memo");
+    CHECK(at != std::string::npos);
+    damaged[at] = 'Z';
+    WriteFileAtomic(root / "bad.fma", damaged);
+    bool okBad;
+    ReadAll(root / "bad.fma", okBad);
+    CHECK(!okBad);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        FileArchiveIo io;
+        unsigned threads = (unsigned)ArgInt(argc, argv, "--threads", 8);
+        fs::path dir = fs::temp_directory_path() / "FolderMemoArchiveBench";
+        fs::create_directories(dir);
+        bool ok = RunArchiveBench(io, dir, (size_t)ArgInt(argc, argv, "--dirs", 100000), threads,
+            [](const std::wstring& line) { std::printf("%s\n", WideToUtf8(line).c_str()); });
+        return ok ? 0 : 1;
+    }
+    TestWalker();
+    TestExportDiffRestore();
+    return TestExit("archive_test");
+}
\ No newline at end of file
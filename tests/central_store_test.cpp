@@ -0,0 +1,204 @@
+// [PRD 5.7] 중앙 로그 저장소: 경로 정규화, 스냅샷/전체 훑기 시작, 잘린 꼬리 복구, 압축, 깨진 헤더
+// --bench [--memos N]: N개 메모로 시작 시간(스냅샷/전체 훑기)과 Exists/Read 평균 측정
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/central_store.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+static fs::path Dir(const char* name) {
+    fs::path dir = fs::temp_directory_path() / "FolderMemoCentralTest" / name;
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir, ec);
+    return dir;
+}
+
+static std::wstring FolderName(size_t i) {
+    wchar_t buf[64];
+    swprintf(buf, 64, L"C:\\Memos\\Project %zu\\Notes", i);
+    return buf;
+}
+
+static void TestBasics() {
+    fs::path dir = Dir("basics");
+    {
+        CentralLogStore store;
+        CHECK(store.Open(dir));
+        CHECK(!store.LastOpen().fromSnapshot);
+        CHECK(store.Write(L"C:\\Work\\Alpha", "first"));
+        CHECK(store.Write(L"D:\\Shared\\Beta\\", "beta"));
+        CHECK(store.Exists(L"c:/work/ALPHA/")); // 대소문자/구분자/끝 구분자 무시
+        CHECK(!store.Exists(L"C:\\Work"));
+        CHECK(store.Write(L"c:/work/alpha", "second")); // 같은 키 -> 덮어씀
+        std::string bytes;
+        CHECK(store.Read(L"C:\\Work\\Alpha", bytes) && bytes == "second");
+        long long mtime = 0;
+        unsigned long long size = 0;
+        CHECK(store.Stamp(L"D:\\Shared\\Beta", mtime, size) && size == 4 && mtime != 0);
+        CHECK(store.Count() == 2);
+        std::vector<std::wstring> folders;
+        store.ListFolders(folders);
+        CHECK(folders.size() == 2);
+        bool original = false;
+        for (const auto& f : folders) original |= f == L"c:/work/alpha"; // 마지막 기록 때의 원래 경로 (정규화 전)
+        CHECK(original);
+    }
+    {
+        CentralLogStore store; // 닫을 때 스냅샷 -> 로그를 다시 훑지 않음
+        CHECK(store.Open(dir));
+        CHECK(store.LastOpen().fromSnapshot && store.LastOpen().scannedBytes == 0);
+        std::string bytes;
+        CHECK(store.Read(L"c:\\work\\alpha", bytes) && bytes == "second");
+        CHECK(store.Write(L"E:\\Gamma", "gamma"));
+    }
+    fs::remove(dir / "store.idx");
+    {
+        CentralLogStore store; // 스냅샷 없음 -> 전체 훑기로 같은 결과
+        CHECK(store.Open(dir));
+        CHECK(!store.LastOpen().fromSnapshot && store.LastOpen().scannedBytes > 0);
+        CHECK(store.Count() == 3);
+        std::string bytes;
+        CHECK(store.Read(L"E:\\Gamma", bytes) && bytes == "gamma");
+    }
+}
+
+// 마지막 레코드가 반쯤 기록된 채 끝남 -> 그 앞까지 살리고 꼬리를 잘라냄, 이후 기록은 유효한 끝에 이어짐
+static void TestTornTail() {
+    fs::path dir = Dir("torn");
+    {
+        CentralLogStore store;
+        CHECK(store.Open(dir));
+        CHECK(store.Write(L"C:\\A", "alpha"));
+        CHECK(store.Write(L"C:\\B", "bravo"));
+    }
+    fs::remove(dir / "store.idx");
+    uint64_t valid = fs::file_size(dir / "store.log");
+    {
+        std::ofstream f(dir / "store.log", std::ios::binary | std::ios::app);
+        f.write("FMSR\x03\0\0\0garbage", 15); // 헤더도 다 못 쓴 레코드
+    }
+    {
+        CentralLogStore store;
+        CHECK(store.Open(dir));
+        CHECK(store.Count() == 2);
+        CHECK(fs::file_size(dir / "store.log") == valid);
+        CHECK(store.Write(L"C:\\C", "charlie"));
+    }
+    fs::remove(dir / "store.idx");
+    {
+        CentralLogStore store;
+        CHECK(store.Open(dir));
+        std::string bytes;
+        CHECK(store.Count() == 3);
+        CHECK(store.Read(L"C:\\C", bytes) && bytes == "charlie");
+        CHECK(store.Read(L"C:\\B", bytes) && bytes == "bravo");
+    }
+
+    // 내용 CRC가 깨진 레코드 -> 그 레코드부터 버림
+    fs::remove(dir / "store.idx");
+    {
+        std::fstream f(dir / "store.log", std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(-1, std::ios::end);
+        f.put('X'); // 마지막 레코드(charlie) 내용 끝 바이트
+    }
+    {
+        CentralLogStore store;
+        CHECK(store.Open(dir));
+        CHECK(store.Count() == 2);
+        CHECK(!store.Exists(L"C:\\C"));
+    }
+}
+
+// 같은 메모를 계속 덮어써 죽은 레코드가 COMPACT_MIN_DEAD_BYTES를 넘으면 압축 -> 세대 증가, 로그는 최신 것만
+static void TestCompaction() {
+    fs::path dir = Dir("compact");
+    CentralLogStore store;
+    CHECK(store.Open(dir));
+    CHECK(store.Write(L"C:\\Keep", "keep"));
+    std::string big(64 * 1024, 'a');
+    uint64_t gen = store.Generation();
+    size_t writes = 0;
+    while (store.Generation() == gen && writes < 200) {
+        big[0] = (char)('a' + writes % 26);
+        CHECK(store.Write(L"C:\\Hot", big));
+        writes++;
+    }
+    CHECK(store.Generation() == gen + 1);
+    CHECK(writes * big.size() > CentralLogStore::COMPACT_MIN_DEAD_BYTES);
+    CHECK(fs::file_size(dir / "store.log") < 2 * big.size());
+    std::string bytes;
+    CHECK(store.Read(L"C:\\Hot", bytes) && bytes == big);
+    CHECK(store.Read(L"C:\\Keep", bytes) && bytes == "keep");
+    CHECK(store.Write(L"C:\\After", "after")); // 교체된 로그에 이어 씀
+    store.Close();
+
+    CentralLogStore again;
+    CHECK(again.Open(dir));
+    CHECK(again.LastOpen().fromSnapshot);
+    CHECK(again.Generation() == gen + 1);
+    CHECK(again.Read(L"C:\\After", bytes) && bytes == "after");
+    CHECK(again.Read(L"C:\\Hot", bytes) && bytes == big);
+}
+
+// 헤더가 깨진 로그 -> store.log.bad로 치우고 새로 시작
+static void TestBadHeader() {
+    fs::path dir = Dir("bad");
+    { std::ofstream(dir / "store.log", std::ios::binary) << "not a memo store log"; }
+    CentralLogStore store;
+    CHECK(store.Open(dir));
+    CHECK(store.Count() == 0);
+    CHECK(fs::exists(dir / "store.log.bad"));
+    CHECK(store.Write(L"C:\\New", "new"));
+}
+
+static void RunBench(size_t memos) {
+    fs::path dir = Dir("bench");
+    std::string body(200, 'm'); // 짧은 메모 (한두 줄)
+    auto t0 = std::chrono::steady_clock::now();
+    {
+        CentralLogStore store;
+        store.Open(dir);
+        for (size_t i = 0; i < memos; i++) store.Write(FolderName(i), body);
+    }
+    std::printf("populate: %zu memos, %.0f ms (fsync per write)\n", memos, ElapsedMs(t0));
+
+    CentralLogStore store;
+    t0 = std::chrono::steady_clock::now();
+    store.Open(dir);
+    std::printf("startup from snapshot: %.1f ms (%zu memos)\n", ElapsedMs(t0), store.Count());
+    store.Close();
+
+    fs::remove(dir / "store.idx");
+    t0 = std::chrono::steady_clock::now();
+    store.Open(dir);
+    std::printf("startup with full log scan: %.1f ms (%zu memos)\n", ElapsedMs(t0), store.Count());
+
+    size_t hits = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < memos; i++) hits += store.Exists(FolderName(i));
+    std::printf("Exists: %.3f us (%zu hits)\n", ElapsedMs(t0) * 1000.0 / (double)memos, hits);
+
+    std::string bytes;
+    size_t read = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < memos; i++) read += store.Read(FolderName(i), bytes);
+    std::printf("Read: %.3f us (%zu reads)\n", ElapsedMs(t0) * 1000.0 / (double)memos, read);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((size_t)ArgInt(argc, argv, "--memos", 100000));
+        return 0;
+    }
+    TestBasics();
+    TestTornTail();
+    TestCompaction();
+    TestBadHeader();
+    return TestExit("central_store_test");
+}
\ No newline at end of file
@@ -0,0 +1,340 @@
+// [PRD 4.6] 외곽 비트맵 캐시 + 메모리 픽셀 장치: 캐시 경유 그리기 = 비트맵 없이 직접 그리기 = 예전 WM_PAINT (편집창 밖 픽셀 동일),
+//   키마다 한 번만 렌더, CHROME_CACHE_MAX 넘으면 가장 오래 안 쓴 것부터 반납, Clear는 비트맵/메모리 DC 모두 반납,
+//   무효화 영역은 상태 전환이면 전체, 아니면 제목줄 + 1px 테두리
+// --bench [--overlays N] [--events K]: 오버레이 N개에 이벤트 K개(경로 갱신/펼침·최소화/충돌/크기 변경/가려졌다 드러남)를 보낼 때
+//   예전(이벤트마다 InvalidateRect(NULL, TRUE) -> 배경 지우기 + 전체 즉시 그리기, 편집창 위 덧칠)과 지금(바뀐 영역만, 캐시 복사)의
+//   이벤트당 그리기 시간, 쓴 픽셀, 편집창 아래 덧칠(깜빡임) 픽셀. 픽셀 장치라 GDI 비용 자체가 아니라 그리는 양의 비교
+//   (Windows 실측은 추적의 Paint 단계 p50/p99와 종료 시 LogChromeStats)
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "core/chrome_cache.h"
+#include "tests/test_util.h"
+
+const int BTN = 25; // main.cpp의 BTN_SIZE
+const int MIN_SIZE = 50;
+const int OPEN_W = 400, OPEN_H = 600;
+
+// 픽셀 버퍼 (창 클라이언트 또는 캐시 비트맵)
+struct Canvas {
+    int w = 0, h = 0;
+    std::vector<uint32_t> px;
+    std::vector<ChromeRect> update; // 그리기 허용 영역 (비면 전체) = 무효화 영역
+    bool clipChild = false;         // WS_CLIPCHILDREN -> 편집창 영역 제외
+    ChromeRect child = { 0, 0, 0, 0 };
+    bool hasChild = false;
+    unsigned long long written = 0;   // 쓴 픽셀
+    unsigned long long overdrawn = 0; // 편집창 아래에 쓴 픽셀 (편집창이 다시 그릴 때까지 보임 -> 깜빡임)
+
+    Canvas(int width, int height) : w(width), h(height), px((size_t)width * height, 0xDEADBEEF) {}
+
+    static bool In(const ChromeRect& r, int x, int y) { return x >= r.left && x < r.right && y >= r.top && y < r.bottom; }
+    void Put(int x, int y, uint32_t color) {
+        if (x < 0 || y < 0 || x >= w || y >= h) return;
+        if (!update.empty()) {
+            bool inside = false;
+            for (const auto& r : update) inside = inside || In(r, x, y);
+            if (!inside) return;
+        }
+        bool underChild = hasChild && In(child, x, y);
+        if (underChild && clipChild) return;
+        px[(size_t)y * w + x] = color;
+        written++;
+        overdrawn += underChild;
+    }
+};
+typedef Canvas* FakeDc;
+
+// 그리기 명령을 픽셀로 (GDI와 같은 규칙: 오른쪽/아래 끝 제외, LineTo는 끝점 제외, Rectangle은 기본 흰 브러시)
+class PixelChromeDevice : public BasicChromeDevice<FakeDc, FakeDc> {
+public:
+    int liveBitmaps = 0;
+    int scratchReleases = 0;
+    bool failBitmaps = false;
+
+    static uint32_t Color(ChromeInk ink) {
+        switch (ink) {
+        case CHROME_INK_BORDER: return 0x646464;
+        case CHROME_INK_LINE: return 0xC8C8C8;
+        case CHROME_INK_CONFLICT: return 0x3246DC;
+        default: return 0xF3F3F3;
+        }
+    }
+    void Fill(FakeDc dc, const ChromeRect& rc, ChromeInk ink) override {
+        for (int y = rc.top; y < rc.bottom; y++) for (int x = rc.left; x < rc.right; x++) dc->Put(x, y, Color(ink));
+    }
+    void Frame(FakeDc dc, const ChromeRect& rc, ChromeInk ink) override {
+        Fill(dc, { rc.left, rc.top, rc.right, rc.top + 1 }, ink);
+        Fill(dc, { rc.left, rc.bottom - 1, rc.right, rc.bottom }, ink);
+        Fill(dc, { rc.left, rc.top, rc.left + 1, rc.bottom }, ink);
+        Fill(dc, { rc.right - 1, rc.top, rc.right, rc.bottom }, ink);
+    }
+    void Line(FakeDc dc, int x0, int y0, int x1, int y1) override {
+        int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1, dy = -std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1, err = dx + dy;
+        while (x0 != x1 || y0 != y1) {
+            dc->Put(x0, y0, 0);
+            int e2 = 2 * err;
+            if (e2 >= dy) { err += dy; x0 += sx; }
+            if (e2 <= dx) { err += dx; y0 += sy; }
+        }
+    }
+    void Box(FakeDc dc, const ChromeRect& rc) override {
+        for (int y = rc.top; y < rc.bottom; y++) {
+            for (int x = rc.left; x < rc.right; x++) {
+                bool edge = x == rc.left || y == rc.top || x == rc.right - 1 || y == rc.bottom - 1;
+                dc->Put(x, y, edge ? 0 : 0xFFFFFF);
+            }
+        }
+    }
+    void Icon(FakeDc dc, const ChromeRect& rc, bool memo) override {
+        // 32px 글꼴 글리프 대신: '+'는 굵기 3 십자, '▤'는 윤곽 + 가로줄 3개
+        int cx = (rc.left + rc.right) / 2, cy = (rc.top + rc.bottom) / 2;
+        if (!memo) {
+            for (int d = -10; d <= 10; d++) for (int t = -1; t <= 1; t++) { dc->Put(cx + d, cy + t, 0x323232); dc->Put(cx + t, cy + d, 0x323232); }
+            return;
+        }
+        for (int y = cy - 11; y <= cy + 11; y++) {
+            for (int x = cx - 11; x <= cx + 11; x++) {
+                bool edge = x == cx - 11 || x == cx + 11 || y == cy - 11 || y == cy + 11;
+                bool rule = (y == cy - 5 || y == cy || y == cy + 5);
+                if (edge || rule) dc->Put(x, y, 0x323232);
+            }
+        }
+    }
+    FakeDc CreateBitmap(FakeDc, int w, int h) override {
+        if (failBitmaps) return nullptr;
+        liveBitmaps++;
+        return new Canvas(w, h);
+    }
+    FakeDc BeginDraw(FakeDc bmp) override { return bmp; }
+    void EndDraw(FakeDc) override {}
+    void Blit(FakeDc dst, FakeDc src, int w, int h) override {
+        for (int y = 0; y < h && y < src->h; y++) for (int x = 0; x < w && x < src->w; x++) dst->Put(x, y, src->px[(size_t)y * src->w + x]);
+    }
+    void DestroyBitmap(FakeDc bmp) override {
+        liveBitmaps--;
+        delete bmp;
+    }
+    void ReleaseScratch() override { scratchReleases++; }
+};
+typedef BasicChromeCache<FakeDc, FakeDc> Cache;
+
+// 예전 WM_PAINT: 클라이언트 전체를 즉시 그림 (배경, 글리프, 전체 테두리, 구분선)
+static void OldPaint(PixelChromeDevice& dev, Canvas& c, const ChromeKey& key) {
+    ChromeRect rc = { 0, 0, c.w, c.h };
+    ChromeInk frame = key.conflict ? CHROME_INK_CONFLICT : CHROME_INK_BORDER;
+    dev.Fill(&c, rc, CHROME_INK_BG);
+    if (key.state != CHROME_OPEN) {
+        dev.Icon(&c, rc, key.state == CHROME_MIN_MEMO);
+        dev.Frame(&c, rc, frame);
+        return;
+    }
+    int right = c.w, expRight = right - BTN, minRight = expRight - BTN;
+    dev.Line(&c, right - BTN + 8, 8, right - 8, BTN - 8);
+    dev.Line(&c, right - 8, 8, right - BTN + 8, BTN - 8);
+    dev.Box(&c, { expRight - BTN + 8, 8, expRight - 8, BTN - 8 });
+    dev.Line(&c, minRight - BTN + 8, BTN - 8, minRight - 8, BTN - 8);
+    dev.Frame(&c, rc, frame);
+    dev.Fill(&c, { 0, BTN, c.w, BTN + 1 }, CHROME_INK_LINE);
+}
+
+static ChromeKey Key(int state, bool conflict, int w, int h) { return { state, conflict, w, state == CHROME_OPEN ? 0 : h }; }
+
+// 편집창 밖 픽셀만 비교 (편집창 영역은 편집창이 그림)
+static bool SameOutsideChild(const Canvas& a, const Canvas& b) {
+    if (a.w != b.w || a.h != b.h) return false;
+    for (int y = 0; y < a.h; y++) {
+        for (int x = 0; x < a.w; x++) {
+            if (a.hasChild && Canvas::In(a.child, x, y)) continue;
+            if (a.px[(size_t)y * a.w + x] != b.px[(size_t)y * b.w + x]) return false;
+        }
+    }
+    return true;
+}
+
+static void SetChild(Canvas& c, bool open) {
+    c.hasChild = open;
+    c.child = { 1, BTN + 1, c.w - 1, c.h - 1 }; // LayoutOverlayEditor
+}
+
+static void TestPixels() {
+    struct Case { int state; bool conflict; int w, h; } cases[] = {
+        { CHROME_MIN_EMPTY, false, MIN_SIZE, MIN_SIZE }, { CHROME_MIN_MEMO, false, MIN_SIZE, MIN_SIZE },
+        { CHROME_MIN_MEMO, true, MIN_SIZE, MIN_SIZE }, { CHROME_OPEN, false, OPEN_W, OPEN_H }, { CHROME_OPEN, true, 600, 900 },
+        { CHROME_OPEN, false, 120, 20 }, { CHROME_OPEN, false, 120, BTN + 1 }, // 제목줄보다 낮은 창
+    };
+    for (const auto& k : cases) {
+        ChromeKey key = Key(k.state, k.conflict, k.w, k.h);
+        bool open = k.state == CHROME_OPEN;
+        PixelChromeDevice dev;
+        Cache cache(&dev, BTN);
+        Canvas cached(k.w, k.h), again(k.w, k.h), direct(k.w, k.h), old(k.w, k.h);
+        SetChild(cached, open); SetChild(again, open); SetChild(direct, open); SetChild(old, open);
+        cached.clipChild = again.clipChild = direct.clipChild = true;
+        cache.Paint(&cached, key, k.w, k.h);
+        cache.Paint(&again, key, k.w, k.h); // 두 번째는 비트맵 복사
+        CHECK(cache.Renders() == 1 && cache.Paints() == 2 && cache.Bitmaps() == 1 && dev.liveBitmaps == 1);
+
+        PixelChromeDevice noBitmaps;
+        noBitmaps.failBitmaps = true;
+        Cache fallback(&noBitmaps, BTN);
+        fallback.Paint(&direct, key, k.w, k.h);
+        CHECK(fallback.Bitmaps() == 0 && fallback.Renders() == 0);
+
+        OldPaint(dev, old, key);
+        CHECK(SameOutsideChild(cached, again));
+        CHECK(SameOutsideChild(cached, direct));
+        CHECK(SameOutsideChild(cached, old)); // 보이는 결과는 예전 그대로
+        if (open && k.h > BTN + 2) CHECK(cached.overdrawn == 0 && old.overdrawn > 0);
+    }
+}
+
+static void TestCache() {
+    PixelChromeDevice dev;
+    {
+        Cache cache(&dev, BTN);
+        Canvas c(OPEN_W, OPEN_H);
+        // 크기(DPI)마다 항목 -> CHROME_CACHE_MAX 넘으면 가장 오래 안 쓴 것부터
+        for (int i = 0; i < (int)CHROME_CACHE_MAX; i++) cache.Paint(&c, Key(CHROME_OPEN, false, 300 + i, 0), 300 + i, 400);
+        CHECK(cache.Bitmaps() == CHROME_CACHE_MAX && cache.Renders() == CHROME_CACHE_MAX);
+        cache.Paint(&c, Key(CHROME_OPEN, false, 300, 0), 300, 500); // 첫 항목 사용 (펼침은 높이가 키에 없음)
+        CHECK(cache.Renders() == CHROME_CACHE_MAX);
+        cache.Paint(&c, Key(CHROME_MIN_MEMO, false, MIN_SIZE, MIN_SIZE), MIN_SIZE, MIN_SIZE);
+        CHECK(cache.Bitmaps() == CHROME_CACHE_MAX && dev.liveBitmaps == (int)CHROME_CACHE_MAX);
+        cache.Paint(&c, Key(CHROME_OPEN, false, 300, 0), 300, 400);
+        cache.Paint(&c, Key(CHROME_OPEN, false, 301, 0), 301, 400); // 가장 오래 안 쓴 것이었음 -> 다시 렌더
+        CHECK(cache.Renders() == CHROME_CACHE_MAX + 2);
+
+        // 크기 0은 비트맵 없이
+        cache.Paint(&c, Key(CHROME_OPEN, false, 0, 0), 0, 0);
+        CHECK(cache.Renders() == CHROME_CACHE_MAX + 2);
+
+        cache.Clear();
+        CHECK(cache.Bitmaps() == 0 && dev.liveBitmaps == 0 && dev.scratchReleases == 1);
+        cache.Paint(&c, Key(CHROME_OPEN, false, 300, 0), 300, 400);
+        CHECK(dev.liveBitmaps == 1);
+    }
+    CHECK(dev.liveBitmaps == 0); // 소멸자도 반납
+
+    std::vector<ChromeRect> dirty;
+    ChromeDirtyRects(OPEN_W, OPEN_H, BTN, true, dirty);
+    CHECK(dirty.size() == 1 && dirty[0].right == OPEN_W && dirty[0].bottom == OPEN_H);
+    ChromeDirtyRects(OPEN_W, OPEN_H, BTN, false, dirty);
+    CHECK(dirty.size() == 4 && dirty[0].bottom == BTN + 1);
+    ChromeDirtyRects(MIN_SIZE, 10, BTN, false, dirty);
+    CHECK(dirty[0].bottom == 10);
+}
+
+// 오버레이 하나의 상태
+struct Overlay {
+    bool open = false;
+    bool memo = false;
+    bool conflict = false;
+    int w = MIN_SIZE, h = MIN_SIZE;
+    ChromeKey Key() const { return ::Key(open ? CHROME_OPEN : (memo ? CHROME_MIN_MEMO : CHROME_MIN_EMPTY), conflict, w, h); }
+};
+
+struct PaintTotals {
+    double ms = 0;
+    unsigned long long paints = 0, written = 0, overdrawn = 0;
+};
+
+static void RunBench(int overlays, int events) {
+    enum { PATH, TOGGLE, CONFLICT, RESIZE, UNCOVER };
+    struct Event { int overlay; int kind; bool memo; int w, h; };
+    std::mt19937 rng(21);
+    std::vector<Event> list;
+    int counts[5] = { 0, 0, 0, 0, 0 };
+    for (int i = 0; i < events; i++) {
+        int r = rng() % 100;
+        int kind = r < 70 ? PATH : r < 80 ? TOGGLE : r < 82 ? CONFLICT : r < 87 ? RESIZE : UNCOVER;
+        counts[kind]++;
+        bool memo = rng() % 100 < 25;
+        bool big = rng() % 2;
+        list.push_back({ (int)(rng() % overlays), kind, memo, big ? 600 : OPEN_W, big ? 900 : OPEN_H });
+    }
+
+    // 같은 이벤트를 두 방식에: 상태 변화는 같고, 무엇을 무효화하고 어떻게 그리는지만 다름
+    PaintTotals before, after;
+    for (int pass = 0; pass < 2; pass++) {
+        bool now = pass == 1;
+        PaintTotals& t = now ? after : before;
+        PixelChromeDevice dev;
+        Cache cache(&dev, BTN);
+        std::vector<Overlay> ov(overlays);
+        std::vector<ChromeRect> dirty;
+        for (const Event& e : list) {
+            Overlay& o = ov[e.overlay];
+            if (e.kind == RESIZE && !o.open) continue; // 확대 버튼은 펼친 오버레이에만
+            ChromeKey oldKey = o.Key();
+            switch (e.kind) {
+            case PATH: o.memo = e.memo; o.open = e.memo; o.conflict = false; break; // ApplyPathResult: 메모 없으면 최소화
+            case TOGGLE: o.open = !o.open; break;
+            case CONFLICT: o.conflict = !o.conflict; break;
+            case RESIZE: o.w = e.w; o.h = e.h; break;
+            default: break;
+            }
+            if (o.open && o.w == MIN_SIZE) { o.w = OPEN_W; o.h = OPEN_H; }
+            if (!o.open) { o.w = o.h = MIN_SIZE; }
+            ChromeKey newKey = o.Key();
+
+            // 무효화할 영역 (비면 그리지 않음)
+            bool paint = true, erase = false;
+            dirty.clear();
+            if (!now) {
+                // 예전: 모든 경로 갱신/상태 전환/크기 변경이 InvalidateRect(NULL, TRUE)
+                erase = e.kind != UNCOVER && e.kind != CONFLICT;
+                ChromeDirtyRects(o.w, o.h, BTN, true, dirty);
+            } else if (e.kind == UNCOVER || newKey.state != oldKey.state) {
+                ChromeDirtyRects(o.w, o.h, BTN, true, dirty);
+            } else if (newKey.conflict != oldKey.conflict) {
+                ChromeDirtyRects(o.w, o.h, BTN, !o.open, dirty);
+            } else if (e.kind == RESIZE) {
+                ChromeDirtyRects(o.w, o.h, BTN, false, dirty);
+            } else {
+                paint = false; // 경로만 바뀜 -> 외곽 그대로
+            }
+            if (!paint) continue;
+
+            Canvas c(o.w, o.h);
+            c.update = dirty;
+            c.clipChild = now;
+            SetChild(c, o.open);
+            auto t0 = std::chrono::steady_clock::now();
+            if (erase) dev.Fill(&c, { 0, 0, o.w, o.h }, CHROME_INK_BG); // WM_ERASEBKGND (클래스 배경 브러시)
+            if (now) cache.Paint(&c, newKey, o.w, o.h);
+            else OldPaint(dev, c, newKey);
+            t.ms += ElapsedMs(t0);
+            t.paints++;
+            t.written += c.written;
+            t.overdrawn += c.overdrawn;
+        }
+        if (now) std::printf("chrome cache: %llu renders, %zu bitmaps, avg paint %.1f us (cache's own timer)\n", cache.Renders(), cache.Bitmaps(),
+            cache.Paints() ? cache.PaintNs() / 1000.0 / cache.Paints() : 0.0);
+    }
+
+    std::printf("overlay chrome: %d overlays, %d events (%d path updates, %d expand/minimize, %d conflict flips, %d resizes, %d uncovers)\n",
+        overlays, events, counts[PATH], counts[TOGGLE], counts[CONFLICT], counts[RESIZE], counts[UNCOVER]);
+    const PaintTotals* rows[] = { &before, &after };
+    const char* labels[] = { "before (invalidate all + erase, immediate draw)", "after (dirty region, cached blit, clip children)" };
+    for (int i = 0; i < 2; i++) {
+        const PaintTotals& t = *rows[i];
+        std::printf("%s: %llu paints, %.2f ms total, %.1f us/event, %.1f K pixels/event written, %.1f K pixels/event drawn under the editor\n",
+            labels[i], t.paints, t.ms, t.ms * 1000 / events, t.written / 1000.0 / events, t.overdrawn / 1000.0 / events);
+    }
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--overlays", 20), (int)ArgInt(argc, argv, "--events", 5000));
+        return TestExit("chrome_cache_bench");
+    }
+    TestPixels();
+    TestCache();
+    return TestExit("chrome_cache_test");
+}
\ No newline at end of file
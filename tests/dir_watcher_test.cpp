@@ -0,0 +1,136 @@
+// [PRD 3.3] inotify 감시 백엔드: 메모 파일 변경만 알림, 폴더당 감시 하나, LRU 해제(고정 제외), 감시 불가 폴더, 폴더 삭제
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/dir_watcher.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+// 알림 기록 -> 특정 폴더 알림을 시한까지 기다림
+class ChangeLog {
+public:
+    void Add(const std::wstring& path) {
+        { std::lock_guard<std::mutex> lock(m_mutex); m_paths.push_back(path); }
+        m_cv.notify_all();
+    }
+    bool WaitFor(const std::wstring& path, int ms) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_cv.wait_for(lock, std::chrono::milliseconds(ms), [&] { return CountLocked(path) > 0; });
+    }
+    size_t Count(const std::wstring& path) { std::lock_guard<std::mutex> lock(m_mutex); return CountLocked(path); }
+    void Clear() { std::lock_guard<std::mutex> lock(m_mutex); m_paths.clear(); }
+
+private:
+    size_t CountLocked(const std::wstring& path) {
+        size_t n = 0;
+        for (const auto& p : m_paths) n += p == path;
+        return n;
+    }
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<std::wstring> m_paths;
+};
+
+static fs::path Root() {
+    fs::path root = fs::temp_directory_path() / "FolderMemoWatchTest";
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root, ec);
+    return root;
+}
+
+static void Touch(const fs::path& p, const char* text) { std::ofstream(p, std::ios::binary) << text; }
+
+static void TestNotifications(const fs::path& root) {
+    ChangeLog log;
+    InotifyDirectoryWatcher watcher([&log](const std::wstring& p) { log.Add(p); });
+    watcher.Start();
+    fs::path dir = root / "notify";
+    fs::create_directories(dir);
+    std::wstring folder = dir.wstring();
+
+    CHECK(watcher.Watch(folder));
+    CHECK(watcher.Watch(folder)); // 같은 폴더 -> 감시 공유
+    CHECK(watcher.Watching() == 1);
+    CHECK(watcher.IsWatching(folder));
+
+    Touch(dir / "other.txt", "x"); // 메모가 아닌 파일 -> 알림 없음
+    Touch(dir / "folder_memo.txt", "hello");
+    CHECK(log.WaitFor(folder, 2000));
+    size_t afterMemo = log.Count(folder);
+    CHECK(afterMemo >= 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 같은 기록의 나머지 이벤트(닫기 등)가 도착하도록
+    log.Clear();
+    Touch(dir / "unrelated.log", "y");
+    fs::rename(dir / "unrelated.log", dir / "unrelated2.log");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(log.Count(folder) == 0);
+
+    // 저널/임시 파일 이름 변경(원자적 교체)도 folder_memo.* -> 알림
+    Touch(dir / "folder_memo.txt.tmp", "replaced");
+    CHECK(log.WaitFor(folder, 2000));
+    log.Clear();
+    fs::rename(dir / "folder_memo.txt.tmp", dir / "folder_memo.txt");
+    CHECK(log.WaitFor(folder, 2000));
+
+    // 폴더 삭제 -> 감시 풀림 + 알림
+    log.Clear();
+    fs::remove_all(dir);
+    CHECK(log.WaitFor(folder, 2000));
+    for (int i = 0; i < 100 && watcher.IsWatching(folder); i++) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(!watcher.IsWatching(folder));
+
+    // 없는 폴더 -> 감시 불가 (호출자는 TTL로)
+    CHECK(!watcher.Watch((root / "missing").wstring()));
+    CHECK(watcher.Unwatchable() == 1);
+    watcher.Stop();
+    CHECK(!watcher.Watch(folder)); // 종료 후에는 감시 안 함
+}
+
+static void TestEviction(const fs::path& root) {
+    ChangeLog log;
+    InotifyDirectoryWatcher watcher([&log](const std::wstring& p) { log.Add(p); });
+    watcher.Start();
+    std::vector<std::wstring> folders;
+    for (size_t i = 0; i <= InotifyDirectoryWatcher::MAX_WATCHES + 1; i++) {
+        fs::path dir = root / "evict" / std::to_string(i);
+        fs::create_directories(dir);
+        folders.push_back(dir.wstring());
+    }
+    watcher.Pin(folders[0]); // 가장 오래됐지만 고정
+    for (size_t i = 0; i < InotifyDirectoryWatcher::MAX_WATCHES; i++) CHECK(watcher.Watch(folders[i]));
+    CHECK(watcher.Watching() == InotifyDirectoryWatcher::MAX_WATCHES);
+
+    CHECK(watcher.Watch(folders[InotifyDirectoryWatcher::MAX_WATCHES])); // 한도 초과 -> 고정 안 된 가장 오래된 것(1번) 해제
+    CHECK(watcher.Watching() == InotifyDirectoryWatcher::MAX_WATCHES);
+    CHECK(watcher.IsWatching(folders[0]));
+    CHECK(!watcher.IsWatching(folders[1]));
+    CHECK(log.Count(folders[1]) == 1); // 해제된 폴더는 캐시 무효화용으로 알림
+
+    CHECK(watcher.Watch(folders[2])); // 재사용 -> 최근으로
+    CHECK(watcher.Watch(folders[InotifyDirectoryWatcher::MAX_WATCHES + 1]));
+    CHECK(watcher.IsWatching(folders[2]));
+    CHECK(!watcher.IsWatching(folders[3]));
+
+    // 해제된 폴더의 변경은 더 이상 알리지 않음
+    log.Clear();
+    Touch(fs::path(folders[1]) / "folder_memo.txt", "late");
+    Touch(fs::path(folders[0]) / "folder_memo.txt", "pinned");
+    CHECK(log.WaitFor(folders[0], 2000));
+    CHECK(log.Count(folders[1]) == 0);
+}
+
+int main() {
+    fs::path root = Root();
+    TestNotifications(root);
+    TestEviction(root);
+    return TestExit("dir_watcher_test");
+}
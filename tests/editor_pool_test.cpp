@@ -0,0 +1,300 @@
+// [PRD 4.5] 편집창 풀 + 가짜 호스트: 빈 풀은 생성, 반납은 글꼴 반납/숨김/편집창 ID 해제 뒤 비우기, 만든 오버레이만 재사용,
+//   EDITOR_POOL_MAX 넘는 예비와 큰 내용을 담았던 편집창은 파괴, 오버레이와 함께 파괴되면 글꼴만 반납(예비 포함), 생성 실패는 세지 않음.
+//   알림은 EDIT처럼 만든 오버레이로 -> 반납/재사용으로 빈 메모나 다른 폴더 저장이 생기지 않는지 (main.cpp의 EN_CHANGE 처리 모형)
+// --bench [--overlays N] [--navs K] [--memo-pct P]: 오버레이 N개가 폴더 이동 K번(메모 있는 폴더 P%, 가끔 사용자가 펼침/최소화)을
+//   할 때 살아 있는 편집창(USER 객체)과 편집 버퍼 크기, 최소화 오버레이가 들고 있는 글자 수 -> 예전(WM_CREATE마다 EDIT)과 비교.
+//   편집 버퍼는 EDIT처럼 담았던 최대 크기에서 줄지 않는 것으로 셈 (Windows 실측은 LogOverlayResources 로그)
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/editor_pool.h"
+#include "tests/test_util.h"
+
+typedef int FakeHwnd; // 0 = NULL
+
+// 편집창 = 번호. 만든 오버레이(바뀌지 않음, 알림 대상), 편집창 ID 여부, 표시, 글꼴 참조, 내용과 버퍼 크기를 기록
+class FakeEditorHost : public BasicEditorHost<FakeHwnd> {
+public:
+    struct Editor {
+        FakeHwnd owner = 0;
+        bool attached = true; // IDC_MEMO_EDIT (아니면 예비 ID)
+        bool visible = false;
+        bool font = false;
+        std::wstring text;
+        size_t capacity = 0; // 담았던 최대 글자 수 (EDIT 버퍼는 줄지 않음)
+    };
+    std::map<FakeHwnd, Editor> live;
+    bool failNext = false;
+    std::function<void(FakeHwnd hOverlay, FakeHwnd hEdit)> onChange; // EN_CHANGE -> 만든 오버레이
+
+    FakeHwnd CreateEditor(FakeHwnd hOverlay) override {
+        if (failNext) { failNext = false; return 0; }
+        live[m_next].owner = hOverlay;
+        return m_next++;
+    }
+    void AdoptEditor(FakeHwnd hEdit) override {
+        CHECK(live.count(hEdit) && !live[hEdit].attached);
+        live[hEdit].attached = true;
+    }
+    void DetachEditor(FakeHwnd hEdit) override {
+        live[hEdit].font = false;
+        live[hEdit].visible = false;
+    }
+    void ForgetEditor(FakeHwnd hEdit) override { live[hEdit].font = false; }
+    size_t EditorTextLength(FakeHwnd hEdit) override { return live[hEdit].text.size(); }
+    void ParkEditor(FakeHwnd hEdit) override {
+        live[hEdit].attached = false;
+        SetText(hEdit, L"");
+    }
+    void DestroyEditor(FakeHwnd hEdit) override {
+        CHECK(live.erase(hEdit) == 1); // 두 번 파괴/모르는 핸들 없음
+    }
+
+    // SetWindowTextW/입력: 내용이 바뀌면 만든 오버레이로 알림
+    void SetText(FakeHwnd hEdit, const std::wstring& text) {
+        Editor& e = live[hEdit];
+        bool changed = e.text != text;
+        e.text = text;
+        e.capacity = std::max(e.capacity, text.size());
+        if (changed && onChange) onChange(e.owner, hEdit);
+    }
+    // GetDlgItem(hOverlay, IDC_MEMO_EDIT)
+    FakeHwnd AttachedTo(FakeHwnd hOverlay) const {
+        for (const auto& kv : live) if (kv.second.owner == hOverlay && kv.second.attached) return kv.first;
+        return 0;
+    }
+
+    // 오버레이 쪽 동작 (main.cpp의 AttachOverlayEditor/FillOverlayEditor 자리)
+    void Show(FakeHwnd hEdit, const std::wstring& text) {
+        Editor& e = live[hEdit];
+        e.visible = e.font = true;
+        e.text = text;
+        e.capacity = std::max(e.capacity, text.size());
+    }
+    size_t BufferChars() const {
+        size_t n = 0;
+        for (const auto& kv : live) n += kv.second.capacity;
+        return n;
+    }
+
+private:
+    FakeHwnd m_next = 1;
+};
+typedef BasicEditorPool<FakeHwnd> Pool;
+
+static void TestPool() {
+    FakeEditorHost host;
+    Pool pool(&host);
+    FakeHwnd a = pool.Acquire(100);
+    CHECK(a && host.live[a].owner == 100 && !host.live[a].visible);
+    CHECK(pool.Created() == 1 && pool.Attached() == 1 && pool.Spare() == 0);
+    host.Show(a, L"memo");
+
+    // 반납 -> 숨김, 글꼴 반납, 편집창 ID 해제 후 비움 (부모는 그대로)
+    pool.Release(100, a);
+    CHECK(host.live.count(a) && host.live[a].owner == 100 && !host.live[a].attached && host.live[a].text.empty());
+    CHECK(!host.live[a].visible && !host.live[a].font && host.AttachedTo(100) == 0);
+    CHECK(pool.Attached() == 0 && pool.Spare() == 1);
+
+    // 다른 오버레이는 남의 예비를 쓰지 않음 -> 새로 생성
+    FakeHwnd b = pool.Acquire(200);
+    CHECK(b != a && host.live[b].owner == 200 && pool.Reused() == 0 && pool.Created() == 2 && pool.Spare() == 1);
+
+    // 만든 오버레이가 다시 펼치면 같은 핸들 재사용
+    FakeHwnd a2 = pool.Acquire(100);
+    CHECK(a2 == a && host.AttachedTo(100) == a && pool.Reused() == 1 && pool.Spare() == 0);
+
+    // 큰 내용을 담았던 편집창은 파괴
+    host.Show(b, std::wstring(EDITOR_POOL_MAX_CHARS + 1, L'x'));
+    pool.Release(200, b);
+    CHECK(!host.live.count(b) && pool.Destroyed() == 1 && pool.Spare() == 0);
+    pool.Release(100, a2);
+
+    // 예비는 전체 EDITOR_POOL_MAX개까지
+    std::vector<FakeHwnd> editors;
+    for (size_t i = 0; i < EDITOR_POOL_MAX + 2; i++) editors.push_back(pool.Acquire(300 + (FakeHwnd)i));
+    CHECK(pool.Attached() == EDITOR_POOL_MAX + 2 && pool.Spare() == 1);
+    for (size_t i = 0; i < editors.size(); i++) pool.Release(300 + (FakeHwnd)i, editors[i]);
+    CHECK(pool.Spare() == EDITOR_POOL_MAX && pool.Destroyed() == 4 && host.live.size() == EDITOR_POOL_MAX);
+
+    // 오버레이와 함께 파괴 -> 붙은 편집창은 글꼴만 반납, 예비도 기록에서 뺌 (파괴는 OS 몫)
+    FakeHwnd c = pool.Acquire(100);
+    CHECK(c == a && pool.Spare() == EDITOR_POOL_MAX - 1);
+    host.Show(c, L"x");
+    pool.Forget(100, c);
+    CHECK(!host.live[c].font && pool.Attached() == 0 && pool.Spare() == EDITOR_POOL_MAX - 1);
+    host.live.erase(c);
+    pool.Forget(300, 0); // 최소화 상태로 닫힘 -> 예비만
+    CHECK(pool.Spare() == EDITOR_POOL_MAX - 2);
+    host.live.erase(editors[0]);
+
+    // NULL은 무시, 생성 실패는 세지 않음
+    pool.Release(500, 0);
+    pool.Forget(500, 0);
+    CHECK(pool.Attached() == 0);
+    pool.Clear();
+    CHECK(host.live.empty() && pool.Spare() == 0);
+    host.failNext = true;
+    unsigned long long created = pool.Created();
+    CHECK(pool.Acquire(500) == 0 && pool.Created() == created && pool.Attached() == 0);
+}
+
+// main.cpp의 EN_CHANGE 처리와 같은 모형: 붙어 있는 편집창의 알림만, settingText면 저장 안 함 -> (오버레이 폴더, 내용) 저장 기록
+struct FakeOverlay {
+    std::wstring path;
+    bool settingText = false;
+};
+
+static void TestNotifications() {
+    FakeEditorHost host;
+    Pool pool(&host);
+    std::map<FakeHwnd, FakeOverlay> overlays;
+    std::vector<std::pair<std::wstring, std::wstring>> saves;
+    host.onChange = [&](FakeHwnd hOverlay, FakeHwnd hEdit) {
+        FakeOverlay& o = overlays[hOverlay];
+        if (hEdit != host.AttachedTo(hOverlay) || o.settingText || o.path.empty()) return;
+        saves.emplace_back(o.path, host.live[hEdit].text);
+    };
+    // main.cpp의 DetachOverlayEditor
+    auto detach = [&](FakeHwnd hOverlay) {
+        overlays[hOverlay].settingText = true;
+        pool.Release(hOverlay, host.AttachedTo(hOverlay));
+        overlays[hOverlay].settingText = false;
+    };
+
+    overlays[100].path = L"C:\\a";
+    overlays[200].path = L"C:\\b";
+    FakeHwnd a = pool.Acquire(100);
+    host.SetText(a, L"memo a");
+    CHECK(saves.size() == 1 && saves[0].first == L"C:\\a");
+
+    // 최소화 -> 비우기 알림이 와도 빈 메모를 저장하지 않음
+    detach(100);
+    CHECK(saves.size() == 1);
+    // settingText 없이도 예비 ID라 무시 (편집창 조회 필터만으로 안전)
+    FakeHwnd spare = a;
+    host.SetText(spare, L"stray");
+    CHECK(saves.size() == 1);
+
+    // 메모 없는 폴더로 이동: 경로가 먼저 바뀐 뒤 반납해도 새 폴더에 빈 메모가 생기지 않음
+    FakeHwnd b = pool.Acquire(200);
+    host.SetText(b, L"memo b");
+    overlays[200].path = L"C:\\empty";
+    detach(200);
+    CHECK(saves.size() == 2 && saves[1].first == L"C:\\b");
+
+    // 다른 오버레이가 펼쳐도 100의 예비를 받지 않음 -> 입력은 자기 폴더로
+    overlays[300].path = L"C:\\c";
+    FakeHwnd c = pool.Acquire(300);
+    CHECK(c != a && c != b);
+    host.SetText(c, L"memo c");
+    CHECK(saves.size() == 3 && saves[2].first == L"C:\\c" && saves[2].second == L"memo c");
+
+    // 100이 다시 펼치면 자기 예비 -> 자기 폴더로
+    FakeHwnd a2 = pool.Acquire(100);
+    CHECK(a2 == a);
+    host.SetText(a2, L"memo a2");
+    CHECK(saves.size() == 4 && saves[3].first == L"C:\\a");
+    for (const auto& s : saves) CHECK(!s.second.empty());
+}
+
+// 메모 크기: 대부분 몇 KB, 가끔 큰 로그
+static size_t MemoChars(std::mt19937& rng) {
+    if (rng() % 100 < 5) return 50 * 1024 + rng() % (150 * 1024);
+    return 500 + rng() % (8 * 1024);
+}
+
+struct Snapshot {
+    size_t editors = 0;
+    size_t bufferChars = 0;
+    size_t minimizedChars = 0; // 최소화 오버레이에 남아 있는 글자
+};
+
+static void Print(const char* label, const Snapshot& end, const Snapshot& peak, int overlays) {
+    std::printf("%s: end %zu editors (%.2f/overlay), %.1f KB edit buffers (%.1f KB/overlay), %.1f KB text held by minimized overlays; "
+        "peak %zu editors, %.1f KB buffers\n",
+        label, end.editors, (double)end.editors / overlays, end.bufferChars * 2 / 1024.0, end.bufferChars * 2 / 1024.0 / overlays,
+        end.minimizedChars * 2 / 1024.0, peak.editors, peak.bufferChars * 2 / 1024.0);
+}
+
+static void RunBench(int overlays, int navs, int memoPct) {
+    // 같은 이동/펼침 순서를 두 방식에 적용
+    struct Step { int overlay; int kind; size_t chars; }; // kind 0 = 이동, 1 = 사용자가 펼침, 2 = 사용자가 최소화
+    std::mt19937 rng(11);
+    std::vector<Step> steps;
+    for (int i = 0; i < navs; i++) {
+        int r = rng() % 100;
+        int kind = r < 85 ? 0 : (r < 93 ? 1 : 2);
+        size_t chars = (kind == 0 && (int)(rng() % 100) < memoPct) ? MemoChars(rng) : 0;
+        steps.push_back({ (int)(rng() % overlays), kind, chars });
+    }
+
+    // 예전: 오버레이마다 WM_CREATE에서 EDIT, 최소화해도 편집창/내용 유지
+    Snapshot beforeEnd, beforePeak;
+    {
+        FakeEditorHost host;
+        std::vector<FakeHwnd> edit(overlays);
+        std::vector<bool> minimized(overlays, true);
+        for (int o = 0; o < overlays; o++) edit[o] = host.CreateEditor(1000 + o);
+        for (const Step& s : steps) {
+            if (s.kind == 0) {
+                host.Show(edit[s.overlay], std::wstring(s.chars, L'x'));
+                minimized[s.overlay] = s.chars == 0;
+            } else {
+                minimized[s.overlay] = s.kind == 2;
+            }
+            beforePeak.editors = std::max(beforePeak.editors, host.live.size());
+            beforePeak.bufferChars = std::max(beforePeak.bufferChars, host.BufferChars());
+        }
+        beforeEnd.editors = host.live.size();
+        beforeEnd.bufferChars = host.BufferChars();
+        for (int o = 0; o < overlays; o++) if (minimized[o]) beforeEnd.minimizedChars += host.live[edit[o]].text.size();
+    }
+
+    // 지금: 펼칠 때만 풀에서 부착, 최소화/메모 없는 폴더면 반납
+    Snapshot afterEnd, afterPeak;
+    FakeEditorHost host;
+    Pool pool(&host);
+    std::vector<FakeHwnd> edit(overlays, 0);
+    std::vector<size_t> folderChars(overlays, 0); // 지금 폴더의 메모 (다시 펼치면 저장 큐/디스크에서 다시 채움)
+    for (const Step& s : steps) {
+        if (s.kind == 0) folderChars[s.overlay] = s.chars;
+        bool expand = s.kind == 1 || (s.kind == 0 && s.chars > 0);
+        FakeHwnd& e = edit[s.overlay];
+        if (expand) {
+            if (!e) e = pool.Acquire(1000 + s.overlay);
+            host.Show(e, std::wstring(folderChars[s.overlay], L'x'));
+        } else if (e) {
+            pool.Release(1000 + s.overlay, e);
+            e = 0;
+        }
+        afterPeak.editors = std::max(afterPeak.editors, host.live.size());
+        afterPeak.bufferChars = std::max(afterPeak.bufferChars, host.BufferChars());
+    }
+    afterEnd.editors = host.live.size();
+    afterEnd.bufferChars = host.BufferChars();
+    CHECK(pool.Attached() + pool.Spare() == host.live.size());
+
+    std::printf("editor pool: %d overlays, %d navigations (%d%% to folders with a memo, 5%% of memos 50-200 KB), user expand/minimize mixed in\n",
+        overlays, navs, memoPct);
+    Print("before (EDIT per overlay)", beforeEnd, beforePeak, overlays);
+    Print("after (pool, attach on expand)", afterEnd, afterPeak, overlays);
+    std::printf("pool: %zu attached, %zu spare, %llu created, %llu reused, %llu destroyed\n", pool.Attached(), pool.Spare(),
+        pool.Created(), pool.Reused(), pool.Destroyed());
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--overlays", 60), (int)ArgInt(argc, argv, "--navs", 5000), (int)ArgInt(argc, argv, "--memo-pct", 25));
+        return TestExit("editor_pool_bench");
+    }
+    TestPool();
+    TestNotifications();
+    return TestExit("editor_pool_test");
+}
\ No newline at end of file
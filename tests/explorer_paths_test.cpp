@@ -0,0 +1,185 @@
+// [PRD 3.1.5] 탐색기 경로 해석기 + 가짜 Shell: 캐시 적중(호출 0회), 바뀐 창만 재조회, 새 탭 -> 재나열, 활성 탭 선택,
+//   일괄 해석(나열 1회), 탭 토큰 참조 계수 (Forget/Shutdown 뒤 남는 토큰 없음)
+// --bench [--windows N] [--tabs T] [--navs K] [--call-us U]: 탐색 K번 해석 지연/Shell 왕복 수.
+//   예전 = 탐색마다 전체 나열 + 일치할 때까지 탭 읽기 (GetExplorerPath), 지금 = 해석기. 호출마다 U µs (프로세스 간 COM 왕복)
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/explorer_paths.h"
+#include "tests/fake_shell.h"
+#include "tests/test_util.h"
+
+typedef BasicExplorerPathResolver<FakeHwnd> Resolver;
+
+static std::wstring Folder(int i) { return L"C:\\Work\\Folder" + std::to_wstring(i); }
+static std::wstring Title(int i) { return L"Folder" + std::to_wstring(i); }
+
+static void TestCacheAndDirty() {
+    FakeShell shell;
+    int tabA = shell.AddTab(1, Folder(1));
+    shell.AddTab(2, Folder(2));
+    Resolver resolver(&shell);
+
+    CHECK(resolver.Resolve(1, Title(1)) == Folder(1));
+    CHECK(shell.ListCalls() == 1); // 처음 보는 창 -> 전체 나열 1회
+    CHECK(resolver.Resolve(1, Title(1)) == Folder(1));
+    CHECK(resolver.Resolve(2, Title(2)) == Folder(2)); // 나열 때 창 2의 탭도 캐시됨
+    CHECK(resolver.Hits() == 1);
+    CHECK(shell.ListCalls() == 1);
+
+    // 창 1 이동 -> 창 1의 탭만 다시 읽음 (나열 없음)
+    unsigned long long calls = shell.Calls();
+    shell.Navigate(tabA, Folder(11));
+    resolver.MarkDirty(1);
+    CHECK(resolver.Resolve(1, Title(11)) == Folder(11));
+    CHECK(shell.ListCalls() == 1 && shell.Calls() == calls + 1);
+
+    // Dirty 표시가 없어도 제목이 바뀌면 재조회
+    shell.Navigate(tabA, Folder(12));
+    CHECK(resolver.Resolve(1, Title(12)) == Folder(12));
+    CHECK(resolver.Resolve(2, Title(2)) == Folder(2));
+
+    // 해석 실패(셸이 아직 모름)는 캐시하지 않음
+    CHECK(resolver.Resolve(3, Title(3)).empty());
+    shell.AddTab(3, Folder(3));
+    CHECK(resolver.Resolve(3, Title(3)) == Folder(3));
+    resolver.Shutdown();
+    CHECK(shell.HeldRefs() == 0 && shell.Disconnects() == 1);
+}
+
+// 한 창의 탭 여러 개: 제목과 이름이 맞는 탭 = 활성 탭. 캐시에 없는 새 탭으로 전환 -> 재나열
+static void TestTabs() {
+    FakeShell shell;
+    shell.AddTab(7, Folder(1));
+    shell.AddTab(7, Folder(2));
+    Resolver resolver(&shell);
+    CHECK(resolver.Resolve(7, Title(2) + L" - File Explorer") == Folder(2));
+    CHECK(resolver.Resolve(7, Title(1)) == Folder(1)); // 같은 창의 다른 탭 -> 캐시된 토큰만 읽음
+    CHECK(shell.ListCalls() == 1);
+    shell.AddTab(7, Folder(5));
+    CHECK(resolver.Resolve(7, Title(5)) == Folder(5));
+    CHECK(shell.ListCalls() == 2);
+
+    // 창이 닫힘 -> 토큰 읽기 실패 -> 빈 경로, Forget이 토큰 해제
+    shell.CloseWindow(7);
+    resolver.MarkDirty(7);
+    CHECK(resolver.Resolve(7, Title(5)).empty());
+    resolver.Forget(7);
+    CHECK(shell.HeldRefs() == 0);
+    CHECK(shell.LiveTabs() == 0); // 닫힌 탭 레코드가 모두 해제됨 (누수 없음)
+}
+
+// 시작 시 일괄 부착: 창 N개 = 나열 1회
+static void TestResolveAll() {
+    FakeShell shell;
+    std::vector<std::pair<FakeHwnd, std::wstring>> windows;
+    for (int i = 0; i < 20; i++) {
+        shell.AddTab(100 + i, Folder(i));
+        windows.push_back({ 100 + i, Title(i) });
+    }
+    windows.push_back({ 999, L"Unknown" });
+    Resolver resolver(&shell);
+    std::vector<std::wstring> paths;
+    resolver.ResolveAll(windows, paths);
+    CHECK(shell.ListCalls() == 1);
+    CHECK(paths.size() == 21 && paths[20].empty());
+    for (int i = 0; i < 20; i++) CHECK(paths[i] == Folder(i));
+    unsigned long long calls = shell.Calls();
+    for (int i = 0; i < 20; i++) CHECK(resolver.Resolve(100 + i, Title(i)) == Folder(i));
+    CHECK(shell.Calls() == calls); // 모두 캐시 적중
+    resolver.Shutdown();
+    CHECK(shell.HeldRefs() == 0);
+}
+
+// 여러 워커가 동시에 해석 (창 0~3) + 다른 창(4~7)의 이동/무효화/재나열 (Win32 풀과 같은 사용)
+static void TestConcurrent() {
+    FakeShell shell;
+    std::vector<int> tabs;
+    for (int i = 0; i < 8; i++) tabs.push_back(shell.AddTab(i, Folder(i)));
+    Resolver resolver(&shell);
+    std::vector<std::thread> threads;
+    int wrong = 0;
+    std::mutex wrongMutex;
+    for (int w = 0; w < 4; w++) {
+        threads.emplace_back([&, w] {
+            for (int n = 0; n < 500; n++) {
+                int hwnd = (w + n) % 4;
+                if (resolver.Resolve(hwnd, Title(hwnd)) != Folder(hwnd)) { std::lock_guard<std::mutex> lock(wrongMutex); wrong++; }
+            }
+        });
+    }
+    for (int n = 0; n < 200; n++) {
+        int hwnd = 4 + n % 4, folder = 100 + n;
+        shell.Navigate(tabs[hwnd], Folder(folder));
+        resolver.MarkDirty(hwnd);
+        if (resolver.Resolve(hwnd, Title(folder)) != Folder(folder)) wrong++;
+        if (n % 50 == 0) shell.AddTab(hwnd, Folder(1000 + n)); // 새 탭 -> 다음 미스가 전체 재나열
+    }
+    for (auto& t : threads) t.join();
+    CHECK(wrong == 0);
+    resolver.Shutdown();
+    CHECK(shell.HeldRefs() == 0);
+}
+
+static void RunBench(int windows, int tabsPerWindow, int navs, int callUs) {
+    std::printf("resolver: %d windows x %d tabs, %d navigations, %d us per shell call\n", windows, tabsPerWindow, navs, callUs);
+    std::fflush(stdout);
+    for (int pass = 0; pass < 2; pass++) {
+        FakeShell shell;
+        std::vector<int> active;
+        for (int w = 0; w < windows; w++) {
+            for (int t = 0; t < tabsPerWindow; t++) {
+                int id = shell.AddTab(w, Folder(w * 100 + t));
+                if (t == 0) active.push_back(id);
+            }
+        }
+        shell.SetCallDelay(callUs);
+        Resolver resolver(&shell);
+        std::vector<double> ms;
+        int wrong = 0;
+        for (int n = 0; n < navs; n++) {
+            int w = (int)((n * 7919u) % (unsigned)windows);
+            int folder = w * 100 + 50 + n % 40; // 활성 탭이 새 폴더로 이동 (NAMECHANGE)
+            shell.Navigate(active[w], Folder(folder));
+            auto t0 = std::chrono::steady_clock::now();
+            std::wstring path;
+            if (pass == 0) {
+                path = OldGetExplorerPath(shell, w, Title(folder));
+            } else {
+                resolver.MarkDirty(w);
+                path = resolver.Resolve(w, Title(folder));
+            }
+            ms.push_back(ElapsedMs(t0));
+            wrong += path != Folder(folder);
+            // 같은 창의 WM_PAINT/표시 갱신 등으로 같은 제목 재조회 (예전에는 매번 다시 나열)
+            if (pass == 1) resolver.Resolve(w, Title(folder));
+        }
+        std::sort(ms.begin(), ms.end());
+        std::printf("%s: p50=%.3fms p99=%.3fms, %.1f shell round trips/navigation, wrong=%d\n",
+            pass == 0 ? "before (enumerate all windows)" : "after (cached resolver)", ms[ms.size() / 2],
+            ms[(size_t)(0.99 * (ms.size() - 1))], (double)shell.Calls() / navs, wrong);
+        std::fflush(stdout);
+        CHECK(wrong == 0);
+        resolver.Shutdown();
+        CHECK(shell.HeldRefs() == 0);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--windows", 20), (int)ArgInt(argc, argv, "--tabs", 2),
+            (int)ArgInt(argc, argv, "--navs", 2000), (int)ArgInt(argc, argv, "--call-us", 50));
+        return TestExit("explorer_paths_bench");
+    }
+    TestCacheAndDirty();
+    TestTabs();
+    TestResolveAll();
+    TestConcurrent();
+    return TestExit("explorer_paths_test");
+}
\ No newline at end of file
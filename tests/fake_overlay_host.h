@@ -0,0 +1,202 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "core/explorer_paths.h"
+#include "core/overlay_events.h"
+#include "core/overlay_registry.h"
+#include "core/path_jobs.h"
+#include "core/replay.h"
+
+// --- [가짜 창 / 오버레이 호스트] ---
+// Win32 없이 실제 라우터(RouteOverlayEvent) + 레지스트리 + 워커 풀 + 경로 해석기를 구동하는 최소 창 모형.
+// -> 핸들 = FakeWnd 포인터. 파괴된 창도 테스트가 끝날 때까지 메모리에 남김 (IsWindow처럼 늦은 확인이 안전하도록).
+// -> 워커 결과/닫기 요청은 PostMessage 대신 큐 + 조건 변수 -> Pump가 UI 스레드 역할.
+struct FakeWnd {
+    int id = 0;
+    bool explorer = false;
+    std::atomic<bool> alive{ true };
+    std::atomic<bool> visible{ false };
+    int x = 0, y = 0;
+
+    std::wstring Title() { std::lock_guard<std::mutex> lock(m_mutex); return m_title; }
+    void SetTitle(const std::wstring& title) { std::lock_guard<std::mutex> lock(m_mutex); m_title = title; }
+
+private:
+    std::mutex m_mutex; // 제목은 워커가 읽음 (GetWindowText)
+    std::wstring m_title;
+};
+typedef FakeWnd* FakeHandle;
+
+struct FakePair {
+    FakeHandle hExplorer = nullptr;
+    FakeHandle hOverlay = nullptr;
+    std::wstring currentPath;
+    unsigned long long pathGeneration = 0;
+    unsigned long long traceEventNs = 0;
+};
+
+class FakeOverlayHost {
+public:
+    typedef FakeHandle Handle;
+    typedef FakePair Pair;
+    typedef BasicExplorerPathResolver<FakeHandle> Resolver;
+
+    explicit FakeOverlayHost(BasicShellBackend<FakeHandle>* shell, int workers = PATH_WORKER_COUNT)
+        : m_resolver(shell), m_jobs([this](FakeHandle o, FakeHandle e, unsigned long long g) { PathJob(o, e, g); }) {
+        m_jobs.Start(workers);
+    }
+    ~FakeOverlayHost() { m_jobs.Stop(); }
+
+    FakeHandle NewWindow(int id, bool explorer, const std::wstring& title) {
+        std::lock_guard<std::mutex> lock(m_windowsMutex);
+        m_windows.emplace_back(new FakeWnd());
+        FakeWnd* w = m_windows.back().get();
+        w->id = id;
+        w->explorer = explorer;
+        w->SetTitle(title);
+        return w;
+    }
+
+    // 탐색기 파괴 -> 소유된 오버레이도 함께 (Win32 소유 창과 같음)
+    void DestroyWindow(FakeHandle hwnd) {
+        hwnd->alive = false;
+        hwnd->visible = false;
+        if (Pair* pair = m_overlays.FindByExplorer(hwnd)) DestroyOverlay(pair->hOverlay);
+    }
+
+    // --- RouteOverlayEvent 호스트 ---
+    bool IsAlive(FakeHandle hwnd) { return hwnd && hwnd->alive; }
+    bool IsVisible(FakeHandle hwnd) { return hwnd->visible; }
+    bool IsExplorer(FakeHandle hwnd) { return hwnd->explorer; }
+    Pair* FindByExplorer(FakeHandle hwnd) { return m_overlays.FindByExplorer(hwnd); }
+    Pair* CreateOverlay(FakeHandle hExplorer) {
+        Pair pair;
+        pair.hExplorer = hExplorer;
+        pair.hOverlay = NewWindow(-hExplorer->id, false, L"Memo");
+        m_created++;
+        return m_overlays.Add(pair);
+    }
+    template <typename Fn> void ForEachOverlay(Fn fn) { m_overlays.ForEach(fn); }
+    void RequestPath(Pair& pair) { pair.pathGeneration = m_jobs.Submit(pair.hOverlay, pair.hExplorer); }
+    void ForgetExplorer(FakeHandle hwnd) { m_resolver.Forget(hwnd); }
+    void MarkPathDirty(FakeHandle hwnd) { m_resolver.MarkDirty(hwnd); }
+    void CancelPath(FakeHandle hwnd) { m_jobs.Cancel(hwnd); }
+    void CloseOverlay(const Pair& pair) { PostClose(pair.hOverlay); }
+    void SchedulePosition(const Pair&) { m_positionRequests++; }
+    void SettlePosition(const Pair&) { m_positionRequests++; }
+
+    // UI 스레드: 워커 결과/닫기 요청 처리 (WindowProc 역할)
+    void Pump() {
+        std::deque<FakeHandle> closes;
+        {
+            std::lock_guard<std::mutex> lock(m_postMutex);
+            closes.swap(m_closes);
+            m_posted = false;
+        }
+        for (FakeHandle h : closes) DestroyOverlay(h);
+        m_results.DrainTo([this](Result& r) {
+            Pair* pair = m_overlays.FindByOverlay(r.hOverlay);
+            if (!pair || r.generation != pair->pathGeneration) return; // 닫혔거나 옛 세대
+            pair->currentPath = r.path;
+            m_applied++;
+        });
+    }
+
+    // 새 결과/닫기 요청이 오거나 ms가 지날 때까지 (MsgWaitForMultipleObjects 역할)
+    void Wait(int ms) {
+        std::unique_lock<std::mutex> lock(m_postMutex);
+        m_postCv.wait_for(lock, std::chrono::milliseconds(ms), [this] { return m_posted; });
+    }
+
+    Resolver& PathResolver() { return m_resolver; }
+    BasicPathJobPool<FakeHandle>& Jobs() { return m_jobs; }
+    BasicOverlayRegistry<Pair, FakeHandle>& Overlays() { return m_overlays; }
+    unsigned long long Created() const { return m_created; }
+    unsigned long long Applied() const { return m_applied; }
+    unsigned long long PositionRequests() const { return m_positionRequests; }
+
+private:
+    struct Result {
+        FakeHandle hOverlay;
+        std::wstring path;
+        unsigned long long generation;
+    };
+
+    void DestroyOverlay(FakeHandle hOverlay) {
+        if (!hOverlay->alive) return;
+        hOverlay->alive = false;
+        m_overlays.RemoveByOverlay(hOverlay);
+    }
+
+    void PostClose(FakeHandle hOverlay) {
+        { std::lock_guard<std::mutex> lock(m_postMutex); m_closes.push_back(hOverlay); m_posted = true; }
+        m_postCv.notify_all();
+    }
+
+    // PathFinderJob과 같은 흐름: 재시도 -> 창이 사라졌으면 닫기 요청, 아니면 최신 세대 결과만 전달
+    void PathJob(FakeHandle hOverlay, FakeHandle hExplorer, unsigned long long generation) {
+        std::wstring path;
+        PathRetryResult retry = RunPathRetry(m_jobs, hExplorer, generation,
+            [](FakeHandle h) { return h->alive.load(); },
+            [this](FakeHandle h) { return m_resolver.Resolve(h, h->Title()); }, path);
+        if (retry == PathRetryResult::Superseded) return;
+        if (retry == PathRetryResult::ExplorerGone) { if (hOverlay->alive) PostClose(hOverlay); return; }
+        if (!hOverlay->alive || !m_jobs.IsLatest(hExplorer, generation)) return;
+        m_results.Push({ hOverlay, path, generation });
+        { std::lock_guard<std::mutex> lock(m_postMutex); m_posted = true; }
+        m_postCv.notify_all();
+    }
+
+    Resolver m_resolver;
+    BasicPathJobPool<FakeHandle> m_jobs;
+    BasicOverlayRegistry<Pair, FakeHandle> m_overlays;
+    MpscQueue<Result> m_results;
+    std::mutex m_windowsMutex;
+    std::deque<std::unique_ptr<FakeWnd>> m_windows;
+    std::mutex m_postMutex;
+    std::condition_variable m_postCv;
+    std::deque<FakeHandle> m_closes;
+    bool m_posted = false;
+    unsigned long long m_created = 0;
+    unsigned long long m_applied = 0;
+    unsigned long long m_positionRequests = 0;
+};
+
+// 재생 세션용 창 경계 (Win32ReplayWindows와 같은 역할). 메모는 root 아래 실제 파일로 씀
+class FakeReplayWindows : public IReplayWindows<FakeHandle> {
+public:
+    explicit FakeReplayWindows(FakeOverlayHost& host) : m_host(host) {}
+
+    void WriteMemo(const std::wstring& folderPath) override {
+        std::ofstream(std::filesystem::path(folderPath) / L"folder_memo.txt", std::ios::binary) << "replay memo\n";
+    }
+    FakeHandle CreateExplorer(int id, const std::wstring& title) override { return m_host.NewWindow(id, true, title); }
+    void ShowExplorer(FakeHandle hwnd, bool visible) override { hwnd->visible = visible; }
+    void MoveExplorer(FakeHandle hwnd, int x, int y) override { hwnd->x = x; hwnd->y = y; }
+    void SetExplorerTitle(FakeHandle hwnd, const std::wstring& title) override { hwnd->SetTitle(title); }
+    void DestroyExplorer(FakeHandle hwnd) override { m_host.DestroyWindow(hwnd); }
+    void Inject(OverlayEvent event, FakeHandle hwnd) override { RouteOverlayEvent(m_host, event, hwnd); }
+    void Pump() override { m_host.Pump(); }
+    void Wait(int ms) override { m_host.Wait(ms); }
+
+    bool OverlayPath(FakeHandle hExplorer, std::wstring& path) override {
+        const FakePair* pair = m_host.FindByExplorer(hExplorer);
+        if (!pair) return false;
+        path = pair->currentPath;
+        return true;
+    }
+
+    void ForEachOverlay(const std::function<void(FakeHandle)>& fn) override {
+        m_host.ForEachOverlay([&fn](FakePair& pair) { fn(pair.hExplorer); });
+    }
+
+private:
+    FakeOverlayHost& m_host;
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/explorer_paths.h"
+
+// --- [가짜 Shell] ---
+// IShellWindows(main.cpp의 ComShellBackend) 대신 쓰는 백엔드. 호출마다 지연을 넣어 프로세스 간 COM 왕복을 흉내냄
+// -> explorer_paths_test, startup_attach_test 공용
+typedef int FakeHwnd;
+typedef BasicShellTab<FakeHwnd> ShellTab;
+
+// 창마다 탭 목록. 토큰 = 나열 시점의 탭 레코드 (참조 계수, 0이 되면 해제) -> 닫힌 탭의 토큰도 해제 전까지 읽기만 실패
+class FakeShell : public BasicShellBackend<FakeHwnd> {
+public:
+    void SetCallDelay(int us) { m_delayUs = us; }
+
+    int AddTab(FakeHwnd hwnd, const std::wstring& path) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Tab* tab = new Tab{ m_nextId++, hwnd, path, 1, true };
+        m_tabs.push_back(tab);
+        m_live++;
+        m_totalRefs++;
+        return tab->id;
+    }
+    void Navigate(int tabId, const std::wstring& path) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Tab* t : m_tabs) if (t->id == tabId) t->path = path;
+    }
+    void CloseWindow(FakeHwnd hwnd) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_tabs.begin(); it != m_tabs.end();) {
+            if ((*it)->hwnd != hwnd) { ++it; continue; }
+            (*it)->open = false;
+            UnrefLocked(*it);
+            it = m_tabs.erase(it);
+        }
+    }
+
+    bool ListTabs(std::vector<ShellTab>& out) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_listCalls++;
+        for (Tab* t : m_tabs) {
+            Delay(); // 창마다 Item() 왕복
+            t->refs++;
+            m_totalRefs++;
+            out.push_back({ t->hwnd, t });
+        }
+        return true;
+    }
+    bool ReadTab(void* token, std::wstring& name, std::wstring& path) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_readCalls++;
+        Delay();
+        Tab* t = (Tab*)token;
+        if (!t->open) return false;
+        path = t->path;
+        size_t slash = path.find_last_of(L'\\');
+        name = slash == std::wstring::npos ? path : path.substr(slash + 1);
+        return true;
+    }
+    void RetainTab(void* token) override { std::lock_guard<std::mutex> lock(m_mutex); ((Tab*)token)->refs++; m_totalRefs++; }
+    void ReleaseTab(void* token) override { std::lock_guard<std::mutex> lock(m_mutex); UnrefLocked((Tab*)token); }
+    void Disconnect() override { std::lock_guard<std::mutex> lock(m_mutex); m_disconnects++; }
+
+    // 프로세스 간 왕복 수 (나열은 창마다 1번, 탭 읽기 1번)
+    unsigned long long Calls() { std::lock_guard<std::mutex> lock(m_mutex); return m_roundTrips; }
+    unsigned long long ListCalls() { std::lock_guard<std::mutex> lock(m_mutex); return m_listCalls; }
+    unsigned long long ReadCalls() { std::lock_guard<std::mutex> lock(m_mutex); return m_readCalls; }
+    int Disconnects() { std::lock_guard<std::mutex> lock(m_mutex); return m_disconnects; }
+    // 셸 자신이 들고 있는 열린 탭 참조 외에 남은 참조 수 (해석기가 들고 있는 토큰)
+    long long HeldRefs() { std::lock_guard<std::mutex> lock(m_mutex); return m_totalRefs - (long long)m_tabs.size(); }
+    long long LiveTabs() { std::lock_guard<std::mutex> lock(m_mutex); return m_live; }
+
+    ~FakeShell() { for (Tab* t : m_tabs) delete t; }
+
+private:
+    struct Tab {
+        int id;
+        FakeHwnd hwnd;
+        std::wstring path;
+        int refs;
+        bool open;
+    };
+
+    void Delay() {
+        m_roundTrips++;
+        if (m_delayUs <= 0) return;
+        auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(m_delayUs);
+        while (std::chrono::steady_clock::now() < until) {} // sleep은 최소 단위가 커서 바쁜 대기
+    }
+    void UnrefLocked(Tab* t) {
+        m_totalRefs--;
+        if (--t->refs == 0) { delete t; m_live--; }
+    }
+
+    std::mutex m_mutex;
+    std::vector<Tab*> m_tabs;
+    int m_nextId = 1;
+    int m_delayUs = 0;
+    long long m_live = 0;
+    long long m_totalRefs = 0;
+    unsigned long long m_listCalls = 0;
+    unsigned long long m_readCalls = 0;
+    unsigned long long m_roundTrips = 0;
+    int m_disconnects = 0;
+};
+
+// 예전 GetExplorerPath: 전체 나열 -> 그 창의 탭을 일치할 때까지 읽음 -> 모두 해제
+inline std::wstring OldGetExplorerPath(FakeShell& shell, FakeHwnd hwnd, const std::wstring& title) {
+    std::vector<ShellTab> all;
+    shell.ListTabs(all);
+    std::wstring found;
+    for (const auto& t : all) {
+        if (found.empty() && t.hwnd == hwnd) {
+            std::wstring name, path;
+            if (shell.ReadTab(t.token, name, path) && title.find(name) != std::wstring::npos) found = path;
+        }
+    }
+    for (const auto& t : all) shell.ReleaseTab(t.token);
+    return found;
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+// [PRD 4.4] 참조 카운트 GDI 캐시 + 카운팅 가짜 팩토리: 같은 키 공유, 참조 0에서 삭제, 캐시 밖 핸들 무시,
+//   Ctrl+휠/경로 갱신 폭주 후 살아 있는 폰트 = 실제로 쓰는 크기 수, 페인트 도구는 첫/마지막 오버레이에서만 생성/삭제
+// --bench [--overlays N] [--ticks K]: 폰트 변경 K번 + 다시 그리기 K번 -> 예전(매번 생성, 폰트는 삭제 안 함)과 생성/누수 수 비교
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "core/gdi_cache.h"
+#include "tests/test_util.h"
+
+typedef uintptr_t FakeObject; // 0 = 실패 (NULL)
+
+// 생성/삭제 횟수와 살아 있는 핸들 (GetGuiResources(GR_GDIOBJECTS) 역할)
+class CountingGdiFactory : public BasicGdiFactory<FakeObject> {
+public:
+    unsigned long long fonts = 0, brushes = 0, pens = 0, destroyed = 0;
+    std::set<FakeObject> live;
+    bool failNext = false;
+
+    FakeObject CreateFontObject(const std::wstring&, int) override { fonts++; return New(); }
+    FakeObject CreateBrushObject(uint32_t) override { brushes++; return New(); }
+    FakeObject CreatePenObject(uint32_t, int) override { pens++; return New(); }
+    void DestroyObject(FakeObject obj) override {
+        destroyed++;
+        CHECK(live.erase(obj) == 1); // 두 번 삭제/모르는 핸들 삭제 없음
+    }
+
+private:
+    FakeObject New() {
+        if (failNext) { failNext = false; return 0; }
+        live.insert(m_next);
+        return m_next++;
+    }
+    FakeObject m_next = 1;
+};
+typedef BasicGdiResourceCache<FakeObject> Cache;
+
+static const wchar_t FACE[] = L"Malgun Gothic";
+
+static void TestSharing() {
+    CountingGdiFactory gdi;
+    Cache cache(&gdi);
+    FakeObject a = cache.AcquireFont(FACE, 18);
+    FakeObject b = cache.AcquireFont(FACE, 18);
+    FakeObject c = cache.AcquireFont(FACE, 20);
+    FakeObject d = cache.AcquireFont(L"Consolas", 18);
+    CHECK(a == b && a != c && a != d);
+    CHECK(gdi.fonts == 3 && cache.LiveFonts() == 3);
+
+    FakeObject red = cache.AcquireBrush(0x0000FF);
+    CHECK(cache.AcquireBrush(0x0000FF) == red);
+    FakeObject pen1 = cache.AcquirePen(0x0000FF, 1);
+    FakeObject pen2 = cache.AcquirePen(0x0000FF, 2);
+    CHECK(pen1 != pen2 && pen1 != red); // 같은 색이라도 종류/두께가 다르면 다른 객체
+    CHECK(cache.LiveBrushes() == 1 && cache.LivePens() == 2 && cache.Created() == 6);
+
+    cache.Release(a);
+    CHECK(gdi.live.count(a) && cache.Owns(a)); // 아직 참조 1
+    cache.Release(b);
+    CHECK(!gdi.live.count(a) && !cache.Owns(a) && cache.LiveFonts() == 2);
+    cache.Release(a); // 이미 삭제됨 -> 무시 (두 번 삭제 없음)
+    cache.Release(0);
+    cache.Release(999999); // 시스템 기본 폰트 등 캐시 밖 핸들
+    CHECK(gdi.destroyed == 1);
+
+    gdi.failNext = true; // 생성 실패 -> NULL, 캐시에 남지 않음
+    CHECK(cache.AcquireFont(FACE, 40) == 0);
+    CHECK(cache.LiveFonts() == 2);
+    FakeObject e = cache.AcquireFont(FACE, 40);
+    CHECK(e != 0 && cache.LiveFonts() == 3);
+
+    for (FakeObject o : { c, d, red, red, pen1, pen2, e }) cache.Release(o);
+    CHECK(gdi.live.empty() && cache.LiveFonts() == 0 && cache.LiveBrushes() == 0 && cache.LivePens() == 0);
+}
+
+// main.cpp의 UpdateMemoFont/ReleaseMemoFont와 같은 흐름 (WM_GETFONT/WM_SETFONT 대신 필드)
+struct FakeEdit {
+    FakeObject font = 0;
+};
+
+static void UpdateMemoFont(Cache& cache, FakeEdit& edit, int size) {
+    FakeObject old = edit.font;
+    FakeObject next = cache.AcquireFont(FACE, size);
+    if (next == old) { cache.Release(next); return; }
+    edit.font = next;
+    cache.Release(old);
+}
+
+static void ReleaseMemoFont(Cache& cache, FakeEdit& edit) {
+    cache.Release(edit.font);
+    edit.font = 0;
+}
+
+// main.cpp의 OverlayPaintKit: 첫 오버레이에서 확보, 마지막 오버레이에서 반납
+struct PaintKit {
+    int users = 0;
+    FakeObject bg = 0, border = 0, line = 0, conflict = 0, glyph = 0, icon = 0;
+
+    void AddRef(Cache& cache) {
+        if (users++ > 0) return;
+        bg = cache.AcquireBrush(0x00F0F0F0);
+        border = cache.AcquireBrush(0x00646464);
+        line = cache.AcquireBrush(0x00C8C8C8);
+        conflict = cache.AcquireBrush(0x003246DC);
+        glyph = cache.AcquirePen(0, 1);
+        icon = cache.AcquireFont(FACE, 32);
+    }
+    void Release(Cache& cache) {
+        if (users == 0 || --users > 0) return;
+        for (FakeObject o : { bg, border, line, conflict, glyph, icon }) cache.Release(o);
+        bg = border = line = conflict = glyph = icon = 0;
+    }
+};
+
+struct StormResult {
+    unsigned long long created = 0;
+    size_t peakLive = 0;
+    size_t leftLive = 0;
+};
+
+// 오버레이 N개: 무작위 오버레이에 Ctrl+휠(±1, 10~40) 또는 다시 그리기. 끝에 모두 닫음
+static StormResult Storm(int overlays, int ticks, bool cached) {
+    CountingGdiFactory gdi;
+    Cache cache(&gdi);
+    PaintKit kit;
+    std::vector<FakeEdit> edits(overlays);
+    std::vector<int> sizes(overlays, 18);
+    StormResult r;
+    std::mt19937 rng(11);
+    for (int i = 0; i < overlays; i++) {
+        if (cached) { kit.AddRef(cache); UpdateMemoFont(cache, edits[i], sizes[i]); }
+        else edits[i].font = gdi.CreateFontObject(FACE, sizes[i]);
+    }
+    for (int t = 0; t < ticks; t++) {
+        int i = (int)(rng() % overlays);
+        if (rng() % 2) {
+            sizes[i] = std::max(10, std::min(40, sizes[i] + (rng() % 2 ? 1 : -1)));
+            if (cached) UpdateMemoFont(cache, edits[i], sizes[i]);
+            else edits[i].font = gdi.CreateFontObject(FACE, sizes[i]); // 예전: 새로 만들고 이전 폰트는 그대로
+        } else if (!cached) {
+            // 예전 WM_PAINT: 브러시 4 + 펜 1 + 아이콘 폰트 1 생성 후 삭제
+            FakeObject objs[] = { gdi.CreateBrushObject(0x00F0F0F0), gdi.CreateBrushObject(0x00646464),
+                gdi.CreateBrushObject(0x00C8C8C8), gdi.CreateBrushObject(0x003246DC), gdi.CreatePenObject(0, 1),
+                gdi.CreateFontObject(FACE, 32) };
+            for (FakeObject o : objs) gdi.DestroyObject(o);
+        }
+        r.peakLive = std::max(r.peakLive, gdi.live.size());
+    }
+    if (cached) {
+        std::set<int> used(sizes.begin(), sizes.end());
+        CHECK(cache.LiveFonts() == (int)used.size() + (used.count(32) ? 0 : 1)); // 쓰는 크기 + 아이콘 폰트
+        CHECK(cache.LiveBrushes() == 4 && cache.LivePens() == 1);
+        for (int i = 0; i < overlays; i++) { ReleaseMemoFont(cache, edits[i]); kit.Release(cache); }
+        CHECK(cache.LiveFonts() == 0 && cache.LiveBrushes() == 0 && cache.LivePens() == 0);
+    }
+    r.created = gdi.fonts + gdi.brushes + gdi.pens;
+    r.leftLive = gdi.live.size();
+    return r;
+}
+
+static void TestStorm() {
+    StormResult after = Storm(20, 5000, true);
+    CHECK(after.leftLive == 0);
+    CHECK(after.peakLive <= 31 + 6); // 크기 10~40 + 페인트 도구
+    StormResult before = Storm(20, 5000, false);
+    CHECK(before.leftLive > 1000); // 예전 흐름은 폰트가 계속 쌓임 (이 테스트가 누수를 재현하는지 확인)
+}
+
+static void RunBench(int overlays, int ticks) {
+    StormResult before = Storm(overlays, ticks, false);
+    StormResult after = Storm(overlays, ticks, true);
+    std::printf("gdi: %d overlays, %d ticks (half Ctrl+wheel, half repaint)\n", overlays, ticks);
+    std::printf("before (create per call): %llu objects created, peak %zu live, %zu leaked after closing all\n",
+        before.created, before.peakLive, before.leftLive);
+    std::printf("after (ref-counted cache): %llu objects created, peak %zu live, %zu leaked after closing all\n",
+        after.created, after.peakLive, after.leftLive);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--overlays", 30), (int)ArgInt(argc, argv, "--ticks", 100000));
+        return TestExit("gdi_cache_bench");
+    }
+    TestSharing();
+    TestStorm();
+    return TestExit("gdi_cache_test");
+}
\ No newline at end of file
@@ -0,0 +1,329 @@
+// [PRD 5.9] 기록 보관: SHA-256 표준 벡터, 청크 경계(결정적, CHUNK_MIN~MAX 크기, 중간 삽입 뒤 다시 맞춰짐), 보존 정책,
+//   저장소(가짜 시계로 HISTORY_INTERVAL_MS 간격/대기본, 크게 줄어드는 저장 직전 내용 보존, 같은 내용은 버전 추가 없음,
+//   다시 열어도 그대로, 잘린 꼬리 정리 후 계속 기록)
+// --bench [--kb K] [--edits E] [--mb M]: 청크 분할/SHA-256 처리량(M MB), 청크 크기 분포, K KB 로그형 메모에 현실적인 편집
+//   E번(끝에 덧붙이기/중간 삽입/오타 수정/줄 삭제)마다 버전을 남길 때 쌓이는 바이트 -> 고정 8KB 청크와 비교한 중복 제거율
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "core/history.h"
+#include "core/utf.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+static fs::path TempDir(const char* name) {
+    fs::path dir = fs::temp_directory_path() / "FolderMemoHistoryTest" / name;
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+    return dir;
+}
+
+static std::string Hex(const Sha256::Digest& d) {
+    static const char* digits = "0123456789abcdef";
+    std::string s;
+    for (uint8_t b : d) { s += digits[b >> 4]; s += digits[b & 15]; }
+    return s;
+}
+
+static std::string RandomBytes(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::string s(n, '\0');
+    for (auto& c : s) c = (char)(rng() & 0xFF);
+    return s;
+}
+
+static void TestSha256() {
+    CHECK(Hex(Sha256::Of("", 0)) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    CHECK(Hex(Sha256::Of("abc", 3)) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    const char* m448 = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    CHECK(Hex(Sha256::Of(m448, strlen(m448))) == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    // 나눠 넣어도 같은 결과 (블록 경계 걸침)
+    std::string data = RandomBytes(1000, 1);
+    Sha256 h;
+    h.Update((const uint8_t*)data.data(), 63);
+    h.Update((const uint8_t*)data.data() + 63, 1);
+    h.Update((const uint8_t*)data.data() + 64, data.size() - 64);
+    CHECK(h.Final() == Sha256::Of(data.data(), data.size()));
+}
+
+static std::vector<Sha256::Digest> Chunks(const std::string& data, std::vector<size_t>& ends) {
+    ChunkBoundaries(data.data(), data.size(), ends);
+    std::vector<Sha256::Digest> out;
+    size_t start = 0;
+    for (size_t end : ends) { out.push_back(Sha256::Of(data.data() + start, end - start)); start = end; }
+    return out;
+}
+
+static void TestChunking() {
+    std::vector<size_t> ends;
+    ChunkBoundaries("", 0, ends);
+    CHECK(ends.empty());
+    ChunkBoundaries("short", 5, ends);
+    CHECK(ends.size() == 1 && ends[0] == 5);
+
+    std::string data = RandomBytes(1 << 20, 2);
+    std::vector<Sha256::Digest> a = Chunks(data, ends);
+    CHECK(!ends.empty() && ends.back() == data.size());
+    size_t start = 0;
+    for (size_t i = 0; i < ends.size(); i++) {
+        size_t len = ends[i] - start;
+        CHECK(len <= CHUNK_MAX_BYTES);
+        if (i + 1 < ends.size()) CHECK(len > CHUNK_MIN_BYTES);
+        start = ends[i];
+    }
+    std::vector<size_t> again;
+    CHECK(Chunks(data, again) == a && again == ends); // 결정적
+
+    // 중간에 100바이트 삽입 -> 그 근처 청크만 바뀌고 뒤는 다시 같은 경계
+    std::string edited = data;
+    edited.insert(300 * 1024, RandomBytes(100, 3));
+    std::vector<Sha256::Digest> b = Chunks(edited, again);
+    std::unordered_set<Sha256::Digest, DigestHash> known(a.begin(), a.end());
+    size_t fresh = 0;
+    for (const auto& d : b) fresh += !known.count(d);
+    CHECK(fresh <= 2);
+    CHECK(a.size() > 64); // 평균 8KB 근처
+}
+
+static void TestRetention() {
+    const int64_t HOUR = 3600 * 1000LL, DAY = 24 * HOUR;
+    const int64_t now = 1000 * DAY + 12 * HOUR;
+    std::vector<int64_t> times = {
+        now - 200 * DAY,                                    // 90일 밖 -> 삭제
+        now - 30 * DAY - 3 * HOUR, now - 30 * DAY - HOUR,   // 같은 날 -> 최신 1개
+        now - 3 * DAY - 50 * 60000, now - 3 * DAY - 10 * 60000, // 같은 시간대 -> 최신 1개
+        now - 3 * DAY + HOUR,                               // 다른 시간대
+        now - 5 * HOUR, now - 5 * HOUR + 1000, now - 1000,  // 최근 1일 -> 전부
+    };
+    std::vector<bool> keep = SelectRetainedVersions(times, now);
+    std::vector<bool> expect = { false, false, true, false, true, true, true, true, true };
+    CHECK(keep == expect);
+
+    // 최신 1개는 아무리 오래돼도 유지
+    keep = SelectRetainedVersions({ now - 500 * DAY, now - 400 * DAY }, now);
+    CHECK(keep.size() == 2 && !keep[0] && keep[1]);
+    CHECK(SelectRetainedVersions({}, now).empty());
+
+    // 폴더당 상한
+    std::vector<int64_t> many;
+    for (size_t i = 0; i < HISTORY_MAX_VERSIONS + 10; i++) many.push_back(now - DAY / 2 + (int64_t)i);
+    keep = SelectRetainedVersions(many, now);
+    CHECK((size_t)std::count(keep.begin(), keep.end(), true) == HISTORY_MAX_VERSIONS);
+    CHECK(!keep[0] && keep.back());
+}
+
+static std::shared_ptr<const std::string> Bytes(const std::string& s) { return std::make_shared<const std::string>(s); }
+
+static void TestStore() {
+    fs::path dir = TempDir("store");
+    int64_t now = 1700000000000LL;
+    const std::wstring folder = L"C:\\Work\\Project";
+    std::string big = RandomBytes(40 * 1024, 4);
+    std::string logs;
+    {
+        MemoHistoryStore store;
+        store.SetClock([&] { return now; });
+        store.SetLog([&](const std::wstring& line) { logs += WideToUtf8(line); });
+        CHECK(store.Open(dir));
+        CHECK(store.List(folder).empty());
+
+        store.OnSaved(folder, Bytes("v1")); // 첫 저장 -> 바로 버전
+        now += 10 * 1000;
+        store.OnSaved(folder, Bytes("v2")); // 간격 안 -> 대기본
+        CHECK(store.List(folder).size() == 1);
+        now += HISTORY_INTERVAL_MS;
+        store.OnSaved(folder, Bytes(big)); // 간격 지남 -> 버전 (v2 대기본은 버려짐)
+        CHECK(store.List(folder).size() == 2);
+
+        now += 5 * 1000;
+        std::string big2 = big;
+        big2[100] ^= 1;
+        store.OnSaved(folder, Bytes(big2)); // 대기본
+        now += 1000;
+        store.OnSaved(folder, Bytes("oops")); // 크게 줄어듦 -> 직전 대기본(big2)을 먼저 버전으로
+        std::vector<MemoVersionInfo> list = store.List(folder);
+        CHECK(list.size() == 3 && list[2].size == big2.size());
+
+        // 같은 내용 스냅숏은 버전 추가 없음 (대기본은 지움)
+        std::string read;
+        CHECK(store.Read(folder, 2, read) && read == big2);
+        CHECK(store.Snapshot(folder, big2));
+        CHECK(store.List(folder).size() == 3);
+        // 대소문자/구분자만 다른 경로는 같은 폴더
+        CHECK(store.List(L"c:/work/project").size() == 3);
+
+        // big2는 big과 청크 대부분을 공유 -> 새로 쌓인 바이트는 바뀐 청크뿐
+        CHECK(store.Committed() == 3);
+        CHECK(store.LogicalBytes() == 2 + big.size() + big2.size());
+        CHECK(store.StoredBytes() < 2 + big.size() + CHUNK_MAX_BYTES);
+        CHECK(!store.Read(folder, 3, read));
+
+        store.OnSaved(folder, Bytes("v4")); // 대기본 -> Close가 남김
+        store.Close();
+    }
+    CHECK(logs.find("history: versions=4") != std::string::npos);
+
+    // 다시 열기 -> 모두 그대로
+    {
+        MemoHistoryStore store;
+        store.SetClock([&] { return now; });
+        CHECK(store.Open(dir));
+        std::vector<MemoVersionInfo> list = store.List(folder);
+        CHECK(list.size() == 4);
+        const char* expect[] = { "v1", nullptr, nullptr, "v4" };
+        for (size_t i = 0; i < list.size(); i++) {
+            std::string read;
+            CHECK(store.Read(folder, i, read) && read.size() == list[i].size);
+            if (expect[i]) CHECK(read == expect[i]);
+        }
+        CHECK(list[0].timeMs < list[1].timeMs && list[2].timeMs < list[3].timeMs);
+    }
+
+    // 쓰다 만 꼬리 (전원 차단) -> 열 때 잘라내고 이어서 기록
+    {
+        std::ofstream(dir / "versions.log", std::ios::binary | std::ios::app) << "FMVR-torn";
+        std::ofstream(dir / "chunks.pack", std::ios::binary | std::ios::app) << "FMHC-torn-chunk";
+        MemoHistoryStore store;
+        store.SetClock([&] { return now; });
+        CHECK(store.Open(dir));
+        CHECK(store.List(folder).size() == 4);
+        now += HISTORY_INTERVAL_MS;
+        store.OnSaved(folder, Bytes("after torn"));
+        std::string read;
+        CHECK(store.List(folder).size() == 5 && store.Read(folder, 4, read) && read == "after torn");
+        store.Close();
+        CHECK(store.Open(dir) && store.List(folder).size() == 5);
+    }
+
+    // 닫힌 저장소는 아무것도 하지 않음
+    MemoHistoryStore closed;
+    closed.OnSaved(folder, Bytes("x"));
+    CHECK(!closed.Snapshot(folder, "x") && closed.List(folder).empty());
+}
+
+// 로그형 메모 한 줄 (날짜 + 항목 + 설명)
+static std::string LogLine(std::mt19937& rng) {
+    static const char* words[] = { u8"배포", u8"회의", "deploy", "review", u8"버그", "checklist", u8"다음", "TODO", u8"정리", "build" };
+    std::string line = "2024-" + std::to_string(1 + rng() % 12) + "-" + std::to_string(1 + rng() % 28) + " ";
+    int n = 4 + rng() % 10;
+    for (int i = 0; i < n; i++) { line += words[rng() % 10]; line += ' '; }
+    return line + "\n";
+}
+
+// 같은 편집 순서를 청크 방식만 바꿔 쌓을 때 저장되는 바이트
+struct DedupRun {
+    std::unordered_set<Sha256::Digest, DigestHash> known;
+    unsigned long long stored = 0;
+    size_t chunks = 0;
+    void Add(const std::string& data, const std::vector<size_t>& ends) {
+        size_t start = 0;
+        for (size_t end : ends) {
+            if (known.insert(Sha256::Of(data.data() + start, end - start)).second) stored += end - start;
+            start = end;
+            chunks++;
+        }
+    }
+};
+
+static void FixedBoundaries(size_t len, size_t size, std::vector<size_t>& ends) {
+    ends.clear();
+    for (size_t at = size; at < len + size; at += size) ends.push_back(std::min(at, len));
+}
+
+static void RunBench(int kb, int edits, int mb) {
+    // 처리량
+    std::string data = RandomBytes((size_t)mb << 20, 5);
+    std::vector<size_t> ends;
+    auto t0 = std::chrono::steady_clock::now();
+    ChunkBoundaries(data.data(), data.size(), ends);
+    double chunkMs = ElapsedMs(t0);
+    t0 = std::chrono::steady_clock::now();
+    Sha256::Digest d = Sha256::Of(data.data(), data.size());
+    double shaMs = ElapsedMs(t0);
+    (void)d;
+    std::vector<size_t> sizes;
+    size_t start = 0, atMax = 0;
+    for (size_t end : ends) { sizes.push_back(end - start); atMax += end - start == CHUNK_MAX_BYTES; start = end; }
+    std::sort(sizes.begin(), sizes.end());
+    std::printf("history: %d MB random data\n", mb);
+    std::printf("ChunkBoundaries %.0f MB/s, SHA-256 %.0f MB/s -> commit path ~%.0f MB/s\n", mb / chunkMs * 1000, mb / shaMs * 1000,
+        mb / (chunkMs + shaMs) * 1000);
+    std::printf("chunks: %zu, avg %.1f KB, p10 %.1f KB, p50 %.1f KB, p90 %.1f KB, max-size cuts %zu\n", sizes.size(),
+        (double)data.size() / sizes.size() / 1024, sizes[sizes.size() / 10] / 1024.0, sizes[sizes.size() / 2] / 1024.0,
+        sizes[sizes.size() * 9 / 10] / 1024.0, atMax);
+
+    // 중복 제거: 로그형 메모에 편집을 이어가며 매번 버전을 남김
+    std::mt19937 rng(9);
+    std::string memo;
+    while (memo.size() < (size_t)kb * 1024) memo += LogLine(rng);
+    DedupRun cdc, fixed;
+    unsigned long long logical = 0;
+    int kinds[4] = { 0, 0, 0, 0 };
+    fs::path dir = TempDir("bench");
+    int64_t now = 1700000000000LL;
+    MemoHistoryStore store;
+    store.SetClock([&] { return now; });
+    CHECK(store.Open(dir));
+    double commitMs = 0;
+    for (int e = 0; e <= edits; e++) {
+        if (e > 0) {
+            // 줄 경계 위치 하나 고르기
+            size_t at = memo.find('\n', rng() % memo.size());
+            at = at == std::string::npos ? memo.size() : at + 1;
+            int r = rng() % 100, kind;
+            if (r < 40) { memo += LogLine(rng); kind = 0; }                        // 끝에 덧붙이기
+            else if (r < 65) { memo.insert(at, LogLine(rng)); kind = 1; }          // 중간 삽입
+            else if (r < 90) { memo[rng() % memo.size()] = 'a' + rng() % 26; kind = 2; } // 오타 수정
+            else {                                                                  // 줄 삭제
+                size_t next = memo.find('\n', at);
+                memo.erase(at, next == std::string::npos ? std::string::npos : next - at + 1);
+                kind = 3;
+            }
+            kinds[kind]++;
+        }
+        logical += memo.size();
+        ChunkBoundaries(memo.data(), memo.size(), ends);
+        cdc.Add(memo, ends);
+        FixedBoundaries(memo.size(), CHUNK_AVG_BYTES, ends);
+        fixed.Add(memo, ends);
+        now += HISTORY_INTERVAL_MS;
+        t0 = std::chrono::steady_clock::now();
+        CHECK(store.Snapshot(L"C:\\bench", memo));
+        commitMs += ElapsedMs(t0);
+    }
+    std::string last;
+    CHECK(store.Read(L"C:\\bench", store.List(L"C:\\bench").size() - 1, last) && last == memo);
+    uint64_t pack = store.PackBytes();
+    store.Close();
+    std::printf("memo: %d KB log-style, %d edits (%d appends, %d middle inserts, %d typo fixes, %d line deletes), a version per edit\n",
+        kb, edits, kinds[0], kinds[1], kinds[2], kinds[3]);
+    std::printf("full copies: %.1f MB\n", logical / 1048576.0);
+    std::printf("fixed 8 KB chunks: %.1f MB stored (dedup %.1fx)\n", fixed.stored / 1048576.0, (double)logical / fixed.stored);
+    std::printf("content-defined chunks: %.1f MB stored (dedup %.1fx), store pack %.1f MB, %.2f ms per commit\n", cdc.stored / 1048576.0,
+        (double)logical / cdc.stored, pack / 1048576.0, commitMs / (edits + 1));
+    std::fflush(stdout);
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--kb", 512), (int)ArgInt(argc, argv, "--edits", 300), (int)ArgInt(argc, argv, "--mb", 64));
+        return TestExit("history_bench");
+    }
+    TestSha256();
+    TestChunking();
+    TestRetention();
+    TestStore();
+    return TestExit("history_test");
+}
\ No newline at end of file
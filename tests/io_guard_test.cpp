@@ -0,0 +1,314 @@
+// [PRD 5.10] 볼륨별 마감 + 차단기: EWMA 분류/마감, 차단기 열림/시험/대기 두 배/닫힘, 늦은 완료, 종료(Stop)
+// -> 결함 주입 가짜 파일 시스템: 볼륨마다 정상/지연/연결 오류/멈춤(취소 가능 또는 불가) 지정
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/io_guard.h"
+#include "tests/test_util.h"
+
+enum class Fault { None, Slow, Unreachable, Missing, Hang, HangUncancellable };
+
+thread_local bool t_unreachable = false; // 가짜 GetLastError
+
+// 워커 시작/끝, 취소 요청을 센다. 취소는 멈춘 호출을 깨움 (CancelSynchronousIo 흉내)
+class FakeIoPlatform : public IIoPlatform {
+public:
+    void* EnterWorker() override { return (void*)(uintptr_t)++entered; }
+    void LeaveWorker(void* worker) override { if (worker) left++; }
+    void CancelWorker(void*) override;
+    void ResetError() override { t_unreachable = false; }
+    bool LastErrorUnreachable() override { return t_unreachable; }
+
+    std::atomic<int> entered{ 0 }, left{ 0 }, cancels{ 0 };
+    class FakeFs* fs = nullptr;
+};
+
+class FakeFs {
+public:
+    void SetFault(const std::wstring& volume, Fault f, int ms = 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_faults[volume] = { f, ms };
+    }
+
+    // 멈춘 호출 모두 풀기 (잠든 디스크가 깨어남)
+    void Wake() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_woken = true;
+        m_cv.notify_all();
+    }
+
+    void Cancel() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cancelGen++;
+        m_cv.notify_all();
+    }
+
+    // 메모 읽기 한 번. 실패면 false (t_unreachable로 원인)
+    bool Read(const std::wstring& folderPath) {
+        calls++;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto it = m_faults.find(VolumeKeyOf(folderPath));
+        std::pair<Fault, int> f = it == m_faults.end() ? std::make_pair(Fault::None, 0) : it->second;
+        switch (f.first) {
+        case Fault::Slow:
+            lock.unlock();
+            std::this_thread::sleep_for(std::chrono::milliseconds(f.second));
+            return true;
+        case Fault::Unreachable:
+            t_unreachable = true;
+            return false;
+        case Fault::Missing:
+            return false;
+        case Fault::Hang:
+        case Fault::HangUncancellable: {
+            unsigned long long gen = m_cancelGen;
+            bool cancellable = f.first == Fault::Hang;
+            hanging++;
+            m_cv.wait(lock, [&] { return m_woken || (cancellable && m_cancelGen != gen); });
+            hanging--;
+            if (m_woken) return true;
+            t_unreachable = true; // ERROR_OPERATION_ABORTED
+            return false;
+        }
+        default:
+            return true;
+        }
+    }
+
+    std::atomic<int> calls{ 0 }, hanging{ 0 };
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::unordered_map<std::wstring, std::pair<Fault, int>> m_faults;
+    bool m_woken = false;
+    unsigned long long m_cancelGen = 0;
+};
+
+void FakeIoPlatform::CancelWorker(void*) {
+    cancels++;
+    if (fs) fs->Cancel();
+}
+
+static bool WaitUntil(const std::function<bool()>& cond, int ms) {
+    auto t0 = std::chrono::steady_clock::now();
+    while (!cond()) {
+        if (ElapsedMs(t0) > ms) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+static void TestVolumeKeys() {
+    CHECK(VolumeKeyOf(L"C:\\Users\\a") == L"c:");
+    CHECK(VolumeKeyOf(L"\\\\?\\D:\\x") == L"d:");
+    CHECK(VolumeKeyOf(L"\\\\NAS\\Share\\dir\\sub") == L"\\\\nas\\share");
+    CHECK(VolumeKeyOf(L"\\\\?\\UNC\\nas\\share\\dir") == L"\\\\nas\\share");
+    CHECK(VolumeKeyOf(L"//nas/share/dir") == L"\\\\nas\\share");
+    CHECK(VolumeKeyOf(L"relative\\path") == L"");
+}
+
+// EWMA: 첫 표본은 그대로, 이후 alpha 0.2. 분류별 마감
+static void TestLatencyClasses() {
+    VolumeHealth h;
+    const std::wstring v = L"x:";
+    VolumeHealth::Admission a = h.Admit(v, 0);
+    CHECK(a.run && !a.probe && a.deadlineMs == IO_DEADLINE_FIRST_MS);
+    CHECK(h.ClassOf(v) == VolumeClass::Unknown);
+    h.Report(v, a, IoOutcome::Ok, 100, 0);
+    CHECK(h.ClassOf(v) == VolumeClass::Fast);
+    CHECK(h.Admit(v, 0).deadlineMs == IO_DEADLINE_FAST_MS);
+
+    h.Report(v, a, IoOutcome::Failed, 300, 0); // 없음/권한 -> 응답은 했으므로 표본 (100 + 0.2 * 200 = 140)
+    CHECK(h.ClassOf(v) == VolumeClass::Fast);
+    h.Report(v, a, IoOutcome::Ok, 300, 0);     // 140 + 0.2 * 160 = 172
+    CHECK(h.ClassOf(v) == VolumeClass::Slow);
+    CHECK(h.Admit(v, 0).deadlineMs == IO_DEADLINE_SLOW_MS);
+    std::vector<VolumeHealth::Stats> stats = h.Snapshot();
+    CHECK(stats.size() == 1 && stats[0].latencyMs > 171.9 && stats[0].latencyMs < 172.1);
+    for (int i = 0; i < 20; i++) h.Report(v, a, IoOutcome::Ok, 10, 0); // 빨라지면 다시 Fast
+    CHECK(h.ClassOf(v) == VolumeClass::Fast);
+    CHECK(h.RetryDelayMs(v, 0) == -1);
+}
+
+// 연결 오류 2회 -> 열림, 대기 중 거절, 시험 하나만 통과, 시험 실패 -> 대기 두 배, 시험 성공 -> 닫힘
+static void TestBreaker() {
+    VolumeHealth h;
+    std::vector<std::wstring> log;
+    h.SetLog([&log](const std::wstring& line) { log.push_back(line); });
+    const std::wstring v = L"\\\\nas\\share";
+    int64_t now = 1000;
+    VolumeHealth::Admission a = h.Admit(v, now);
+    h.Report(v, a, IoOutcome::Unreachable, 0, now);
+    CHECK(h.ClassOf(v) != VolumeClass::Unavailable); // 한 번은 넘김 (순간 오류)
+    CHECK(h.RetryDelayMs(v, now) == 0);
+    h.Report(v, h.Admit(v, now), IoOutcome::Unreachable, 0, now);
+    CHECK(h.ClassOf(v) == VolumeClass::Unavailable);
+    CHECK(log.size() == 1);
+    CHECK(h.RetryDelayMs(v, now) == IO_BREAKER_FIRST_MS);
+
+    CHECK(!h.Admit(v, now + IO_BREAKER_FIRST_MS - 1).run); // 대기 중 -> 디스크에 가지 않음
+    a = h.Admit(v, now + IO_BREAKER_FIRST_MS);
+    CHECK(a.run && a.probe);
+    CHECK(!h.Admit(v, now + IO_BREAKER_FIRST_MS).run); // 시험 중 -> 다른 호출 거절
+    now += IO_BREAKER_FIRST_MS;
+    h.Report(v, a, IoOutcome::Unreachable, 0, now);
+    CHECK(h.RetryDelayMs(v, now) == IO_BREAKER_FIRST_MS * 2);
+    for (int i = 0; i < 10; i++) { // 계속 실패 -> 최대 대기까지만
+        now += IO_BREAKER_MAX_MS;
+        a = h.Admit(v, now);
+        CHECK(a.probe);
+        h.Report(v, a, IoOutcome::Unreachable, 0, now);
+    }
+    CHECK(h.RetryDelayMs(v, now) == IO_BREAKER_MAX_MS);
+
+    now += IO_BREAKER_MAX_MS;
+    a = h.Admit(v, now);
+    h.Report(v, a, IoOutcome::Ok, 20, now);
+    CHECK(h.ClassOf(v) == VolumeClass::Fast);
+    CHECK(h.Admit(v, now).run);
+    CHECK(log.back().find(L"available again") != std::wstring::npos);
+    std::vector<VolumeHealth::Stats> stats = h.Snapshot();
+    CHECK(stats.size() == 1 && stats[0].trips == 1 && stats[0].rejected == 2);
+
+    // 다시 열리면 대기 시간은 처음부터
+    h.Report(v, h.Admit(v, now), IoOutcome::TimedOut, IO_DEADLINE_FAST_MS, now); // 시간 초과는 1회로 열림
+    CHECK(h.RetryDelayMs(v, now) == IO_BREAKER_FIRST_MS);
+}
+
+// 마감을 넘긴 작업이 IO_MAX_ABANDONED_PER_VOLUME개면 거절, 늦게 끝나면 닫힘
+static void TestAbandoned() {
+    VolumeHealth h;
+    const std::wstring v = L"y:";
+    VolumeHealth::Admission a = h.Admit(v, 0);
+    h.Report(v, a, IoOutcome::TimedOut, a.deadlineMs, 0);
+    CHECK(h.ClassOf(v) == VolumeClass::Unavailable);
+    a = h.Admit(v, IO_BREAKER_FIRST_MS); // 시험 호출도 마감을 넘김 -> 묶인 작업 2개
+    CHECK(a.probe && a.deadlineMs == IO_DEADLINE_SLOW_MS);
+    h.Report(v, a, IoOutcome::TimedOut, a.deadlineMs, IO_BREAKER_FIRST_MS);
+    CHECK(!h.Admit(v, 10LL * IO_BREAKER_MAX_MS).run); // 대기가 지나도 묶인 작업이 많음 -> 거절
+    h.ReportLate(v, IoOutcome::Ok, 5000);             // 잠든 디스크가 깨어남 -> 닫힘
+    CHECK(h.ClassOf(v) == VolumeClass::Slow);
+    CHECK(h.Admit(v, 10LL * IO_BREAKER_MAX_MS).run);
+    h.ReportLate(v, IoOutcome::Rejected, 0);          // 시작 전에 버려진 것은 표본 아님
+    CHECK(h.RetryDelayMs(v, 10LL * IO_BREAKER_MAX_MS) == -1);
+}
+
+// 가짜 파일 시스템을 GuardIo로: 연결 오류 2회 뒤에는 디스크에 가지 않음, 없음(Failed)은 차단기와 무관
+static void TestGuardedFakeFs() {
+    FakeFs fs;
+    FakeIoPlatform platform;
+    platform.fs = &fs;
+    {
+        VolumeHealth h;
+        DeadlineIoPool pool(&platform);
+        const std::wstring down = L"\\\\down\\share\\a", missing = L"m:\\a", slow = L"s:\\a";
+        fs.SetFault(L"\\\\down\\share", Fault::Unreachable);
+        fs.SetFault(L"m:", Fault::Missing);
+        fs.SetFault(L"s:", Fault::Slow, 160);
+
+        CHECK(!GuardIo(h, pool, &platform, down, [&] { return fs.Read(down); }));
+        CHECK(!GuardIo(h, pool, &platform, down, [&] { return fs.Read(down); }));
+        int calls = fs.calls;
+        int finished = 0;
+        CHECK(!GuardIo(h, pool, &platform, down, [&] { return fs.Read(down); }, [&] { finished++; }));
+        CHECK(fs.calls == calls); // 차단기 열림 -> 가짜 디스크까지 가지 않음
+        CHECK(finished == 1);     // 실행 안 함도 finished 한 번
+
+        for (int i = 0; i < 5; i++) CHECK(!GuardIo(h, pool, &platform, missing, [&] { return fs.Read(missing); }));
+        CHECK(h.ClassOf(L"m:") == VolumeClass::Fast);
+
+        CHECK(GuardIo(h, pool, &platform, slow, [&] { return fs.Read(slow); }));
+        CHECK(h.ClassOf(L"s:") == VolumeClass::Slow); // 실제 지연이 EWMA로
+        CHECK(GuardIo(h, pool, &platform, L"c:\\ok", [&] { return fs.Read(L"c:\\ok"); }));
+        pool.Stop();
+        CHECK(!GuardIo(h, pool, &platform, L"c:\\ok", [&] { return fs.Read(L"c:\\ok"); })); // 종료 뒤 -> 실행 안 함
+    }
+    CHECK(WaitUntil([&] { return platform.left == platform.entered; }, 2000)); // 쉬던 워커 종료 + 취소용 핸들 해제
+}
+
+// 멈춘 호출: 마감에 TimedOut + 취소 시도 -> 취소되면 late(Unreachable)
+static void TestDeadlineCancel() {
+    FakeFs fs;
+    FakeIoPlatform platform;
+    platform.fs = &fs;
+    {
+        DeadlineIoPool pool(&platform);
+        fs.SetFault(L"h:", Fault::Hang);
+        std::mutex m;
+        std::condition_variable cv;
+        bool gotLate = false;
+        IoOutcome lateOutcome = IoOutcome::Ok;
+        double latency = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        IoOutcome r = pool.Run([&] { return fs.Read(L"h:\\x") ? IoOutcome::Ok : t_unreachable ? IoOutcome::Unreachable : IoOutcome::Failed; },
+            50, latency, [&](IoOutcome o, double) {
+                std::lock_guard<std::mutex> lock(m);
+                gotLate = true;
+                lateOutcome = o;
+                cv.notify_all();
+            });
+        CHECK(r == IoOutcome::TimedOut);
+        CHECK(latency == 50);
+        CHECK(ElapsedMs(t0) < 1000);
+        CHECK(platform.cancels == 1);
+        std::unique_lock<std::mutex> lock(m);
+        CHECK(cv.wait_for(lock, std::chrono::seconds(2), [&] { return gotLate; }));
+        CHECK(lateOutcome == IoOutcome::Unreachable);
+    }
+    CHECK(WaitUntil([&] { return platform.left == platform.entered; }, 2000));
+}
+
+// 종료: 워커가 모두 취소 불가로 묶이면 새 작업은 줄에서 기다림 -> Stop이 버림(즉시 Rejected),
+// 늦게 끝난 작업은 late를 부르지 않고, 워커는 끝나며 핸들을 해제
+static void TestStopDropsQueued() {
+    FakeFs fs;
+    FakeIoPlatform platform;
+    platform.fs = &fs;
+    fs.SetFault(L"z:", Fault::HangUncancellable);
+    std::atomic<int> lates{ 0 };
+    {
+        DeadlineIoPool pool(&platform);
+        double latency = 0;
+        for (size_t i = 0; i < IO_MAX_WORKERS; i++) {
+            IoOutcome r = pool.Run([&] { fs.Read(L"z:\\x"); return IoOutcome::Ok; }, 5, latency, [&](IoOutcome, double) { lates++; });
+            CHECK(r == IoOutcome::TimedOut);
+        }
+        CHECK(WaitUntil([&] { return fs.hanging == (int)IO_MAX_WORKERS; }, 2000));
+        CHECK(pool.Workers() == IO_MAX_WORKERS);
+
+        IoOutcome queued = IoOutcome::Ok;
+        std::atomic<bool> ran{ false };
+        auto t0 = std::chrono::steady_clock::now();
+        std::thread caller([&] { queued = pool.Run([&] { ran = true; return IoOutcome::Ok; }, 10000, latency, nullptr); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        pool.Stop();
+        caller.join();
+        CHECK(queued == IoOutcome::Rejected);
+        CHECK(ElapsedMs(t0) < 5000);
+
+        fs.Wake(); // 묶였던 작업이 이제 끝남 -> 종료 뒤라 late 없음
+        CHECK(WaitUntil([&] { return pool.Workers() == 0; }, 2000));
+        CHECK(!ran);
+        CHECK(lates == 0);
+    }
+    CHECK(platform.left == platform.entered);
+    CHECK(platform.entered == (int)IO_MAX_WORKERS);
+}
+
+int main() {
+    TestVolumeKeys();
+    TestLatencyClasses();
+    TestBreaker();
+    TestAbandoned();
+    TestGuardedFakeFs();
+    TestDeadlineCancel();
+    TestStopDropsQueued();
+    return TestExit("io_guard_test");
+}
\ No newline at end of file
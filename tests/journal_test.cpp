@@ -0,0 +1,185 @@
+// [PRD 5.4] 저널 재생/복구: 무작위 편집을 저널로 기록한 뒤 임의 위치에서 잘라(크래시) 재생 결과 확인,
+// 캐시 검증(외부 수정 시 캐시 폐기), 압축 (전체 기록으로 바뀐 뒤의 압축 포함).
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/file_io.h"
+#include "core/journal.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+static std::wstring TestFolder(const char* name) {
+    fs::path p = fs::temp_directory_path() / "FolderMemoJournalTest" / name;
+    std::error_code ec;
+    fs::remove_all(p, ec);
+    fs::create_directories(p, ec);
+    return p.wstring();
+}
+
+// 이전 내용의 임의 구간을 임의 바이트로 치환
+static std::string RandomEdit(const std::string& prev, std::mt19937& rng) {
+    std::string next = prev;
+    size_t at = prev.empty() ? 0 : rng() % (prev.size() + 1);
+    size_t remove = prev.empty() ? 0 : std::min<size_t>(rng() % 8, prev.size() - at);
+    std::string insert;
+    for (size_t n = rng() % 24; n > 0; n--) insert.push_back((char)('a' + rng() % 26));
+    if (rng() % 4 == 0) insert += "\xED\x95\x9C\n"; // 한 + 줄바꿈
+    next.replace(at, remove, insert);
+    return next;
+}
+
+// 기록 -> (저널 길이, 그때 내용) 목록
+struct Recorded {
+    std::string base;
+    std::string journal;
+    std::vector<std::pair<uint64_t, std::string>> checkpoints; // 레코드 끝 위치 -> 내용
+};
+
+static Recorded RecordEdits(const std::wstring& folder, int edits, std::mt19937& rng) {
+    Recorded r;
+    r.base = "base line\n";
+    CHECK(WriteFileAtomic(MemoJournalStore::BasePath(folder), r.base));
+    MemoJournalStore store;
+    std::string content = r.base;
+    for (int i = 0; i < edits; i++) {
+        std::string next = RandomEdit(content, rng);
+        if (next == content) continue;
+        CHECK(store.Save(folder, next));
+        content = next;
+        std::string journal;
+        CHECK(ReadWholeFile(MemoJournalStore::JournalPath(folder), journal));
+        r.checkpoints.push_back({ journal.size(), content });
+    }
+    CHECK(ReadWholeFile(MemoJournalStore::JournalPath(folder), r.journal));
+    CHECK(store.Load(folder) == content);
+    return r;
+}
+
+// 잘린 위치 이전의 마지막 완전한 레코드까지 재생되어야 함
+static void TestTruncation() {
+    std::mt19937 rng(12345);
+    std::wstring folder = TestFolder("truncate");
+    Recorded r = RecordEdits(folder, 200, rng);
+    CHECK(!r.checkpoints.empty());
+
+    for (int trial = 0; trial < 2000; trial++) {
+        size_t cut = rng() % (r.journal.size() + 1);
+        std::string expect = r.base;
+        uint64_t expectLen = cut >= JOURNAL_HEADER_SIZE ? JOURNAL_HEADER_SIZE : 0;
+        for (const auto& cp : r.checkpoints) {
+            if (cp.first > cut) break;
+            expect = cp.second;
+            expectLen = cp.first;
+        }
+        uint64_t validLen = 0;
+        std::string got = ReplayJournal(r.base, r.journal.substr(0, cut), validLen);
+        CHECK(got == expect);
+        CHECK(validLen == expectLen);
+    }
+
+    // 바이트 하나가 깨짐 -> 그 레코드부터 재생 중단
+    for (int trial = 0; trial < 500; trial++) {
+        std::string broken = r.journal;
+        size_t at = JOURNAL_HEADER_SIZE + rng() % (broken.size() - JOURNAL_HEADER_SIZE);
+        broken[at] ^= (char)(1 + rng() % 255);
+        std::string expect = r.base;
+        for (const auto& cp : r.checkpoints) {
+            if (cp.first > at) break;
+            expect = cp.second;
+        }
+        uint64_t validLen = 0;
+        CHECK(ReplayJournal(r.base, broken, validLen) == expect);
+        CHECK(validLen <= at);
+    }
+
+    // 기준 파일이 바뀜 (압축 완료 후 저널 삭제 전 크래시) -> 저널 무시
+    uint64_t validLen = 1;
+    CHECK(ReplayJournal(r.base + "x", r.journal, validLen) == r.base + "x");
+    CHECK(validLen == 0);
+}
+
+// 크래시로 잘린 저널에서 새 프로세스가 복구 -> 다음 기록이 쓰레기 꼬리를 잘라내고 이어 씀
+static void TestRecoveryAfterCrash() {
+    std::mt19937 rng(777);
+    for (int trial = 0; trial < 40; trial++) {
+        std::wstring folder = TestFolder("recover");
+        Recorded r = RecordEdits(folder, 30, rng);
+        size_t cut = JOURNAL_HEADER_SIZE + rng() % (r.journal.size() - JOURNAL_HEADER_SIZE + 1);
+        CHECK(WriteFileAtomic(MemoJournalStore::JournalPath(folder), r.journal.substr(0, cut)));
+        std::string expect = r.base;
+        for (const auto& cp : r.checkpoints) {
+            if (cp.first > cut) break;
+            expect = cp.second;
+        }
+
+        MemoJournalStore store;
+        CHECK(store.Load(folder) == expect);
+        std::string next = expect + "after crash\n";
+        CHECK(store.Save(folder, next));
+
+        MemoJournalStore reopened;
+        CHECK(reopened.Load(folder) == next);
+        reopened.Compact(folder);
+        std::string base;
+        CHECK(ReadWholeFile(MemoJournalStore::BasePath(folder), base));
+        CHECK(base == next);
+        CHECK(!fs::exists(MemoJournalStore::JournalPath(folder)));
+    }
+}
+
+// 캐시된 상태는 디스크가 바뀌면 버려야 함
+static void TestCacheValidation() {
+    std::wstring folder = TestFolder("cache");
+    CHECK(WriteFileAtomic(MemoJournalStore::BasePath(folder), "one\n"));
+    MemoJournalStore store;
+    CHECK(store.Save(folder, "one\ntwo\n"));
+    CHECK(store.Load(folder) == "one\ntwo\n");
+
+    // 외부 도구가 기준 파일을 고침 -> 저널 헤더 불일치 -> 새 기준 파일이 진실
+    CHECK(WriteFileAtomic(MemoJournalStore::BasePath(folder), "edited elsewhere\n"));
+    CHECK(store.Load(folder) == "edited elsewhere\n");
+
+    // 그 위에 이어 쓴 편집은 새 기준 기준으로 기록되어 살아남음
+    CHECK(store.Save(folder, "edited elsewhere\nand here\n"));
+    MemoJournalStore reopened;
+    CHECK(reopened.Load(folder) == "edited elsewhere\nand here\n");
+
+    // 다른 프로세스가 저널을 접고 지움 -> 캐시 폐기 후 기준 파일만
+    reopened.Compact(folder);
+    CHECK(WriteFileAtomic(MemoJournalStore::BasePath(folder), "compacted by another process\n"));
+    CHECK(store.Load(folder) == "compacted by another process\n");
+}
+
+// 저널로 기록한 뒤 전체 기록(작아진 큰 메모)으로 기준 파일을 바꾸고 저널을 지움 -> 압축이 캐시된 옛 내용으로 덮어쓰면 안 됨
+static void TestCompactAfterFullWrite() {
+    std::wstring folder = TestFolder("fullwrite");
+    CHECK(WriteFileAtomic(MemoJournalStore::BasePath(folder), "big memo\n"));
+    MemoJournalStore store;
+    CHECK(store.Save(folder, "big memo\nmore\n"));
+    CHECK(fs::exists(MemoJournalStore::JournalPath(folder)));
+
+    CHECK(WriteFileAtomic(MemoJournalStore::BasePath(folder), "small\n"));
+    fs::remove(MemoJournalStore::JournalPath(folder));
+    store.Compact(folder);
+    std::string base;
+    CHECK(ReadWholeFile(MemoJournalStore::BasePath(folder), base));
+    CHECK(base == "small\n");
+
+    // 다시 저널로 -> 새 기준 위에 기록
+    CHECK(store.Save(folder, "small\nagain\n"));
+    store.Compact(folder);
+    CHECK(ReadWholeFile(MemoJournalStore::BasePath(folder), base));
+    CHECK(base == "small\nagain\n");
+    CHECK(!fs::exists(MemoJournalStore::JournalPath(folder)));
+}
+
+int main() {
+    TestTruncation();
+    TestRecoveryAfterCrash();
+    TestCacheValidation();
+    TestCompactAfterFullWrite();
+    return TestExit("journal_test");
+}
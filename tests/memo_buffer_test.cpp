@@ -0,0 +1,114 @@
+// [PRD 5.11] 편집 버퍼: 무작위 편집(서로게이트 쌍 포함)마다 전체 재인코딩과 같은지, 저장 사본 공유, UTF-8에서 바로 gram 추출
+// --bench [--keys N]: 합성 입력 세션 (RunEditBench, 앱의 --edit-bench와 같음). 저장 열은 Writer가 하는 일 전부를 잼
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/edit_bench.h"
+#include "core/grams.h"
+#include "core/memo_buffer.h"
+#include "core/utf.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+static void Append(std::wstring& s, char32_t cp) {
+    if (sizeof(wchar_t) == 2 && cp >= 0x10000) {
+        cp -= 0x10000;
+        s.push_back((wchar_t)(0xD800 + (cp >> 10)));
+        s.push_back((wchar_t)(0xDC00 + (cp & 0x3FF)));
+    } else {
+        s.push_back((wchar_t)cp);
+    }
+}
+
+static std::wstring RandomText(std::mt19937& rng, size_t chars) {
+    static const char32_t pool[] = { U'a', U'Z', U' ', U'\r', U'\n', U'가', U'힣', U'é', U'中', U'😀', U'𝄞' };
+    std::wstring s;
+    for (size_t i = 0; i < chars; i++) Append(s, pool[rng() % (sizeof(pool) / sizeof(pool[0]))]);
+    return s;
+}
+
+static bool Matches(MemoBuffer& buffer, const std::wstring& doc) {
+    std::string expect;
+    WideToUtf8(doc.data(), doc.size(), expect);
+    return *buffer.Snapshot() == expect && buffer.Equals(doc.data(), doc.size()) && buffer.Length() == doc.size();
+}
+
+// 편집창처럼 문서를 고치고 ApplyChange (실패하면 앱처럼 LoadText) -> 매번 전체 재인코딩과 비교
+static void TestRandomEdits() {
+    std::mt19937 rng(11);
+    for (int trial = 0; trial < 60; trial++) {
+        std::wstring doc = RandomText(rng, rng() % 3000);
+        MemoBuffer buffer;
+        std::string bytes;
+        WideToUtf8(doc.data(), doc.size(), bytes);
+        CHECK(buffer.LoadUtf8(bytes));
+        size_t caret = doc.empty() ? 0 : rng() % doc.size();
+        for (int e = 0; e < 300; e++) {
+            size_t pos = std::min(caret, doc.size()), del = 0;
+            int kind = (int)(rng() % 6);
+            std::wstring ins;
+            if (kind <= 2) ins = RandomText(rng, 1);                                   // 입력 (서로게이트 쌍이면 2단위)
+            else if (kind == 3) del = std::min<size_t>(doc.size() - pos, 1 + rng() % 3); // Delete
+            else if (kind == 4 && pos) { size_t n = std::min<size_t>(pos, 1 + rng() % 3); pos -= n; del = n; } // Backspace
+            else ins = RandomText(rng, rng() % 40), del = std::min<size_t>(doc.size() - pos, rng() % 20); // 붙여넣기/덮어쓰기
+            // 편집창은 서로게이트 쌍 가운데를 자르지 않음
+            if (sizeof(wchar_t) == 2) {
+                if (pos > 0 && pos < doc.size() && doc[pos] >= 0xDC00 && doc[pos] <= 0xDFFF) { pos--; if (del) del++; }
+                size_t end = pos + del;
+                if (end > 0 && end < doc.size() && doc[end] >= 0xDC00 && doc[end] <= 0xDFFF) del++;
+            }
+            if (!del && ins.empty()) continue;
+            doc.replace(pos, del, ins);
+            caret = pos + ins.size();
+            if (!buffer.ApplyChange(doc.data(), doc.size(), caret)) buffer.LoadText(doc.data(), doc.size());
+            if (rng() % 7 == 0) caret = doc.empty() ? 0 : rng() % (doc.size() + 1); // 캐럿 이동
+            bool same = Matches(buffer, doc);
+            CHECK(same);
+            if (!same) return; // 첫 실패만 보고
+        }
+    }
+}
+
+// 기록 중(또는 캐시/색인이 들고 있는) 사본은 이후 편집에 바뀌지 않음
+static void TestSnapshotSharing() {
+    std::wstring doc = L"hello 메모\n";
+    MemoBuffer buffer;
+    buffer.LoadText(doc.data(), doc.size());
+    std::shared_ptr<const std::string> held = buffer.Snapshot();
+    std::string before = *held;
+    doc += L"more";
+    CHECK(buffer.ApplyChange(doc.data(), doc.size(), doc.size()));
+    std::shared_ptr<const std::string> next = buffer.Snapshot();
+    CHECK(*held == before);
+    CHECK(*next == WideToUtf8(doc));
+    CHECK(buffer.Snapshot() == next); // 바뀐 것이 없으면 같은 사본
+}
+
+static void TestGramsUtf8() {
+    std::mt19937 rng(3);
+    std::vector<uint32_t> a, b;
+    for (int i = 0; i < 50; i++) {
+        std::wstring text = RandomText(rng, rng() % 500) + L" Search 검색어, TEST!";
+        std::string bytes = WideToUtf8(text);
+        ExtractGrams(Utf8ToWide(bytes), a);
+        ExtractGramsUtf8(bytes.data(), bytes.size(), b);
+        CHECK(a == b);
+    }
+    ExtractGramsUtf8("Ab b", 4, a);
+    CHECK(a.size() == 3); // a, b, ab (대소문자 접음, 공백에서 끊김)
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        bool ok = RunEditBench((size_t)ArgInt(argc, argv, "--keys", 20000), fs::temp_directory_path() / "FolderMemoEditBench",
+            [](const std::wstring& line) { std::printf("%s\n", WideToUtf8(line).c_str()); });
+        return ok ? 0 : 1;
+    }
+    TestRandomEdits();
+    TestSnapshotSharing();
+    TestGramsUtf8();
+    return TestExit("memo_buffer_test");
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+// [PRD 3.4] 메모 내용 캐시: 스탬프 검증, LRU 제거, 예산/큰 메모 제외, 무효화, 지연 디코드 공유
+// --bench [--steps N] [--mb M]: 합성 탐색 재생으로 캐시 없음/있음 비교 (Win32 앱의 --memo-cache-bench와 같은 코드)
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/memo_cache.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+static MemoStat Stamp(long long mtime, unsigned long long size) {
+    MemoStat st;
+    st.exists = true;
+    st.mtime = mtime;
+    st.size = size;
+    return st;
+}
+
+static std::shared_ptr<const std::string> Bytes(const std::string& s) { return std::make_shared<std::string>(s); }
+
+static void TestStampValidation() {
+    MemoContentCache cache(1024 * 1024);
+    auto bytes = Bytes("메모 memo");
+    cache.Store(L"C:\\A", bytes, Stamp(1, bytes->size()));
+    auto hit = cache.Lookup(L"c:/a/", Stamp(1, bytes->size())); // 정규화 키
+    CHECK(hit && hit->Text() == L"메모 memo");
+    CHECK(hit && hit->bytes == bytes); // 저장 사본 그대로 공유
+    CHECK(!cache.Lookup(L"C:\\A", Stamp(2, bytes->size()))); // 바뀐 파일 -> 버림
+    CHECK(cache.Stale() == 1);
+    CHECK(!cache.Lookup(L"C:\\A", Stamp(1, bytes->size()))); // 이미 제거됨
+    CHECK(cache.Hits() == 1 && cache.Misses() == 2);
+    CHECK(cache.Entries() == 0 && cache.Bytes() == 0);
+
+    std::wstring text = L"이미 디코드";
+    cache.Store(L"C:\\B", Bytes(WideToUtf8(text)), Stamp(5, 1), &text); // 편집창 채우기 -> 디코드한 것 그대로
+    hit = cache.Lookup(L"C:\\B", Stamp(5, 1));
+    CHECK(hit && hit->Text() == text);
+    cache.Invalidate(L"c:\\b");
+    CHECK(!cache.Lookup(L"C:\\B", Stamp(5, 1)));
+    CHECK(cache.Invalidations() == 1);
+    CHECK(hit && hit->Text() == text); // 조회한 쪽이 들고 있는 동안 제거되어도 안전
+}
+
+// 예산을 넘으면 가장 오래 안 쓴 것부터, 예산 1/4보다 큰 메모는 넣지 않음
+static void TestLruBudget() {
+    const size_t memo = 1000;
+    const size_t keyBytes = 4 * sizeof(wchar_t); // "C:\N"
+    const size_t cost = memo * sizeof(wchar_t) + memo + keyBytes + MEMO_CACHE_ENTRY_OVERHEAD;
+    MemoContentCache cache(cost * 4 + cost / 2); // 4개 들어감
+    std::string body(memo, 'x');
+    for (int i = 0; i < 4; i++) cache.Store(L"C:\\" + std::to_wstring(i), Bytes(body), Stamp(i, memo));
+    CHECK(cache.Entries() == 4 && cache.Bytes() == 4 * cost);
+    CHECK(cache.Lookup(L"C:\\0", Stamp(0, memo))); // 0을 최근으로
+    cache.Store(L"C:\\4", Bytes(body), Stamp(4, memo));
+    CHECK(cache.Evictions() == 1);
+    CHECK(!cache.Lookup(L"C:\\1", Stamp(1, memo))); // 가장 오래 안 쓴 것
+    CHECK(cache.Lookup(L"C:\\0", Stamp(0, memo)));
+    CHECK(cache.Lookup(L"C:\\4", Stamp(4, memo)));
+
+    cache.Store(L"C:\\2", Bytes(std::string(memo * 2, 'y')), Stamp(9, memo * 2)); // 1/4 초과 -> 기존 항목만 지우고 넣지 않음
+    CHECK(!cache.Lookup(L"C:\\2", Stamp(9, memo * 2)));
+    CHECK(!cache.Lookup(L"C:\\2", Stamp(2, memo)));
+
+    cache.SetBudget(0); // 끔 -> 모두 비움
+    CHECK(cache.Entries() == 0 && cache.Bytes() == 0);
+    cache.Store(L"C:\\5", Bytes(body), Stamp(5, memo));
+    CHECK(cache.Entries() == 0);
+}
+
+// 저장이 채운 항목: 여러 스레드가 처음 적중해도 디코드는 한 번, 모두 같은 텍스트
+static void TestConcurrentFirstDecode() {
+    MemoContentCache cache(16 * 1024 * 1024);
+    std::string body;
+    while (body.size() < 256 * 1024) body += "줄 line 𝄞\n";
+    cache.Store(L"C:\\Big", Bytes(body), Stamp(1, body.size()));
+    std::wstring expect = Utf8ToWide(body);
+    std::vector<std::thread> threads;
+    std::vector<const std::wstring*> seen(4, nullptr);
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&, i] {
+            auto hit = cache.Lookup(L"C:\\Big", Stamp(1, body.size()));
+            if (hit) seen[i] = &hit->Text();
+        });
+    }
+    for (auto& t : threads) t.join();
+    for (int i = 0; i < 4; i++) CHECK(seen[i] && seen[i] == seen[0]);
+    CHECK(seen[0] && *seen[0] == expect);
+}
+
+int main(int argc, char** argv) {
+    fs::path dir = fs::temp_directory_path() / "FolderMemoCacheBench";
+    auto print = [](const std::wstring& line) { std::printf("%ls\n", line.c_str()); std::fflush(stdout); };
+    if (HasArg(argc, argv, "--bench")) {
+        return RunMemoCacheBench(dir, (size_t)ArgInt(argc, argv, "--steps", 20000), (size_t)ArgInt(argc, argv, "--mb", 32), print) ? 0 : 1;
+    }
+    TestStampValidation();
+    TestLruBudget();
+    TestConcurrentFirstDecode();
+    CHECK(RunMemoCacheBench(dir, 300, 32, [](const std::wstring&) {})); // 작은 재생: 캐시 있음/없음이 같은 내용을 보였는지
+    return TestExit("memo_cache_test");
+}
\ No newline at end of file
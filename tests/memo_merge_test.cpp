@@ -0,0 +1,125 @@
+// [PRD 5.8] 줄 단위 3-way 병합: 깨끗한 병합, 같은 편집, 충돌, 겹치지 않는 무작위 편집
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/memo_merge.h"
+#include "tests/test_util.h"
+
+static std::string Join(const std::vector<std::string>& lines) {
+    std::string s;
+    for (const auto& l : lines) s += l + "\n";
+    return s;
+}
+
+static void TestClean() {
+    std::string base = "a\nb\nc\nd\ne\n", out;
+    CHECK(MergeMemoText(base, "A\nb\nc\nd\ne\n", "a\nb\nc\nd\nE\n", out));
+    CHECK(out == "A\nb\nc\nd\nE\n");
+
+    // 한쪽은 삽입, 다른 쪽은 삭제
+    CHECK(MergeMemoText(base, "a\nb\nnew\nc\nd\ne\n", "a\nb\nc\ne\n", out));
+    CHECK(out == "a\nb\nnew\nc\ne\n");
+
+    // 한쪽만 바뀜 -> 그쪽 그대로 (마지막 줄바꿈 없음도 보존)
+    CHECK(MergeMemoText(base, base, "x\ny", out));
+    CHECK(out == "x\ny");
+    CHECK(MergeMemoText(base, "x\ny", base, out));
+    CHECK(out == "x\ny");
+
+    // 빈 기준 위 한쪽 추가
+    CHECK(MergeMemoText("", "", "hello\n", out));
+    CHECK(out == "hello\n");
+}
+
+static void TestIdentical() {
+    std::string base = "one\ntwo\nthree\n", out;
+    std::string both = "one\n2\nthree\nfour\n";
+    CHECK(MergeMemoText(base, both, both, out));
+    CHECK(out == both);
+
+    // 같은 줄을 같게 고치고 다른 곳은 각자 고침
+    CHECK(MergeMemoText("a\nb\nc\nd\ne\nf\ng\n", "a\nB\nc\nd\nE\nf\ng\n", "a\nB\nc\nd\ne\nf\nG\n", out));
+    CHECK(out == "a\nB\nc\nd\nE\nf\nG\n");
+}
+
+static void TestConflict() {
+    std::string base = "a\nb\nc\n", out;
+    CHECK(!MergeMemoText(base, "a\nmine\nc\n", "a\ntheirs\nc\n", out));
+    CHECK(out == "a\n<<<<<<< 내 편집\nmine\n=======\ntheirs\n>>>>>>> 디스크\nc\n");
+
+    // 충돌 구간 밖의 깨끗한 변경은 그대로 합쳐짐
+    CHECK(!MergeMemoText("1\n2\n3\n4\n5\n", "X\n2\nmine\n4\n5\n", "1\n2\ntheirs\n4\nY\n", out));
+    CHECK(out.find("X\n2\n<<<<<<< 내 편집\nmine\n=======\ntheirs\n>>>>>>> 디스크\n4\nY\n") == 0);
+
+    // 줄바꿈 없는 마지막 줄끼리 충돌 -> 표식이 줄 중간에 붙지 않음
+    CHECK(!MergeMemoText("z", "mine", "theirs", out));
+    CHECK(out == "<<<<<<< 내 편집\nmine\n=======\ntheirs\n>>>>>>> 디스크\n");
+}
+
+// 서로 떨어진 구간(사이에 손대지 않은 줄이 최소 1줄)만 고친 두 편집 -> 항상 깨끗이, 두 편집을 모두 적용한 결과와 같아야 함
+static void TestRandomNonOverlapping() {
+    std::mt19937 rng(2024);
+    int uid = 0;
+    for (int trial = 0; trial < 3000; trial++) {
+        int n = 3 + (int)(rng() % 40);
+        std::vector<std::string> base;
+        for (int i = 0; i < n; i++) base.push_back("base " + std::to_string(i));
+
+        // 구간 나누기: 각 base 줄은 ours(1)/theirs(2)/그대로(0) 중 하나, 편집 구간 사이에는 그대로인 줄이 있어야 함
+        std::vector<int> owner(n, 0);
+        for (int i = 0; i < n;) {
+            int len = 1 + (int)(rng() % 3);
+            int who = (int)(rng() % 3);
+            bool prevEdited = i > 0 && owner[i - 1] != 0;
+            if (prevEdited) who = 0;
+            for (int k = 0; k < len && i < n; k++, i++) owner[i] = who;
+        }
+
+        // 구간마다 교체/삭제/삽입 중 하나 (삽입은 구간 앞에 새 줄 + 원래 줄 유지)
+        std::vector<std::string> ours, theirs, expect;
+        for (int i = 0; i < n;) {
+            int j = i;
+            while (j < n && owner[j] == owner[i]) j++;
+            std::vector<std::string> orig(base.begin() + i, base.begin() + j), edited;
+            if (owner[i] == 0) {
+                edited = orig;
+            } else {
+                int kind = (int)(rng() % 3);
+                if (kind == 0) { for (int k = i; k < j; k++) edited.push_back("edit " + std::to_string(uid++)); }
+                else if (kind == 1) { /* 삭제 */ }
+                else { edited.push_back("insert " + std::to_string(uid++)); edited.insert(edited.end(), orig.begin(), orig.end()); }
+            }
+            const std::vector<std::string>& o = owner[i] == 1 ? edited : orig;
+            const std::vector<std::string>& t = owner[i] == 2 ? edited : orig;
+            ours.insert(ours.end(), o.begin(), o.end());
+            theirs.insert(theirs.end(), t.begin(), t.end());
+            expect.insert(expect.end(), edited.begin(), edited.end());
+            i = j;
+        }
+
+        std::string out;
+        bool clean = MergeMemoText(Join(base), Join(ours), Join(theirs), out);
+        CHECK(clean);
+        CHECK(out == Join(expect));
+        if (!clean || out != Join(expect)) break; // 첫 실패만 보고
+    }
+}
+
+static void TestMatchLinesMonotonic() {
+    std::vector<std::string> base, other;
+    SplitLines("a\nb\nc\nb\na\n", base);
+    SplitLines("b\na\nc\na\nb\n", other);
+    std::vector<int> m = MatchLines(base, other);
+    int last = -1;
+    for (int v : m) if (v >= 0) { CHECK(v > last); last = v; }
+}
+
+int main() {
+    TestClean();
+    TestIdentical();
+    TestConflict();
+    TestRandomNonOverlapping();
+    TestMatchLinesMonotonic();
+    return TestExit("memo_merge_test");
+}
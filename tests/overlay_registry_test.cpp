@@ -0,0 +1,215 @@
+// [PRD 4.3] 오버레이 레지스트리 + MPSC 결과 큐: 양방향 조회/제거, 같은 탐색기의 새 오버레이, 생산자별 FIFO와 유실 없음
+// --bench [--entries N] [--writers W] [--lookups L]: UI 스레드 조회 + 경로 결과를 쓰는 워커 W개.
+//   예전 = 전역 뮤텍스 아래 벡터 선형 탐색 (워커도 같은 락으로 currentPath 기록), 지금 = 해시 조회 + 워커는 큐에 Push만
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/overlay_registry.h"
+#include "tests/test_util.h"
+
+struct Pair {
+    uintptr_t hExplorer = 0;
+    uintptr_t hOverlay = 0;
+    std::wstring currentPath;
+};
+typedef BasicOverlayRegistry<Pair, uintptr_t> Registry;
+
+static Pair Make(uintptr_t explorer, uintptr_t overlay) {
+    Pair p;
+    p.hExplorer = explorer;
+    p.hOverlay = overlay;
+    return p;
+}
+
+static void TestRegistry() {
+    Registry reg;
+    Pair* a = reg.Add(Make(1, 101));
+    reg.Add(Make(2, 102));
+    CHECK(reg.Size() == 2);
+    CHECK(reg.FindByExplorer(1) == a && reg.FindByOverlay(101) == a);
+    CHECK(!reg.FindByExplorer(101) && !reg.FindByOverlay(1));
+    for (uintptr_t i = 0; i < 1000; i++) reg.Add(Make(1000 + i, 5000 + i)); // 재해시 뒤에도 포인터 유지
+    CHECK(reg.FindByOverlay(101) == a);
+    a->currentPath = L"C:\\A";
+    CHECK(reg.FindByExplorer(1)->currentPath == L"C:\\A");
+
+    // 같은 탐색기에 새 오버레이 (옛 것이 아직 파괴 중) -> 탐색기 조회는 새 것, 옛 것을 지워도 새 연결 유지
+    Pair* b = reg.Add(Make(1, 201));
+    CHECK(reg.FindByExplorer(1) == b);
+    reg.RemoveByOverlay(101);
+    CHECK(reg.FindByExplorer(1) == b && !reg.FindByOverlay(101));
+    reg.RemoveByOverlay(201);
+    CHECK(!reg.FindByExplorer(1));
+    reg.RemoveByOverlay(999999); // 없는 핸들 -> 무시
+
+    size_t n = 0;
+    reg.ForEach([&n](Pair&) { n++; });
+    CHECK(n == reg.Size() && n == 1001);
+}
+
+// 생산자 여럿이 동시에 Push, 소비자가 도중에 여러 번 Drain -> 전부 한 번씩, 생산자마다 순서 유지
+static void TestMpscQueue() {
+    struct Item { int producer; int seq; };
+    MpscQueue<Item> queue;
+    const int producers = 4, perProducer = 20000;
+    std::atomic<int> done{ 0 };
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < perProducer; i++) queue.Push({ p, i });
+            done++;
+        });
+    }
+    std::vector<int> next(producers, 0);
+    size_t received = 0, outOfOrder = 0;
+    auto drain = [&] {
+        queue.DrainTo([&](Item& item) {
+            if (item.seq != next[item.producer]) outOfOrder++;
+            next[item.producer] = item.seq + 1;
+            received++;
+        });
+    };
+    while (done < producers) drain();
+    for (auto& t : threads) t.join();
+    drain();
+    CHECK(received == (size_t)producers * perProducer);
+    CHECK(outOfOrder == 0);
+
+    MpscQueue<std::wstring>* leftovers = new MpscQueue<std::wstring>();
+    leftovers->Push(L"남은 결과"); // 소멸자가 정리
+    delete leftovers;
+}
+
+// 예전 구조: std::vector<OverlayPair> g_overlays + g_overlayMutex
+struct LockedVector {
+    std::mutex mutex;
+    std::vector<Pair> pairs;
+
+    bool Touch(uintptr_t hExplorer) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Pair& p : pairs) if (p.hExplorer == hExplorer) return true;
+        return false;
+    }
+    void SetPath(uintptr_t hOverlay, const std::wstring& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Pair& p : pairs) if (p.hOverlay == hOverlay) { p.currentPath = path; return; }
+    }
+};
+
+struct Result {
+    uintptr_t hOverlay;
+    std::wstring path;
+};
+
+// 조회 BATCH번씩 묶어 잰 lookup당 시간 -> 중앙값/꼬리 (꼬리 = 워커가 락을 잡고 있던 구간)
+const size_t BATCH = 256;
+
+static void PrintLookups(const char* label, std::vector<double>& batchNs, double ms, unsigned long long updates) {
+    std::sort(batchNs.begin(), batchNs.end());
+    auto at = [&](double q) { return batchNs[(size_t)(q * (batchNs.size() - 1) + 0.5)] / BATCH; };
+    std::printf("%s: %.1f ns/lookup p50, %.1f p99, %.1f max, %.0f writer updates/ms\n", label, at(0.5), at(0.99), at(1.0),
+        (double)updates / ms);
+    std::fflush(stdout);
+}
+
+static void WaitStarted(std::atomic<int>& started, int writers) {
+    while (started < writers) std::this_thread::yield();
+}
+
+static void RunBench(size_t entries, int writers, size_t lookups) {
+    std::printf("registry: %zu overlays, %d resolver writers, %zu UI lookups (LOCATIONCHANGE/WM_PAINT pattern)\n",
+        entries, writers, lookups);
+    std::fflush(stdout);
+    std::vector<uintptr_t> order(lookups);
+    for (size_t i = 0; i < lookups; i++) order[i] = 1 + (i * 2654435761u) % entries; // 흩어진 탐색기 핸들
+    lookups -= lookups % BATCH;
+
+    // 예전
+    {
+        LockedVector old;
+        for (size_t i = 1; i <= entries; i++) old.pairs.push_back(Make(i, 100000000 + i));
+        std::atomic<bool> stop{ false };
+        std::atomic<int> started{ 0 };
+        std::atomic<unsigned long long> written{ 0 };
+        std::vector<std::thread> threads;
+        for (int w = 0; w < writers; w++) {
+            threads.emplace_back([&, w] {
+                started++;
+                for (size_t i = w; !stop; i += writers) {
+                    old.SetPath(100000000 + 1 + i % entries, L"C:\\Path");
+                    written++;
+                }
+            });
+        }
+        WaitStarted(started, writers);
+        std::vector<double> batchNs;
+        size_t hits = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < lookups; b += BATCH) {
+            auto tb = std::chrono::steady_clock::now();
+            for (size_t i = b; i < b + BATCH; i++) hits += old.Touch(order[i]);
+            batchNs.push_back(ElapsedMs(tb) * 1e6);
+        }
+        double ms = ElapsedMs(t0);
+        stop = true;
+        for (auto& t : threads) t.join();
+        PrintLookups("before (vector + global mutex)", batchNs, ms, written.load());
+        CHECK(hits == lookups);
+    }
+
+    // 지금: UI 스레드 전용 레지스트리, 워커는 큐로만
+    {
+        Registry reg;
+        for (size_t i = 1; i <= entries; i++) reg.Add(Make(i, 100000000 + i));
+        MpscQueue<Result> results;
+        std::atomic<bool> stop{ false };
+        std::atomic<int> started{ 0 };
+        std::atomic<unsigned long long> pushed{ 0 };
+        std::vector<std::thread> threads;
+        for (int w = 0; w < writers; w++) {
+            threads.emplace_back([&, w] {
+                started++;
+                for (size_t i = w; !stop; i += writers) {
+                    results.Push({ 100000000 + 1 + i % entries, L"C:\\Path" });
+                    pushed++;
+                    if (pushed % 64 == 0) std::this_thread::yield(); // 실제 워커는 Shell 조회 사이에만 Push
+                }
+            });
+        }
+        WaitStarted(started, writers);
+        std::vector<double> batchNs;
+        size_t hits = 0, applied = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < lookups; b += BATCH) {
+            auto tb = std::chrono::steady_clock::now();
+            for (size_t i = b; i < b + BATCH; i++) hits += reg.FindByExplorer(order[i]) != nullptr;
+            batchNs.push_back(ElapsedMs(tb) * 1e6);
+            results.DrainTo([&](Result& r) { // 메시지 루프가 사이사이 WM_APP 결과 처리 (조회 시간에는 넣지 않음)
+                if (Pair* q = reg.FindByOverlay(r.hOverlay)) { q->currentPath = r.path; applied++; }
+            });
+        }
+        double ms = ElapsedMs(t0);
+        stop = true;
+        for (auto& t : threads) t.join();
+        results.DrainTo([&](Result&) { applied++; });
+        PrintLookups("after (hash registry + MPSC queue)", batchNs, ms, pushed.load());
+        CHECK(applied == pushed.load());
+        CHECK(hits == lookups);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((size_t)ArgInt(argc, argv, "--entries", 5000), (int)ArgInt(argc, argv, "--writers", 4),
+            (size_t)ArgInt(argc, argv, "--lookups", 200000));
+        return TestExit("overlay_registry_bench");
+    }
+    TestRegistry();
+    TestMpscQueue();
+    return TestExit("overlay_registry_test");
+}
\ No newline at end of file
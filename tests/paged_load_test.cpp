@@ -0,0 +1,267 @@
+// [PRD 5.5] 분할 로딩 + 가짜 UI 큐: 첫 화면은 줄 끝에서 자름, 청크가 UTF-8 문자를 자르지 않음, 이어 붙인 결과 = 전체 디코드,
+//   마지막 청크의 SHA-256 = 파일 해시, 전송 중 청크 PAGED_MAX_INFLIGHT 이하, 취소 시 워커가 바로 멈춤
+// --bench [--sizes 1,4,16,64] (MB): 크기별로 예전(읽기 -> 변환 -> wstring -> 편집창 복사, 모두 UI 스레드)과 지금(매핑 + 첫 화면,
+//   나머지는 워커)의 첫 화면까지 시간, 전체 완료 시간, 최대 RSS 증가 (/proc/self/clear_refs로 구간마다 VmHWM 초기화)
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/paged_load.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+typedef int FakeHwnd;
+typedef BasicPagedMemoLoad<FakeHwnd> Load;
+typedef BasicMemoChunk<FakeHwnd> Chunk;
+
+// PostMessage + 메시지 루프 대신: 워커가 넣고 UI 스레드(테스트 본문)가 꺼냄
+class FakeUiQueue {
+public:
+    bool Post(Chunk* chunk) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed) return false; // 창이 사라짐
+        m_chunks.push_back(chunk);
+        m_cv.notify_one();
+        return true;
+    }
+    Chunk* Wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [&] { return !m_chunks.empty(); });
+        Chunk* c = m_chunks.front();
+        m_chunks.pop_front();
+        return c;
+    }
+    size_t Pending() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_chunks.size();
+    }
+    void Close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        for (Chunk* c : m_chunks) delete c;
+        m_chunks.clear();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Chunk*> m_chunks;
+    bool m_closed = false;
+};
+
+// 로그형 메모: 한글/영문 줄 (UTF-8 1~3바이트 글자가 섞여 청크 경계가 문자 중간에 걸리기 쉬움)
+static std::string MakeMemo(size_t bytes) {
+    std::string out;
+    out.reserve(bytes + 128);
+    for (unsigned n = 0; out.size() < bytes; n++) {
+        out += "2024-03-" + std::to_string(n % 28 + 1) + " ";
+        out += (n % 3 == 0) ? u8"배포 완료: 서버 " : (n % 3 == 1) ? u8"회의록 — 검토 필요 ✓ " : "build ok, cache hit ";
+        out += std::to_string(n) + "\n";
+    }
+    return out;
+}
+
+static fs::path WriteTemp(const char* name, const std::string& bytes) {
+    fs::path dir = fs::temp_directory_path() / "FolderMemoPagedTest";
+    fs::create_directories(dir);
+    fs::path p = dir / name;
+    CHECK(WriteFileAtomic(p, bytes));
+    return p;
+}
+
+// main.cpp의 BeginPagedLoad + AppendMemoChunk 흐름 (편집창 = wstring)
+struct PagedResult {
+    double firstMs = 0, totalMs = 0;
+    int maxInFlight = 0;
+    size_t chunks = 0;
+};
+
+static PagedResult LoadPaged(const fs::path& p, std::wstring& edit, Sha256::Digest& digest) {
+    PagedResult r;
+    auto load = std::make_shared<Load>();
+    FakeUiQueue ui;
+    CHECK(load->Open(p));
+    std::wstring first;
+    load->FirstScreen(first);
+    edit = first; // SetDlgItemTextW
+    r.firstMs = ElapsedMs(load->started);
+    if (load->Complete()) {
+        r.totalMs = r.firstMs;
+        return r;
+    }
+    std::thread worker([&] { RunPagedLoadWorker(load, [&](Chunk* c) { return ui.Post(c); }); });
+    for (;;) {
+        std::unique_ptr<Chunk> chunk(ui.Wait());
+        {
+            std::lock_guard<std::mutex> lock(load->mutex);
+            r.maxInFlight = std::max(r.maxInFlight, load->inFlight);
+        }
+        load->ChunkConsumed();
+        edit += chunk->text; // EM_REPLACESEL (끝에 이어 붙임)
+        r.chunks++;
+        if (chunk->last) { digest = chunk->digest; break; }
+    }
+    r.totalMs = ElapsedMs(load->started);
+    worker.join();
+    return r;
+}
+
+static void TestChunkEnd() {
+    std::string s = u8"가나다\nabc";
+    // 3바이트 글자 중간에서 자르려 하면 글자 앞으로
+    CHECK(Utf8ChunkEnd(s.data(), 0, s.size(), 4, false) == 3);
+    CHECK(Utf8ChunkEnd(s.data(), 0, s.size(), 8, false) == 6);
+    // 줄 끝 선호: 절반 이후의 마지막 '\n' 다음
+    CHECK(Utf8ChunkEnd(s.data(), 0, s.size(), 12, true) == 10);
+    CHECK(Utf8ChunkEnd(s.data(), 0, s.size(), 100, true) == s.size());
+}
+
+static void TestLoad() {
+    std::string bytes = MakeMemo(3 * 1024 * 1024 + 777);
+    fs::path p = WriteTemp("memo3.txt", bytes);
+    std::wstring edit;
+    Sha256::Digest digest{};
+    PagedResult r = LoadPaged(p, edit, digest);
+    CHECK(edit == Utf8ToWide(bytes)); // 청크 경계가 글자를 자르지 않음
+    CHECK(digest == Sha256::Of(bytes.data(), bytes.size()));
+    CHECK(r.maxInFlight <= PAGED_MAX_INFLIGHT);
+    CHECK(r.chunks >= bytes.size() / PAGED_CHUNK_BYTES);
+
+    // 첫 화면은 PAGED_FIRST_BYTES 이하, 줄 끝에서 끝남
+    Load load;
+    CHECK(load.Open(p));
+    CHECK(load.firstEnd <= PAGED_FIRST_BYTES && load.firstEnd > PAGED_FIRST_BYTES / 2 && bytes[load.firstEnd - 1] == '\n');
+    CHECK(!load.Complete());
+
+    // 작은 파일은 첫 화면이 전부
+    Load small;
+    CHECK(small.Open(WriteTemp("small.txt", MakeMemo(1000))));
+    CHECK(small.Complete());
+    Load empty;
+    CHECK(!empty.Open(WriteTemp("empty.txt", ""))); // 빈 파일은 매핑 안 함 -> 일반 로딩
+}
+
+// UI가 청크를 받지 않으면 워커는 PAGED_MAX_INFLIGHT에서 멈춤 -> 취소하면 바로 끝남. 창이 닫히면 청크를 버리고 끝남
+static void TestCancel() {
+    fs::path p = WriteTemp("memo8.txt", MakeMemo(8 * 1024 * 1024));
+    {
+        auto load = std::make_shared<Load>();
+        CHECK(load->Open(p));
+        FakeUiQueue ui;
+        std::thread worker([&] { RunPagedLoadWorker(load, [&](Chunk* c) { return ui.Post(c); }); });
+        for (int i = 0; i < 200 && ui.Pending() < (size_t)PAGED_MAX_INFLIGHT; i++) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK(ui.Pending() == (size_t)PAGED_MAX_INFLIGHT); // 상한에서 대기 중
+        auto t0 = std::chrono::steady_clock::now();
+        load->Cancel();
+        worker.join();
+        CHECK(ElapsedMs(t0) < 100);
+        ui.Close();
+    }
+    {
+        auto load = std::make_shared<Load>();
+        CHECK(load->Open(p));
+        FakeUiQueue ui;
+        ui.Close();
+        RunPagedLoadWorker(load, [&](Chunk* c) { return ui.Post(c); }); // 첫 전달 실패 -> 바로 반환
+        CHECK(load->inFlight == 1);
+    }
+}
+
+#ifdef __linux__
+// 최대 RSS (KB). clear_refs에 5를 쓰면 VmHWM이 현재 RSS로 초기화됨
+static long ReadStatusKb(const char* key) {
+    std::ifstream f("/proc/self/status");
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.compare(0, std::strlen(key), key) == 0) return std::atol(line.c_str() + std::strlen(key) + 1);
+    }
+    return -1;
+}
+static void ResetPeak() { std::ofstream("/proc/self/clear_refs") << "5"; }
+#else
+static long ReadStatusKb(const char*) { return -1; }
+static void ResetPeak() {}
+#endif
+
+static void RunBench(const std::string& sizes) {
+    std::printf("paged load: sizes in MB, text MB = one decoded copy, wchar_t = %zu bytes (UTF-16 on Windows is half)\n", sizeof(wchar_t));
+    std::printf("%8s %8s | %28s | %28s\n", "", "", "before (read+convert on UI)", "after (mapped, chunked)");
+    std::printf("%8s %8s | %8s %8s %10s | %8s %8s %10s\n", "file MB", "text MB", "first ms", "total ms", "peak +MB", "first ms",
+        "total ms", "peak +MB");
+    size_t start = 0;
+    while (start < sizes.size()) {
+        size_t comma = sizes.find(',', start);
+        if (comma == std::string::npos) comma = sizes.size();
+        int mb = std::atoi(sizes.substr(start, comma - start).c_str());
+        start = comma + 1;
+        if (mb <= 0) continue;
+        std::string bytes = MakeMemo((size_t)mb * 1024 * 1024);
+        fs::path p = WriteTemp("bench.txt", bytes);
+        std::wstring expected = Utf8ToWide(bytes);
+        bytes.clear();
+        bytes.shrink_to_fit();
+
+        // 예전 LoadMemo: vector<char> -> vector<wchar_t> -> wstring -> 편집창 사본 (모두 UI 스레드, 끝나야 첫 화면)
+        double beforeFirst, beforePeak;
+        {
+            long base = ReadStatusKb("VmRSS:");
+            ResetPeak();
+            auto t0 = std::chrono::steady_clock::now();
+            std::wstring edit;
+            {
+                std::string raw;
+                ReadWholeFile(p, raw);
+                std::vector<char> file(raw.begin(), raw.end());
+                raw.clear();
+                raw.shrink_to_fit();
+                std::wstring decoded;
+                Utf8ToWide(file.data(), file.size(), decoded);
+                std::vector<wchar_t> wide(decoded.begin(), decoded.end());
+                decoded.clear();
+                decoded.shrink_to_fit();
+                std::wstring text(wide.begin(), wide.end());
+                edit.assign(text.begin(), text.end()); // SetDlgItemTextW 안의 복사
+            }
+            beforeFirst = ElapsedMs(t0);
+            beforePeak = (ReadStatusKb("VmHWM:") - base) / 1024.0;
+            CHECK(edit == expected);
+        }
+        PagedResult after;
+        double afterPeak;
+        {
+            std::wstring edit;
+            Sha256::Digest digest{};
+            long base = ReadStatusKb("VmRSS:");
+            ResetPeak();
+            after = LoadPaged(p, edit, digest);
+            afterPeak = (ReadStatusKb("VmHWM:") - base) / 1024.0;
+            CHECK(edit == expected);
+        }
+        std::printf("%8d %8.1f | %8.2f %8.1f %10.1f | %8.3f %8.1f %10.1f\n", mb, expected.size() * sizeof(wchar_t) / 1048576.0,
+            beforeFirst, beforeFirst, beforePeak, after.firstMs, after.totalMs, afterPeak);
+        std::fflush(stdout);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        std::string sizes = "1,4,16,64";
+        for (int i = 1; i + 1 < argc; i++) if (std::strcmp(argv[i], "--sizes") == 0) sizes = argv[i + 1];
+        RunBench(sizes);
+        return TestExit("paged_load_bench");
+    }
+    TestChunkEnd();
+    TestLoad();
+    TestCancel();
+    return TestExit("paged_load_test");
+}
\ No newline at end of file
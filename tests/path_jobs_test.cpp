@@ -0,0 +1,210 @@
+// [PRD 3.1.2] 경로 탐색 워커 풀: 창별 직렬화, 대기 요청 병합, 세대 번호로 옛 결과 폐기, 취소, 재시도 대기 깨우기
+// --bench [--events N] [--windows W] [--job-us U] [--gap-us G]: 빠른 폴더 이동 N번 (작업 하나 U µs, 이벤트 간격 G µs).
+//   예전 = 이벤트마다 새 스레드, 지금 = 워커 PATH_WORKER_COUNT개. UI 스레드 비용/실행된 작업 수/전체 소요
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/overlay_registry.h"
+#include "core/path_jobs.h"
+#include "tests/test_util.h"
+
+typedef uintptr_t Handle;
+using Clock = std::chrono::steady_clock;
+
+static void Spin(int us) {
+    Clock::time_point until = Clock::now() + std::chrono::microseconds(us);
+    while (Clock::now() < until) {}
+}
+
+struct Result {
+    Handle hExplorer;
+    unsigned long long generation;
+};
+
+// 무작위 Submit/Cancel 폭주 -> 같은 창 작업은 동시에 돌지 않고, UI가 마지막으로 받아들인 결과 = 마지막 요청
+static void TestStress() {
+    const int windows = 16, events = 20000;
+    std::vector<std::atomic<int>> running(windows);
+    std::atomic<int> overlap{ 0 }, started{ 0 }, exited{ 0 };
+    std::atomic<unsigned long long> jobs{ 0 };
+    MpscQueue<Result> results;
+    BasicPathJobPool<Handle>* pool = nullptr;
+    BasicPathJobPool<Handle> jobsPool(
+        [&](Handle, Handle hExplorer, unsigned long long gen) {
+            if (running[hExplorer]++ != 0) overlap++;
+            jobs++;
+            Spin(20);
+            if (pool->IsLatest(hExplorer, gen)) results.Push({ hExplorer, gen });
+            running[hExplorer]--;
+        },
+        [&] { started++; }, [&] { exited++; });
+    pool = &jobsPool;
+    jobsPool.Start(4);
+
+    std::vector<unsigned long long> latest(windows, 0), applied(windows, 0);
+    std::vector<bool> cancelled(windows, false);
+    auto drain = [&] {
+        results.DrainTo([&](Result& r) {
+            if (r.generation == latest[r.hExplorer]) applied[r.hExplorer] = r.generation; // 옛 세대는 버림
+        });
+    };
+    std::mt19937 rng(7);
+    for (int n = 0; n < events; n++) {
+        Handle w = rng() % windows;
+        if (rng() % 50 == 0) {
+            jobsPool.Cancel(w);
+            cancelled[w] = true;
+        } else {
+            latest[w] = jobsPool.Submit(1000 + w, w);
+            cancelled[w] = false;
+        }
+        if (n % 64 == 0) drain();
+    }
+    Clock::time_point deadline = Clock::now() + std::chrono::seconds(10);
+    for (;;) {
+        drain();
+        bool settled = true;
+        for (int w = 0; w < windows; w++) if (!cancelled[w] && latest[w] && applied[w] != latest[w]) settled = false;
+        if (settled || Clock::now() > deadline) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    for (int w = 0; w < windows; w++) if (!cancelled[w] && latest[w]) CHECK(applied[w] == latest[w]);
+    CHECK(overlap == 0);
+    CHECK(jobs < (unsigned long long)events); // 병합됨
+    CHECK(jobsPool.SubmittedCount() + jobsPool.CancelledCount() <= (unsigned long long)events);
+    CHECK(jobsPool.CoalescedCount() > 0);
+    jobsPool.Stop();
+    CHECK(started == 4 && exited == 4); // COM 초기화/해제는 워커당 1번
+}
+
+// 재시도: 짧게 시작해 늘어나는 대기, 새 요청이 오면 즉시 깨어나 밀려남, 취소/창 닫힘도 즉시
+static void TestRetry() {
+    BasicPathJobPool<Handle> pool([](Handle, Handle, unsigned long long) {});
+    Handle hwnd = 5;
+
+    // 세 번째 시도에 성공 -> Resolved, 대기 = 25 + 50ms 언저리
+    unsigned long long gen = pool.Submit(1, hwnd);
+    int attempts = 0;
+    std::wstring path;
+    Clock::time_point t0 = Clock::now();
+    PathRetryResult r = RunPathRetry(pool, hwnd, gen, [](Handle) { return true; },
+        [&](Handle) { return ++attempts == 3 ? std::wstring(L"C:\\Ready") : std::wstring(); }, path);
+    CHECK(r == PathRetryResult::Resolved && path == L"C:\\Ready" && attempts == 3);
+    CHECK(ElapsedMs(t0) >= PATH_RETRY_FIRST_MS * 3 - 5 && ElapsedMs(t0) < 1000);
+
+    // 대기 중 같은 창에 새 요청 -> 긴 대기를 기다리지 않고 Superseded
+    gen = pool.Submit(1, hwnd);
+    std::thread later([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        pool.Submit(1, hwnd);
+    });
+    t0 = Clock::now();
+    attempts = 0;
+    r = RunPathRetry(pool, hwnd, gen, [](Handle) { return true; }, [&](Handle) { attempts++; return std::wstring(); }, path);
+    later.join();
+    CHECK(r == PathRetryResult::Superseded);
+    CHECK(ElapsedMs(t0) < 500);
+
+    // 취소 -> 즉시 중단
+    gen = pool.Submit(1, hwnd);
+    std::thread cancel([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        pool.Cancel(hwnd);
+    });
+    t0 = Clock::now();
+    r = RunPathRetry(pool, hwnd, gen, [](Handle) { return true; }, [](Handle) { return std::wstring(); }, path);
+    cancel.join();
+    CHECK(r == PathRetryResult::Superseded && ElapsedMs(t0) < 500);
+
+    // 창이 사라짐 -> 해석 시도 없이 ExplorerGone
+    gen = pool.Submit(1, hwnd);
+    attempts = 0;
+    r = RunPathRetry(pool, hwnd, gen, [](Handle) { return false; }, [&](Handle) { attempts++; return std::wstring(); }, path);
+    CHECK(r == PathRetryResult::ExplorerGone && attempts == 0);
+
+    // Reserve 뒤 Submit -> 일괄 결과 세대는 더 이상 최신 아님
+    unsigned long long reserved = pool.Reserve();
+    unsigned long long next = pool.Submit(1, 9);
+    CHECK(next > reserved && pool.IsLatest(9, next) && !pool.IsLatest(9, reserved));
+}
+
+static void RunBench(int events, int windows, int jobUs, int gapUs) {
+    std::printf("path jobs: %d navigation events over %d windows, %d us per job, %d us between events\n", events, windows,
+        jobUs, gapUs);
+    std::fflush(stdout);
+
+    // 예전: 이벤트마다 std::thread (detach 대신 끝에 join -> 전체 소요 측정)
+    {
+        std::vector<double> uiUs;
+        std::vector<std::thread> threads;
+        std::atomic<unsigned long long> ran{ 0 };
+        std::atomic<int> concurrent{ 0 }, peak{ 0 };
+        Clock::time_point t0 = Clock::now();
+        for (int n = 0; n < events; n++) {
+            Clock::time_point e0 = Clock::now();
+            threads.emplace_back([&] {
+                int c = ++concurrent;
+                int p = peak;
+                while (c > p && !peak.compare_exchange_weak(p, c)) {}
+                Spin(jobUs);
+                ran++;
+                concurrent--;
+            });
+            uiUs.push_back(ElapsedMs(e0) * 1000.0);
+            std::this_thread::sleep_for(std::chrono::microseconds(gapUs));
+        }
+        for (auto& t : threads) t.join();
+        double ms = ElapsedMs(t0);
+        std::sort(uiUs.begin(), uiUs.end());
+        std::printf("before (thread per event): UI p50=%.1fus p99=%.1fus, %llu jobs run, peak %d threads, %.0f ms total\n",
+            uiUs[uiUs.size() / 2], uiUs[(size_t)(0.99 * (uiUs.size() - 1))], ran.load(), peak.load(), ms);
+        std::fflush(stdout);
+    }
+
+    // 지금: 고정 풀 + 창별 병합
+    {
+        std::vector<double> uiUs;
+        std::atomic<unsigned long long> ran{ 0 };
+        std::vector<std::atomic<unsigned long long>> lastRan(windows);
+        BasicPathJobPool<Handle> pool([&](Handle, Handle hExplorer, unsigned long long gen) {
+            Spin(jobUs);
+            ran++;
+            lastRan[hExplorer] = gen;
+        });
+        pool.Start(PATH_WORKER_COUNT);
+        std::vector<unsigned long long> latest(windows, 0);
+        Clock::time_point t0 = Clock::now();
+        for (int n = 0; n < events; n++) {
+            Clock::time_point e0 = Clock::now();
+            latest[n % windows] = pool.Submit(1000 + n % windows, n % windows);
+            uiUs.push_back(ElapsedMs(e0) * 1000.0);
+            std::this_thread::sleep_for(std::chrono::microseconds(gapUs));
+        }
+        for (int w = 0; w < windows; w++) while (lastRan[w] != latest[w]) std::this_thread::yield(); // 창마다 마지막 요청까지 실행됨
+        double ms = ElapsedMs(t0);
+        pool.Stop();
+        std::sort(uiUs.begin(), uiUs.end());
+        std::printf("after (pool of %d): UI p50=%.1fus p99=%.1fus, %llu jobs run (%llu coalesced), %.0f ms total\n",
+            PATH_WORKER_COUNT, uiUs[uiUs.size() / 2], uiUs[(size_t)(0.99 * (uiUs.size() - 1))], ran.load(),
+            pool.CoalescedCount(), ms);
+        std::fflush(stdout);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--events", 5000), (int)ArgInt(argc, argv, "--windows", 8),
+            (int)ArgInt(argc, argv, "--job-us", 200), (int)ArgInt(argc, argv, "--gap-us", 100));
+        return TestExit("path_jobs_bench");
+    }
+    TestStress();
+    TestRetry();
+    return TestExit("path_jobs_test");
+}
\ No newline at end of file
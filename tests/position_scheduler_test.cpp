@@ -0,0 +1,204 @@
+// [PRD 3.2.2] 프레임 단위 위치 동기화 스케줄러 + 가짜 창 백엔드: 첫 이벤트 즉시 반영, 프레임당 트랜잭션 1번, 같은 위치 생략,
+//   유휴 프레임에서 박자 정지, 사라진 창/닫힌 오버레이 제외, 메시지 대기 시한(FrameWaitMs/RunDueFrame), 드래그 끝(Settle) 즉시 반영
+// --bench [--windows N] [--seconds S] [--event-hz H]: 드래그 폭주 (창 N개를 S초 동안 H Hz LOCATIONCHANGE, 가상 시계)
+//   -> 받은 이벤트 수 vs 이동 수/트랜잭션 수 (예전 = 이벤트마다 SetWindowPos 1번) + 이벤트당 UI 시간
+#include <cstdio>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/position_scheduler.h"
+#include "tests/test_util.h"
+
+typedef int FakeHwnd;
+typedef BasicOverlayPositionScheduler<FakeHwnd> Scheduler;
+
+// 탐색기 프레임 표 + 적용된 이동 기록 (오버레이 = 탐색기 + 1000)
+class FakeWindowOps : public BasicOverlayWindowOps<FakeHwnd> {
+public:
+    struct Frame { int right, bottom; };
+    std::unordered_map<FakeHwnd, Frame> explorers;
+    std::unordered_map<FakeHwnd, OverlayRect> overlays; // 마지막으로 적용된 위치
+    unsigned long long frameQueries = 0;
+    unsigned long long transactions = 0;
+    unsigned long long moves = 0;
+
+    bool GetExplorerFrame(FakeHwnd hExplorer, int& right, int& bottom) override {
+        frameQueries++;
+        auto it = explorers.find(hExplorer);
+        if (it == explorers.end()) return false;
+        right = it->second.right;
+        bottom = it->second.bottom;
+        return true;
+    }
+    void MoveOverlays(const std::vector<std::pair<FakeHwnd, OverlayRect>>& batch) override {
+        transactions++;
+        for (const auto& m : batch) { overlays[m.first] = m.second; moves++; }
+    }
+
+    // main.cpp의 OverlayTargetRect + ComputeOverlayRect와 같은 모양 (우측 하단 기준)
+    Scheduler::TargetFn Target() {
+        return [this](FakeHwnd hOverlay, OverlayRect& out) {
+            int right, bottom;
+            if (!GetExplorerFrame(hOverlay - 1000, right, bottom)) return false;
+            out = { right - 225, bottom - 125, 200, 100 };
+            return true;
+        };
+    }
+};
+
+static void TestPacing() {
+    FakeWindowOps ops;
+    Scheduler sched(&ops);
+    auto target = ops.Target();
+    ops.explorers[1] = { 800, 600 };
+    ops.explorers[2] = { 1600, 900 };
+
+    // 첫 이벤트 -> 즉시 이동 + 박자 시작
+    CHECK(sched.Schedule(1001, target));
+    CHECK(sched.Pacing() && ops.transactions == 1 && ops.overlays[1001].x == 575);
+
+    // 같은 프레임 안의 이벤트 여럿 -> 표시만 (이동 없음)
+    for (int i = 0; i < 10; i++) {
+        ops.explorers[1].right += 5;
+        ops.explorers[2].bottom += 3;
+        CHECK(!sched.Schedule(1001, target));
+        CHECK(!sched.Schedule(1002, target));
+    }
+    CHECK(ops.transactions == 1);
+
+    // 프레임: Dirty 둘 -> 트랜잭션 1번에 이동 2개, 최종 위치
+    CHECK(sched.OnFrame(target));
+    CHECK(ops.transactions == 2 && ops.moves == 3);
+    CHECK(ops.overlays[1001].x == 850 - 225 && ops.overlays[1002].y == 930 - 125);
+
+    // 위치가 안 바뀐 이벤트 (포커스 변경 등) -> 이동 생략
+    CHECK(!sched.Schedule(1001, target));
+    CHECK(sched.OnFrame(target));
+    CHECK(ops.transactions == 2 && sched.MovesSkipped() == 1);
+
+    // Dirty 없는 프레임 -> 박자 정지, 다음 이벤트는 다시 즉시
+    CHECK(!sched.OnFrame(target));
+    CHECK(!sched.Pacing());
+    ops.explorers[2].right = 1000;
+    CHECK(sched.Schedule(1002, target));
+    CHECK(ops.transactions == 3 && ops.overlays[1002].x == 775);
+
+    CHECK(sched.EventsReceived() == 23);
+    CHECK(sched.MovesIssued() == 4 && sched.Transactions() == 3);
+}
+
+static void TestForgetAndGone() {
+    FakeWindowOps ops;
+    Scheduler sched(&ops);
+    auto target = ops.Target();
+    ops.explorers[1] = { 800, 600 };
+    ops.explorers[2] = { 800, 600 };
+    sched.Schedule(1001, target);
+    ops.explorers[1].right = 900;
+    ops.explorers.erase(2); // 탐색기 사라짐 -> 프레임 조회 실패
+    sched.Schedule(1002, target);
+    sched.Schedule(1001, target);
+    sched.Forget(1001); // 오버레이 닫힘 -> Dirty에서도 빠짐
+    CHECK(sched.HasDirty());
+    CHECK(sched.OnFrame(target));
+    CHECK(ops.transactions == 1 && ops.overlays[1001].x == 575); // 두 번째 이동 없음
+    CHECK(!sched.HasDirty());
+
+    // 상태 토글로 즉시 이동한 위치 기억 -> 같은 위치 이벤트는 생략
+    OverlayRect rc = { 675, 475, 200, 100 };
+    sched.NoteApplied(1001, rc);
+    CHECK(sched.OnFrame(target) == false);
+    CHECK(sched.Schedule(1001, target));
+    CHECK(ops.transactions == 1 && sched.MovesSkipped() == 1);
+}
+
+// 메시지 루프 박자: 박자 중에만 대기 시한, 시각 전에는 프레임 없음, 유휴 프레임 뒤 무기한 대기, 드래그 끝은 즉시
+static void TestFrameDeadline() {
+    FakeWindowOps ops;
+    Scheduler sched(&ops);
+    int64_t now = 1000;
+    sched.SetClock([&now] { return now; });
+    auto target = ops.Target();
+    ops.explorers[1] = { 800, 600 };
+
+    CHECK(sched.FrameWaitMs() == POSITION_WAIT_FOREVER); // 유휴: 깨어날 일 없음
+    CHECK(!sched.RunDueFrame(target));
+    CHECK(sched.Schedule(1001, target));
+    CHECK(sched.FrameWaitMs() == POSITION_FRAME_MS);
+
+    // 프레임 시각 전 -> 이벤트가 와도 이동 없음, 남은 시간만 줄어듦
+    now += 10;
+    ops.explorers[1].right = 850;
+    sched.Schedule(1001, target);
+    CHECK(sched.RunDueFrame(target) && ops.transactions == 1);
+    CHECK(sched.FrameWaitMs() == POSITION_FRAME_MS - 10);
+
+    // 시각 지남 -> 프레임 1번, 다음 시한은 지금부터
+    now += 6;
+    CHECK(sched.RunDueFrame(target) && ops.transactions == 2 && ops.overlays[1001].x == 625);
+    CHECK(sched.FrameWaitMs() == POSITION_FRAME_MS);
+
+    // 늦게 깨어나도 밀린 프레임을 몰아서 돌지 않음 -> Dirty 없으면 박자 정지
+    now += 100;
+    CHECK(!sched.RunDueFrame(target));
+    CHECK(!sched.Pacing() && sched.FrameWaitMs() == POSITION_WAIT_FOREVER);
+
+    // 드래그 중 끝(MOVESIZEEND) -> 다음 프레임을 기다리지 않고 최종 위치 + 박자 정지
+    ops.explorers[1].right = 900;
+    CHECK(sched.Schedule(1001, target));
+    ops.explorers[1].right = 950;
+    sched.Schedule(1001, target);
+    sched.Settle(1001, target);
+    CHECK(ops.overlays[1001].x == 725 && ops.transactions == 4);
+    CHECK(!sched.Pacing() && sched.FrameWaitMs() == POSITION_WAIT_FOREVER);
+    sched.Settle(1001, target); // 이미 그 위치 -> 생략
+    CHECK(ops.transactions == 4 && sched.MovesSkipped() == 1);
+}
+
+// 가상 시계: 창마다 1/H초 간격 이벤트, 이벤트 처리 사이마다 RunDueFrame (main.cpp의 PumpOverlayMessages와 같은 순서)
+static void Drag(int windows, double seconds, int eventHz, bool print) {
+    FakeWindowOps ops;
+    Scheduler sched(&ops);
+    double now = 0;
+    sched.SetClock([&now] { return (int64_t)now; });
+    auto target = ops.Target();
+    for (int w = 0; w < windows; w++) ops.explorers[w] = { 800 + w, 600 };
+    double eventStep = 1000.0 / eventHz;
+    unsigned long long events = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (; now < seconds * 1000.0; now += eventStep) {
+        sched.RunDueFrame(target);
+        for (int w = 0; w < windows; w++) {
+            ops.explorers[w].right += 1; // 드래그 중: 매 이벤트마다 1px
+            sched.Schedule(1000 + w, target);
+            events++;
+        }
+    }
+    for (int w = 0; w < windows; w++, events++) sched.Settle(1000 + w, target); // 드래그 끝 (MOVESIZEEND)
+    double ms = ElapsedMs(t0);
+    for (int w = 0; w < windows; w++) CHECK(ops.overlays[1000 + w].x == ops.explorers[w].right - 225); // 마지막 위치 반영
+    CHECK(sched.EventsReceived() == events);
+    double frames = seconds * 1000.0 / POSITION_FRAME_MS;
+    CHECK(sched.Transactions() <= (unsigned long long)frames + 2);
+    if (print) {
+        std::printf("drag: %d windows, %.1f s at %d Hz -> %llu events\n", windows, seconds, eventHz, events);
+        std::printf("before (SetWindowPos per event): %llu moves, %llu frame queries\n", events, events);
+        std::printf("after (frame-paced): %llu moves in %llu transactions, %llu skipped, %llu frame queries, %.3f us/event scheduler cost\n",
+            sched.MovesIssued(), sched.Transactions(), sched.MovesSkipped(), ops.frameQueries, ms * 1000.0 / events);
+        std::fflush(stdout);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        Drag((int)ArgInt(argc, argv, "--windows", 4), (double)ArgInt(argc, argv, "--seconds", 5),
+            (int)ArgInt(argc, argv, "--event-hz", 500), true);
+        return TestExit("position_scheduler_bench");
+    }
+    TestPacing();
+    TestForgetAndGone();
+    TestFrameDeadline();
+    Drag(3, 1, 250, false);
+    return TestExit("position_scheduler_test");
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+// [PRD 7.2] 이벤트 재생을 가짜 창/가짜 Shell로 구동 -> 라우팅/경로 해석/워커 풀 상태 머신의 불변식 확인 + 지연 측정
+//   replay_test                                  : 기록 파일 + 작은 무작위 재생 (ctest)
+//   replay_test --bench [--windows N] [--events N] [--rate N] [--init-ms N] : 무작위 재생 후 처리량/지연 출력
+#include <cstdio>
+#include <filesystem>
+
+#include "core/replay.h"
+#include "tests/fake_overlay_host.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+static fs::path ReplayRoot() {
+    fs::path root = fs::temp_directory_path() / "FolderMemoReplayTest";
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root, ec);
+    return root;
+}
+
+static ReplayStats RunEvents(const std::vector<ReplayEvent>& events, int initMs) {
+    BasicReplayShellBackend<FakeHandle> shell;
+    shell.SetInitDelay(initMs);
+    FakeOverlayHost host(&shell);
+    FakeReplayWindows windows(host);
+    BasicReplaySession<FakeHandle> session(windows, shell, ReplayRoot());
+    ReplayStats stats = session.Run(events);
+    CHECK(host.Overlays().Size() == 0); // 모든 창 정리 후 남은 오버레이 없음
+    return stats;
+}
+
+static void PrintStats(const ReplayStats& stats) {
+    std::printf("replay: %zu events in %.1f ms (%.0f events/s)\n", stats.injected, stats.injectMs,
+        stats.injectMs > 0 ? stats.injected * 1000.0 / stats.injectMs : 0.0);
+    std::printf("path latency: n=%zu p50=%.2fms p90=%.2fms p99=%.2fms max=%.2fms\n", stats.latencyMs.size(),
+        stats.Percentile(0.5), stats.Percentile(0.9), stats.Percentile(0.99), stats.Percentile(1.0));
+    std::printf("invariants: checks=%llu ghost=%llu missing=%llu duplicate=%llu stale=%llu\n",
+        stats.checks, stats.ghost, stats.missing, stats.duplicate, stats.stale);
+}
+
+static void TestTraceFile() {
+    const char* trace =
+        "# 두 창: 생성/표시, 폴더 이동, 가림, 파괴\n"
+        "0 create 1 a\n"
+        "0 show 1\n"
+        "0 memo a\\b\n"
+        "0 create 2 a\\b\n"
+        "0 show 2\n"
+        "5 namechange 1 a\\b\\c\n"
+        "5 location 1 10 20\n"
+        "10 check\n"
+        "12 cloaked 2\n"
+        "12 namechange 1 a\n"
+        "15 check\n"
+        "20 destroy 1\n"
+        "25 check\n";
+    std::vector<ReplayEvent> events;
+    std::wstring error;
+    CHECK(ParseReplayTrace(trace, events, error));
+    CHECK(error.empty());
+    CHECK(events.size() == 13);
+
+    ReplayStats stats = RunEvents(events, 0);
+    CHECK(stats.Clean());
+    CHECK(stats.checks == 5); // 기록 3 + 마지막 2
+    CHECK(stats.latencyMs.size() >= 3); // 창 1/2 첫 표시 + 창 1 이동 (연속 이동은 병합될 수 있음)
+
+    std::vector<ReplayEvent> bad;
+    CHECK(!ParseReplayTrace("0 teleport 1\n", bad, error));
+    CHECK(!error.empty());
+}
+
+static void TestSynthetic(int windows, int events, int rate, int initMs, bool print) {
+    std::vector<ReplayEvent> trace;
+    GenerateReplayEvents(windows, events, rate, trace);
+    std::vector<ReplayEvent> again;
+    GenerateReplayEvents(windows, events, rate, again);
+    CHECK(trace.size() == again.size()); // 고정 시드
+    ReplayStats stats = RunEvents(trace, initMs);
+    if (print) PrintStats(stats);
+    CHECK(stats.Clean());
+    CHECK(!stats.latencyMs.empty());
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        TestSynthetic((int)ArgInt(argc, argv, "--windows", 8), (int)ArgInt(argc, argv, "--events", 20000),
+            (int)ArgInt(argc, argv, "--rate", 0), (int)ArgInt(argc, argv, "--init-ms", 0), true);
+        return TestExit("replay_bench");
+    }
+    TestTraceFile();
+    TestSynthetic(4, 1500, 0, 0, false);
+    TestSynthetic(3, 300, 0, 40, false); // [PRD 3.1.6] 초기화 중인 창 -> 재시도 경로
+    return TestExit("replay_test");
+}
@@ -0,0 +1,252 @@
+// [PRD 5.3] 백그라운드 저장 큐: 입력 병합(유휴 기록), 최대 지연, 즉시 기록(Flush/Stop), 기록 실패 재시도, 대기 내용 조회
+// --bench [--keys N] [--rate R] [--kb K]: 키 입력 폭주 재생 -> 기록 횟수 + UI 스레드 입력당 시간 (예전 입력마다 동기 기록과 비교)
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/file_io.h"
+#include "core/save_queue.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+// 가짜 Writer: 기록 순서/시각/내용만 남김. failFirst번까지는 실패
+struct FakeWriter {
+    struct Write {
+        std::wstring path;
+        std::string bytes;
+        Clock::time_point at;
+    };
+    std::mutex mutex;
+    std::vector<Write> writes;
+    int failFirst = 0;
+    int attempts = 0;
+
+    MemoSaveQueue::WriteFn Fn() {
+        return [this](const std::wstring& path, const std::shared_ptr<const std::string>& bytes) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (attempts++ < failFirst) return false;
+            writes.push_back({ path, *bytes, Clock::now() });
+            return true;
+        };
+    }
+    size_t Count() { std::lock_guard<std::mutex> lock(mutex); return writes.size(); }
+    Write First() { std::lock_guard<std::mutex> lock(mutex); return writes.front(); }
+    Write Last() { std::lock_guard<std::mutex> lock(mutex); return writes.back(); }
+
+    // 기록이 n개가 될 때까지 (최대 ms)
+    bool WaitFor(size_t n, int ms) {
+        Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(ms);
+        while (Count() < n) {
+            if (Clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+};
+
+// 편집창 흉내: 끝에 한 글자씩 입력 -> 버퍼에 반영
+struct FakeEdit {
+    std::wstring text;
+    std::shared_ptr<MemoBuffer> buffer = std::make_shared<MemoBuffer>();
+
+    void Type(wchar_t c) {
+        text.push_back(c);
+        if (!buffer->ApplyChange(text.data(), text.size(), text.size())) buffer->LoadText(text.data(), text.size());
+    }
+};
+
+static const wchar_t* TYPED = L"가나다 abc 라마바\n";
+
+// 빠른 연속 입력 -> 유휴 SAVE_IDLE_MS 뒤 최신 내용으로 한 번만 기록
+static void TestCoalescing() {
+    FakeWriter writer;
+    MemoSaveQueue queue(writer.Fn());
+    queue.Start();
+    FakeEdit edit;
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < 200; i++) {
+        edit.Type(TYPED[i % 12]);
+        queue.Submit(L"C:\\A", edit.buffer);
+    }
+    CHECK(queue.TryGetPending(L"C:\\A") == edit.buffer); // 기록 전에 돌아와도 최신 내용
+    CHECK(queue.HasPending(L"C:\\A"));
+    CHECK(writer.WaitFor(1, SAVE_IDLE_MS + 2000));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(writer.Count() == 1);
+    CHECK(writer.Last().bytes == WideToUtf8(edit.text));
+    CHECK(writer.Last().at - t0 >= std::chrono::milliseconds(SAVE_IDLE_MS));
+    CHECK(queue.SubmittedCount() == 200 && queue.WrittenCount() == 1);
+    CHECK(!queue.HasPending(L"C:\\A") && !queue.TryGetPending(L"C:\\A"));
+}
+
+// 유휴 간격보다 짧게 계속 입력해도 첫 입력부터 SAVE_MAX_LATENCY_MS 안에는 기록
+static void TestMaxLatency() {
+    FakeWriter writer;
+    MemoSaveQueue queue(writer.Fn());
+    queue.Start();
+    FakeEdit edit;
+    Clock::time_point t0 = Clock::now();
+    const int stepMs = SAVE_IDLE_MS / 5;
+    while (Clock::now() - t0 < std::chrono::milliseconds(SAVE_MAX_LATENCY_MS + 4 * stepMs)) {
+        edit.Type(L'x');
+        queue.Submit(L"C:\\Busy", edit.buffer);
+        std::this_thread::sleep_for(std::chrono::milliseconds(stepMs));
+    }
+    CHECK(writer.Count() >= 1);
+    if (writer.Count() >= 1) {
+        auto first = writer.First().at - t0;
+        CHECK(first >= std::chrono::milliseconds(SAVE_MAX_LATENCY_MS));
+        CHECK(first < std::chrono::milliseconds(SAVE_MAX_LATENCY_MS + 3 * stepMs));
+    }
+    queue.Stop(); // 남은 입력은 종료 때 기록
+    CHECK(writer.Last().bytes == WideToUtf8(edit.text));
+}
+
+// [PRD 5.3.1] Flush = 그 폴더만 즉시 기록, Stop = 남은 것 전부 기록. 경로가 다르면 따로 기록
+static void TestFlushAndStop() {
+    FakeWriter writer;
+    MemoSaveQueue queue(writer.Fn());
+    queue.Start();
+    FakeEdit a, b;
+    a.Type(L'a');
+    b.Type(L'b');
+    queue.Submit(L"C:\\A", a.buffer);
+    queue.Submit(L"C:\\B", b.buffer);
+    queue.Flush(L"C:\\A");
+    CHECK(writer.Count() == 1 && writer.Last().path == L"C:\\A" && writer.Last().bytes == "a");
+    CHECK(!queue.HasPending(L"C:\\A") && queue.HasPending(L"C:\\B"));
+    queue.Flush(L"C:\\A"); // 대기 없음 -> 아무것도 안 함
+    CHECK(writer.Count() == 1);
+
+    b.Type(L'c');
+    queue.Submit(L"C:\\B", b.buffer);
+    queue.Discard(L"C:\\Nothing");
+    queue.Stop();
+    CHECK(writer.Count() == 2 && writer.Last().path == L"C:\\B" && writer.Last().bytes == "bc");
+    CHECK(queue.PendingCount() == 0);
+}
+
+// [PRD 5.10] 기록 실패 -> retry가 준 대기 뒤에 다시. 그 사이 새 입력이 오면 새 내용으로
+static void TestRetry() {
+    FakeWriter writer;
+    writer.failFirst = 2;
+    int retries = 0;
+    MemoSaveQueue queue(writer.Fn(), [&retries](const std::wstring&) { retries++; return 50; });
+    queue.Start();
+    FakeEdit edit;
+    edit.Type(L'1');
+    queue.Submit(L"C:\\Net", edit.buffer);
+    Clock::time_point t0 = Clock::now();
+    queue.Flush(L"C:\\Net"); // UI 스레드 Flush 실패 -> Writer 대기열로
+    CHECK(writer.Count() == 0 && queue.HasPending(L"C:\\Net"));
+    edit.Type(L'2');
+    queue.Submit(L"C:\\Net", edit.buffer);
+    CHECK(writer.WaitFor(1, SAVE_IDLE_MS + 2000));
+    CHECK(writer.Last().bytes == "12");
+    CHECK(writer.Last().at - t0 >= std::chrono::milliseconds(SAVE_IDLE_MS)); // 새 입력 -> 유휴 대기도 다시
+    CHECK(retries == 2 && queue.RetriedCount() == 2);
+
+    // retry가 음수 -> 포기 (대기열에 남기지 않음)
+    FakeWriter failing;
+    failing.failFirst = 1000;
+    MemoSaveQueue giveUp(failing.Fn(), [](const std::wstring&) { return -1; });
+    giveUp.Submit(L"C:\\Gone", edit.buffer);
+    giveUp.Flush(L"C:\\Gone");
+    CHECK(!giveUp.HasPending(L"C:\\Gone") && giveUp.RetriedCount() == 0);
+}
+
+static double Percentile(std::vector<double>& v, double q) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[(size_t)(q * (v.size() - 1) + 0.5)];
+}
+
+// 키 입력 폭주: rate 키/초로 keys번 입력 (200번마다 SAVE_IDLE_MS보다 긴 멈춤), 메모 시작 크기 kb.
+// 예전 = 입력마다 UI 스레드에서 전체 복사 + 인코딩 + 원자적 기록. 지금 = ApplyChange + Submit, 기록은 Writer가 실제 파일로
+static void RunBench(size_t keys, int rate, size_t kb) {
+    fs::path dir = fs::temp_directory_path() / "FolderMemoSaveQueueBench";
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir, ec);
+    fs::path file = dir / "folder_memo.txt";
+
+    std::wstring start;
+    while (start.size() < kb * 1024) start += L"기존 메모 줄 existing line\n";
+    std::printf("keystroke storm: %zu keys at %d keys/s, %zu KB memo, pause %d ms every 200 keys\n", keys, rate,
+        kb, SAVE_IDLE_MS + 200);
+    std::fflush(stdout);
+
+    // 예전: 입력마다 동기 기록
+    std::vector<double> syncMs;
+    {
+        std::wstring text = start;
+        for (size_t i = 0; i < keys; i++) {
+            text.push_back(TYPED[i % 12]);
+            Clock::time_point t0 = Clock::now();
+            std::wstring copy = text; // GetWindowText
+            WriteFileAtomic(file, WideToUtf8(copy));
+            syncMs.push_back(ElapsedMs(t0));
+        }
+    }
+    std::printf("before (write per key): %zu writes, UI p50=%.3fms p99=%.3fms max=%.3fms\n", syncMs.size(),
+        Percentile(syncMs, 0.5), Percentile(syncMs, 0.99), Percentile(syncMs, 1.0));
+    std::fflush(stdout);
+
+    // 지금: 저장 큐
+    unsigned long long writes = 0;
+    MemoSaveQueue queue([&](const std::wstring&, const std::shared_ptr<const std::string>& bytes) {
+        writes++;
+        return WriteFileAtomic(file, *bytes);
+    });
+    queue.Start();
+    FakeEdit edit;
+    edit.text = start;
+    edit.buffer->LoadText(start.data(), start.size());
+    std::vector<double> uiMs;
+    Clock::time_point begin = Clock::now(), next = begin;
+    for (size_t i = 0; i < keys; i++) {
+        if (rate > 0) {
+            std::this_thread::sleep_until(next);
+            next += std::chrono::microseconds(1000000 / rate);
+        }
+        if (i > 0 && i % 200 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SAVE_IDLE_MS + 200));
+            next = Clock::now();
+        }
+        Clock::time_point t0 = Clock::now();
+        edit.Type(TYPED[i % 12]);
+        queue.Submit(L"C:\\Storm", edit.buffer);
+        uiMs.push_back(ElapsedMs(t0));
+    }
+    double typingMs = ElapsedMs(begin);
+    queue.Stop();
+    std::printf("after (save queue): %llu writes for %llu submits over %.0f ms, UI p50=%.3fms p99=%.3fms max=%.3fms\n",
+        (unsigned long long)writes, queue.SubmittedCount(), typingMs, Percentile(uiMs, 0.5), Percentile(uiMs, 0.99),
+        Percentile(uiMs, 1.0));
+
+    std::string onDisk;
+    bool same = ReadWholeFile(file, onDisk) && onDisk == WideToUtf8(edit.text);
+    std::printf("final file matches editor: %s\n", same ? "yes" : "NO");
+    std::fflush(stdout);
+    CHECK(same);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((size_t)ArgInt(argc, argv, "--keys", 2000), (int)ArgInt(argc, argv, "--rate", 100),
+            (size_t)ArgInt(argc, argv, "--kb", 256));
+        return TestExit("save_queue_bench");
+    }
+    TestCoalescing();
+    TestMaxLatency();
+    TestFlushAndStop();
+    TestRetry();
+    return TestExit("save_queue_test");
+}
\ No newline at end of file
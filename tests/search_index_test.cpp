@@ -0,0 +1,222 @@
+// [PRD 6.1] 전역 역색인: 한글 부분 일치(조사 붙은 단어), 대소문자, 미룬 갱신, 제거/Tombstone, 병합 후 다시 열기(매핑 이미지), 손상 이미지,
+//   폴더 크롤러의 증분 판단(안 바뀐 메모는 다시 읽지 않음)과 사라진 메모 정리
+// --bench [--memos N] [--kb K] [--queries Q]: 메모 N개(평균 K KB)를 크롤해 색인 처리량(메모/s, MB/s)과 병합/이미지 크기,
+//   매핑된 이미지에 대한 질의 지연 p50/p99 -> 예전 방식(메모를 모두 열어 부분 문자열 검색) 1회와 비교, 변경 없는 재크롤 시간
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/search_index.h"
+#include "core/utf.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+static fs::path TempDir(const char* name) {
+    fs::path dir = fs::temp_directory_path() / "FolderMemoSearchTest" / name;
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+    return dir;
+}
+
+static bool Has(const std::vector<std::wstring>& hits, const std::wstring& path) {
+    return std::find(hits.begin(), hits.end(), path) != hits.end();
+}
+
+static void TestQuery() {
+    fs::path dir = TempDir("query");
+    fs::path image = dir / "memo_index.bin";
+    {
+        MemoSearchIndex index;
+        CHECK(!index.Open(image)); // 아직 이미지 없음 -> 빈 색인
+        index.UpdateDocument(L"/a", WideToUtf8(L"3월 회의록은 공유 폴더에"), 1, 10);
+        index.UpdateDocument(L"/b", WideToUtf8(L"Release Notes: 회의 일정"), 2, 20);
+        index.UpdateDocument(L"/c", "grocery list", 3, 30);
+
+        CHECK(index.Query(L"회의록").size() == 1 && index.Query(L"회의록")[0] == L"/a"); // 조사가 붙어도 부분 일치
+        std::vector<std::wstring> hits = index.Query(L"회의");
+        CHECK(hits.size() == 2 && Has(hits, L"/a") && Has(hits, L"/b"));
+        CHECK(index.Query(L"release notes").size() == 1); // 대소문자 무시, 공백은 구분자
+        CHECK(index.Query(L"없는말").empty());
+        CHECK(index.Query(L"  ").empty());
+        CHECK(index.IsUpToDate(L"/a", 1, 10) && !index.IsUpToDate(L"/a", 1, 11) && !index.IsUpToDate(L"/z", 1, 10));
+
+        CHECK(index.Merge());
+        CHECK(fs::file_size(image) > 0);
+        CHECK(index.Query(L"회의").size() == 2); // 병합 후에는 매핑된 이미지에서 질의
+
+        // 이미지에 있는 문서 갱신 -> Tombstone + 델타, 제거
+        index.UpdateDocument(L"/a", WideToUtf8(L"회의 취소"), 4, 12);
+        CHECK(index.Query(L"회의록").empty() && index.Query(L"취소").size() == 1);
+        index.RemoveDocument(L"/c");
+        CHECK(index.Query(L"grocery").empty());
+        CHECK(index.DocumentCount() == 2);
+
+        // 오버레이 저장: 추출을 미룸 -> 질의 때 반영, 마지막 사본만 남음
+        index.UpdateDocumentLater(L"/d", std::make_shared<const std::string>(WideToUtf8(L"첫 번째")), 5, 5);
+        index.UpdateDocumentLater(L"/d", std::make_shared<const std::string>(WideToUtf8(L"두 번째 저장")), 6, 6);
+        CHECK(index.IsUpToDate(L"/d", 6, 6));
+        CHECK(index.Query(L"첫").empty() && index.Query(L"저장").size() == 1);
+        // 빈 내용 -> 제거
+        index.UpdateDocument(L"/b", "", 7, 0);
+        CHECK(index.Query(L"release").empty());
+        CHECK(index.Merge());
+        CHECK(index.DocumentCount() == 2);
+    }
+    {
+        MemoSearchIndex index; // 다시 시작: 이미지를 매핑만 하고 바로 질의
+        CHECK(index.Open(image));
+        CHECK(index.DocumentCount() == 2);
+        CHECK(index.Query(L"취소").size() == 1 && index.Query(L"저장")[0] == L"/d");
+        CHECK(index.IsUpToDate(L"/a", 4, 12) && !index.IsUpToDate(L"/c", 3, 30));
+        std::vector<std::wstring> all = index.AllPaths();
+        CHECK(all.size() == 2 && Has(all, L"/a") && Has(all, L"/d"));
+    }
+    {
+        std::string bytes;
+        ReadWholeFile(image, bytes);
+        bytes.resize(bytes.size() / 2); // 잘린 이미지 -> 거부, 빈 색인으로 시작
+        WriteFileAtomic(image, bytes);
+        MemoSearchIndex index;
+        CHECK(!index.Open(image));
+        CHECK(index.DocumentCount() == 0 && index.Query(L"취소").empty());
+    }
+}
+
+static void WriteMemo(const fs::path& folder, const std::string& text) {
+    fs::create_directories(folder);
+    CHECK(WriteFileAtomic(folder / "folder_memo.txt", text));
+}
+
+static void TestCrawl() {
+    fs::path dir = TempDir("crawl");
+    fs::path root = dir / "root";
+    WriteMemo(root / "a", WideToUtf8(L"프로젝트 일정"));
+    WriteMemo(root / "a" / "b", "deploy checklist");
+    WriteMemo(root / "c", WideToUtf8(L"영수증 보관"));
+    fs::create_directories(root / "empty");
+
+    MemoSearchIndex index;
+    index.Open(dir / "memo_index.bin");
+    MemoIndexer indexer(index);
+    FolderMemoIndexSource source;
+    std::vector<std::wstring> roots = { root.wstring() };
+    MemoIndexer::CrawlStats s = indexer.Crawl(source, roots);
+    CHECK(s.visited == 3 && s.indexed == 3 && s.removed == 0);
+    CHECK(index.DocumentCount() == 3);
+    CHECK(index.Query(L"일정").size() == 1 && index.Query(L"일정")[0] == (root / "a").wstring());
+
+    // 다시 크롤 -> 아무것도 다시 읽지 않음
+    s = indexer.Crawl(source, roots);
+    CHECK(s.visited == 3 && s.indexed == 0);
+
+    // 하나 수정(크기 변경), 하나 삭제 -> 그것만 반영
+    WriteMemo(root / "a" / "b", "deploy checklist v2");
+    fs::remove_all(root / "c");
+    s = indexer.Crawl(source, roots);
+    CHECK(s.visited == 2 && s.indexed == 1 && s.removed == 1);
+    CHECK(index.Query(L"v2").size() == 1 && index.Query(L"영수증").empty());
+
+    // 루트 밖 문서는 정리 대상 아님
+    index.UpdateDocument(L"/elsewhere", "deploy", 1, 6);
+    s = indexer.Crawl(source, roots);
+    CHECK(s.removed == 0 && index.Query(L"deploy").size() == 2);
+
+    // 백그라운드 시작/정지
+    MemoIndexer background(index);
+    background.Start(&source, roots);
+    background.Stop();
+    CHECK(index.DocumentCount() == 3);
+}
+
+// 벤치 말뭉치: 한글/영문 단어를 섞은 메모 (폴더 100개마다 하위 디렉터리 하나)
+static const wchar_t* const WORDS[] = { L"회의", L"일정", L"프로젝트", L"보고서", L"영수증", L"계약서", L"견적", L"디자인", L"검토",
+    L"배포", L"release", L"deploy", L"invoice", L"budget", L"draft", L"review", L"meeting", L"todo", L"backup", L"archive" };
+static const size_t WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+
+static std::wstring RandomText(std::mt19937& rng, size_t chars) {
+    std::wstring text;
+    while (text.size() < chars) {
+        text += WORDS[rng() % WORD_COUNT];
+        text += std::to_wstring(rng() % 1000); // 고유 토큰이 있어야 posting이 다양해짐
+        text += (rng() % 8 == 0) ? L"\n" : L" ";
+    }
+    return text;
+}
+
+static void RunBench(int memos, int kb, int queries) {
+    fs::path dir = TempDir("bench");
+    fs::path root = dir / "root";
+    std::mt19937 rng(5);
+    unsigned long long corpusBytes = 0;
+    for (int i = 0; i < memos; i++) {
+        std::string bytes = WideToUtf8(RandomText(rng, (size_t)kb * 1024 / 2 + rng() % (kb * 1024)));
+        WriteMemo(root / std::to_string(i / 100) / std::to_string(i), bytes);
+        corpusBytes += bytes.size();
+    }
+    std::vector<std::wstring> roots = { root.wstring() };
+    std::printf("search: %d memos, %.1f MB of UTF-8\n", memos, corpusBytes / 1048576.0);
+
+    MemoSearchIndex index;
+    index.Open(dir / "memo_index.bin");
+    MemoIndexer indexer(index);
+    FolderMemoIndexSource source;
+    auto t0 = std::chrono::steady_clock::now();
+    MemoIndexer::CrawlStats s = indexer.Crawl(source, roots);
+    double ms = ElapsedMs(t0);
+    std::printf("full crawl: %llu memos in %.0f ms -> %.0f memos/s, %.1f MB/s (incl. merges), image %.1f MB\n", s.indexed, ms,
+        s.indexed * 1000.0 / ms, s.bytes / 1048576.0 / (ms / 1000.0), fs::file_size(dir / "memo_index.bin") / 1048576.0);
+    t0 = std::chrono::steady_clock::now();
+    s = indexer.Crawl(source, roots);
+    std::printf("unchanged re-crawl: %llu read, %.0f ms\n", s.indexed, ElapsedMs(t0));
+
+    // 질의: 단어 + 숫자 (예: "보고서42"), 단어 둘
+    MemoSearchIndex mapped; // 다시 시작한 앱처럼 매핑만
+    t0 = std::chrono::steady_clock::now();
+    mapped.Open(dir / "memo_index.bin");
+    double openMs = ElapsedMs(t0);
+    std::vector<std::wstring> qs;
+    for (int q = 0; q < queries; q++) {
+        std::wstring w = WORDS[rng() % WORD_COUNT];
+        qs.push_back(q % 2 ? w + std::to_wstring(rng() % 1000) : w + L" " + WORDS[rng() % WORD_COUNT]);
+    }
+    std::vector<double> us;
+    size_t totalHits = 0;
+    for (const auto& q : qs) {
+        t0 = std::chrono::steady_clock::now();
+        totalHits += mapped.Query(q).size();
+        us.push_back(ElapsedMs(t0) * 1000.0);
+    }
+    std::sort(us.begin(), us.end());
+    std::printf("after (mapped index): open %.1f ms, %d queries p50=%.0fus p99=%.0fus, %.1f hits/query (limit 100)\n", openMs,
+        queries, us[us.size() / 2], us[(size_t)(0.99 * (us.size() - 1))], (double)totalHits / queries);
+
+    // 예전: 색인 없이 메모를 모두 열고 디코드해 부분 문자열 검색 (질의 1개)
+    const std::wstring& needle = qs[1];
+    t0 = std::chrono::steady_clock::now();
+    size_t scanHits = 0;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().filename() != "folder_memo.txt") continue;
+        std::string bytes;
+        source.Read(it->path().parent_path().wstring(), bytes);
+        if (Utf8ToWide(bytes).find(needle) != std::wstring::npos) scanHits++;
+    }
+    std::printf("before (open + scan every memo): 1 query in %.0f ms, %zu hits\n", ElapsedMs(t0), scanHits);
+    std::fflush(stdout);
+    fs::remove_all(dir, ec);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--memos", 5000), (int)ArgInt(argc, argv, "--kb", 4), (int)ArgInt(argc, argv, "--queries", 1000));
+        return TestExit("search_index_bench");
+    }
+    TestQuery();
+    TestCrawl();
+    return TestExit("search_index_test");
+}
\ No newline at end of file
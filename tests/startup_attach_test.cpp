@@ -0,0 +1,164 @@
+// [PRD 3.2.3] 시작 시 일괄 부착 + 가짜 Shell: 창 60개를 Shell 나열 1회로 해석, 활성 탭 선택, 못 찾은 창도 preload 호출(빈 경로),
+//   창마다 정확히 한 번 preload, 해석 결과가 캐시에 남아 이후 Resolve는 Shell 호출 없음, 남는 탭 토큰 없음
+// --bench [--windows N] [--tabs T] [--call-us U] [--read-ms R] [--kb K]: 이미 열린 탐색기 N개에 모든 오버레이가 준비될 때까지.
+//   예전 = 창마다 경로 작업(워커 PATH_WORKER_COUNT개, 작업마다 전체 나열) + UI 스레드에서 메모를 하나씩 읽음,
+//   지금 = RunStartupAttach. Shell 호출마다 U µs, 메모 읽기마다 R ms (네트워크/찬 디스크), 창 4개 중 3개에 K KB 메모
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/file_io.h"
+#include "core/path_jobs.h"
+#include "core/startup_attach.h"
+#include "core/utf.h"
+#include "tests/fake_shell.h"
+#include "tests/test_util.h"
+
+namespace fs = std::filesystem;
+
+typedef BasicExplorerPathResolver<FakeHwnd> Resolver;
+typedef BasicStartupWindow<FakeHwnd> StartupWindow;
+
+static std::wstring Folder(int i) { return L"C:\\Work\\Folder" + std::to_wstring(i); }
+static std::wstring Title(int i) { return L"Folder" + std::to_wstring(i); }
+
+// 창 w: 탭 T개 (Folder(w*100 + t)), 활성 탭 = 마지막 탭 -> 제목으로 골라야 함
+static std::vector<StartupWindow> OpenWindows(FakeShell& shell, int windows, int tabs) {
+    std::vector<StartupWindow> out;
+    for (int w = 0; w < windows; w++) {
+        for (int t = 0; t < tabs; t++) shell.AddTab(w, Folder(w * 100 + t));
+        out.push_back({ w, 10000 + w, Title(w * 100 + tabs - 1), (unsigned long long)w + 1 });
+    }
+    return out;
+}
+
+static void TestBatch() {
+    FakeShell shell;
+    std::vector<StartupWindow> windows = OpenWindows(shell, 60, 2);
+    windows.push_back({ 999, 10999, Title(1), 61 }); // Shell에 아직 없는 창 (초기화 중)
+    Resolver resolver(&shell);
+
+    std::vector<std::atomic<int>> calls(windows.size());
+    std::vector<std::wstring> paths;
+    StartupAttachStats stats = RunStartupAttach(resolver, windows, paths, [&](size_t i, const std::wstring& path) {
+        calls[i]++;
+        return !path.empty() && i % 2 == 0;
+    });
+    CHECK(shell.ListCalls() == 1);
+    CHECK(paths.size() == windows.size());
+    for (int w = 0; w < 60; w++) CHECK(paths[w] == Folder(w * 100 + 1));
+    CHECK(paths[60].empty());
+    for (auto& c : calls) CHECK(c == 1);
+    CHECK(stats.resolved == 60 && stats.preloaded == 30);
+
+    // 해석 결과가 캐시됨 -> 이후 같은 제목 Resolve는 Shell 호출 없음
+    unsigned long long shellCalls = shell.Calls();
+    CHECK(resolver.Resolve(7, Title(701)) == Folder(701));
+    CHECK(shell.Calls() == shellCalls && resolver.Hits() == 1);
+
+    // 창이 없으면 아무것도 안 함
+    std::vector<StartupWindow> none;
+    stats = RunStartupAttach(resolver, none, paths, [](size_t, const std::wstring&) { return true; });
+    CHECK(paths.empty() && stats.preloaded == 0 && shell.ListCalls() == 1);
+
+    resolver.Shutdown();
+    CHECK(shell.HeldRefs() == 0);
+}
+
+static fs::path TempDir(const char* name) {
+    fs::path dir = fs::temp_directory_path() / "FolderMemoStartupTest" / name;
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+    return dir;
+}
+
+// LoadMemo 대신: 읽기 지연 + 읽기 + 변환 (창 i의 메모가 없으면 false)
+static bool ReadMemo(const fs::path& dir, size_t i, int readMs, std::wstring& out) {
+    fs::path p = dir / std::to_string(i) / "folder_memo.txt";
+    std::error_code ec;
+    if (!fs::exists(p, ec)) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(readMs));
+    std::string bytes;
+    if (!ReadWholeFile(p, bytes)) return false;
+    Utf8ToWide(bytes.data(), bytes.size(), out);
+    return true;
+}
+
+static void RunBench(int windowCount, int tabs, int callUs, int readMs, int kb) {
+    fs::path dir = TempDir("bench");
+    std::string memo;
+    while (memo.size() < (size_t)kb * 1024) memo += u8"회의록 정리, deploy checklist — 다음 주 배포\n";
+    for (int w = 0; w < windowCount; w++) {
+        fs::create_directories(dir / std::to_string(w));
+        if (w % 4 != 3) CHECK(WriteFileAtomic(dir / std::to_string(w) / "folder_memo.txt", memo));
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    std::printf("startup attach: %d explorer windows x %d tabs, %d us per shell call, %d ms per memo read, %d KB memos, %u cores\n",
+        windowCount, tabs, callUs, readMs, kb, hw);
+
+    // 예전: 창마다 경로 작업 -> 워커 PATH_WORKER_COUNT개가 각자 전체 나열 -> 결과가 오면 UI가 메모를 읽어 표시
+    {
+        FakeShell shell;
+        std::vector<StartupWindow> windows = OpenWindows(shell, windowCount, tabs);
+        shell.SetCallDelay(callUs);
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::wstring> paths(windows.size());
+        std::atomic<size_t> next{ 0 };
+        std::vector<std::thread> workers;
+        for (int n = 0; n < PATH_WORKER_COUNT; n++) {
+            workers.emplace_back([&] {
+                for (size_t i; (i = next.fetch_add(1)) < windows.size();) paths[i] = OldGetExplorerPath(shell, windows[i].hExplorer, windows[i].title);
+            });
+        }
+        for (auto& t : workers) t.join();
+        double resolveMs = ElapsedMs(t0);
+        int wrong = 0, loaded = 0;
+        for (size_t i = 0; i < windows.size(); i++) {
+            wrong += paths[i] != Folder((int)i * 100 + tabs - 1);
+            std::wstring text;
+            loaded += ReadMemo(dir, i, readMs, text);
+        }
+        double totalMs = ElapsedMs(t0);
+        CHECK(wrong == 0);
+        std::printf("before (job per window, %d workers, reads on UI): resolve %.1f ms, all ready %.1f ms, %llu shell calls (%llu lists), %d memos\n",
+            PATH_WORKER_COUNT, resolveMs, totalMs, shell.Calls(), shell.ListCalls(), loaded);
+    }
+    // 지금: RunStartupAttach (나열 1회 + 병렬 미리 읽기) -> 결과 한꺼번에 전달
+    {
+        FakeShell shell;
+        std::vector<StartupWindow> windows = OpenWindows(shell, windowCount, tabs);
+        shell.SetCallDelay(callUs);
+        Resolver resolver(&shell);
+        std::vector<std::wstring> texts(windows.size());
+        std::vector<std::wstring> paths;
+        auto t0 = std::chrono::steady_clock::now();
+        StartupAttachStats stats = RunStartupAttach(resolver, windows, paths,
+            [&](size_t i, const std::wstring& path) { return !path.empty() && ReadMemo(dir, i, readMs, texts[i]); });
+        double totalMs = ElapsedMs(t0);
+        int wrong = 0;
+        for (size_t i = 0; i < windows.size(); i++) wrong += paths[i] != Folder((int)i * 100 + tabs - 1);
+        CHECK(wrong == 0);
+        std::printf("after (RunStartupAttach, up to %d threads): resolve %.1f ms, all ready %.1f ms, %llu shell calls (%llu lists), %zu memos\n",
+            STARTUP_PRELOAD_THREADS, stats.resolveMs, totalMs, shell.Calls(), shell.ListCalls(), stats.preloaded);
+        resolver.Shutdown();
+        CHECK(shell.HeldRefs() == 0);
+    }
+    std::fflush(stdout);
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--windows", 60), (int)ArgInt(argc, argv, "--tabs", 2), (int)ArgInt(argc, argv, "--call-us", 50),
+            (int)ArgInt(argc, argv, "--read-ms", 2), (int)ArgInt(argc, argv, "--kb", 8));
+        return TestExit("startup_attach_bench");
+    }
+    TestBatch();
+    return TestExit("startup_attach_test");
+}
\ No newline at end of file
@@ -0,0 +1,260 @@
+// [PRD 3.3] 메모 존재 캐시: 적중/미스, '없음' 캐시, 알림 없는 폴더의 TTL 만료, stat 도중 무효화된 결과 버림,
+//   감시는 track일 때만 (Linux: inotify 백엔드로 구동 -> 메모 생성/수정/폴더 삭제가 캐시를 무효화, 감시 불가 폴더는 TTL)
+// --bench [--folders N] [--visits V] [--probe-ms P]: 폴더 N개를 재방문 위주로 V번 이동할 때 적중률, 실제 stat 횟수와 시간,
+//   UNC/클라우드 폴더의 stat 1회를 P ms로 잡은 예상 대기 (캐시 없음 vs 있음)
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/file_io.h"
+#include "core/stat_cache.h"
+#include "tests/test_util.h"
+#ifdef __linux__
+#include <condition_variable>
+#include <mutex>
+
+#include "core/dir_watcher.h"
+#endif
+
+namespace fs = std::filesystem;
+
+static fs::path TempDir(const char* name) {
+    fs::path dir = fs::temp_directory_path() / "FolderMemoStatCacheTest" / name;
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir);
+    return dir;
+}
+
+static void WriteMemo(const fs::path& folder, const std::string& text) {
+    fs::create_directories(folder);
+    CHECK(WriteFileAtomic(folder / "folder_memo.txt", text));
+}
+
+// 감시 백엔드 대신: 걸 수 있는지만 정하고 호출 수를 셈
+struct FakeWatcher {
+    bool watchable = true;
+    int calls = 0;
+    bool Watch(const std::wstring&) { calls++; return watchable; }
+};
+
+static void TestCache() {
+    fs::path dir = TempDir("cache");
+    std::wstring memo = (dir / "memo").wstring();
+    std::wstring none = (dir / "none").wstring();
+    WriteMemo(memo, "hello");
+    fs::create_directories(none);
+
+    MemoStatCache cache;
+    FakeWatcher watcher;
+    MemoStat st = StatMemoCached(cache, watcher, memo, true);
+    CHECK(st.exists && st.size == 5);
+    CHECK(cache.Misses() == 1 && cache.Hits() == 0 && watcher.calls == 1);
+    st = StatMemoCached(cache, watcher, memo, true);
+    CHECK(st.exists && st.size == 5 && cache.Hits() == 1 && watcher.calls == 1); // 적중 -> 감시도 stat도 없음
+
+    // '없음'도 캐시 -> 나중에 생겨도 알림(Invalidate) 전에는 그대로
+    CHECK(!StatMemoCached(cache, watcher, none, true).exists);
+    WriteMemo(none, "new");
+    CHECK(!StatMemoCached(cache, watcher, none, true).exists);
+    cache.Invalidate(none);
+    CHECK(cache.Invalidations() == 1);
+    st = StatMemoCached(cache, watcher, none, true);
+    CHECK(st.exists && st.size == 3);
+
+    // track이 아니면 캐시도 감시도 안 함
+    std::wstring other = (dir / "other").wstring();
+    int calls = watcher.calls;
+    StatMemoCached(cache, watcher, other, false);
+    StatMemoCached(cache, watcher, other, false);
+    CHECK(watcher.calls == calls);
+    unsigned long long misses = cache.Misses();
+    StatMemoCached(cache, watcher, other, false);
+    CHECK(cache.Misses() == misses + 1);
+
+    // 없는 폴더의 무효화는 세지 않음
+    cache.Invalidate(other);
+    CHECK(cache.Invalidations() == 1);
+}
+
+static void TestTtlAndRace() {
+    fs::path dir = TempDir("ttl");
+    std::wstring memo = (dir / "memo").wstring();
+    WriteMemo(memo, "a");
+
+    // 알림을 걸 수 없는 폴더는 짧은 TTL
+    MemoStatCache cache(50, 600);
+    FakeWatcher unwatchable;
+    unwatchable.watchable = false;
+    CHECK(StatMemoCached(cache, unwatchable, memo, true).size == 1);
+    WriteMemo(memo, "abc");
+    CHECK(StatMemoCached(cache, unwatchable, memo, true).size == 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    CHECK(StatMemoCached(cache, unwatchable, memo, true).size == 3);
+
+    // 감시 중인 폴더는 긴 TTL (같은 시간이 지나도 적중)
+    MemoStatCache watchedCache(50, 600);
+    FakeWatcher watcher;
+    StatMemoCached(watchedCache, watcher, memo, true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    unsigned long long hits = watchedCache.Hits();
+    StatMemoCached(watchedCache, watcher, memo, true);
+    CHECK(watchedCache.Hits() == hits + 1);
+
+    // Lookup과 Store 사이에 무효화 -> 그 결과는 버림
+    MemoStatCache raced;
+    MemoStat st;
+    uint64_t epoch = 0;
+    CHECK(!raced.Lookup(memo, st, epoch));
+    raced.Invalidate(memo);
+    raced.Store(memo, StatMemoFile(memo), true, epoch);
+    CHECK(raced.Raced() == 1);
+    CHECK(!raced.Lookup(memo, st, epoch));
+}
+
+#ifdef __linux__
+// 알림을 받으면 캐시를 무효화하고, 테스트는 그 알림을 기다림 (main.cpp의 OnMemoFolderChanged 자리)
+class InvalidatingListener {
+public:
+    explicit InvalidatingListener(MemoStatCache& cache) : m_cache(cache) {}
+    void OnChange(const std::wstring& folder) {
+        m_cache.Invalidate(folder);
+        { std::lock_guard<std::mutex> lock(m_mutex); m_changes++; }
+        m_cv.notify_all();
+    }
+    // 캐시가 folder를 더는 적중시키지 않을 때까지 (알림 도착) 기다림
+    bool WaitInvalidated(const std::wstring& folder, int ms) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+        for (;;) {
+            MemoStat st;
+            uint64_t epoch;
+            if (!m_cache.Lookup(folder, st, epoch)) return true;
+            std::unique_lock<std::mutex> lock(m_mutex);
+            int seen = m_changes;
+            if (!m_cv.wait_until(lock, deadline, [&] { return m_changes != seen; })) return false;
+        }
+    }
+
+private:
+    MemoStatCache& m_cache;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    int m_changes = 0;
+};
+
+static void TestInotify() {
+    fs::path dir = TempDir("inotify");
+    std::wstring folder = (dir / "a").wstring();
+    fs::create_directories(folder);
+
+    MemoStatCache cache(50, 600);
+    InvalidatingListener listener(cache);
+    InotifyDirectoryWatcher watcher([&](const std::wstring& f) { listener.OnChange(f); });
+    watcher.Start();
+
+    // 없음 -> 캐시 -> 메모 생성 알림으로 무효화 -> 새 stat
+    CHECK(!StatMemoCached(cache, watcher, folder, true).exists);
+    CHECK(watcher.IsWatching(folder));
+    WriteMemo(folder, "first");
+    CHECK(listener.WaitInvalidated(folder, 2000));
+    MemoStat st = StatMemoCached(cache, watcher, folder, true);
+    CHECK(st.exists && st.size == 5);
+
+    // 내용 변경 -> 새 스탬프
+    WriteMemo(folder, "second write");
+    CHECK(listener.WaitInvalidated(folder, 2000));
+    MemoStat st2 = StatMemoCached(cache, watcher, folder, true);
+    CHECK(st2.exists && st2.size == 12);
+
+    // 다른 파일 변경은 무효화하지 않음
+    CHECK(WriteFileAtomic(fs::path(folder) / "notes.txt", "x"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    unsigned long long hits = cache.Hits();
+    StatMemoCached(cache, watcher, folder, true);
+    CHECK(cache.Hits() == hits + 1);
+
+    // 폴더 삭제 -> 감시가 풀리며 알림 -> 다음 조회는 '없음', 다시 걸 수 없으니 TTL
+    fs::remove_all(folder);
+    CHECK(listener.WaitInvalidated(folder, 2000));
+    CHECK(!StatMemoCached(cache, watcher, folder, true).exists);
+    CHECK(!watcher.IsWatching(folder));
+    WriteMemo(folder, "back");
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    CHECK(StatMemoCached(cache, watcher, folder, true).exists); // TTL 만료 -> 다시 stat, 이번엔 감시도 걸림
+    CHECK(watcher.IsWatching(folder));
+    watcher.Stop();
+}
+#endif
+
+// 탐색기 이동 흉내: 최근 방문한 폴더로 돌아가는 경우가 많음 (뒤로 가기, 부모 <-> 자식)
+static void RunBench(int folders, int visits, double probeMs) {
+    fs::path dir = TempDir("bench");
+    std::vector<std::wstring> paths;
+    for (int i = 0; i < folders; i++) {
+        fs::path p = dir / std::to_string(i);
+        if (i % 4 == 0) WriteMemo(p, "memo " + std::to_string(i));
+        else fs::create_directories(p);
+        paths.push_back(p.wstring());
+    }
+    std::mt19937 rng(7);
+    std::vector<int> order;
+    std::vector<int> recent;
+    for (int v = 0; v < visits; v++) {
+        int f = (!recent.empty() && rng() % 10 < 8) ? recent[rng() % recent.size()] : (int)(rng() % folders);
+        order.push_back(f);
+        recent.push_back(f);
+        if (recent.size() > 16) recent.erase(recent.begin());
+    }
+
+    // 캐시 없음: 이동마다 stat
+    size_t found = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f : order) found += StatMemoFile(paths[f]).exists;
+    double beforeMs = ElapsedMs(t0);
+
+    MemoStatCache cache;
+    size_t cachedFound = 0;
+    double afterMs;
+#ifdef __linux__
+    InotifyDirectoryWatcher watcher([&](const std::wstring& f) { cache.Invalidate(f); });
+    watcher.Start();
+    const char* backend = "inotify";
+#else
+    FakeWatcher watcher;
+    const char* backend = "fake";
+#endif
+    t0 = std::chrono::steady_clock::now();
+    for (int f : order) cachedFound += StatMemoCached(cache, watcher, paths[f], true).exists;
+    afterMs = ElapsedMs(t0);
+#ifdef __linux__
+    watcher.Stop();
+#endif
+    CHECK(cachedFound == found);
+
+    unsigned long long probes = cache.Misses();
+    std::printf("stat cache: %d folders (1 in 4 has a memo), %d visits, %s watcher\n", folders, visits, backend);
+    std::printf("before (stat every visit): %d stats, %.1f ms local, %.0f ms at %.0f ms/stat\n", visits, beforeMs, visits * probeMs, probeMs);
+    std::printf("after (cached, watch + stat on miss): %llu stats (hit rate %.1f%%), %.1f ms local, %.0f ms at %.0f ms/stat\n", probes,
+        100.0 * cache.Hits() / visits, afterMs, probes * probeMs, probeMs);
+    std::printf("invalidations: %llu (watch evictions past MAX_WATCHES count here)\n", cache.Invalidations());
+    std::fflush(stdout);
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--folders", 500), (int)ArgInt(argc, argv, "--visits", 20000), (double)ArgInt(argc, argv, "--probe-ms", 150));
+        return TestExit("stat_cache_bench");
+    }
+    TestCache();
+    TestTtlAndRace();
+#ifdef __linux__
+    TestInotify();
+#endif
+    return TestExit("stat_cache_test");
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// --- [테스트 공용] ---
+// 외부 테스트 프레임워크 없이 CHECK + 실패 수 집계. 실패해도 계속 진행하고 종료 코드로만 알림 (ctest).
+// 벤치는 같은 실행 파일에 "--bench"를 주면 돌림 (ctest는 기본값 = 작은 크기로 정확성만 확인).
+inline int& TestFailures() { static int n = 0; return n; }
+
+#define CHECK(cond) do { if (!(cond)) { std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); TestFailures()++; } } while (0)
+
+inline int TestExit(const char* name) {
+    if (TestFailures()) { std::fprintf(stderr, "%s: %d check(s) failed\n", name, TestFailures()); return 1; }
+    std::printf("%s: ok\n", name);
+    return 0;
+}
+
+inline bool HasArg(int argc, char** argv, const char* flag) {
+    for (int i = 1; i < argc; i++) if (std::strcmp(argv[i], flag) == 0) return true;
+    return false;
+}
+
+// "--name 123" 형식 정수 인자 (없으면 기본값)
+inline long long ArgInt(int argc, char** argv, const char* flag, long long fallback) {
+    for (int i = 1; i + 1 < argc; i++) if (std::strcmp(argv[i], flag) == 0) return std::atoll(argv[i + 1]);
+    return fallback;
+}
+
+inline double ElapsedMs(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
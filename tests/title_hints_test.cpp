@@ -0,0 +1,256 @@
+// [PRD 3.1.6] 제목 -> 경로 추측(LRU: 갱신, 용량 초과 시 가장 오래 안 쓴 것부터, 빈 값 무시) + 재시도 깨우기:
+//   경로가 늦게 준비되는 창도 NAMECHANGE 뒤 준비 즉시(다음 짧은 재시도에서) 해석됨
+// --bench [--navs N] [--gap-ms G] [--call-us U]: 새 탐색기 창 N개를 G ms 간격으로 열 때 폴더 이동 -> 메모 표시 지연 (가짜 Shell).
+//   창마다 제목(NAMECHANGE)은 5~50ms 뒤, Shell 등록은 그보다 10ms~3s 늦음 (대부분 짧고 10%는 1.5s 이상).
+//   예전 = 생성/NAMECHANGE마다 스레드, 300ms x 5회 폴링 (1.5s 안에 못 찾으면 표시 안 함),
+//   지금 = 워커 풀 + RunPathRetry (25ms부터 두 배, 상한 300ms, 새 요청에 깨어남), 지금 + 추측 = 최근 같은 제목의 경로를 먼저 표시
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/path_jobs.h"
+#include "core/title_hints.h"
+#include "tests/fake_shell.h"
+#include "tests/test_util.h"
+
+typedef BasicExplorerPathResolver<FakeHwnd> Resolver;
+typedef std::chrono::steady_clock Clock;
+
+static void TestHints() {
+    TitlePathHints hints;
+    CHECK(hints.Find(L"Docs").empty());
+    hints.Remember(L"Docs", L"C:\\Work\\Docs");
+    CHECK(hints.Find(L"Docs") == L"C:\\Work\\Docs");
+    hints.Remember(L"Docs", L"C:\\Home\\Docs"); // 같은 제목 -> 마지막 경로로
+    CHECK(hints.Find(L"Docs") == L"C:\\Home\\Docs");
+    hints.Remember(L"", L"C:\\x");
+    hints.Remember(L"Empty", L"");
+    CHECK(hints.Find(L"").empty() && hints.Find(L"Empty").empty());
+
+    // 용량 초과 -> 가장 오래 안 쓴 것부터. Find도 사용으로 침
+    TitlePathHints lru;
+    for (size_t i = 0; i < TITLE_HINT_CAPACITY; i++) lru.Remember(L"t" + std::to_wstring(i), L"p" + std::to_wstring(i));
+    CHECK(lru.Find(L"t0") == L"p0");
+    lru.Remember(L"new", L"pn");
+    CHECK(lru.Find(L"t0") == L"p0" && lru.Find(L"t1").empty() && lru.Find(L"new") == L"pn");
+    lru.Remember(L"t2", L"p2b"); // 갱신도 사용 -> t3이 다음 희생
+    lru.Remember(L"new2", L"pn2");
+    CHECK(lru.Find(L"t2") == L"p2b" && lru.Find(L"t3").empty());
+}
+
+// 창이 제목을 먼저 내고(NAMECHANGE) Shell 등록은 나중 -> 재시도가 준비 직후 찾아야 함 (예전 300ms 폴링이면 300ms 단위)
+static void TestLateShell() {
+    FakeShell shell;
+    Resolver resolver(&shell);
+    std::atomic<long long> resolvedMs{ -1 };
+    Clock::time_point t0 = Clock::now();
+    BasicPathJobPool<FakeHwnd>* pool = nullptr;
+    BasicPathJobPool<FakeHwnd> jobs([&](FakeHwnd, FakeHwnd hExplorer, unsigned long long gen) {
+        std::wstring path;
+        if (RunPathRetry(*pool, hExplorer, gen, [](FakeHwnd) { return true; },
+                [&](FakeHwnd h) { return resolver.Resolve(h, L"Late"); }, path) == PathRetryResult::Resolved && !path.empty()) {
+            long long expected = -1;
+            resolvedMs.compare_exchange_strong(expected, (long long)ElapsedMs(t0));
+        }
+    });
+    pool = &jobs;
+    jobs.Start(PATH_WORKER_COUNT);
+    jobs.Submit(101, 1); // 창 생성
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    jobs.Submit(101, 1); // NAMECHANGE (아직 Shell에 없음)
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    shell.AddTab(1, L"C:\\Work\\Late");
+    for (int i = 0; i < 200 && resolvedMs < 0; i++) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    jobs.Stop();
+    // 등록 140ms 언저리 -> 재시도 간격(25, 50, 100, ...) 안에서 찾음 (예전 폴링이면 300ms)
+    CHECK(resolvedMs >= 140 && resolvedMs < 140 + 2 * PATH_RETRY_FIRST_MS * 4);
+    resolver.Shutdown();
+    CHECK(shell.HeldRefs() == 0);
+}
+
+// 벤치 말뭉치: 같은 폴더 이름이 다른 위치에 있음 (제목만으로는 구분 불가 -> 추측이 틀릴 수 있음)
+static const wchar_t* const FOLDERS[] = { L"C:\\Work\\Docs", L"C:\\Home\\Docs", L"C:\\Work\\Src", L"C:\\Work\\Build", L"C:\\Photos\\2024",
+    L"C:\\Photos\\2023", L"D:\\Archive\\2024", L"C:\\Work\\Notes", L"C:\\Home\\Music", L"C:\\Home\\Downloads" };
+static const size_t FOLDER_COUNT = sizeof(FOLDERS) / sizeof(FOLDERS[0]);
+
+static std::wstring TitleOf(const std::wstring& path) { return path.substr(path.find_last_of(L'\\') + 1); }
+
+struct Navigation {
+    std::wstring folder;
+    std::wstring title;
+    int titleMs; // 생성 -> NAMECHANGE
+    int readyMs; // 생성 -> Shell 등록
+};
+
+struct Timeline {
+    enum Kind { Create, NameChange, Ready };
+    int atMs;
+    Kind kind;
+    int nav;
+};
+
+static std::vector<Timeline> Schedule(const std::vector<Navigation>& navs, int gapMs) {
+    std::vector<Timeline> events;
+    for (int i = 0; i < (int)navs.size(); i++) {
+        events.push_back({ i * gapMs, Timeline::Create, i });
+        events.push_back({ i * gapMs + navs[i].titleMs, Timeline::NameChange, i });
+        events.push_back({ i * gapMs + navs[i].readyMs, Timeline::Ready, i });
+    }
+    std::stable_sort(events.begin(), events.end(), [](const Timeline& a, const Timeline& b) { return a.atMs < b.atMs; });
+    return events;
+}
+
+// 창마다 처음 표시/확정 시각 (생성 기준 ms, -1 = 표시 안 됨)
+struct Latencies {
+    std::mutex mutex;
+    std::vector<double> firstMs, confirmedMs;
+    std::vector<Clock::time_point> created;
+    int confirmed = 0, replaced = 0;
+
+    explicit Latencies(size_t n) : firstMs(n, -1), confirmedMs(n, -1), created(n) {}
+    void Shown(int i, bool real) {
+        std::lock_guard<std::mutex> lock(mutex);
+        double ms = ElapsedMs(created[i]);
+        if (firstMs[i] < 0) firstMs[i] = ms;
+        if (real && confirmedMs[i] < 0) confirmedMs[i] = ms;
+    }
+};
+
+// 백분위수는 예전 방식이 표시한 창들(baseline >= 0)끼리 비교 -> 예전이 포기한 느린 창이 빠져도 공정하게. 느린 창은 최대값/미표시로
+static void Print(const char* label, const std::vector<double>& ms, const std::vector<double>& baseline) {
+    std::vector<double> common, all;
+    for (size_t i = 0; i < ms.size(); i++) {
+        if (ms[i] < 0) continue;
+        all.push_back(ms[i]);
+        if (baseline[i] >= 0) common.push_back(ms[i]);
+    }
+    std::sort(common.begin(), common.end());
+    auto pct = [&](double q) { return common.empty() ? 0.0 : common[(size_t)(q * (common.size() - 1))]; };
+    std::printf("%-42s p50=%6.1fms p90=%6.1fms | all: max=%6.1fms, never shown %zu/%zu\n", label, pct(0.5), pct(0.9),
+        all.empty() ? 0.0 : *std::max_element(all.begin(), all.end()), ms.size() - all.size(), ms.size());
+}
+
+// 타임라인을 실제 시간으로 재생 (이 스레드 = 탐색기 + WinEventProc)
+template <typename OnEvent>
+static void Play(const std::vector<Timeline>& events, Latencies& lat, OnEvent onEvent) {
+    Clock::time_point start = Clock::now();
+    for (const Timeline& e : events) {
+        std::this_thread::sleep_until(start + std::chrono::milliseconds(e.atMs));
+        if (e.kind == Timeline::Create) lat.created[e.nav] = Clock::now();
+        onEvent(e);
+    }
+}
+
+static void RunBench(int navCount, int gapMs, int callUs) {
+    std::mt19937 rng(17);
+    std::vector<Navigation> navs;
+    for (int i = 0; i < navCount; i++) {
+        Navigation n;
+        n.folder = FOLDERS[rng() % FOLDER_COUNT];
+        n.title = TitleOf(n.folder);
+        n.titleMs = 5 + (int)(rng() % 46);
+        int r = (int)(rng() % 100);
+        int lag = r < 60 ? 10 + (int)(rng() % 140) : r < 90 ? 150 + (int)(rng() % 650) : 1500 + (int)(rng() % 1500);
+        n.readyMs = n.titleMs + lag;
+        navs.push_back(n);
+    }
+    std::vector<Timeline> events = Schedule(navs, gapMs);
+    std::printf("navigation -> memo visible: %d new explorer windows, %d ms apart, %d us per shell call, %zu folders (some share a name)\n",
+        navCount, gapMs, callUs, FOLDER_COUNT);
+
+    // 예전: 생성/NAMECHANGE마다 스레드 -> GetExplorerPath, 못 찾으면 300ms 자고 다시 (최대 5회)
+    std::vector<double> before;
+    {
+        FakeShell shell;
+        shell.SetCallDelay(callUs);
+        Latencies lat(navs.size());
+        std::vector<std::thread> threads;
+        Play(events, lat, [&](const Timeline& e) {
+            if (e.kind == Timeline::Ready) { shell.AddTab(e.nav, navs[e.nav].folder); return; }
+            threads.emplace_back([&, i = e.nav] {
+                for (int attempt = 0; attempt < 5; attempt++) {
+                    if (OldGetExplorerPath(shell, i, navs[i].title) == navs[i].folder) { lat.Shown(i, true); return; }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                }
+            });
+        });
+        for (auto& t : threads) t.join();
+        before = lat.firstMs;
+        Print("before (thread per event, 5 x 300ms poll):", lat.firstMs, before);
+    }
+
+    // 지금: 워커 풀 + 적응형 재시도. speculative면 생성/NAMECHANGE 때 같은 제목의 최근 경로를 먼저 표시
+    for (int speculative = 0; speculative < 2; speculative++) {
+        FakeShell shell;
+        shell.SetCallDelay(callUs);
+        Resolver resolver(&shell);
+        Latencies lat(navs.size());
+        std::mutex hintsMutex; // 앱에서는 UI 스레드 전용. 여기서는 결과를 워커에서 바로 적용
+        TitlePathHints hints;
+        std::vector<std::wstring> guessed(navs.size());
+        BasicPathJobPool<FakeHwnd>* pool = nullptr;
+        BasicPathJobPool<FakeHwnd> jobs([&](FakeHwnd, FakeHwnd hExplorer, unsigned long long gen) {
+            std::wstring path;
+            int i = hExplorer;
+            PathRetryResult r = RunPathRetry(*pool, hExplorer, gen, [](FakeHwnd) { return true; },
+                [&](FakeHwnd h) { return resolver.Resolve(h, navs[i].title); }, path);
+            if (r != PathRetryResult::Resolved || path.empty() || !pool->IsLatest(hExplorer, gen)) return;
+            CHECK(path == navs[i].folder);
+            std::lock_guard<std::mutex> lock(hintsMutex);
+            if (!guessed[i].empty()) {
+                (guessed[i] == path ? lat.confirmed : lat.replaced)++;
+                guessed[i].clear();
+            }
+            hints.Remember(navs[i].title, path);
+            lat.Shown(i, true);
+        });
+        pool = &jobs;
+        jobs.Start(PATH_WORKER_COUNT);
+        Play(events, lat, [&](const Timeline& e) {
+            if (e.kind == Timeline::Ready) { shell.AddTab(e.nav, navs[e.nav].folder); return; }
+            jobs.Submit(1000 + e.nav, e.nav);
+            if (!speculative) return;
+            std::lock_guard<std::mutex> lock(hintsMutex);
+            std::wstring hint = hints.Find(navs[e.nav].title);
+            if (!hint.empty() && lat.confirmedMs[e.nav] < 0 && guessed[e.nav].empty()) {
+                guessed[e.nav] = hint;
+                lat.Shown(e.nav, false);
+            }
+        });
+        // 마지막 창의 재시도가 끝날 때까지
+        auto deadline = Clock::now() + std::chrono::milliseconds(PATH_RESOLVE_BUDGET_MS);
+        for (;;) {
+            bool all;
+            { std::lock_guard<std::mutex> lock(lat.mutex); all = std::none_of(lat.confirmedMs.begin(), lat.confirmedMs.end(), [](double v) { return v < 0; }); }
+            if (all || Clock::now() > deadline) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        jobs.Stop();
+        if (!speculative) {
+            Print("after (worker pool, adaptive retry):", lat.firstMs, before);
+        } else {
+            Print("after + speculative, first memo shown:", lat.firstMs, before);
+            Print("after + speculative, path confirmed:", lat.confirmedMs, before);
+            std::printf("speculative guesses: %d confirmed, %d replaced (same folder name elsewhere)\n", lat.confirmed, lat.replaced);
+        }
+        resolver.Shutdown();
+        CHECK(shell.HeldRefs() == 0);
+    }
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--navs", 40), (int)ArgInt(argc, argv, "--gap-ms", 150), (int)ArgInt(argc, argv, "--call-us", 50));
+        return TestExit("title_hints_bench");
+    }
+    TestHints();
+    TestLateShell();
+    return TestExit("title_hints_test");
+}
\ No newline at end of file
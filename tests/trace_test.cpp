@@ -0,0 +1,209 @@
+// [PRD 7.1] 지연 추적: 히스토그램 구간(하한 <= 값 < 상한, 상대 오차 6.25% 이내), 백분위수, 링 순서/덮어쓰기,
+//   기록 중 스냅숏이 찢어진 칸을 내놓지 않음, 링 재사용, 스레드 이름, Chrome JSON 형식, 매크로가 단계 히스토그램에 기록
+//   (FM_TRACE=0 빌드에서는 매크로가 아무것도 하지 않는지만 확인)
+// --bench [--ops N] [--threads T]: FM_TRACE_SCOPE 1회 비용(빈 루프 대비 ns), T개 스레드 동시 기록(히스토그램 원자 경합),
+//   가득 찬 링에서 Chrome JSON 덤프 시간
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/trace.h"
+#include "tests/test_util.h"
+
+#if FM_TRACE
+static void TestHistogram() {
+    typedef trace::Histogram H;
+    // 구간 경계: 값은 자기 구간 안, 구간 폭 / 하한 <= 1/16
+    for (uint64_t v = 0; v < 200000; v += (v < 1000 ? 1 : 997)) {
+        int b = H::BucketOf(v);
+        CHECK(H::BucketLow(b) <= v && v < H::BucketHigh(b));
+        if (v >= (uint64_t)H::SUB_COUNT) CHECK((H::BucketHigh(b) - H::BucketLow(b)) * 16 <= H::BucketLow(b));
+    }
+    for (int shift = 20; shift < 42; shift++) {
+        uint64_t v = ((uint64_t)1 << shift) + 12345;
+        int b = H::BucketOf(v);
+        CHECK(H::BucketLow(b) <= v && v < H::BucketHigh(b));
+    }
+    CHECK(H::BucketOf(~0ULL) == H::BUCKETS - 1);
+    for (int b = 1; b < H::BUCKETS - 1; b++) CHECK(H::BucketLow(b) == H::BucketHigh(b - 1)); // 빈틈/겹침 없음
+
+    H h;
+    CHECK(h.Count() == 0 && h.Percentile(0.5) == 0);
+    for (uint64_t v = 1; v <= 100000; v++) h.Record(v * 1000); // 1µs ~ 100ms
+    CHECK(h.Count() == 100000 && h.Max() == 100000000ULL);
+    CHECK(h.Mean() == 50000500ULL);
+    const double qs[] = { 0.01, 0.5, 0.9, 0.99, 0.999 };
+    for (double q : qs) {
+        double exact = q * 100000 * 1000;
+        double got = (double)h.Percentile(q);
+        CHECK(got >= exact * 0.999 && got <= exact * 1.0625);
+    }
+    CHECK(h.Percentile(1.0) == h.Max());
+}
+
+static trace::Event Ev(uint64_t k) { return { k, k * 3 + 1, k ^ 0x5a5a, (uint32_t)(k % trace::STAGE_COUNT) }; }
+static bool Consistent(const trace::Event& e) {
+    return e.dur == e.start * 3 + 1 && e.id == (e.start ^ 0x5a5a) && e.stage == e.start % trace::STAGE_COUNT;
+}
+
+static void TestRing() {
+    trace::Ring ring;
+    std::vector<trace::Event> out;
+    ring.Snapshot(out);
+    CHECK(out.empty());
+    for (uint64_t k = 0; k < 100; k++) ring.Push(Ev(k));
+    ring.Snapshot(out);
+    CHECK(out.size() == 100 && out.front().start == 0 && out.back().start == 99);
+
+    // 가득 차면 가장 오래된 것부터 덮어씀 -> 마지막 SIZE개만, 순서대로
+    for (uint64_t k = 100; k < trace::Ring::SIZE * 2 + 7; k++) ring.Push(Ev(k));
+    out.clear();
+    ring.Snapshot(out);
+    CHECK(out.size() == trace::Ring::SIZE && ring.Written() == trace::Ring::SIZE * 2 + 7);
+    CHECK(out.front().start == trace::Ring::SIZE + 7 && out.back().start == trace::Ring::SIZE * 2 + 6);
+    for (size_t i = 1; i < out.size(); i++) CHECK(out[i].start == out[i - 1].start + 1);
+
+    // 쓰는 스레드 하나 + 덤프 반복 -> 내놓은 칸은 모두 한 번의 Push 그대로 (찢어진 칸 없음)
+    std::atomic<bool> done{ false };
+    std::thread writer([&] {
+        for (uint64_t k = 0; k < 2000000; k++) ring.Push(Ev(k));
+        done = true;
+    });
+    size_t snapshots = 0, torn = 0;
+    while (!done) {
+        out.clear();
+        ring.Snapshot(out);
+        for (const auto& e : out) torn += !Consistent(e);
+        snapshots++;
+    }
+    writer.join();
+    CHECK(torn == 0);
+    CHECK(snapshots > 0);
+}
+
+static void TestTracer() {
+    trace::Tracer tracer;
+    trace::Ring* a = tracer.Acquire("ui");
+    trace::Ring* b = tracer.Acquire("path-worker");
+    CHECK(a != b);
+    a->Push({ 1000, 2500, 0x10, trace::PathJob });
+    a->Push({ 5000, 0, 0x10, trace::WinEvent });
+    b->Push({ 2000, 1000, 0x20, trace::LoadMemo });
+    tracer.Release(b);
+    trace::Ring* c = tracer.Acquire("save");
+    CHECK(c == b); // 끝난 스레드의 링 재사용 (기록은 남아 있음)
+
+    std::string json;
+    tracer.WriteChromeJson(json);
+    CHECK(json.compare(0, 18, "{\"displayTimeUnit\"") == 0);
+    CHECK(json.size() >= 3 && json.compare(json.size() - 3, 3, "]}\n") == 0);
+    CHECK(json.find("\"args\":{\"name\":\"ui\"}") != std::string::npos);
+    CHECK(json.find("\"args\":{\"name\":\"save\"}") != std::string::npos);
+    CHECK(json.find("\"name\":\"PathJob\",\"cat\":\"fm\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":1.000,\"dur\":2.500") != std::string::npos);
+    CHECK(json.find("\"name\":\"WinEvent\",\"cat\":\"fm\",\"ph\":\"i\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"LoadMemo\"") != std::string::npos);
+    int depth = 0, minDepth = 0;
+    for (char ch : json) {
+        depth += (ch == '{' || ch == '[') - (ch == '}' || ch == ']');
+        if (depth < minDepth) minDepth = depth;
+    }
+    CHECK(depth == 0 && minDepth == 0);
+}
+
+static void TestMacros() {
+    uint64_t before = trace::Global().Hist(trace::SaveMemo).Count();
+    std::thread t([] {
+        FM_TRACE_THREAD("macro-test");
+        { FM_TRACE_SCOPE(SaveMemo, 0x77); }
+        uint64_t start = FM_TRACE_NOW();
+        FM_TRACE_SPAN(SaveMemo, 0x77, start);
+        FM_TRACE_INSTANT(WinEvent, 0x77); // 순간 이벤트는 히스토그램에 안 들어감
+    });
+    t.join();
+    CHECK(trace::Global().Hist(trace::SaveMemo).Count() == before + 2);
+    std::string json;
+    trace::Global().WriteChromeJson(json);
+    CHECK(json.find("\"args\":{\"name\":\"macro-test\"}") != std::string::npos);
+    CHECK(json.find("\"id\":\"0x77\"") != std::string::npos);
+}
+#else
+static void TestMacros() {
+    // 꺼진 빌드: 매크로는 식 하나로 사라지고, 인자도 평가하지 않음
+    int evaluated = 0;
+    FM_TRACE_THREAD("off");
+    FM_TRACE_SCOPE(SaveMemo, evaluated++);
+    FM_TRACE_INSTANT(WinEvent, evaluated++);
+    FM_TRACE_SPAN(SaveMemo, evaluated++, FM_TRACE_NOW());
+    CHECK(evaluated == 0 && FM_TRACE_NOW() == 0ULL);
+}
+#endif
+
+#if FM_TRACE
+static volatile uint64_t g_sink;
+
+static double NsPerOp(int ops, void (*body)(int)) {
+    auto t0 = std::chrono::steady_clock::now();
+    body(ops);
+    return ElapsedMs(t0) * 1e6 / ops;
+}
+static void EmptyLoop(int ops) { for (int i = 0; i < ops; i++) g_sink = g_sink + (uint64_t)i; }
+static void ScopeLoop(int ops) {
+    for (int i = 0; i < ops; i++) { FM_TRACE_SCOPE(ApplyResult, i); g_sink = g_sink + (uint64_t)i; }
+}
+static void InstantLoop(int ops) {
+    for (int i = 0; i < ops; i++) { FM_TRACE_INSTANT(WinEvent, i); g_sink = g_sink + (uint64_t)i; }
+}
+static void NowLoop(int ops) { for (int i = 0; i < ops; i++) g_sink = g_sink + trace::NowNs(); }
+
+static void RunBench(int ops, int threads) {
+    FM_TRACE_THREAD("bench");
+    ScopeLoop(1000); // 링 등록
+    double empty = NsPerOp(ops, EmptyLoop);
+    double now = NsPerOp(ops, NowLoop);
+    double scope = NsPerOp(ops, ScopeLoop);
+    double instant = NsPerOp(ops, InstantLoop);
+    std::printf("trace: %d ops/thread\n", ops);
+    std::printf("empty loop %.1f ns/op, steady_clock::now %.1f ns\n", empty, now);
+    std::printf("FM_TRACE_SCOPE %.1f ns/op (+%.1f), FM_TRACE_INSTANT %.1f ns/op (+%.1f); FM_TRACE=0 expands to ((void)0)\n", scope,
+        scope - empty, instant, instant - empty);
+
+    // 여러 스레드가 같은 단계에 기록 (링은 각자, 히스토그램 카운터는 공유)
+    std::vector<std::thread> pool;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) pool.emplace_back([ops] { FM_TRACE_THREAD("bench-worker"); ScopeLoop(ops); });
+    for (auto& t : pool) t.join();
+    double ms = ElapsedMs(t0);
+    std::printf("%d threads: %.1f ns/op wall, %.1f M scopes/s total\n", threads, ms * 1e6 / ((double)ops * threads),
+        (double)ops * threads / ms / 1000.0);
+
+    std::string json;
+    t0 = std::chrono::steady_clock::now();
+    trace::Global().WriteChromeJson(json);
+    double dumpMs = ElapsedMs(t0);
+    const trace::Histogram& h = trace::Global().Hist(trace::ApplyResult);
+    std::printf("dump: %.1f ms, %.1f MB JSON; ApplyResult scope p50=%lluns p99=%lluns max=%lluns over %llu samples\n", dumpMs,
+        json.size() / 1048576.0, (unsigned long long)h.Percentile(0.5), (unsigned long long)h.Percentile(0.99),
+        (unsigned long long)h.Max(), (unsigned long long)h.Count());
+    std::fflush(stdout);
+}
+#endif
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+#if FM_TRACE
+        RunBench((int)ArgInt(argc, argv, "--ops", 5000000), (int)ArgInt(argc, argv, "--threads", 4));
+#else
+        std::printf("trace: built with FM_TRACE=0, nothing to measure\n");
+#endif
+        return TestExit("trace_bench");
+    }
+#if FM_TRACE
+    TestHistogram();
+    TestRing();
+    TestTracer();
+#endif
+    TestMacros();
+    return TestExit("trace_test");
+}
\ No newline at end of file
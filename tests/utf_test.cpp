@@ -0,0 +1,307 @@
+// [PRD 5.6] UTF-8 <-> UTF-16 변환기: 유니코드 표준의 잘못된 시퀀스 예(최대 유효 접두 = U+FFFD 하나), 경계값,
+//   재사용 버퍼(두 번째 변환은 새 할당 없음), 퍼즈: 무작위/변형 입력을 디스패치 수준마다(스칼라/SSE2/AVX2) 참조 구현과 비교 + 왕복 일치
+// --fuzz N: 퍼즈 반복 수 (기본 3000)
+// --bench [--mb M]: 말뭉치(ASCII, 한글+ASCII 혼합, 한글만, 이모지 혼합)마다 디코드/인코드 MB/s
+//   -> 예전 방식(크기 계산 1번 + 변환 1번, 매번 새 버퍼: MultiByteToWideChar 두 번 호출과 같은 모양, 스칼라) vs 스칼라 폴백 vs SSE2 vs AVX2
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/utf.h"
+#include "tests/test_util.h"
+
+// --- 참조 구현 (코드 포인트 단위, 단순하고 느림) ---
+static void RefAppend16(std::u16string& out, uint32_t cp) {
+    if (cp >= 0x10000) {
+        cp -= 0x10000;
+        out.push_back((char16_t)(0xD800 + (cp >> 10)));
+        out.push_back((char16_t)(0xDC00 + (cp & 0x3FF)));
+    } else {
+        out.push_back((char16_t)cp);
+    }
+}
+
+// 유니코드 표 3-7의 올바른 바이트 범위. 잘못되면 그 지점까지의 최대 유효 접두를 U+FFFD 하나로
+static std::u16string RefDecode(const std::string& in) {
+    std::u16string out;
+    size_t i = 0;
+    while (i < in.size()) {
+        unsigned char c = (unsigned char)in[i];
+        size_t need;
+        unsigned char lo = 0x80, hi = 0xBF;
+        uint32_t cp;
+        if (c < 0x80) { out.push_back(c); i++; continue; }
+        if (c >= 0xC2 && c <= 0xDF) { need = 1; cp = c & 0x1F; }
+        else if (c == 0xE0) { need = 2; cp = 0; lo = 0xA0; }
+        else if (c == 0xED) { need = 2; cp = 0xD; hi = 0x9F; }
+        else if (c >= 0xE1 && c <= 0xEF) { need = 2; cp = c & 0x0F; }
+        else if (c == 0xF0) { need = 3; cp = 0; lo = 0x90; }
+        else if (c == 0xF4) { need = 3; cp = 4; hi = 0x8F; }
+        else if (c >= 0xF1 && c <= 0xF3) { need = 3; cp = c & 0x07; }
+        else { out.push_back(0xFFFD); i++; continue; }
+        size_t got = 0;
+        while (got < need && i + 1 + got < in.size()) {
+            unsigned char cc = (unsigned char)in[i + 1 + got];
+            if (cc < (got == 0 ? lo : 0x80) || cc > (got == 0 ? hi : 0xBF)) break;
+            cp = (cp << 6) | (cc & 0x3F);
+            got++;
+        }
+        if (got < need) { out.push_back(0xFFFD); i += 1 + got; continue; }
+        RefAppend16(out, cp);
+        i += 1 + need;
+    }
+    return out;
+}
+
+static void RefAppend8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) out += (char)cp;
+    else if (cp < 0x800) { out += (char)(0xC0 | (cp >> 6)); out += (char)(0x80 | (cp & 0x3F)); }
+    else if (cp < 0x10000) { out += (char)(0xE0 | (cp >> 12)); out += (char)(0x80 | ((cp >> 6) & 0x3F)); out += (char)(0x80 | (cp & 0x3F)); }
+    else {
+        out += (char)(0xF0 | (cp >> 18)); out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F)); out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+// 짝 없는 서로게이트는 U+FFFD
+static std::string RefEncode(const std::u16string& in) {
+    std::string out;
+    for (size_t i = 0; i < in.size(); i++) {
+        uint32_t c = in[i];
+        if (c >= 0xD800 && c <= 0xDBFF && i + 1 < in.size() && in[i + 1] >= 0xDC00 && in[i + 1] <= 0xDFFF) {
+            RefAppend8(out, 0x10000 + ((c - 0xD800) << 10) + (in[i + 1] - 0xDC00));
+            i++;
+        } else if (c >= 0xD800 && c <= 0xDFFF) {
+            RefAppend8(out, 0xFFFD);
+        } else {
+            RefAppend8(out, c);
+        }
+    }
+    return out;
+}
+
+static std::vector<utf::Isa> SupportedIsas() {
+    std::vector<utf::Isa> out = { utf::Isa::Scalar };
+    if (utf::DetectIsa() >= utf::Isa::Sse2) out.push_back(utf::Isa::Sse2);
+    if (utf::DetectIsa() >= utf::Isa::Avx2) out.push_back(utf::Isa::Avx2);
+    return out;
+}
+
+static const char* IsaName(utf::Isa isa) {
+    return isa == utf::Isa::Avx2 ? "avx2" : isa == utf::Isa::Sse2 ? "sse2" : "scalar";
+}
+
+static std::u16string Decode(const std::string& s) {
+    std::u16string out;
+    utf::Utf8ToUtf16<char16_t>(s.data(), s.size(), out);
+    return out;
+}
+
+static std::string Encode(const std::u16string& s) {
+    std::string out;
+    utf::Utf16ToUtf8(s.data(), s.size(), out);
+    return out;
+}
+
+static void TestKnownVectors() {
+    for (utf::Isa isa : SupportedIsas()) {
+        CHECK(utf::ForceIsa(isa));
+        // 유니코드 표준 3.9절 예: 61 F1 80 80 E1 80 C2 62 80 63 80 BF 64
+        CHECK(Decode("\x61\xF1\x80\x80\xE1\x80\xC2\x62\x80\x63\x80\xBF\x64") ==
+            std::u16string(u"a\xFFFD\xFFFD\xFFFD" u"b\xFFFD" u"c\xFFFD\xFFFD" u"d"));
+        CHECK(Decode("\xC0\xAF") == u"\xFFFD\xFFFD");             // overlong 2바이트
+        CHECK(Decode("\xE0\x80\xAF") == u"\xFFFD\xFFFD\xFFFD");   // overlong 3바이트
+        CHECK(Decode("\xED\xA0\x80") == u"\xFFFD\xFFFD\xFFFD");   // 서로게이트 인코딩
+        CHECK(Decode("\xF4\x90\x80\x80").size() == 4);            // U+10FFFF 초과
+        CHECK(Decode("\xF0\x9F\x98\x80") == u"\xD83D\xDE00");     // 😀
+        CHECK(Decode("\xEA\xB0\x80\xED\x9E\xA3") == u"\xAC00\xD7A3"); // 가, 힣 (한글 경계)
+        CHECK(Decode("\xE2\x82") == u"\xFFFD");                   // 끝에서 잘림
+        CHECK(Decode(std::string(40, 'a') + "\xFF" + std::string(40, 'b')) ==
+            std::u16string(40, u'a') + u"\xFFFD" + std::u16string(40, u'b')); // SIMD 구간 사이 오류
+        CHECK(Encode(u"a\xD800" u"b\xDC00") == "a\xEF\xBF\xBD" "b\xEF\xBF\xBD"); // 짝 없는 서로게이트
+        CHECK(Encode(std::u16string(33, u'x') + u"\xAC00") == std::string(33, 'x') + "\xEA\xB0\x80");
+    }
+    CHECK(utf::ForceIsa(utf::DetectIsa()));
+    CHECK(!utf::ForceIsa((utf::Isa)((int)utf::DetectIsa() + 1)));
+
+    // wchar_t (Linux는 32비트: 서로게이트 없이 코드 포인트 그대로)
+    std::wstring w = Utf8ToWide(std::string("\xF0\x9F\x98\x80"));
+    CHECK(sizeof(wchar_t) == 2 ? w.size() == 2 : (w.size() == 1 && (uint32_t)w[0] == 0x1F600));
+    CHECK(WideToUtf8(w) == "\xF0\x9F\x98\x80");
+}
+
+// 두 번째 변환부터는 기존 용량을 그대로 씀 (저장마다 새 할당 없음)
+static void TestReuse() {
+    std::string big(1 << 16, 'a'), small = "\xEA\xB0\x80 hello";
+    std::wstring out;
+    Utf8ToWide(big.data(), big.size(), out);
+    const wchar_t* p = out.data();
+    Utf8ToWide(small.data(), small.size(), out);
+    CHECK(out.data() == p && out.size() == 7);
+    std::string bytes;
+    WideToUtf8(std::wstring(1 << 14, L'\xAC00').c_str(), 1 << 14, bytes);
+    const char* q = bytes.data();
+    WideToUtf8(out.data(), out.size(), bytes);
+    CHECK(bytes.data() == q && bytes == small);
+}
+
+// 무작위 코드 포인트 (ASCII 구간, 한글, 기타 BMP, 이모지, 경계값)
+static uint32_t RandomCodePoint(std::mt19937& rng) {
+    switch (rng() % 6) {
+    case 0: case 1: return 0x20 + rng() % 0x5F;
+    case 2: return 0xAC00 + rng() % 11172;
+    case 3: { uint32_t c = 0x80 + rng() % (0x10000 - 0x80); return (c >= 0xD800 && c <= 0xDFFF) ? 0xFFFD : c; }
+    case 4: return 0x1F300 + rng() % 0x300;
+    default: {
+        static const uint32_t edges[] = { 0, 0x7F, 0x80, 0x7FF, 0x800, 0xFFFF, 0x10000, 0x10FFFF, 0xD7FF, 0xE000 };
+        return edges[rng() % 10];
+    }
+    }
+}
+
+static std::string RandomInput(std::mt19937& rng) {
+    std::string s;
+    size_t len = rng() % 200;
+    int kind = rng() % 4;
+    if (kind == 0) { // 무작위 바이트
+        for (size_t i = 0; i < len; i++) s += (char)(rng() & 0xFF);
+        return s;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (kind == 1 && rng() % 3) { size_t run = rng() % 40; s.append(run, (char)('a' + rng() % 26)); } // 긴 ASCII 구간 (SIMD 경로)
+        RefAppend8(s, RandomCodePoint(rng));
+    }
+    if (kind == 3 && !s.empty()) { // 올바른 입력을 몇 바이트 변형 (자르기/바꾸기/끼워 넣기)
+        for (int m = rng() % 4; m >= 0; m--) {
+            size_t at = rng() % s.size();
+            switch (rng() % 3) {
+            case 0: s.erase(at, 1 + rng() % 3); break;
+            case 1: s[at] = (char)(rng() & 0xFF); break;
+            default: s.insert(at, 1, (char)(0x80 | (rng() & 0x7F))); break;
+            }
+            if (s.empty()) break;
+        }
+    }
+    return s;
+}
+
+static void TestFuzz(int iterations) {
+    std::mt19937 rng(1234);
+    std::vector<utf::Isa> isas = SupportedIsas();
+    for (int n = 0; n < iterations; n++) {
+        std::string in = RandomInput(rng);
+        std::u16string expected = RefDecode(in);
+        std::string reencoded = RefEncode(expected);
+        for (utf::Isa isa : isas) {
+            utf::ForceIsa(isa);
+            std::u16string got = Decode(in);
+            if (got != expected) { CHECK(got == expected); std::fprintf(stderr, "  decode mismatch (%s), case %d\n", IsaName(isa), n); break; }
+            std::string back = Encode(got);
+            CHECK(back == reencoded);
+            CHECK(Decode(back) == expected); // 치환 후에는 왕복이 고정점
+            if (RefEncode(RefDecode(in)) == in) CHECK(back == in); // 올바른 입력은 바이트 단위로 그대로
+        }
+        // 짝 없는 서로게이트를 섞은 UTF-16 -> 인코드 비교
+        std::u16string u16 = expected;
+        if (!u16.empty() && rng() % 2) u16[rng() % u16.size()] = (char16_t)(0xD800 + rng() % 0x800);
+        for (utf::Isa isa : isas) {
+            utf::ForceIsa(isa);
+            CHECK(Encode(u16) == RefEncode(u16));
+        }
+    }
+    utf::ForceIsa(utf::DetectIsa());
+}
+
+// --- 벤치 ---
+static std::string Corpus(const char* kind, size_t bytes, std::mt19937& rng) {
+    std::string s;
+    std::string k = kind;
+    while (s.size() < bytes) {
+        if (k == "ascii") { s += "build 1234 ok: cache hit, 17 files changed\n"; continue; }
+        if (k == "hangul") { RefAppend8(s, 0xAC00 + rng() % 11172); continue; }
+        if (k == "mixed") { // 한글 단어 + 공백/숫자/영문 (보통 메모)
+            for (int j = 0; j < 2 + (int)(rng() % 3); j++) RefAppend8(s, 0xAC00 + rng() % 11172);
+            s += (rng() % 4 == 0) ? " v2.1 " : " ";
+            if (rng() % 10 == 0) s += "\n";
+            continue;
+        }
+        RefAppend8(s, rng() % 3 ? 0x1F600 + rng() % 0x50 : 0xAC00 + rng() % 11172); // emoji
+        s += ' ';
+    }
+    return s;
+}
+
+// 예전 모양: 크기 계산 1번 + 변환 1번, 호출마다 새 버퍼 (변환 자체는 스칼라 경로 -> 두 번 돌고 새로 할당하는 비용만 비교)
+static size_t TwoPassDecode(const std::string& in) {
+    std::u16string sizing;
+    utf::Utf8ToUtf16<char16_t>(in.data(), in.size(), sizing); // 1번째: 크기만 씀
+    std::u16string out;
+    out.reserve(sizing.size());
+    utf::Utf8ToUtf16<char16_t>(in.data(), in.size(), out);
+    return out.size();
+}
+
+static size_t TwoPassEncode(const std::u16string& in) {
+    std::string sizing;
+    utf::Utf16ToUtf8(in.data(), in.size(), sizing);
+    std::string out;
+    out.reserve(sizing.size());
+    utf::Utf16ToUtf8(in.data(), in.size(), out);
+    return out.size();
+}
+
+template <typename Fn>
+static double Throughput(size_t bytes, int reps, Fn fn) {
+    double best = 1e18;
+    for (int r = 0; r < reps; r++) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, ElapsedMs(t0));
+    }
+    return bytes / 1048576.0 / (best / 1000.0);
+}
+
+static void RunBench(int mb) {
+    std::mt19937 rng(9);
+    std::vector<utf::Isa> isas = SupportedIsas();
+    std::printf("utf: %d MB per corpus, best of 5, MB/s of UTF-8 (decode) / UTF-8 produced (encode)\n", mb);
+    std::printf("%-7s %-6s %10s", "corpus", "dir", "two-pass");
+    for (utf::Isa isa : isas) std::printf(" %10s", IsaName(isa));
+    std::printf("\n");
+    for (const char* kind : { "ascii", "mixed", "hangul", "emoji" }) {
+        std::string in = Corpus(kind, (size_t)mb * 1024 * 1024, rng);
+        std::u16string decoded = RefDecode(in);
+        std::u16string out16;
+        std::string out8;
+        utf::ForceIsa(utf::Isa::Scalar);
+        std::printf("%-7s %-6s %10.0f", kind, "decode", Throughput(in.size(), 5, [&] { TwoPassDecode(in); }));
+        for (utf::Isa isa : isas) {
+            utf::ForceIsa(isa);
+            std::printf(" %10.0f", Throughput(in.size(), 5, [&] { utf::Utf8ToUtf16<char16_t>(in.data(), in.size(), out16); }));
+            CHECK(out16 == decoded);
+        }
+        utf::ForceIsa(utf::Isa::Scalar);
+        std::printf("\n%-7s %-6s %10.0f", kind, "encode", Throughput(in.size(), 5, [&] { TwoPassEncode(decoded); }));
+        for (utf::Isa isa : isas) {
+            utf::ForceIsa(isa);
+            std::printf(" %10.0f", Throughput(in.size(), 5, [&] { utf::Utf16ToUtf8(decoded.data(), decoded.size(), out8); }));
+            CHECK(out8 == in);
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+    utf::ForceIsa(utf::DetectIsa());
+}
+
+int main(int argc, char** argv) {
+    if (HasArg(argc, argv, "--bench")) {
+        RunBench((int)ArgInt(argc, argv, "--mb", 16));
+        return TestExit("utf_bench");
+    }
+    TestKnownVectors();
+    TestReuse();
+    TestFuzz((int)ArgInt(argc, argv, "--fuzz", 3000));
+    return TestExit("utf_test");
+}
\ No newline at end of file
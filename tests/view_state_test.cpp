@@ -0,0 +1,150 @@
+// [PRD 4.7] 폴더별 보기 상태 표: 헤더 초기화, seqlock(기록 중 종료), CRC(찢긴 페이지), 탐사 구간 교체, 읽기/기록 동시성
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/view_state.h"
+#include "tests/test_util.h"
+
+const uint32_t SLOTS = 64;
+
+// 매핑된 파일 대신 메모리 (4바이트 정렬)
+struct Region {
+    std::vector<uint32_t> words = std::vector<uint32_t>(ViewStateTable::BytesFor(SLOTS) / 4, 0);
+    uint32_t* Record(size_t slot) { return words.data() + ViewStateTable::HEADER_SIZE / 4 + slot * ViewStateTable::RECORD_WORDS; }
+};
+
+static FolderViewState State(int font, uint32_t line, uint32_t caret, bool minimized = false) {
+    FolderViewState st;
+    st.fontSize = font;
+    st.firstLine = line;
+    st.caret = caret;
+    st.minimized = minimized;
+    return st;
+}
+
+static void TestRoundTripAndHeader() {
+    Region r;
+    ViewStateTable t;
+    CHECK(!t.Attach(r.words.data(), r.words.size() * 4, 48)); // 2의 거듭제곱만
+    CHECK(!t.Attach(r.words.data(), 16, SLOTS));              // 크기 부족
+    CHECK(t.Attach(r.words.data(), r.words.size() * 4, SLOTS));
+    CHECK(r.words[0] == ViewStateTable::MAGIC && r.words[2] == SLOTS);
+
+    uint64_t a = ViewStateTable::KeyOf(L"c:\\work\\alpha");
+    FolderViewState out;
+    CHECK(!t.Find(a, out));
+    t.Store(a, State(30, 120, 4000, true), 100);
+    CHECK(t.Find(a, out));
+    CHECK(out.fontSize == 30 && out.firstLine == 120 && out.caret == 4000 && out.minimized && !out.expanded);
+    t.Store(a, State(18, 5, 6), 101); // 같은 키 -> 같은 칸 덮어씀
+    CHECK(t.Find(a, out) && out.fontSize == 18 && !out.minimized);
+
+    ViewStateTable again; // 다시 실행: 같은 파일 -> 내용 유지
+    CHECK(again.Attach(r.words.data(), r.words.size() * 4, SLOTS));
+    CHECK(again.Find(a, out) && out.caret == 6);
+
+    r.words[3] = 7; // 형식(레코드 크기)이 다른 파일 -> 전부 비움
+    CHECK(again.Attach(r.words.data(), r.words.size() * 4, SLOTS));
+    CHECK(!again.Find(a, out));
+    CHECK(ViewStateTable::KeyOf(L"") != 0);
+}
+
+// 기록 도중 프로세스가 죽어 seq가 홀수로 남음 -> 기록 없음으로 보고, 다음 기록이 그 칸을 먼저 재사용
+static void TestTornSeqlock() {
+    Region r;
+    ViewStateTable t;
+    t.Attach(r.words.data(), r.words.size() * 4, SLOTS);
+    uint64_t key = 5; // 시작 칸 5
+    t.Store(key, State(25, 1, 2), 10);
+    uint32_t* rec = r.Record(5);
+    rec[2] |= 1;
+    rec[5] = 999; // 반쯤 쓴 값
+    FolderViewState out;
+    CHECK(!t.Find(key, out));
+
+    uint64_t other = 5 + SLOTS; // 같은 시작 칸 -> 깨진 칸을 재사용 (탐사 구간을 계속 막지 않게)
+    t.Store(other, State(26, 3, 4), 11);
+    CHECK((rec[2] & 1) == 0);
+    CHECK(((uint64_t)rec[0] | ((uint64_t)rec[1] << 32)) == other);
+    CHECK(t.Find(other, out) && out.fontSize == 26);
+}
+
+// 찢긴 페이지: seq는 짝수지만 내용이 섞임 -> CRC 불일치로 기록 없음, 같은 키를 다시 쓰면 회복
+static void TestCrcMismatch() {
+    Region r;
+    ViewStateTable t;
+    t.Attach(r.words.data(), r.words.size() * 4, SLOTS);
+    uint64_t key = ViewStateTable::KeyOf(L"d:\\shared\\beta");
+    t.Store(key, State(22, 40, 41), 10);
+    size_t slot = (size_t)key & (SLOTS - 1);
+    r.Record(slot)[6] ^= 0x10000; // 캐럿 한 비트
+    FolderViewState out;
+    CHECK(!t.Find(key, out));
+    t.Store(key, State(22, 40, 41), 12);
+    CHECK(t.Find(key, out) && out.caret == 41);
+}
+
+// 탐사 구간(VIEW_STATE_PROBE_LIMIT칸)이 차면 그 구간에서 마지막 사용이 가장 오래된 레코드를 교체
+static void TestProbeEviction() {
+    Region r;
+    ViewStateTable t;
+    t.Attach(r.words.data(), r.words.size() * 4, SLOTS);
+    std::vector<uint64_t> keys;
+    for (size_t i = 0; i < VIEW_STATE_PROBE_LIMIT; i++) {
+        keys.push_back(9 + i * SLOTS); // 모두 시작 칸 9
+        uint32_t use = i == 3 ? 1 : 100 + (uint32_t)i; // 3번이 가장 오래 안 씀
+        t.Store(keys.back(), State(20, (uint32_t)i, 0), use);
+    }
+    FolderViewState out;
+    for (uint64_t k : keys) CHECK(t.Find(k, out));
+    uint64_t extra = 9 + VIEW_STATE_PROBE_LIMIT * SLOTS;
+    t.Store(extra, State(40, 77, 0), 500);
+    CHECK(t.Find(extra, out) && out.firstLine == 77);
+    CHECK(!t.Find(keys[3], out));
+    for (size_t i = 0; i < keys.size(); i++) if (i != 3) CHECK(t.Find(keys[i], out) && out.firstLine == i);
+
+    // 구간 밖 키는 영향 없음
+    uint64_t far = 40;
+    t.Store(far, State(21, 1, 1), 1);
+    CHECK(t.Find(far, out));
+}
+
+// 기록자 하나 + 읽기 스레드 여럿: 읽은 레코드는 항상 한 번의 Store 전체 (줄 == 캐럿 == 글꼴 기준 값)
+static void TestConcurrentReaders() {
+    Region r;
+    ViewStateTable t;
+    t.Attach(r.words.data(), r.words.size() * 4, SLOTS);
+    uint64_t key = 17;
+    t.Store(key, State(10, 0, 0), 0);
+    std::atomic<bool> stop{ false };
+    std::atomic<unsigned long long> reads{ 0 }, torn{ 0 };
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++) {
+        readers.emplace_back([&] {
+            FolderViewState out;
+            while (!stop) {
+                if (!t.Find(key, out)) continue; // 기록 중 -> 건너뜀 (앱은 기본값)
+                reads++;
+                if (out.firstLine != out.caret || out.fontSize != (int)(10 + out.firstLine % 50)) torn++;
+            }
+        });
+    }
+    for (uint32_t i = 1; i <= 200000; i++) t.Store(key, State((int)(10 + i % 50), i, i), i);
+    stop = true;
+    for (auto& th : readers) th.join();
+    CHECK(torn == 0);
+    FolderViewState out;
+    CHECK(t.Find(key, out) && out.firstLine == 200000);
+}
+
+int main() {
+    TestRoundTripAndHeader();
+    TestTornSeqlock();
+    TestCrcMismatch();
+    TestProbeEviction();
+    TestConcurrentReaders();
+    return TestExit("view_state_test");
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+// [PRD 6.2] fm_archive: 메모 아카이브 명령의 이식 가능한 CLI (Win32 앱의 --archive-* 와 같은 core/archive 사용)
+// -> 사용법:
+//    fm_archive export <아카이브> <루트>... [--threads N]
+//    fm_archive restore <아카이브> [--target 폴더]
+//    fm_archive diff <아카이브> [--target 폴더] [--threads N]
+//    fm_archive bench <폴더> <디렉터리 수> [--threads N]
+// -> 메모 읽기/복원은 FileArchiveIo (core/archive.h).
+// -> 종료 코드: 0 성공/차이 없음, 1 실패/차이 있음/건너뜀 있음, 2 사용법 오류
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/archive.h"
+#include "core/utf.h"
+
+namespace fs = std::filesystem;
+
+static void Print(const std::wstring& line) { std::printf("%s\n", WideToUtf8(line).c_str()); }
+
+static int Usage() {
+    std::fprintf(stderr,
+        "usage: fm_archive export <archive> <root>... [--threads N]\n"
+        "       fm_archive restore <archive> [--target DIR]\n"
+        "       fm_archive diff <archive> [--target DIR] [--threads N]\n"
+        "       fm_archive bench <dir> <directories> [--threads N]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) return Usage();
+    std::string cmd = argv[1];
+    std::vector<std::wstring> args;
+    std::wstring target;
+    unsigned threads = 0;
+    for (int i = 2; i < argc; i++) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = (unsigned)std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--target") == 0 && i + 1 < argc) target = Utf8ToWide(argv[++i]);
+        else args.push_back(Utf8ToWide(argv[i]));
+    }
+    if (threads == 0) {
+        unsigned n = std::thread::hardware_concurrency();
+        threads = n ? std::min(n * 2, 32u) : 4; // 앱의 ArchiveThreadCount와 같은 기본값
+    }
+    FileArchiveIo io;
+    fs::path archive = args[0];
+
+    if (cmd == "export") {
+        if (args.size() < 2) return Usage();
+        std::vector<std::wstring> roots;
+        for (size_t i = 1; i < args.size(); i++) roots.push_back(fs::absolute(args[i]).lexically_normal().wstring());
+        ArchiveStats stats;
+        if (!ExportMemoArchive(io, roots, archive, threads, stats)) { Print(L"export failed: " + archive.wstring()); return 1; }
+        Print(ArchiveStatsLine(L"export", stats, threads));
+        return 0;
+    }
+    if (cmd == "restore") {
+        size_t restored, unchanged, skipped;
+        bool ok = RestoreMemoArchive(io, archive, target, restored, unchanged, skipped);
+        Print(L"restored " + std::to_wstring(restored) + L" memos (" + std::to_wstring(unchanged) + L" unchanged, " +
+            std::to_wstring(skipped) + L" skipped)" + (ok ? L"" : L" - archive is truncated or damaged"));
+        return ok && !skipped ? 0 : 1;
+    }
+    if (cmd == "diff") {
+        ArchiveStats stats;
+        std::vector<std::wstring> lines;
+        if (!DiffMemoArchive(io, archive, target, threads, lines, stats)) { Print(L"archive is truncated or damaged: " + archive.wstring()); return 1; }
+        for (const auto& line : lines) Print(line);
+        Print(ArchiveStatsLine(L"diff", stats, threads));
+        Print(std::to_wstring(lines.size()) + L" difference(s)");
+        return lines.empty() ? 0 : 1;
+    }
+    if (cmd == "bench") {
+        if (args.size() < 2) return Usage();
+        return RunArchiveBench(io, archive, (size_t)std::atoll(WideToUtf8(args[1]).c_str()), threads, Print) ? 0 : 1;
+    }
+    return Usage();
+}
\ No newline at end of file
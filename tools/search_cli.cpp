@@ -0,0 +1,63 @@
+// [PRD 6.1] fm_search: 전역 메모 검색의 이식 가능한 CLI (Win32 앱의 --reindex / --search 와 같은 core/search_index)
+// -> 사용법:
+//    fm_search index <색인 이미지> <루트>...
+//    fm_search query <색인 이미지> <검색어> [--limit N]
+// -> 메모 읽기는 FolderMemoIndexSource (folder_memo.txt + 남은 저널 재생, LoadMemo와 같은 UTF-8).
+// -> 종료 코드: 0 성공/결과 있음, 1 실패/결과 없음, 2 사용법 오류
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/search_index.h"
+#include "core/utf.h"
+
+namespace fs = std::filesystem;
+
+static void Print(const std::wstring& line) { std::printf("%s\n", WideToUtf8(line).c_str()); }
+
+static int Usage() {
+    std::fprintf(stderr,
+        "usage: fm_search index <image> <root>...\n"
+        "       fm_search query <image> <text> [--limit N]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) return Usage();
+    std::string cmd = argv[1];
+    std::vector<std::wstring> args;
+    size_t limit = 100;
+    for (int i = 3; i < argc; i++) {
+        if (std::strcmp(argv[i], "--limit") == 0 && i + 1 < argc) limit = (size_t)std::atoll(argv[++i]);
+        else args.push_back(Utf8ToWide(argv[i]));
+    }
+    if (args.empty()) return Usage();
+    MemoSearchIndex index;
+    index.Open(argv[2]);
+    auto t0 = std::chrono::steady_clock::now();
+
+    if (cmd == "index") {
+        std::vector<std::wstring> roots;
+        for (const auto& root : args) roots.push_back(fs::absolute(root).lexically_normal().wstring());
+        FolderMemoIndexSource source;
+        MemoIndexer indexer(index);
+        MemoIndexer::CrawlStats stats = indexer.Crawl(source, roots);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+        Print(L"indexed " + std::to_wstring(index.DocumentCount()) + L" memos in " + std::to_wstring(ms) + L" ms (" +
+            std::to_wstring(stats.indexed) + L" read, " + std::to_wstring(stats.visited - stats.indexed) + L" unchanged, " +
+            std::to_wstring(stats.removed) + L" removed)");
+        return 0;
+    }
+    if (cmd == "query") {
+        std::vector<std::wstring> hits = index.Query(args[0], limit);
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+        for (const auto& path : hits) Print(path);
+        Print(std::to_wstring(hits.size()) + L" result(s) in " + std::to_wstring(us) + L" us");
+        return hits.empty() ? 1 : 0;
+    }
+    return Usage();
+}
\ No newline at end of file